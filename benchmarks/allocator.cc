@@ -0,0 +1,62 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "legate.h"
+
+#include "bench.h"
+
+using namespace Legion;
+
+namespace legate {
+namespace bench {
+
+// Arguments: the size of each allocation and the chunk size of the arena (0 for no arena)
+static void scoped_allocator_allocate(benchmark::State& state)
+{
+  const auto bytes      = static_cast<size_t>(state.range(0));
+  const auto chunk_size = static_cast<size_t>(state.range(1));
+
+  ScopedAllocator allocator(Memory::Kind::SYSTEM_MEM, true /*scoped*/, 16, chunk_size);
+  for (auto _ : state) {
+    auto* ptr = allocator.allocate(bytes);
+    benchmark::DoNotOptimize(ptr);
+    allocator.deallocate(ptr);
+  }
+}
+
+BENCHMARK(scoped_allocator_allocate)->ArgsProduct({{64, 4096}, {0, 1 << 20}});
+
+// Arguments: the number of allocations live at the same time and the chunk size of the arena
+static void scoped_allocator_allocate_many(benchmark::State& state)
+{
+  const auto num_allocations = state.range(0);
+  const auto chunk_size      = static_cast<size_t>(state.range(1));
+
+  std::vector<void*> ptrs(num_allocations);
+  for (auto _ : state) {
+    ScopedAllocator allocator(Memory::Kind::SYSTEM_MEM, true /*scoped*/, 16, chunk_size);
+    for (auto& ptr : ptrs) ptr = allocator.allocate(64);
+    for (auto& ptr : ptrs) allocator.deallocate(ptr);
+  }
+  state.SetItemsProcessed(state.iterations() * num_allocations);
+}
+
+BENCHMARK(scoped_allocator_allocate_many)->ArgsProduct({{16, 256}, {0, 1 << 20}});
+
+}  // namespace bench
+}  // namespace legate
@@ -0,0 +1,41 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "legion.h"
+
+#include "core/runtime/context.h"
+
+namespace legate {
+namespace bench {
+
+// The benchmarks run inside the top-level task, so they can create region trees and buffers
+// and launch tasks. Every benchmark file registers its benchmarks statically.
+struct Environment {
+  Legion::Runtime* runtime;
+  Legion::Context context;
+  // The library context of legate.core, which owns the projection and sharding functors
+  const LibraryContext* core_library;
+};
+
+const Environment& get_environment();
+
+// Tasks used by the benchmarks must be registered before the runtime starts
+void register_deserializer_tasks();
+
+}  // namespace bench
+}  // namespace legate
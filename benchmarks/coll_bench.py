@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+
+# Copyright 2022 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+"""Measures the latency and bandwidth of the collectives that Legate tasks
+run on communicators, in the style of the OSU micro-benchmarks.
+
+Run it with the legate driver, which decides the processors available to
+the communicators, e.g.
+
+    legate --cpus 8 benchmarks/coll_bench.py --comm cpu
+    legate --gpus 4 benchmarks/coll_bench.py --comm nccl --ops allreduce
+
+CPU communicators use the MPI backend of the coll library when Legate was
+built with networking, and the local (shared memory) backend otherwise.
+
+"""
+from __future__ import annotations
+
+import argparse
+import struct
+import sys
+
+from legate.core import Rect, ReductionOp, float64, int32, int64
+from legate.core.launcher import TaskLauncher
+from legate.core.runtime import runtime
+
+# These must be kept in sync with BenchCollective in
+# src/core/comm/comm_bench.h
+COLLECTIVES = {
+    "alltoallv": 0,
+    "alltoall": 1,
+    "allgather": 2,
+    "allreduce": 3,
+    "bcast": 4,
+}
+
+
+def bytes_moved(op: str, size: int, num_ranks: int) -> float:
+    """Returns the number of bytes each rank exchanges with the others in
+    one collective on messages of the given size. Allreduce is counted as
+    a reduce-scatter followed by an allgather, as in nccl-tests."""
+    if op in ("alltoallv", "alltoall", "allgather"):
+        return size * (num_ranks - 1)
+    elif op == "allreduce":
+        return 2 * size * (num_ranks - 1) / num_ranks
+    else:
+        return size
+
+
+def time_collective(
+    comm: str,
+    op: str,
+    size: int,
+    num_ranks: int,
+    warmup: int,
+    iterations: int,
+) -> float:
+    context = runtime.core_context
+    library = runtime.core_library
+    if comm == "nccl":
+        communicator = runtime.get_nccl_communicator()
+        tag = library.LEGATE_GPU_VARIANT
+    else:
+        communicator = runtime.get_cpu_communicator()
+        tag = (
+            library.LEGATE_OMP_VARIANT
+            if runtime.num_omps > 0
+            else library.LEGATE_CPU_VARIANT
+        )
+
+    launch_domain = Rect([num_ranks])
+    task = TaskLauncher(
+        context, library.LEGATE_CORE_COLL_BENCH_TASK_ID, tag=tag
+    )
+    task.add_scalar_arg(COLLECTIVES[op], int32)
+    task.add_scalar_arg(size, int64)
+    task.add_scalar_arg(warmup, int32)
+    task.add_scalar_arg(iterations, int32)
+    task.add_communicator(communicator.get_handle(launch_domain))
+    if communicator.needs_barrier:
+        task.insert_barrier()
+    task.set_concurrent(True)
+    times = task.execute(launch_domain)
+
+    # Like the OSU benchmarks, we report the time of the slowest rank
+    redop = context.type_system[float64].reduction_op_id(ReductionOp.MAX)
+    result = runtime.reduce_future_map(times, redop)
+    return struct.unpack("d", result.get_buffer(8))[0]
+
+
+def parse_sizes(value: str) -> list[int]:
+    return [int(size) for size in value.split(",")]
+
+
+def main(argv: list[str]) -> None:
+    parser = argparse.ArgumentParser(
+        description="Benchmark collectives on Legate communicators"
+    )
+    parser.add_argument(
+        "--comm",
+        choices=("cpu", "nccl"),
+        default="cpu",
+        help="Communicator to benchmark",
+    )
+    parser.add_argument(
+        "--ops",
+        type=lambda value: value.split(","),
+        default=list(COLLECTIVES),
+        help="Comma-separated collectives to run "
+        f"(default: {','.join(COLLECTIVES)})",
+    )
+    parser.add_argument(
+        "--ranks",
+        type=parse_sizes,
+        default=None,
+        help="Comma-separated rank counts (default: powers of two up to "
+        "the number of processors)",
+    )
+    parser.add_argument(
+        "--min-size",
+        type=int,
+        default=1,
+        help="Smallest message size in bytes",
+    )
+    parser.add_argument(
+        "--max-size",
+        type=int,
+        default=1 << 22,
+        help="Largest message size in bytes",
+    )
+    parser.add_argument(
+        "--warmup",
+        type=int,
+        default=10,
+        help="Number of untimed iterations",
+    )
+    parser.add_argument(
+        "--iterations",
+        type=int,
+        default=100,
+        help="Number of timed iterations",
+    )
+    args = parser.parse_args(argv)
+
+    for op in args.ops:
+        if op not in COLLECTIVES:
+            parser.error(f"unknown collective: {op}")
+
+    if args.ranks is None:
+        if args.comm == "nccl":
+            num_procs = runtime.num_gpus
+        else:
+            num_procs = runtime.num_omps or runtime.num_cpus
+        args.ranks = []
+        num_ranks = 2
+        while num_ranks <= num_procs:
+            args.ranks.append(num_ranks)
+            num_ranks *= 2
+        if len(args.ranks) == 0:
+            parser.error("at least two processors are needed")
+
+    sizes = []
+    size = args.min_size
+    while size <= args.max_size:
+        sizes.append(size)
+        size *= 2
+
+    for op in args.ops:
+        for num_ranks in args.ranks:
+            print(f"# {op} on {num_ranks} ranks ({args.comm})")
+            header = f"{'# Size':<12}{'Latency (us)':>16}"
+            print(f"{header}{'Bandwidth (MB/s)':>20}")
+            for size in sizes:
+                elapsed = time_collective(
+                    args.comm,
+                    op,
+                    size,
+                    num_ranks,
+                    args.warmup,
+                    args.iterations,
+                )
+                bandwidth = bytes_moved(op, size, num_ranks) / elapsed / 1e6
+                print(f"{size:<12}{elapsed * 1e6:>16.2f}{bandwidth:>20.2f}")
+            print()
+
+
+if __name__ == "__main__":
+    main(sys.argv[1:])
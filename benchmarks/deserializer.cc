@@ -0,0 +1,103 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+
+#include <benchmark/benchmark.h>
+
+#include "legate.h"
+
+#include "bench.h"
+
+using namespace Legion;
+
+namespace legate {
+namespace bench {
+
+// Unpacking arguments takes far less time than launching a task, so the task unpacks its
+// arguments many times and reports the average time it took
+static constexpr int32_t NUM_UNPACKS = 100;
+
+static TaskID unpack_task_id{0};
+
+static double unpack_task(const Task* task,
+                          const std::vector<PhysicalRegion>& regions,
+                          Context context,
+                          Runtime* runtime)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (int32_t idx = 0; idx < NUM_UNPACKS; ++idx) {
+    TaskDeserializer dez(task, regions);
+    auto inputs     = dez.unpack<std::vector<Store>>();
+    auto outputs    = dez.unpack<std::vector<Store>>();
+    auto reductions = dez.unpack<std::vector<Store>>();
+    auto scalars    = dez.unpack<std::vector<Scalar>>();
+    benchmark::DoNotOptimize(inputs.data());
+    benchmark::DoNotOptimize(scalars.data());
+  }
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(stop - start).count() / NUM_UNPACKS;
+}
+
+void register_deserializer_tasks()
+{
+  unpack_task_id = Runtime::generate_static_task_id();
+  TaskVariantRegistrar registrar(unpack_task_id, "unpack_task");
+  registrar.add_constraint(ProcessorConstraint(Processor::LOC_PROC));
+  registrar.set_leaf(true);
+  Runtime::preregister_task_variant<double, unpack_task>(registrar, "unpack_task");
+}
+
+// Arguments: the number of region stores and the number of scalars passed to the task
+static void unpack_task_args(benchmark::State& state)
+{
+  auto& env              = get_environment();
+  auto* runtime          = env.runtime;
+  auto context           = env.context;
+  const auto num_stores  = static_cast<FieldID>(state.range(0));
+  const auto num_scalars = state.range(1);
+
+  auto index_space = runtime->create_index_space(context, Rect<1>(0, 1023));
+  auto field_space = runtime->create_field_space(context);
+  {
+    auto allocator = runtime->create_field_allocator(context, field_space);
+    for (FieldID fid = 0; fid < num_stores; ++fid) allocator.allocate_field(sizeof(double), fid);
+  }
+  auto region = runtime->create_logical_region(context, index_space, field_space);
+  for (FieldID fid = 0; fid < num_stores; ++fid)
+    runtime->fill_field<double>(context, region, region, fid, 0.0);
+
+  for (auto _ : state) {
+    TaskLauncher launcher(unpack_task_id, 0 /*default mapper*/);
+    for (FieldID fid = 0; fid < num_stores; ++fid)
+      launcher.add_input(TaskLauncher::RegionStore{region, fid, LegateTypeCode::DOUBLE_LT});
+    for (int64_t idx = 0; idx < num_scalars; ++idx) launcher.add_scalar(Scalar(idx));
+    auto result = launcher.execute_single(runtime, context);
+    state.SetIterationTime(result.get_result<double>());
+  }
+
+  runtime->destroy_logical_region(context, region);
+  runtime->destroy_field_space(context, field_space);
+  runtime->destroy_index_space(context, index_space);
+}
+
+BENCHMARK(unpack_task_args)
+  ->ArgsProduct({{1, 4, 16}, {0, 8}})
+  ->UseManualTime()
+  ->Unit(benchmark::kMicrosecond);
+
+}  // namespace bench
+}  // namespace legate
@@ -0,0 +1,144 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+
+#include <benchmark/benchmark.h>
+
+#include "legate.h"
+
+#include "bench.h"
+#include "core/mapping/instance_manager.h"
+
+using namespace Legion;
+
+namespace legate {
+namespace bench {
+
+using mapping::InstanceMappingPolicy;
+using mapping::InstanceSet;
+using mapping::RegionGroup;
+
+static constexpr coord_t GROUP_SIZE = 100;
+
+// A region tree whose root is split into equal partitions of different granularities
+class RegionTree {
+ public:
+  RegionTree(int64_t num_groups) : env_(get_environment())
+  {
+    auto* runtime = env_.runtime;
+    auto context  = env_.context;
+    index_space_  = runtime->create_index_space(context, Rect<1>(0, num_groups * GROUP_SIZE - 1));
+    field_space_  = runtime->create_field_space(context);
+    {
+      auto allocator = runtime->create_field_allocator(context, field_space_);
+      allocator.allocate_field(sizeof(double), 0);
+    }
+    region_ = runtime->create_logical_region(context, index_space_, field_space_);
+  }
+  ~RegionTree()
+  {
+    auto* runtime = env_.runtime;
+    auto context  = env_.context;
+    runtime->destroy_logical_region(context, region_);
+    runtime->destroy_field_space(context, field_space_);
+    for (auto& color_space : color_spaces_) runtime->destroy_index_space(context, color_space);
+    runtime->destroy_index_space(context, index_space_);
+  }
+
+ public:
+  // Returns the subregions of an equal partition with the given number of colors and their
+  // domains
+  std::vector<std::pair<LogicalRegion, Domain>> partition(int64_t num_colors)
+  {
+    auto* runtime    = env_.runtime;
+    auto context     = env_.context;
+    auto color_space = runtime->create_index_space(context, Rect<1>(0, num_colors - 1));
+    color_spaces_.push_back(color_space);
+    auto partition = runtime->get_logical_partition(
+      context, region_, runtime->create_equal_partition(context, index_space_, color_space));
+
+    std::vector<std::pair<LogicalRegion, Domain>> subregions;
+    for (int64_t color = 0; color < num_colors; ++color) {
+      auto subregion = runtime->get_logical_subregion_by_color(partition, DomainPoint(color));
+      subregions.emplace_back(subregion,
+                              runtime->get_index_space_domain(subregion.get_index_space()));
+    }
+    return subregions;
+  }
+
+ private:
+  const Environment& env_;
+  IndexSpace index_space_;
+  FieldSpace field_space_;
+  LogicalRegion region_;
+  std::vector<IndexSpace> color_spaces_;
+};
+
+// Creates an instance set where each of the subregions is mapped to its own instance
+static InstanceSet create_instance_set(
+  const std::vector<std::pair<LogicalRegion, Domain>>& subregions)
+{
+  InstanceSet instance_set;
+  InstanceMappingPolicy policy;
+  for (auto& [subregion, domain] : subregions)
+    instance_set.record_instance(
+      std::make_shared<RegionGroup>(std::set<LogicalRegion>{subregion}, domain),
+      InstanceSet::Instance(),
+      policy);
+  return instance_set;
+}
+
+// Arguments: the number of instances in the set
+static void instance_set_find_instance(benchmark::State& state)
+{
+  RegionTree tree(state.range(0));
+  auto subregions   = tree.partition(state.range(0));
+  auto instance_set = create_instance_set(subregions);
+
+  InstanceMappingPolicy policy;
+  InstanceSet::Instance result;
+  size_t idx = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(instance_set.find_instance(subregions[idx].first, result, policy));
+    idx = (idx + 1) % subregions.size();
+  }
+}
+
+BENCHMARK(instance_set_find_instance)->Arg(16)->Arg(256)->Arg(4096);
+
+// Arguments: the number of instances in the set
+static void instance_set_construct_overlapping_region_group(benchmark::State& state)
+{
+  RegionTree tree(state.range(0));
+  auto instance_set = create_instance_set(tree.partition(state.range(0)));
+  // Each of these subregions is two and a half times as big as the ones that have instances,
+  // so the groups it overlaps with have to be found and considered for coalescing
+  auto queries = tree.partition(std::max<int64_t>(state.range(0) * 2 / 5, 1));
+
+  size_t idx = 0;
+  for (auto _ : state) {
+    auto& [query, domain] = queries[idx];
+    benchmark::DoNotOptimize(
+      instance_set.construct_overlapping_region_group(query, domain, false /*exact*/));
+    idx = (idx + 1) % queries.size();
+  }
+}
+
+BENCHMARK(instance_set_construct_overlapping_region_group)->Arg(16)->Arg(256)->Arg(4096);
+
+}  // namespace bench
+}  // namespace legate
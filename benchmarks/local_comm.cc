@@ -0,0 +1,50 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "legate.h"
+
+#include "bench.h"
+#include "core/comm/coll.h"
+
+namespace legate {
+namespace bench {
+
+// Arguments: the size of the segment and whether it is copied with streaming stores. Run it
+// under numactl with the source and destination bound to different sockets to see the case
+// LocalNetwork collectives hit when peers sit on the other socket.
+static void local_network_copy_segment(benchmark::State& state)
+{
+  const auto bytes  = static_cast<size_t>(state.range(0));
+  const bool stream = state.range(1) != 0;
+
+  std::vector<int8_t> src(bytes, 1);
+  std::vector<int8_t> dst(bytes);
+  for (auto _ : state) {
+    comm::coll::streamCopy(dst.data(), src.data(), bytes, stream ? 0 : SIZE_MAX);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+BENCHMARK(local_network_copy_segment)->ArgsProduct({{4096, 1 << 20, 1 << 26, 1 << 30}, {0, 1}});
+
+}  // namespace bench
+}  // namespace legate
@@ -0,0 +1,75 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "legate.h"
+
+#include "bench.h"
+
+using namespace Legion;
+
+namespace legate {
+namespace bench {
+
+static Environment environment{};
+
+const Environment& get_environment() { return environment; }
+
+static void toplevel_task(const Task* task,
+                          const std::vector<PhysicalRegion>& regions,
+                          Context context,
+                          Runtime* runtime)
+{
+  Core::parse_config();
+  legate_core_perform_registration();
+
+  // This must match the configuration in core_registration_callback, so we get back the
+  // resources that legate.core already reserved
+  ResourceConfig config;
+  config.max_tasks         = LEGATE_CORE_NUM_TASK_IDS;
+  config.max_projections   = LEGATE_CORE_MAX_FUNCTOR_ID;
+  config.max_shardings     = LEGATE_CORE_MAX_FUNCTOR_ID;
+  config.max_reduction_ops = LEGATE_CORE_MAX_REDUCTION_OP_ID;
+  LibraryContext core_library(runtime, "legate.core", config);
+
+  environment.runtime      = runtime;
+  environment.context      = context;
+  environment.core_library = &core_library;
+
+  benchmark::RunSpecifiedBenchmarks();
+}
+
+}  // namespace bench
+}  // namespace legate
+
+int main(int argc, char** argv)
+{
+  // Google Benchmark takes out the flags it recognizes and leaves the rest to Legion
+  benchmark::Initialize(&argc, argv);
+
+  auto toplevel_task_id = Runtime::generate_static_task_id();
+  {
+    TaskVariantRegistrar registrar(toplevel_task_id, "legate_core_bench");
+    registrar.add_constraint(ProcessorConstraint(Processor::LOC_PROC));
+    Runtime::preregister_task_variant<legate::bench::toplevel_task>(registrar,
+                                                                   "legate_core_bench");
+  }
+  legate::bench::register_deserializer_tasks();
+
+  Runtime::set_top_level_task_id(toplevel_task_id);
+  return Runtime::start(argc, argv);
+}
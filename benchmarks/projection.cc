@@ -0,0 +1,139 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "legate.h"
+
+#include "bench.h"
+#include "core/runtime/projection.h"
+
+using namespace Legion;
+
+namespace legate {
+namespace bench {
+
+// Points of a 64x64 launch domain, which the benchmarks cycle through
+static const std::vector<DomainPoint>& launch_points_2d()
+{
+  static const auto points = [] {
+    std::vector<DomainPoint> points;
+    for (PointInRectIterator<2> it(Rect<2>(Point<2>(0, 0), Point<2>(63, 63))); it(); ++it)
+      points.push_back(DomainPoint(*it));
+    return points;
+  }();
+  return points;
+}
+
+// The affine maps that the projection functors are created from. Each of them picks a
+// different kind of functor: a shift, a selection (here, a transpose), and a general affine map.
+enum class AffineMap : int32_t {
+  SHIFT     = 0,
+  SELECTION = 1,
+  AFFINE    = 2,
+};
+
+static ProjectionID get_affine_projection_id(AffineMap map)
+{
+  static const ProjectionID base_id = [] {
+    auto base_id = get_environment().core_library->get_projection_id(
+      LEGATE_CORE_FIRST_DYNAMIC_FUNCTOR_ID);
+
+    int32_t shift_dims[]    = {0, 1};
+    int32_t shift_weights[] = {1, 1};
+    int32_t shift_offsets[] = {1, 2};
+    legate_register_affine_projection_functor(
+      2, 2, shift_dims, shift_weights, shift_offsets, base_id);
+
+    int32_t select_dims[]    = {1, 0};
+    int32_t select_weights[] = {1, 1};
+    int32_t select_offsets[] = {0, 0};
+    legate_register_affine_projection_functor(
+      2, 2, select_dims, select_weights, select_offsets, base_id + 1);
+
+    int32_t affine_dims[]    = {1, 0};
+    int32_t affine_weights[] = {2, 3};
+    int32_t affine_offsets[] = {1, 0};
+    legate_register_affine_projection_functor(
+      2, 2, affine_dims, affine_weights, affine_offsets, base_id + 2);
+
+    return base_id;
+  }();
+  return base_id + static_cast<ProjectionID>(map);
+}
+
+// Arguments: the affine map
+static void affine_project_point(benchmark::State& state)
+{
+  auto proj_id  = get_affine_projection_id(static_cast<AffineMap>(state.range(0)));
+  auto* functor = find_legate_projection_functor(proj_id);
+  auto& points  = launch_points_2d();
+  const Domain launch_domain(Rect<2>(Point<2>(0, 0), Point<2>(63, 63)));
+
+  size_t idx = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(functor->project_point(points[idx], launch_domain));
+    idx = (idx + 1) % points.size();
+  }
+}
+
+BENCHMARK(affine_project_point)
+  ->Arg(static_cast<int32_t>(AffineMap::SHIFT))
+  ->Arg(static_cast<int32_t>(AffineMap::SELECTION))
+  ->Arg(static_cast<int32_t>(AffineMap::AFFINE));
+
+// Arguments: the number of colors in each dimension of the 2D color space
+static void delinearize_project(benchmark::State& state)
+{
+  auto& env       = get_environment();
+  auto* runtime   = env.runtime;
+  auto context    = env.context;
+  const auto side = state.range(0);
+
+  auto index_space =
+    runtime->create_index_space(context, Rect<2>(Point<2>(0, 0), Point<2>(1023, 1023)));
+  auto color_space =
+    runtime->create_index_space(context, Rect<2>(Point<2>(0, 0), Point<2>(side - 1, side - 1)));
+  auto field_space = runtime->create_field_space(context);
+  {
+    auto allocator = runtime->create_field_allocator(context, field_space);
+    allocator.allocate_field(sizeof(double), 0);
+  }
+  auto region    = runtime->create_logical_region(context, index_space, field_space);
+  auto partition = runtime->get_logical_partition(
+    context, region, runtime->create_equal_partition(context, index_space, color_space));
+
+  auto* functor = Runtime::get_projection_functor(
+    env.core_library->get_projection_id(LEGATE_CORE_DELINEARIZE_PROJ_ID));
+  const auto num_colors = side * side;
+  const Domain launch_domain(Rect<1>(0, num_colors - 1));
+
+  int64_t color = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(functor->project(partition, DomainPoint(color), launch_domain));
+    color = (color + 1) % num_colors;
+  }
+
+  runtime->destroy_logical_region(context, region);
+  runtime->destroy_field_space(context, field_space);
+  runtime->destroy_index_space(context, color_space);
+  runtime->destroy_index_space(context, index_space);
+}
+
+BENCHMARK(delinearize_project)->Arg(4)->Arg(16)->Arg(64);
+
+}  // namespace bench
+}  // namespace legate
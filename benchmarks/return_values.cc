@@ -0,0 +1,77 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "legate.h"
+
+#include "bench.h"
+
+using namespace Legion;
+
+namespace legate {
+namespace bench {
+
+static ReturnValues create_return_values(int64_t num_values, size_t value_size)
+{
+  std::vector<int8_t> value(value_size, 1);
+  std::vector<ReturnValue> return_values;
+  for (int64_t idx = 0; idx < num_values; ++idx) {
+    if (value_size <= ReturnValue::MAX_INLINE_SIZE)
+      return_values.emplace_back(value.data(), value_size);
+    else {
+      UntypedDeferredValue deferred(value_size, Memory::Kind::SYSTEM_MEM, value.data());
+      return_values.emplace_back(deferred, value_size);
+    }
+  }
+  return ReturnValues(std::move(return_values));
+}
+
+// Arguments: the number of return values and the size of each value
+static void return_values_pack(benchmark::State& state)
+{
+  auto return_values = create_return_values(state.range(0), state.range(1));
+
+  std::vector<int8_t> buffer(return_values.legion_buffer_size());
+  for (auto _ : state) {
+    return_values.legion_serialize(buffer.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+
+BENCHMARK(return_values_pack)->ArgsProduct({{1, 4, 32}, {8, 64}});
+
+// Arguments: the number of return values and the size of each value
+static void return_values_unpack(benchmark::State& state)
+{
+  auto return_values = create_return_values(state.range(0), state.range(1));
+
+  std::vector<int8_t> buffer(return_values.legion_buffer_size());
+  return_values.legion_serialize(buffer.data());
+  for (auto _ : state) {
+    ReturnValues unpacked;
+    unpacked.legion_deserialize(buffer.data());
+    benchmark::DoNotOptimize(unpacked);
+  }
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+
+// A single value is returned as is, without the header that legion_deserialize expects
+BENCHMARK(return_values_unpack)->ArgsProduct({{4, 32}, {8, 64}});
+
+}  // namespace bench
+}  // namespace legate
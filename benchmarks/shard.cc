@@ -0,0 +1,72 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "legate.h"
+
+#include "bench.h"
+
+using namespace Legion;
+
+namespace legate {
+namespace bench {
+
+static ShardingFunctor* get_linearizing_functor()
+{
+  auto shard_id = get_environment().core_library->get_sharding_id(LEGATE_CORE_LINEARIZE_SHARD_ID);
+  return Runtime::get_sharding_functor(shard_id);
+}
+
+// Arguments: the number of shards
+static void linearizing_shard(benchmark::State& state)
+{
+  auto* functor           = get_linearizing_functor();
+  const auto total_shards = static_cast<size_t>(state.range(0));
+  const Rect<2> launch_rect(Point<2>(0, 0), Point<2>(63, 63));
+  const Domain launch_domain(launch_rect);
+
+  PointInRectIterator<2> it(launch_rect);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(functor->shard(DomainPoint(*it), launch_domain, total_shards));
+    ++it;
+    if (!it()) it = PointInRectIterator<2>(launch_rect);
+  }
+}
+
+BENCHMARK(linearizing_shard)->Arg(8)->Arg(64)->Arg(1024);
+
+// Arguments: the number of shards
+static void linearizing_invert(benchmark::State& state)
+{
+  auto* functor           = get_linearizing_functor();
+  const auto total_shards = static_cast<size_t>(state.range(0));
+  const Domain launch_domain(Rect<2>(Point<2>(0, 0), Point<2>(63, 63)));
+
+  std::vector<DomainPoint> points;
+  ShardID shard = 0;
+  for (auto _ : state) {
+    points.clear();
+    functor->invert(shard, launch_domain, launch_domain, total_shards, points);
+    benchmark::DoNotOptimize(points.data());
+    shard = (shard + 1) % total_shards;
+  }
+}
+
+BENCHMARK(linearizing_invert)->Arg(8)->Arg(64)->Arg(1024);
+
+}  // namespace bench
+}  // namespace legate
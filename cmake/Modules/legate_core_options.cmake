@@ -78,6 +78,8 @@ endif()
 
 option(legate_core_STATIC_CUDA_RUNTIME "Statically link the cuda runtime library" OFF)
 option(legate_core_EXCLUDE_LEGION_FROM_ALL "Exclude Legion targets from legate.core's 'all' target" OFF)
+option(legate_core_BUILD_BENCHMARKS "Build the legate_core_bench microbenchmarks" OFF)
+option(legate_core_BUILD_TESTS "Build the legate_core_tests C++ unit tests" OFF)
 
 set_or_default(NCCL_DIR NCCL_PATH)
 set_or_default(Thrust_DIR THRUST_PATH)
@@ -0,0 +1,25 @@
+#=============================================================================
+# Copyright 2022 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#=============================================================================
+
+# Use CPM to find or clone Google Benchmark
+function(find_or_configure_benchmark)
+    include(${rapids-cmake-dir}/cpm/gbench.cmake)
+
+    # The benchmarks aren't installed, so the dependency isn't exported either
+    rapids_cpm_gbench()
+endfunction()
+
+find_or_configure_benchmark()
@@ -68,7 +68,7 @@ from ._legion import (
 )
 
 # Import select types for Legate library construction
-from .allocation import DistributedAllocation
+from .allocation import DeviceAllocation, DistributedAllocation
 from .context import Annotation, track_provenance
 from .legate import (
     Array,
@@ -98,9 +98,23 @@ from .types import (
     float64,
     complex64,
     complex128,
+    rect1,
     ReductionOp,
 )
-from .io import CustomSplit, TiledSplit, ingest
+from .io import (
+    BinaryFileReader,
+    BinaryFileWriter,
+    CustomSplit,
+    HDF5Reader,
+    HDF5Writer,
+    TiledSplit,
+    TileReader,
+    TileWriter,
+    ZarrReader,
+    ZarrWriter,
+    export,
+    ingest,
+)
 
 # Import the PyArrow type system
 from pyarrow import (
@@ -23,7 +23,13 @@ from .partition import Partition
 from .pending import _pending_unordered
 from .region import PhysicalRegion, Region
 from .space import IndexSpace
-from .util import Dispatchable, ExternalResources, FieldID, dispatch
+from .util import (
+    Dispatchable,
+    ExternalResources,
+    FieldID,
+    dispatch,
+    find_local_memory,
+)
 
 if TYPE_CHECKING:
     from . import FieldListLike, Rect
@@ -1259,6 +1265,7 @@ class IndexAttach(Dispatchable[ExternalResources]):
         mapper: int = 0,
         tag: int = 0,
         provenance: Optional[str] = None,
+        memory: Optional[Any] = None,
     ) -> None:
         """
         A variant of Attach that allows attaching multiple pieces of external
@@ -1276,11 +1283,15 @@ class IndexAttach(Dispatchable[ExternalResources]):
             Maps sub-regions to buffers on the shard's local address space.
             Each sub-region will be attached to the corresponding buffer.
             Each shard should pass a set of distinct subregions, and all
-            sub-regions must be disjoint.
+            sub-regions must be disjoint. Buffers in device memory can be
+            passed as objects exposing ``__cuda_array_interface__``.
         mapper : int
             ID of the mapper to use for mapping the operation
         tag : int
             Tag to pass to the mapper to provide context for any mapper calls
+        memory : legion_memory_t, optional
+            Local memory that holds the buffers. Defaults to the local
+            system memory.
         """
         self.launcher = legion.legion_index_attach_launcher_create(
             parent.handle,
@@ -1296,30 +1307,33 @@ class IndexAttach(Dispatchable[ExternalResources]):
         )
         fields = ffi.new("legion_field_id_t[1]")
         fields[0] = field.fid if isinstance(field, FieldID) else field
-        # Find a local system memory
-        machine = legion.legion_machine_create()
-        query = legion.legion_memory_query_create(machine)
-        legion.legion_memory_query_only_kind(query, legion.SYSTEM_MEM)
-        legion.legion_memory_query_local_address_space(query)
-        sysmem_count = legion.legion_memory_query_count(query)
-        assert sysmem_count > 0
-        mem = legion.legion_memory_query_first(query)
-        if sysmem_count > 1:
+        if memory is None:
+            # Find a local system memory
             # TODO: We should check if the capacity of this memory is 0
-            mem = legion.legion_memory_query_next(query, mem)
-        legion.legion_memory_query_destroy(query)
-        legion.legion_machine_destroy(machine)
+            memory = find_local_memory(legion.SYSTEM_MEM, 1)
+            if memory is None:
+                memory = find_local_memory(legion.SYSTEM_MEM)
+            assert memory is not None
         for (sub_region, buf) in shard_local_data.items():
             if sub_region.parent is not None:
                 assert sub_region.parent.parent is parent
+            # Buffers in device memory are always laid out in C order
+            interface = getattr(buf, "__cuda_array_interface__", None)
+            if interface is None:
+                (base, column_major) = (ffi.from_buffer(buf), buf.f_contiguous)
+            else:
+                (base, column_major) = (
+                    ffi.cast("void*", interface["data"][0]),
+                    False,
+                )
             legion.legion_index_attach_launcher_attach_array_soa(
                 self.launcher,
                 sub_region.handle,
-                ffi.from_buffer(buf),
-                buf.f_contiguous,
+                base,
+                column_major,
                 fields,
                 1,  # num_fields
-                mem,
+                memory,
             )
 
     def set_restricted(self, restricted: bool) -> None:
@@ -174,6 +174,35 @@ class Dispatchable(Generic[T]):
 FieldListLike = Union[int, FieldID, List[int], List[FieldID]]
 
 
+def find_local_memory(kind: Any, index: int = 0) -> Optional[Any]:
+    """
+    Find a memory of the given kind in the local address space
+
+    Parameters
+    ----------
+    kind : legion_memory_kind_t
+        Kind of the memory to find
+    index : int
+        Position of the memory among the local memories of the same kind
+
+    Returns
+    -------
+    A `legion_memory_t` handle, or None if there is no such memory
+    """
+    machine = legion.legion_machine_create()
+    query = legion.legion_memory_query_create(machine)
+    legion.legion_memory_query_only_kind(query, kind)
+    legion.legion_memory_query_local_address_space(query)
+    memory = None
+    if index < legion.legion_memory_query_count(query):
+        memory = legion.legion_memory_query_first(query)
+        for _ in range(index):
+            memory = legion.legion_memory_query_next(query, memory)
+    legion.legion_memory_query_destroy(query)
+    legion.legion_machine_destroy(machine)
+    return memory
+
+
 class ExternalResources:
     def __init__(self, handle: Any) -> None:
         """
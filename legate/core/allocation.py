@@ -14,8 +14,11 @@
 #
 from __future__ import annotations
 
+from math import prod
 from typing import TYPE_CHECKING, Any, Callable, Union
 
+import numpy as np
+
 if TYPE_CHECKING:
     from . import Partition as LegionPartition, Point
     from .store import RegionField
@@ -33,13 +36,22 @@ class InlineMappedAllocation:
         shape: tuple[int, ...],
         address: int,
         strides: tuple[int, ...],
+        on_device: bool = False,
     ) -> None:
         self._region_field = region_field
         self._shape = shape
         self._address = address
         self._strides = strides
+        self._on_device = on_device
         self._consumed = False
 
+    @property
+    def on_device(self) -> bool:
+        """
+        Whether the address points to framebuffer memory
+        """
+        return self._on_device
+
     def __del__(self) -> None:
         if not self._consumed:
             self._region_field.decrement_inline_mapped_ref_count(
@@ -85,4 +97,41 @@ class DistributedAllocation:
         self.shard_local_buffers = shard_local_buffers
 
 
-Attachable = Union[memoryview, DistributedAllocation]
+class DeviceAllocation:
+    def __init__(self, obj: Any) -> None:
+        """
+        Represents a buffer in GPU framebuffer memory, such as a CuPy array,
+        to be attached in place as a framebuffer instance
+
+        Parameters
+        ----------
+        obj : Any
+            Object exposing ``__cuda_array_interface__``. The buffer must be
+            contiguous in C order, and the object is kept alive for as long
+            as the allocation is.
+        """
+        interface = obj.__cuda_array_interface__
+        self.shape: tuple[int, ...] = tuple(interface["shape"])
+        self.itemsize = np.dtype(interface["typestr"]).itemsize
+        strides = interface.get("strides")
+        if strides is not None:
+            expected = []
+            stride = self.itemsize
+            for extent in reversed(self.shape):
+                expected.append(stride)
+                stride *= extent
+            if tuple(strides) != tuple(reversed(expected)):
+                raise ValueError(
+                    "Only buffers contiguous in C order can be attached"
+                )
+        self.ptr: int = interface["data"][0]
+        self.nbytes = prod(self.shape) * self.itemsize
+        self._interface = interface
+        self._owner = obj
+
+    @property
+    def __cuda_array_interface__(self) -> dict[str, Any]:
+        return self._interface
+
+
+Attachable = Union[memoryview, DistributedAllocation, DeviceAllocation]
@@ -16,7 +16,8 @@ from __future__ import annotations
 
 import struct
 from abc import ABC, abstractmethod, abstractproperty
-from typing import TYPE_CHECKING
+from collections import OrderedDict
+from typing import TYPE_CHECKING, Any
 
 from . import FutureMap, Point, Rect
 
@@ -25,21 +26,48 @@ if TYPE_CHECKING:
 
 
 class Communicator(ABC):
-    def __init__(self, runtime: Runtime) -> None:
+    def __init__(self, runtime: Runtime, capacity: int) -> None:
         self._runtime = runtime
         self._context = runtime.core_context
 
-        self._handles: dict[int, FutureMap] = {}
+        # Communicators are keyed by the volume of the launch domain, which
+        # determines the set of processors they span. The dict is kept in
+        # least-recently-used order so we know which one to retire first.
+        self._handles: OrderedDict[int, FutureMap] = OrderedDict()
         # From launch domains to communicator future maps transformed to N-D
         self._nd_handles: dict[Rect, FutureMap] = {}
+        self._capacity = max(capacity, 1)
+        self._num_hits = 0
+        self._num_created = 0
+        self._num_retired = 0
 
     def _get_1d_handle(self, volume: int) -> FutureMap:
         if volume in self._handles:
+            self._handles.move_to_end(volume)
+            self._num_hits += 1
             return self._handles[volume]
         comm = self._initialize(volume)
         self._handles[volume] = comm
+        self._num_created += 1
+        if len(self._handles) > self._capacity:
+            self._retire_least_recently_used()
         return comm
 
+    def _retire_least_recently_used(self) -> None:
+        volume, handle = self._handles.popitem(last=False)
+        self._nd_handles = {
+            launch_domain: comm
+            for launch_domain, comm in self._nd_handles.items()
+            if launch_domain.get_volume() != volume
+        }
+        # Launches that used the communicator may still be running, and
+        # Legion doesn't order the finalization task after them because they
+        # all only read the handle. An execution fence keeps the finalization
+        # from tearing the communicator down under them.
+        self._runtime.issue_execution_fence()
+        self._finalize(volume, handle)
+        self._num_retired += 1
+
     def _transform_handle(
         self, comm: FutureMap, launch_domain: Rect
     ) -> FutureMap:
@@ -64,7 +92,27 @@ class Communicator(ABC):
         # Drop the references to the handles dict after
         # all handles have been finalized to ensure that
         # no references to FutureMaps are kept.
-        self._handles = {}
+        self._handles = OrderedDict()
+        self._nd_handles = {}
+
+    def describe(self) -> dict[str, Any]:
+        """
+        Returns a summary of the communicators currently cached
+
+        Returns
+        -------
+        dict[str, Any]
+            The cached volumes from least to most recently used, the
+            launch domains with N-D views of them, and usage counters
+        """
+        return {
+            "volumes": list(self._handles.keys()),
+            "launch_domains": [str(dom) for dom in self._nd_handles.keys()],
+            "capacity": self._capacity,
+            "hits": self._num_hits,
+            "created": self._num_created,
+            "retired": self._num_retired,
+        }
 
     @abstractproperty
     def needs_barrier(self) -> bool:
@@ -80,8 +128,8 @@ class Communicator(ABC):
 
 
 class NCCLCommunicator(Communicator):
-    def __init__(self, runtime: Runtime) -> None:
-        super().__init__(runtime)
+    def __init__(self, runtime: Runtime, capacity: int) -> None:
+        super().__init__(runtime, capacity)
         library = runtime.core_library
 
         self._init_nccl_id = library.LEGATE_CORE_INIT_NCCL_ID_TASK_ID
@@ -120,8 +168,8 @@ class NCCLCommunicator(Communicator):
 
 
 class CPUCommunicator(Communicator):
-    def __init__(self, runtime: Runtime) -> None:
-        super().__init__(runtime)
+    def __init__(self, runtime: Runtime, capacity: int) -> None:
+        super().__init__(runtime, capacity)
         library = runtime.core_library
 
         self._init_cpucoll_mapping = (
@@ -136,7 +184,7 @@ class CPUCommunicator(Communicator):
         self._needs_barrier = False
 
     def destroy(self) -> None:
-        if len(self._handles) > 0:
+        if self._num_created > 0:
             # Call the default destroy to finalize all cpu communicators that
             #   have been created
             Communicator.destroy(self)
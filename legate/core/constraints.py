@@ -17,7 +17,7 @@ from __future__ import annotations
 from collections.abc import Iterable
 from typing import TYPE_CHECKING, Any, Iterator, Optional, Protocol, Union
 
-from .partition import Restriction
+from .partition import Image as ImagePartition, Restriction
 
 if TYPE_CHECKING:
     from .partition import PartitionBase
@@ -219,6 +219,47 @@ class Scale(Expr):
             yield unknown
 
 
+class Image(Expr):
+    # The image of a partition of a store holding ranges, interpreted as
+    # ranges of points in the store being constrained
+    def __init__(self, expr: Expr) -> None:
+        if not isinstance(expr, PartSym):
+            raise NotImplementedError(
+                "Images are supported only for partition variables"
+            )
+        elif expr.ndim != 1:
+            raise NotImplementedError(
+                "Images are supported only for 1-D stores"
+            )
+        self._expr = expr
+
+    @property
+    def ndim(self) -> int:
+        return 1
+
+    @property
+    def closed(self) -> bool:
+        return self._expr.closed
+
+    def __repr__(self) -> str:
+        return f"image({self._expr})"
+
+    def subst(self, mapping: dict[PartSym, PartitionBase]) -> Expr:
+        return Lit(ImagePartition(self._expr.store, mapping[self._expr]))
+
+    def reduce(self) -> Lit:
+        raise NotImplementedError(
+            "Images must be substituted before being reduced"
+        )
+
+    def unknowns(self) -> Iterator[PartSym]:
+        yield self._expr
+
+
+def image(expr: Expr) -> Image:
+    return Image(expr)
+
+
 class Constraint:
     pass
 
@@ -30,7 +30,7 @@ import numpy as np
 
 from . import Future, legion
 from .resource import ResourceScope
-from .types import TypeSystem
+from .types import TypeSystem, int8, rect1
 
 if TYPE_CHECKING:
     import numpy.typing as npt
@@ -379,6 +379,19 @@ class Context:
             ndim=ndim,
         )
 
+    def create_string_store(
+        self, num_strings: int, num_chars: int
+    ) -> tuple[Store, Store]:
+        """
+        Creates the two stores of a string store: a store of ``rect1``
+        ranges, one for each string, and a store of ``int8`` characters that
+        the ranges point into. Operations using the string store should
+        partition the characters with ``add_image``.
+        """
+        ranges = self.create_store(rect1, shape=(num_strings,))
+        chars = self.create_store(int8, shape=(num_chars,))
+        return ranges, chars
+
     def get_nccl_communicator(self) -> Communicator:
         return self._runtime.get_nccl_communicator()
 
@@ -389,8 +402,17 @@ class Context:
         self._runtime.issue_execution_fence(block=block)
 
     def tree_reduce(
-        self, task_id: int, store: Store, mapper_id: int = 0, radix: int = 4
+        self,
+        task_id: int,
+        store: Store,
+        mapper_id: int = 0,
+        radix: Optional[int] = None,
     ) -> Store:
+        """
+        Reduces a store with a tree of tasks. Unless a radix is given, each
+        level of the tree picks its own: wide while the level's points
+        share nodes and narrow once they span nodes.
+        """
         from .operation import Reduce
 
         result = self.create_store(store.type)
@@ -0,0 +1,131 @@
+# Copyright 2022 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+from __future__ import annotations
+
+from typing import Iterator, Optional, Protocol
+
+# Bandwidths reported by the mapper are in MB/s
+_MB = 1 << 20
+
+
+class CostModel(Protocol):
+    def estimate(
+        self,
+        extents: tuple[int, ...],
+        launch_shape: tuple[int, ...],
+        itemsize: int,
+        existing: Optional[tuple[int, ...]],
+    ) -> float:
+        """
+        Estimates the cost of partitioning a store of the given extents
+        with a launch grid.
+
+        Parameters
+        ----------
+        extents : tuple[int, ...]
+            Extents of the dimensions being partitioned
+        launch_shape : tuple[int, ...]
+            Candidate launch grid, of the same length as ``extents``
+        itemsize : int
+            Size of each element in bytes
+        existing : tuple[int, ...], optional
+            Color shape of the partition the store currently has, if any
+
+        Returns
+        -------
+        float
+            Estimated cost; only the ordering between candidates matters
+        """
+        ...
+
+
+class DefaultCostModel:
+    """
+    A cost model that charges each candidate launch grid for the time to
+    stream a tile through a processor, the time to exchange the tile's
+    boundaries with its neighbors, and the time to move the store out of
+    the partition it currently has. Candidates whose tiles don't fit in the
+    memory of a single piece are ruled out.
+    """
+
+    def __init__(
+        self,
+        piece_memory: int,
+        local_bandwidth: int,
+        remote_bandwidth: int,
+    ) -> None:
+        # Realm reports zero when it doesn't know the bandwidth, in which
+        # case we only compare candidates relative to each other
+        local_bandwidth = max(local_bandwidth, 1)
+        if remote_bandwidth <= 0:
+            remote_bandwidth = local_bandwidth
+        self._piece_memory = piece_memory
+        self._local_bandwidth = float(local_bandwidth * _MB)
+        self._remote_bandwidth = float(remote_bandwidth * _MB)
+
+    def estimate(
+        self,
+        extents: tuple[int, ...],
+        launch_shape: tuple[int, ...],
+        itemsize: int,
+        existing: Optional[tuple[int, ...]],
+    ) -> float:
+        tile = tuple(
+            (ext + colors - 1) // colors
+            for ext, colors in zip(extents, launch_shape)
+        )
+        tile_bytes = itemsize
+        for ext in tile:
+            tile_bytes *= ext
+
+        if self._piece_memory > 0 and tile_bytes > self._piece_memory:
+            return float("inf")
+
+        compute = tile_bytes / self._local_bandwidth
+
+        # Each split dimension exchanges two faces of the tile
+        halo_bytes = 0
+        for ext, colors in zip(tile, launch_shape):
+            if colors > 1:
+                halo_bytes += 2 * (tile_bytes // ext)
+        halo = halo_bytes / self._remote_bandwidth
+
+        # Switching to a different grid moves most of the tile
+        repartition = 0.0
+        if existing is not None and existing != launch_shape:
+            repartition = tile_bytes / self._remote_bandwidth
+
+        return compute + halo + repartition
+
+
+def enumerate_launch_shapes(
+    extents: tuple[int, ...], num_pieces: int
+) -> Iterator[tuple[int, ...]]:
+    """
+    Enumerates all launch grids with exactly ``num_pieces`` points that
+    don't have more colors than elements in any dimension
+    """
+    if len(extents) == 0:
+        if num_pieces == 1:
+            yield ()
+        return
+    ext = extents[0]
+    for colors in range(1, min(ext, num_pieces) + 1):
+        if num_pieces % colors != 0:
+            continue
+        for rest in enumerate_launch_shapes(
+            extents[1:], num_pieces // colors
+        ):
+            yield (colors,) + rest
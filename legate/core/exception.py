@@ -35,6 +35,9 @@ class PendingException:
         self._future = future
         self._tb_repr = tb_repr
 
+    def is_ready(self) -> bool:
+        return self._future.is_ready(subscribe=True)
+
     def raise_exception(self) -> None:
         buf = self._future.get_buffer()
         (raised,) = struct.unpack("?", buf[:1])
@@ -14,7 +14,12 @@
 #
 from __future__ import annotations
 
-from typing import TYPE_CHECKING, Callable, Iterable, Optional, Union
+import mmap
+import os
+from concurrent.futures import ThreadPoolExecutor
+from typing import TYPE_CHECKING, Any, Callable, Iterable, Optional, Union
+
+import numpy as np
 
 from . import ffi  # Make sure we only have one ffi instance
 from . import (
@@ -58,6 +63,13 @@ class DataSplit:
     ) -> Partition:
         raise NotImplementedError("Implement in derived classes")
 
+    def get_subdomain(self, shape: Shape, color: Point) -> Rect:
+        """
+        Returns the subset of the overall domain covered by the buffer of
+        the given color
+        """
+        raise NotImplementedError("Implement in derived classes")
+
 
 class CustomSplit(DataSplit):
     def __init__(self, get_subdomain: Callable[[Point], Rect]) -> None:
@@ -74,7 +86,10 @@ class CustomSplit(DataSplit):
             called once for each color, on the appropriate process for that
             color (see the documentation for `get_local_colors` on `ingest`).
         """
-        self.get_subdomain = get_subdomain
+        self._get_subdomain = get_subdomain
+
+    def get_subdomain(self, shape: Shape, color: Point) -> Rect:
+        return self._get_subdomain(color)
 
     def make_partition(
         self,
@@ -84,7 +99,7 @@ class CustomSplit(DataSplit):
     ) -> Partition:
         futures = {}
         for c in local_colors:
-            rect = self.get_subdomain(c)
+            rect = self._get_subdomain(c)
             futures[c] = Future.from_cdata(legion_runtime, rect.raw())
         domains = FutureMap.from_dict(
             legion_context,
@@ -118,6 +133,15 @@ class TiledSplit(DataSplit):
         """
         self.tile_shape = tile_shape
 
+    def get_subdomain(self, shape: Shape, color: Point) -> Rect:
+        tile_shape = Shape(self.tile_shape)
+        lo = tuple(color[dim] * tile for dim, tile in enumerate(tile_shape))
+        hi = tuple(
+            min(lo[dim] + tile, shape[dim]) - 1
+            for dim, tile in enumerate(tile_shape)
+        )
+        return Rect(hi, lo, exclusive=False)
+
     def make_partition(
         self,
         store: Store,
@@ -135,12 +159,274 @@ class TiledSplit(DataSplit):
         return part
 
 
+def _to_slices(rect: Rect) -> tuple[slice, ...]:
+    return tuple(
+        slice(rect.lo[dim], rect.hi[dim] + 1) for dim in range(rect.dim)
+    )
+
+
+class TileReader:
+    """
+    Reads the tiles of an array stored in a file. This is an abstract base
+    class, use one of the concrete derived classes instead.
+
+    A reader can be passed to `ingest` in place of a `get_buffer` callback.
+    Each process then reads all of its local tiles concurrently on a pool of
+    threads. The reads are double-buffered: each tile is prefetched when the
+    read of the tile before it starts, so the file system loads it while the
+    previous tile is being read and converted.
+    """
+
+    def __init__(self, num_threads: Optional[int] = None) -> None:
+        """
+        Parameters
+        ----------
+        num_threads : int | None
+            Number of threads each process uses to read its tiles. Defaults
+            to the number of CPUs on the host.
+        """
+        self._num_threads = num_threads or os.cpu_count() or 1
+
+    def read_tile(self, rect: Rect) -> memoryview:
+        """
+        Returns a buffer holding the elements of the tile. This is called
+        from a reader thread.
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def prefetch_tile(self, rect: Rect) -> None:
+        """
+        Starts loading the tile in the background without waiting for it.
+        This is called for each tile when the read of the previous tile
+        starts, and must return quickly.
+        """
+        pass
+
+    def read_tiles(self, tiles: dict[Point, Rect]) -> dict[Point, memoryview]:
+        rects = list(tiles.values())
+
+        def read(idx: int) -> memoryview:
+            if idx + 1 < len(rects):
+                self.prefetch_tile(rects[idx + 1])
+            return self.read_tile(rects[idx])
+
+        if len(rects) > 0:
+            self.prefetch_tile(rects[0])
+        with ThreadPoolExecutor(
+            max_workers=min(self._num_threads, max(len(tiles), 1))
+        ) as pool:
+            # The pool starts the reads in submission order, which keeps the
+            # prefetches one tile ahead of them
+            futures = {
+                color: pool.submit(read, idx)
+                for idx, color in enumerate(tiles.keys())
+            }
+            return {
+                color: future.result() for color, future in futures.items()
+            }
+
+
+class BinaryFileReader(TileReader):
+    def __init__(
+        self,
+        path: Union[str, os.PathLike[str]],
+        dtype: Any,
+        shape: tuple[int, ...],
+        offset: int = 0,
+        order: str = "C",
+        num_threads: Optional[int] = None,
+    ) -> None:
+        """
+        Reads tiles of a dense array stored as raw binary data in a file.
+
+        The file is memory-mapped. A tile whose elements are contiguous in
+        the file, e.g. a block of whole rows of a row-major array, is
+        attached in place without being copied; the reader threads fault in
+        its pages, which the kernel has been asked to read ahead. Other
+        tiles are gathered into new buffers by the reader threads.
+
+        Parameters
+        ----------
+        path : str | os.PathLike
+            File that holds the array
+        dtype : numpy.dtype-like
+            Type of the array elements
+        shape : Tuple[int]
+            Shape of the whole array
+        offset : int
+            Offset of the array in bytes from the beginning of the file
+        order : str
+            Either "C" for row-major or "F" for column-major layouts
+        num_threads : int | None
+            Number of threads each process uses to read its tiles
+        """
+        super().__init__(num_threads)
+        self._path = path
+        self._offset = offset
+        # The mapping is copy-on-write, so Legate can take ownership of the
+        # tiles attached in place without modifying the file
+        self._array = np.memmap(
+            path,
+            dtype=dtype,
+            mode="c",
+            offset=offset,
+            shape=shape,
+            order=order,
+        )
+
+    def _get_view(self, rect: Rect) -> np.ndarray[Any, Any]:
+        return self._array[_to_slices(rect)]
+
+    def prefetch_tile(self, rect: Rect) -> None:
+        view = self._get_view(rect)
+        if view.size == 0 or not (
+            view.flags.c_contiguous or view.flags.f_contiguous
+        ):
+            return
+        if not hasattr(os, "posix_fadvise"):
+            return
+        start = (
+            view.__array_interface__["data"][0]
+            - self._array.__array_interface__["data"][0]
+            + self._offset
+        )
+        with open(self._path, "rb") as f:
+            os.posix_fadvise(
+                f.fileno(), start, view.nbytes, os.POSIX_FADV_WILLNEED
+            )
+
+    def read_tile(self, rect: Rect) -> memoryview:
+        view = self._get_view(rect)
+        if view.flags.c_contiguous or view.flags.f_contiguous:
+            # Touch a byte of every page so that the tile is in memory by the
+            # time it is attached. NumPy drops the GIL in the reduction, so
+            # the reader threads take their page faults in parallel.
+            if view.size > 0:
+                pages = view.ravel(order="K").view(np.uint8)[:: mmap.PAGESIZE]
+                pages.sum()
+            return memoryview(view)
+        return memoryview(np.ascontiguousarray(view))
+
+
+class HDF5Reader(TileReader):
+    def __init__(
+        self,
+        path: Union[str, os.PathLike[str]],
+        dataset: str,
+        num_threads: Optional[int] = None,
+    ) -> None:
+        """
+        Reads tiles of a dataset in an HDF5 file. Requires h5py.
+
+        Contiguous datasets that are neither chunked nor filtered are read
+        through a `BinaryFileReader` over the dataset's extent in the file,
+        which attaches suitably shaped tiles in place. Other datasets are
+        read tile by tile through h5py, which serializes the reads.
+
+        Parameters
+        ----------
+        path : str | os.PathLike
+            HDF5 file that holds the dataset
+        dataset : str
+            Name of the dataset
+        num_threads : int | None
+            Number of threads each process uses to read its tiles
+        """
+        import h5py  # type: ignore[import]
+
+        super().__init__(num_threads)
+        self._file = h5py.File(path, "r")
+        self._dataset = self._file[dataset]
+        self._binary_reader: Optional[BinaryFileReader] = None
+        offset = self._dataset.id.get_offset()
+        if (
+            offset is not None
+            and self._dataset.chunks is None
+            and self._dataset.compression is None
+        ):
+            self._binary_reader = BinaryFileReader(
+                path,
+                self._dataset.dtype,
+                self._dataset.shape,
+                offset=offset,
+                num_threads=num_threads,
+            )
+
+    def prefetch_tile(self, rect: Rect) -> None:
+        if self._binary_reader is not None:
+            self._binary_reader.prefetch_tile(rect)
+
+    def read_tile(self, rect: Rect) -> memoryview:
+        if self._binary_reader is not None:
+            return self._binary_reader.read_tile(rect)
+        return memoryview(
+            np.ascontiguousarray(self._dataset[_to_slices(rect)])
+        )
+
+
+class ZarrReader(TileReader):
+    def __init__(
+        self,
+        store: Any,
+        num_threads: Optional[int] = None,
+    ) -> None:
+        """
+        Reads tiles of a Zarr array. Requires zarr.
+
+        Tiles are best aligned with the chunks of the array, so that each
+        chunk is read and decompressed by exactly one reader thread.
+
+        Parameters
+        ----------
+        store : str | zarr.Array
+            Path or URL of the array, or an already opened array
+        num_threads : int | None
+            Number of threads each process uses to read its tiles
+        """
+        import zarr  # type: ignore[import]
+
+        super().__init__(num_threads)
+        self._array = (
+            store if isinstance(store, zarr.Array) else zarr.open(store, "r")
+        )
+
+    def read_tile(self, rect: Rect) -> memoryview:
+        return memoryview(np.ascontiguousarray(self._array[_to_slices(rect)]))
+
+
+# Assign colors following the default sharding
+def _get_default_local_colors(colors: tuple[int, ...]) -> list[Point]:
+    sid = runtime.core_context.get_sharding_id(
+        runtime.core_library.LEGATE_CORE_LINEARIZE_SHARD_ID
+    )
+    shard = legion.legion_runtime_local_shard(legion_runtime, legion_context)
+    domain = Rect(colors).raw()
+    total_shards = legion.legion_runtime_total_shards(
+        legion_runtime, legion_context
+    )
+    points_size = ffi.new("size_t *")
+    points_size[0] = 1
+    for c in colors:
+        points_size[0] *= c
+    points_ptr = ffi.new("legion_domain_point_t[%s]" % points_size[0])
+    legion.legion_sharding_functor_invert(
+        sid,
+        shard,
+        domain,
+        domain,
+        total_shards,
+        points_ptr,
+        points_size,
+    )
+    return [Point(points_ptr[i]) for i in range(points_size[0])]
+
+
 def ingest(
     dtype: DataType,
     shape: Union[int, tuple[int, ...]],
     colors: tuple[int, ...],
     data_split: DataSplit,
-    get_buffer: Callable[[Point], memoryview],
+    get_buffer: Union[Callable[[Point], memoryview], TileReader],
     get_local_colors: Optional[Callable[[], Iterable[Point]]] = None,
 ) -> Table:
     """
@@ -165,7 +451,7 @@ def ingest(
     data_split : DataSplit
         Specifies what subset of the overall domain is covered by each buffer
 
-    get_buffer : Callable[[Point], memoryview]
+    get_buffer : Callable[[Point], memoryview] | TileReader
         This function will be called on the appropriate process for each color
         (see the documentation for `get_local_colors`) and should return a
         pre-existing buffer residing in local memory, or generate one on the
@@ -174,6 +460,10 @@ def ingest(
         The contents of each buffer may be in row-major or column-major order.
         Legate will take ownership of the returned memory.
 
+        A `TileReader` can be passed instead to read the buffers from a file.
+        Each process then reads the subdomains of its colors, as described
+        by `data_split`, concurrently.
+
     get_local_colors : Callable[[], Iterable[Point]] | None
         If `None` then Legate will assume that every buffer is accessible from
         any process (rank) where Legate is running. Legate will then invoke
@@ -217,42 +507,341 @@ def ingest(
             f"data_split: expected a DataSplit object but got {data_split}"
         )
 
-    # Assign colors following the default sharding
-    def default_get_local_colors() -> list[Point]:
-        sid = runtime.core_context.get_sharding_id(
-            runtime.core_library.LEGATE_CORE_LINEARIZE_SHARD_ID
-        )
-        shard = legion.legion_runtime_local_shard(
-            legion_runtime, legion_context
-        )
-        domain = Rect(colors).raw()
-        total_shards = legion.legion_runtime_total_shards(
-            legion_runtime, legion_context
-        )
-        points_size = ffi.new("size_t *")
-        points_size[0] = 1
-        for c in colors:
-            points_size[0] *= c
-        points_ptr = ffi.new("legion_domain_point_t[%s]" % points_size[0])
-        legion.legion_sharding_functor_invert(
-            sid,
-            shard,
-            domain,
-            domain,
-            total_shards,
-            points_ptr,
-            points_size,
-        )
-        return [Point(points_ptr[i]) for i in range(points_size[0])]
-
     store = runtime.core_context.create_store(dtype, Shape(shape))
     local_colors = (
-        get_local_colors() if get_local_colors else default_get_local_colors()
+        get_local_colors()
+        if get_local_colors
+        else _get_default_local_colors(colors)
     )
     partition = data_split.make_partition(store, colors, local_colors)
-    shard_local_buffers = {c: get_buffer(c) for c in local_colors}
+    if isinstance(get_buffer, TileReader):
+        shard_local_buffers = get_buffer.read_tiles(
+            {
+                c: data_split.get_subdomain(store.shape, c)
+                for c in local_colors
+            }
+        )
+    else:
+        shard_local_buffers = {c: get_buffer(c) for c in local_colors}
     alloc = DistributedAllocation(partition, shard_local_buffers)
     store.attach_external_allocation(runtime.core_context, alloc, False)
     # first store is the (non-existent) mask
     array = Array(dtype, [None, store])
     return Table.from_arrays([array], ["ingested"])
+
+
+class TileWriter:
+    """
+    Writes the tiles of an array to a file. This is an abstract base class,
+    use one of the concrete derived classes instead. Writers are passed to
+    `export`.
+    """
+
+    def __init__(self, num_threads: Optional[int] = None) -> None:
+        """
+        Parameters
+        ----------
+        num_threads : int | None
+            Number of threads each process uses to write its tiles. Defaults
+            to the number of CPUs on the host.
+        """
+        self._num_threads = num_threads or os.cpu_count() or 1
+
+    def open(self, dtype: np.dtype[Any], shape: tuple[int, ...]) -> None:
+        """
+        Prepares the file for an array of the given type and shape. This is
+        called on every process before any tile is written.
+        """
+        pass
+
+    def get_buffer(self, rect: Rect, dtype: np.dtype[Any]) -> memoryview:
+        """
+        Returns the buffer that receives the elements of the tile. Writers
+        can return a view of the file itself to have the tile written in
+        place. By default, a new buffer is allocated.
+        """
+        shape = tuple(
+            rect.hi[dim] - rect.lo[dim] + 1 for dim in range(rect.dim)
+        )
+        return memoryview(np.empty(shape, dtype=dtype))
+
+    def write_tile(self, rect: Rect, buf: memoryview) -> None:
+        """
+        Writes the buffer of the tile to the file. This is called from a
+        writer thread once the buffer holds the tile's elements.
+        """
+        raise NotImplementedError("Implement in derived classes")
+
+    def close(self) -> None:
+        """
+        Finishes writing the tiles of this process
+        """
+        pass
+
+    def write_tiles(
+        self, tiles: dict[Point, Rect], buffers: dict[Point, memoryview]
+    ) -> None:
+        with ThreadPoolExecutor(
+            max_workers=min(self._num_threads, max(len(tiles), 1))
+        ) as pool:
+            futures = [
+                pool.submit(self.write_tile, rect, buffers[color])
+                for color, rect in tiles.items()
+            ]
+            for future in futures:
+                future.result()
+
+
+class BinaryFileWriter(TileWriter):
+    def __init__(
+        self,
+        path: Union[str, os.PathLike[str]],
+        offset: int = 0,
+        num_threads: Optional[int] = None,
+    ) -> None:
+        """
+        Writes a dense array in row-major order as raw binary data to a file,
+        which is created if it doesn't exist.
+
+        The file is memory-mapped on every process. Tiles that are
+        contiguous in the file, e.g. blocks of whole rows, are written in
+        place; the other tiles are staged in separate buffers and copied
+        into the mapping by the writer threads.
+
+        Parameters
+        ----------
+        path : str | os.PathLike
+            File to write the array to
+        offset : int
+            Offset of the array in bytes from the beginning of the file
+        num_threads : int | None
+            Number of threads each process uses to write its tiles
+        """
+        super().__init__(num_threads)
+        self._path = path
+        self._offset = offset
+        self._array: Optional[np.memmap[Any, Any]] = None
+
+    def open(self, dtype: np.dtype[Any], shape: tuple[int, ...]) -> None:
+        # Every process extends the file to the same size, so it doesn't
+        # matter which one gets to do it first
+        size = self._offset + int(np.prod(shape)) * dtype.itemsize
+        fd = os.open(self._path, os.O_RDWR | os.O_CREAT, 0o644)
+        try:
+            if os.fstat(fd).st_size < size:
+                os.ftruncate(fd, size)
+        finally:
+            os.close(fd)
+        self._array = np.memmap(
+            self._path,
+            dtype=dtype,
+            mode="r+",
+            offset=self._offset,
+            shape=shape,
+        )
+
+    def get_buffer(self, rect: Rect, dtype: np.dtype[Any]) -> memoryview:
+        assert self._array is not None
+        view = self._array[_to_slices(rect)]
+        if view.flags.c_contiguous:
+            return memoryview(view)
+        return super().get_buffer(rect, dtype)
+
+    def write_tile(self, rect: Rect, buf: memoryview) -> None:
+        assert self._array is not None
+        view = self._array[_to_slices(rect)]
+        if view.size == 0:
+            return
+        # Tiles written in place need no copy. Slicing the mapping again
+        # makes a new view object, so the buffer is compared by its address.
+        data = np.asarray(buf)
+        if (
+            data.__array_interface__["data"][0]
+            == view.__array_interface__["data"][0]
+        ):
+            return
+        view[...] = data.reshape(view.shape)
+
+    def close(self) -> None:
+        if self._array is not None:
+            self._array.flush()
+            self._array = None
+
+
+class HDF5Writer(TileWriter):
+    def __init__(
+        self,
+        path: Union[str, os.PathLike[str]],
+        dataset: str,
+        num_threads: Optional[int] = None,
+    ) -> None:
+        """
+        Writes tiles to a dataset in an HDF5 file. Requires h5py.
+
+        The dataset must already exist with the array's type and shape, and
+        must be contiguous and allocated early, e.g. created by a single
+        process with ``create_dataset(..., fillvalue=0)`` on a contiguous
+        layout, so that every process can write its tiles in place through
+        a `BinaryFileWriter` over the dataset's extent in the file.
+
+        Parameters
+        ----------
+        path : str | os.PathLike
+            HDF5 file that holds the dataset
+        dataset : str
+            Name of the dataset
+        num_threads : int | None
+            Number of threads each process uses to write its tiles
+        """
+        import h5py  # type: ignore[import]
+
+        super().__init__(num_threads)
+        with h5py.File(path, "r") as f:
+            dset = f[dataset]
+            offset = dset.id.get_offset()
+            if (
+                offset is None
+                or dset.chunks is not None
+                or dset.compression is not None
+            ):
+                raise ValueError(
+                    "Only allocated, contiguous, and unfiltered datasets can "
+                    "be written in parallel"
+                )
+            self._shape = tuple(dset.shape)
+        self._writer = BinaryFileWriter(
+            path, offset=offset, num_threads=num_threads
+        )
+
+    def open(self, dtype: np.dtype[Any], shape: tuple[int, ...]) -> None:
+        if shape != self._shape:
+            raise ValueError(
+                f"Dataset has shape {self._shape}, but the store has {shape}"
+            )
+        self._writer.open(dtype, shape)
+
+    def get_buffer(self, rect: Rect, dtype: np.dtype[Any]) -> memoryview:
+        return self._writer.get_buffer(rect, dtype)
+
+    def write_tile(self, rect: Rect, buf: memoryview) -> None:
+        self._writer.write_tile(rect, buf)
+
+    def close(self) -> None:
+        self._writer.close()
+
+
+class ZarrWriter(TileWriter):
+    def __init__(
+        self,
+        store: Any,
+        num_threads: Optional[int] = None,
+    ) -> None:
+        """
+        Writes tiles to an existing Zarr array. Requires zarr.
+
+        Tiles are best aligned with the chunks of the array, so that no two
+        processes write the same chunk.
+
+        Parameters
+        ----------
+        store : str | zarr.Array
+            Path or URL of the array, or an already opened array
+        num_threads : int | None
+            Number of threads each process uses to write its tiles
+        """
+        import zarr  # type: ignore[import]
+
+        super().__init__(num_threads)
+        self._array = (
+            store if isinstance(store, zarr.Array) else zarr.open(store, "r+")
+        )
+
+    def open(self, dtype: np.dtype[Any], shape: tuple[int, ...]) -> None:
+        if shape != tuple(self._array.shape):
+            raise ValueError(
+                f"Array has shape {self._array.shape}, but the store has "
+                f"{shape}"
+            )
+
+    def write_tile(self, rect: Rect, buf: memoryview) -> None:
+        self._array[_to_slices(rect)] = np.asarray(buf)
+
+
+def _get_tile(partition: Tiling, shape: Shape, color: Point) -> Rect:
+    lo = tuple(
+        partition.offset[dim] + color[dim] * partition.tile_shape[dim]
+        for dim in range(shape.ndim)
+    )
+    hi = tuple(
+        min(lo[dim] + partition.tile_shape[dim], shape[dim]) - 1
+        for dim in range(shape.ndim)
+    )
+    return Rect(hi, lo, exclusive=False)
+
+
+def export(store: Store, writer: TileWriter) -> None:
+    """
+    Writes the contents of a store to a file, with each process writing the
+    tiles of the store it owns under the store's key partition. The data is
+    not gathered to any single process.
+
+    Each process attaches the tile buffers it gets from the writer to a copy
+    of the store, which the runtime fills in place on the processes owning
+    the buffers. The writer threads then write the buffers to the file.
+    This call blocks until all local tiles are written.
+
+    Parameters
+    ----------
+    store : Store
+        Store to write. Must not be a variable-size or future-backed store.
+    writer : TileWriter
+        Writes the tiles to the file
+    """
+    if store.kind is not RegionField or store.unbound:
+        raise ValueError(
+            "Only fixed-size RegionField-backed stores can be exported"
+        )
+    shape = store.shape
+    dtype = np.dtype(store.type.type.to_pandas_dtype())
+
+    # Use the partition the store is already distributed with, so that the
+    # tiles are written by the processes that hold them
+    partition = store.compute_key_partition(store.find_restrictions())
+    if not isinstance(partition, Tiling):
+        partition = Tiling(shape, Shape((1,) * shape.ndim))
+    assert partition.color_shape is not None
+    colors = tuple(partition.color_shape)
+
+    target = runtime.core_context.create_store(store.type.type, shape)
+    target.set_key_partition(partition)
+    legion_partition = target.find_or_create_legion_partition(
+        partition, complete=True
+    )
+    assert legion_partition is not None
+
+    writer.open(dtype, tuple(shape))
+    tiles = {
+        color: _get_tile(partition, shape, color)
+        for color in _get_default_local_colors(colors)
+    }
+    buffers = {
+        color: writer.get_buffer(rect, dtype) for color, rect in tiles.items()
+    }
+    alloc = DistributedAllocation(legion_partition, buffers)
+    target.attach_external_allocation(runtime.core_context, alloc, True)
+
+    copy = runtime.core_context.create_copy()
+    copy.add_input(store)
+    copy.add_output(target)
+    copy.execute()
+    runtime.flush_scheduling_window()
+
+    # Detaching the buffers flushes the tiles back to them
+    region_field = target.storage
+    assert isinstance(region_field, RegionField)
+    detached = region_field.detach_external_allocation(unordered=False)
+    assert detached is not None
+    detached.wait()
+
+    writer.write_tiles(tiles, buffers)
+    writer.close()
@@ -38,9 +38,11 @@ from . import (
     IndexTask,
     Partition as LegionPartition,
     Task as SingleTask,
+    ffi,
     legion,
     types as ty,
 )
+from ._legion.util import Dispatchable
 from .runtime import runtime
 from .utils import OrderedSet
 
@@ -83,6 +85,21 @@ _SERIALIZERS: dict[Any, Serializer] = {
     ty.string: BufferBuilder.pack_string,
 }
 
+# C types of the scalars that can be passed to native task launches
+_NATIVE_SCALAR_TYPES: dict[Any, str] = {
+    bool: "bool",
+    ty.int8: "int8_t",
+    ty.int16: "int16_t",
+    ty.int32: "int32_t",
+    ty.int64: "int64_t",
+    ty.uint8: "uint8_t",
+    ty.uint16: "uint16_t",
+    ty.uint32: "uint32_t",
+    ty.uint64: "uint64_t",
+    ty.float32: "float",
+    ty.float64: "double",
+}
+
 EntryType = Tuple[Union["Broadcast", "Partition"], int, int]
 
 
@@ -706,6 +723,62 @@ class CopyReqAnalyzer(RequirementIndexer):
         return self._requirement_map[(req, field_id)]
 
 
+class NativeTask(Dispatchable[Future]):
+    """
+    A single task whose arguments the core library packs in C++. The C
+    arrays describing the arguments, and the scalar values they point to,
+    must stay alive until the task is launched.
+    """
+
+    def __init__(
+        self,
+        task_id: int,
+        mapper_id: int,
+        tag: int,
+        inputs: tuple[Any, int],
+        outputs: tuple[Any, int],
+        reductions: tuple[Any, int],
+        scalars: tuple[Any, int],
+        values: list[Any],
+        flags: tuple[bool, bool, bool],
+        provenance: Optional[str],
+    ) -> None:
+        self._task_id = task_id
+        self._mapper_id = mapper_id
+        self._tag = tag
+        self._inputs = inputs
+        self._outputs = outputs
+        self._reductions = reductions
+        self._scalars = scalars
+        self._values = values
+        self._flags = flags
+        self._provenance = provenance
+
+    def launch(
+        self,
+        legion_runtime: legion.legion_runtime_t,
+        legion_context: legion.legion_context_t,
+        **kwargs: Any,
+    ) -> Future:
+        provenance = (
+            ffi.NULL if self._provenance is None else self._provenance.encode()
+        )
+        handle = runtime.core_library.legate_launch_single_task(
+            legion_runtime,
+            legion_context,
+            self._task_id,
+            self._mapper_id,
+            self._tag,
+            *self._inputs,
+            *self._outputs,
+            *self._reductions,
+            *self._scalars,
+            *self._flags,
+            provenance,
+        )
+        return Future(handle)
+
+
 class TaskLauncher:
     def __init__(
         self,
@@ -739,6 +812,7 @@ class TaskLauncher:
         self._has_side_effect = side_effect
         self._insert_barrier = False
         self._can_raise_exception = False
+        self._reports_time = False
         self._provenance = provenance
         self._concurrent = False
 
@@ -810,6 +884,8 @@ class TaskLauncher:
 
             region = store.storage.region
             field_id = store.storage.field.field_id
+            if perm != Permission.READ:
+                store.storage.field.invalidate_images()
 
             req = RegionReq(region, perm, proj, tag, flags)
 
@@ -892,6 +968,9 @@ class TaskLauncher:
     def set_can_raise_exception(self, can_raise_exception: bool) -> None:
         self._can_raise_exception = can_raise_exception
 
+    def set_reports_time(self, reports_time: bool) -> None:
+        self._reports_time = reports_time
+
     def set_concurrent(self, concurrent: bool) -> None:
         self._concurrent = concurrent
 
@@ -912,6 +991,7 @@ class TaskLauncher:
         pack_args(argbuf, self._reductions)
         pack_args(argbuf, self._scalars)
         argbuf.pack_bool(self._can_raise_exception)
+        argbuf.pack_bool(self._reports_time)
         argbuf.pack_bool(self._insert_barrier)
         argbuf.pack_32bit_uint(len(self._comms))
 
@@ -955,6 +1035,7 @@ class TaskLauncher:
         pack_args(argbuf, self._reductions)
         pack_args(argbuf, self._scalars)
         argbuf.pack_bool(self._can_raise_exception)
+        argbuf.pack_bool(self._reports_time)
 
         assert len(self._comms) == 0
 
@@ -991,13 +1072,109 @@ class TaskLauncher:
         self._out_analyzer.update_storages()
         return result
 
+    def _native_store_args(
+        self, args: list[LauncherArg], permission: Permission
+    ) -> Optional[Any]:
+        c_args = ffi.new("legate_store_arg_t[]", max(len(args), 1))
+        for idx, arg in enumerate(args):
+            if not isinstance(arg, RegionFieldArg):
+                return None
+            req = arg._req
+            if not isinstance(req, RegionReq):
+                return None
+            if req.permission != permission or arg._store.transformed:
+                return None
+            c_arg = c_args[idx]
+            c_arg.region = req.region.handle
+            c_arg.field_id = arg._field_id
+            c_arg.code = arg._store.type.code
+            c_arg.redop = max(arg._redop, 0)
+            c_arg.tag = req.tag
+            c_arg.flags = req.flags
+        return c_args
+
+    def _native_scalar_args(self) -> Optional[tuple[Any, list[Any]]]:
+        c_args = ffi.new("legate_scalar_arg_t[]", max(len(self._scalars), 1))
+        values: list[Any] = []
+        for idx, scalar in enumerate(self._scalars):
+            dtype = scalar._dtype
+            if not scalar._untyped or dtype not in _NATIVE_SCALAR_TYPES:
+                return None
+            value = ffi.new(f"{_NATIVE_SCALAR_TYPES[dtype]}*", scalar._value)
+            values.append(value)
+            c_args[idx].code = self._core_types[dtype].code
+            c_args[idx].value = value
+        return c_args, values
+
+    def _execute_single_natively(self) -> Optional[Future]:
+        """
+        Launches the task with a single call into the core library, which
+        packs the arguments in C++. Returns None if the launch uses anything
+        the native launcher doesn't handle, in which case the caller packs
+        the arguments in Python.
+        """
+        if (
+            len(self._future_args) > 0
+            or len(self._future_map_args) > 0
+            or not self._out_analyzer.empty
+            or not self._error_on_interference
+            or self._sharding_space is not None
+            or self._point is not None
+        ):
+            return None
+        inputs = self._native_store_args(self._inputs, Permission.READ)
+        outputs = self._native_store_args(self._outputs, Permission.WRITE)
+        reductions = self._native_store_args(
+            self._reductions, Permission.REDUCTION
+        )
+        scalars = self._native_scalar_args()
+        if (
+            inputs is None
+            or outputs is None
+            or reductions is None
+            or scalars is None
+        ):
+            return None
+        (c_scalars, values) = scalars
+
+        task = NativeTask(
+            self.legion_task_id,
+            self.legion_mapper_id,
+            self._tag,
+            (inputs, len(self._inputs)),
+            (outputs, len(self._outputs)),
+            (reductions, len(self._reductions)),
+            (c_scalars, len(self._scalars)),
+            values,
+            (
+                self._can_raise_exception,
+                self._reports_time,
+                self._has_side_effect,
+            ),
+            self._provenance,
+        )
+        return self._context.dispatch_single(task)
+
     def execute_single(self) -> Future:
+        if runtime.native_launch:
+            result = self._execute_single_natively()
+            if result is not None:
+                return result
         argbuf = BufferBuilder()
         result = self._context.dispatch_single(self.build_single_task(argbuf))
         self._out_analyzer.update_storages()
         return result
 
 
+class CoreTaskLauncher(TaskLauncher):
+    # Launches a core task that gets mapped by the mapper of a library, like
+    # fused tasks, which are mapped by the mapper of the library whose tasks
+    # got fused
+    @property
+    def legion_task_id(self) -> int:
+        return runtime.core_context.get_task_id(self._task_id)
+
+
 class CopyLauncher:
     def __init__(
         self,
@@ -1060,6 +1237,8 @@ class CopyLauncher:
 
         region = store.storage.region
         field_id = store.storage.field.field_id
+        if perm != Permission.READ:
+            store.storage.field.invalidate_images()
 
         req = RegionReq(region, perm, proj, tag, flags)
 
@@ -1161,6 +1340,19 @@ class CopyLauncher:
     def set_point(self, point: Point) -> None:
         self._point = point
 
+    def _get_indirect_requirements(
+        self, req_analyzer: CopyReqAnalyzer
+    ) -> list[tuple[RegionReq, int]]:
+        # A batched copy shares one indirection among all its source-target
+        # pairs. Legion still wants one indirection requirement per pair,
+        # so we repeat the shared one, while the mapper sees the store only
+        # once and maps all the requirements to the same instance.
+        requirements = req_analyzer.requirements
+        num_pairs = len(self._inputs)
+        if len(requirements) == 1 and num_pairs > 1:
+            return requirements * num_pairs
+        return requirements
+
     def build_copy(self, launch_domain: Rect) -> IndexCopy:
         argbuf = BufferBuilder()
         pack_args(argbuf, self._inputs)
@@ -1183,8 +1375,12 @@ class CopyLauncher:
 
         add_requirements(self._input_reqs.requirements)
         add_requirements(self._output_reqs.requirements)
-        add_requirements(self._source_indirect_reqs.requirements)
-        add_requirements(self._target_indirect_reqs.requirements)
+        add_requirements(
+            self._get_indirect_requirements(self._source_indirect_reqs)
+        )
+        add_requirements(
+            self._get_indirect_requirements(self._target_indirect_reqs)
+        )
 
         if self._sharding_space is not None:
             copy.set_sharding_space(self._sharding_space)
@@ -1214,8 +1410,12 @@ class CopyLauncher:
 
         add_requirements(self._input_reqs.requirements)
         add_requirements(self._output_reqs.requirements)
-        add_requirements(self._source_indirect_reqs.requirements)
-        add_requirements(self._target_indirect_reqs.requirements)
+        add_requirements(
+            self._get_indirect_requirements(self._source_indirect_reqs)
+        )
+        add_requirements(
+            self._get_indirect_requirements(self._target_indirect_reqs)
+        )
 
         if self._sharding_space is not None:
             copy.set_sharding_space(self._sharding_space)
@@ -1277,6 +1477,7 @@ class FillLauncher:
             assert isinstance(self._lhs.storage, RegionField)
             assert isinstance(self._value.storage, Future)
         assert self._lhs_proj.part is not None
+        self._lhs.storage.field.invalidate_images()
         fill = IndexFill(
             self._lhs_proj.part,
             self._lhs_proj.proj,
@@ -1296,6 +1497,7 @@ class FillLauncher:
         if TYPE_CHECKING:
             assert isinstance(self._lhs.storage, RegionField)
             assert isinstance(self._value.storage, Future)
+        self._lhs.storage.field.invalidate_images()
         fill = SingleFill(
             self._lhs.storage.region,
             self._lhs.storage.region.get_root(),
@@ -0,0 +1,220 @@
+# Copyright 2022 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+from __future__ import annotations
+
+import struct
+import weakref
+from typing import TYPE_CHECKING, Optional
+
+from . import Future, FutureMap, Point, Rect
+from .partition import Tiling, Weighted
+from .shape import Shape
+
+if TYPE_CHECKING:
+    from .operation import AutoTask, Operation
+    from .partition import PartitionBase
+    from .runtime import Runtime
+    from .solver import Strategy
+    from .store import Store
+
+# Maximum number of stores whose partitions the load balancer tracks
+_MAX_TRACKED_STORES = 4096
+
+
+class LoadBalancer:
+    """
+    Rebalances partitions of 1-D stores using the execution times of the
+    point tasks that last ran on them. Index launches over a balanced store
+    report the time each point took, and the next launch over the same
+    store gets a weighted partition that assigns each point a number of
+    elements proportional to the throughput it achieved.
+    """
+
+    def __init__(self, runtime: Runtime, threshold: float) -> None:
+        self._runtime = runtime
+        # A store is rebalanced only when its slowest point took this much
+        # longer than the average
+        self._threshold = threshold
+        # Store ids mapped to a weak reference to the store, the number of
+        # elements each color of its partition got, and the time each point
+        # took. The feedback must not keep the store and its data alive.
+        self._feedback: dict[
+            int, tuple[weakref.ref[Store], tuple[int, ...], FutureMap]
+        ] = {}
+        # Store ids mapped to the weighted partitions we created for them,
+        # with the number of elements assigned to each color
+        self._partitions: dict[int, tuple[Weighted, tuple[int, ...]]] = {}
+
+    def _get_counts(
+        self, store: Store, partition: PartitionBase
+    ) -> Optional[tuple[int, ...]]:
+        extent = store.shape[0]
+        if isinstance(partition, Tiling):
+            if partition.offset[0] != 0:
+                return None
+            assert partition.color_shape is not None
+            tile = partition.tile_shape[0]
+            return tuple(
+                max(min(tile * (color + 1), extent) - tile * color, 0)
+                for color in range(partition.color_shape[0])
+            )
+        elif isinstance(partition, Weighted):
+            entry = self._partitions.get(store._unique_id)
+            if entry is not None and entry[0] is partition:
+                return entry[1]
+        return None
+
+    def select_target(
+        self, op: AutoTask, strategy: Strategy
+    ) -> Optional[tuple[Store, tuple[int, ...]]]:
+        """
+        Picks a store of the operation whose partition can be rebalanced
+        with the execution times of its point tasks. Only 1-D stores whose
+        partition has one color per point are eligible.
+        """
+        launch_domain = strategy.launch_domain
+        if launch_domain is None or launch_domain.dim != 1:
+            return None
+        if len(op.unbound_outputs) > 0:
+            return None
+        launch_shape = Shape(c + 1 for c in launch_domain.hi)
+        for store, part_symb in zip(
+            op.inputs + op.outputs, op._input_parts + op._output_parts
+        ):
+            if store.ndim != 1 or store.kind is Future:
+                continue
+            if store.transformed:
+                continue
+            partition = strategy.get_partition(part_symb)
+            if partition.color_shape != launch_shape:
+                continue
+            counts = self._get_counts(store, partition)
+            if counts is not None:
+                return (store, counts)
+        return None
+
+    def record_timings(
+        self, target: tuple[Store, tuple[int, ...]], timings: FutureMap
+    ) -> None:
+        (store, counts) = target
+        if (
+            store._unique_id not in self._feedback
+            and len(self._feedback) >= _MAX_TRACKED_STORES
+        ):
+            del self._feedback[next(iter(self._feedback))]
+        self._feedback[store._unique_id] = (
+            weakref.ref(store),
+            counts,
+            timings,
+        )
+
+    def _read_timings(
+        self, timings: FutureMap, num_colors: int
+    ) -> Optional[list[int]]:
+        futures = [
+            timings.get_future(Point([color])) for color in range(num_colors)
+        ]
+        # We never block on the timings; the store keeps its partition until
+        # all points that reported them have finished. The runtime only
+        # creates a load balancer on a single node, as shards polling the
+        # futures at different times would make different choices.
+        if not all(future.is_ready() for future in futures):
+            return None
+        return [
+            struct.unpack("Q", future.get_buffer(8))[0] for future in futures
+        ]
+
+    def _rebalance_counts(
+        self, counts: tuple[int, ...], times: list[int]
+    ) -> Optional[tuple[int, ...]]:
+        total_time = sum(times)
+        if total_time == 0 or any(time == 0 for time in times):
+            return None
+        average = total_time / len(times)
+        if max(times) <= average * (1.0 + self._threshold):
+            return None
+
+        # Give each color a number of elements proportional to the rate at
+        # which its point processed elements, making sure no color is empty
+        volume = sum(counts)
+        if volume < len(counts):
+            return None
+        rates = [count / time for count, time in zip(counts, times)]
+        total_rate = sum(rates)
+        if total_rate == 0:
+            return None
+        result = [max(int(volume * rate / total_rate), 1) for rate in rates]
+        # Hand the remainder out to, or take the excess from, the fastest
+        # colors first
+        order = sorted(
+            range(len(rates)), key=lambda color: rates[color], reverse=True
+        )
+        diff = volume - sum(result)
+        idx = 0
+        while diff != 0:
+            color = order[idx % len(order)]
+            if diff > 0:
+                result[color] += 1
+                diff -= 1
+            elif result[color] > 1:
+                result[color] -= 1
+                diff += 1
+            idx += 1
+        return tuple(result)
+
+    def _create_partition(self, counts: tuple[int, ...]) -> Weighted:
+        runtime = self._runtime
+        num_colors = len(counts)
+        futures = {
+            Point([color]): runtime.create_future(
+                struct.pack("Q", count), 8
+            )
+            for color, count in enumerate(counts)
+        }
+        weights = FutureMap.from_dict(
+            runtime.legion_context,
+            runtime.legion_runtime,
+            Rect([num_colors]),
+            futures,
+        )
+        return Weighted(Shape((num_colors,)), weights)
+
+    def rebalance(self, ops: list[Operation]) -> None:
+        """
+        Updates the key partitions of the stores used by the operations
+        with the feedback that arrived since the last time
+        """
+        for op in ops:
+            for store in op.get_all_stores():
+                entry = self._feedback.get(store._unique_id)
+                if entry is None or entry[0]() is not store:
+                    continue
+                (_, counts, timings) = entry
+                times = self._read_timings(timings, len(counts))
+                if times is None:
+                    continue
+                del self._feedback[store._unique_id]
+
+                new_counts = self._rebalance_counts(counts, times)
+                if new_counts is None or sum(new_counts) != store.shape[0]:
+                    continue
+                partition = self._create_partition(new_counts)
+                if (
+                    store._unique_id not in self._partitions
+                    and len(self._partitions) >= _MAX_TRACKED_STORES
+                ):
+                    del self._partitions[next(iter(self._partitions))]
+                self._partitions[store._unique_id] = (partition, new_counts)
+                store.set_key_partition(partition)
@@ -27,20 +27,28 @@ from typing import (
 import legate.core.types as ty
 
 from . import Future, FutureMap, Rect
-from .constraints import PartSym
-from .launcher import CopyLauncher, FillLauncher, TaskLauncher
-from .partition import REPLICATE, Weighted
+from .constraints import Alignment, PartSym, image
+from .launcher import (
+    CopyLauncher,
+    CoreTaskLauncher,
+    FillLauncher,
+    TaskLauncher,
+)
+from .partition import REPLICATE, Image, Weighted
 from .shape import Shape
 from .store import Store, StorePartition
+from .types import rect1
 from .utils import OrderedSet, capture_traceback_repr
 
 if TYPE_CHECKING:
+    from ..timing import Timer
     from .communicator import Communicator
     from .constraints import Constraint
     from .context import Context
     from .launcher import Proj
     from .projection import ProjFn, ProjOut, SymbolicPoint
     from .solver import Strategy
+    from .store import Storage
     from .types import DTType
 
 
@@ -179,6 +187,29 @@ class Operation(OperationProtocol):
         part = self._get_unique_partition(store)
         self.add_constraint(part.broadcast(axes=axes))
 
+    def add_image(self, ranges: Store, store: Store) -> None:
+        """
+        Partitions a store by the ranges of points held in another store,
+        which is how a string store keeps its characters next to its ranges
+
+        Parameters
+        ----------
+        ranges : Store
+            1-D store of type ``rect1`` whose elements are ranges of points
+            in ``store``
+        store : Store
+            1-D store partitioned by the image of the partition of ``ranges``
+        """
+        self._check_store(ranges)
+        self._check_store(store)
+        if ranges.type.type != rect1 or ranges.ndim != 1:
+            raise ValueError("Ranges must be a 1-D store of type rect1")
+        elif store.ndim != 1 or store.transformed:
+            raise ValueError("Images are supported only for 1-D root stores")
+        part1 = self._get_unique_partition(ranges)
+        part2 = self._get_unique_partition(store)
+        self.add_constraint(part2 <= image(part1))
+
     def add_constraint(self, constraint: Constraint) -> None:
         self._constraints.append(constraint)
 
@@ -250,11 +281,27 @@ class Task(TaskProtocol):
         self._tb_repr: Union[None, str] = None
         self._side_effect = False
         self._concurrent = False
+        self._fusable = False
+        self._eager = False
+        # The store whose partition the load balancer rebalances with the
+        # execution times of this task, and the sizes of its tiles
+        self._load_balance_target: Optional[
+            tuple[Store, tuple[int, ...]]
+        ] = None
+        # The timer collecting the execution times of this task, if any
+        self._timer: Optional[Timer] = None
 
     @property
     def side_effect(self) -> bool:
         return self._side_effect
 
+    def set_timer(self, timer: Optional[Timer]) -> None:
+        self._timer = timer
+
+    @property
+    def reports_time(self) -> bool:
+        return self._timer is not None or self._load_balance_target is not None
+
     def set_side_effect(self, side_effect: bool) -> None:
         self._side_effect = side_effect
 
@@ -265,6 +312,19 @@ class Task(TaskProtocol):
     def set_concurrent(self, concurrent: bool) -> None:
         self._concurrent = concurrent
 
+    @property
+    def fusable(self) -> bool:
+        return self._fusable
+
+    def set_fusable(self, fusable: bool) -> None:
+        """
+        Marks the task as fusable, which means the task is element-wise on
+        aligned stores and its library registered fusable variants of it.
+        Consecutive fusable tasks in the scheduling window can then be
+        launched together as a single fused task.
+        """
+        self._fusable = fusable
+
     def get_name(self) -> str:
         libname = self.context.library.get_name()
         return f"{libname}.Task(tid:{self._task_id}, uid:{self._op_id})"
@@ -292,6 +352,22 @@ class Task(TaskProtocol):
         for (arg, dtype) in self._scalar_args:
             launcher.add_scalar_arg(arg, dtype)
 
+    def _record_elapsed_time(
+        self,
+        timings: Union[Future, FutureMap],
+        launch_domain: Optional[Rect],
+    ) -> None:
+        if self._timer is not None:
+            self._timer.record(self, timings, launch_domain)
+        if self._load_balance_target is not None and isinstance(
+            timings, FutureMap
+        ):
+            runtime = self.context.runtime
+            assert runtime.load_balancer is not None
+            runtime.load_balancer.record_timings(
+                self._load_balance_target, timings
+            )
+
     def _demux_scalar_stores_future(self, result: Future) -> None:
         num_unbound_outs = len(self.unbound_outputs)
         num_scalar_outs = len(self.scalar_outputs)
@@ -303,6 +379,7 @@ class Task(TaskProtocol):
             + num_scalar_outs
             + num_scalar_reds
             + int(self.can_raise_exception)
+            + int(self.reports_time)
         )
 
         if num_all_scalars == 0:
@@ -318,6 +395,8 @@ class Task(TaskProtocol):
                 runtime.record_pending_exception(
                     self._exn_types, result, self._tb_repr
                 )
+            elif self.reports_time:
+                self._record_elapsed_time(result, None)
             else:
                 assert num_unbound_outs == 1
         else:
@@ -336,6 +415,11 @@ class Task(TaskProtocol):
                     runtime.extract_scalar(result, idx),
                     self._tb_repr,
                 )
+                idx += 1
+            if self.reports_time:
+                self._record_elapsed_time(
+                    runtime.extract_scalar(result, idx), None
+                )
 
     def _demux_scalar_stores_future_map(
         self,
@@ -352,6 +436,7 @@ class Task(TaskProtocol):
             + num_scalar_outs
             + num_scalar_reds
             + int(self.can_raise_exception)
+            + int(self.reports_time)
         )
         launch_shape = Shape(c + 1 for c in launch_domain.hi)
         assert num_scalar_outs == 0
@@ -375,6 +460,8 @@ class Task(TaskProtocol):
                     runtime.reduce_exception_future_map(result),
                     self._tb_repr,
                 )
+            elif self.reports_time:
+                self._record_elapsed_time(result, launch_domain)
             else:
                 assert False
         else:
@@ -409,6 +496,14 @@ class Task(TaskProtocol):
                     runtime.reduce_exception_future_map(exn_fut_map),
                     self._tb_repr,
                 )
+                idx += 1
+            if self.reports_time:
+                self._record_elapsed_time(
+                    runtime.extract_scalar_with_domain(
+                        result, idx, launch_domain
+                    ),
+                    launch_domain,
+                )
 
     def _demux_scalar_stores(
         self,
@@ -575,18 +670,58 @@ class AutoTask(AutoOperation, Task):
                 continue
             self.record_reuse(strategy, idx, store, part_symb)
 
-    def launch(self, strategy: Strategy) -> None:
-        launcher = TaskLauncher(
+    def _compress_transfer(
+        self, store: Store, part_symb: PartSym, strategy: Strategy
+    ) -> None:
+        # Stores that opted in are moved to the new partition by the
+        # compressed shuffle before the task reads them. Within a node,
+        # Legion's copies are cheaper than compressing the data.
+        runtime = self.context.runtime
+        if (
+            runtime.num_nodes == 1
+            or not strategy.parallel
+            or strategy.launch_ndim != store.ndim
+        ):
+            return
+        partition = strategy.get_partition(part_symb)
+        if store.can_compress_transfer(partition):
+            runtime.compressed_shuffle(
+                store, partition, self.context, self.mapper_id
+            )
+
+    def _create_launcher(self) -> TaskLauncher:
+        tag = (
+            self.context.core_library.LEGATE_CORE_EAGER_TASK_TAG
+            if self._eager
+            else 0
+        )
+        return TaskLauncher(
             self.context,
             self._task_id,
             self.mapper_id,
+            tag=tag,
             side_effect=self._side_effect,
             provenance=self.provenance,
         )
 
+    def launch_eagerly(self) -> None:
+        """
+        Launches the task right away as a single task on the CPUs of the
+        calling node. All stores are replicated, so the task skips the
+        partitioner, and the mapper skips the target selection.
+        """
+        from .solver import Strategy
+
+        self._eager = True
+        self.launch(Strategy.replicated(self.all_unknowns))
+
+    def launch(self, strategy: Strategy) -> None:
+        launcher = self._create_launcher()
+
         self.find_all_reusable_store_pairs(strategy)
 
         for store, part_symb in zip(self._inputs, self._input_parts):
+            self._compress_transfer(store, part_symb, strategy)
             req, tag, _ = self.get_requirement(store, part_symb, strategy)
             launcher.add_input(store, req, tag=tag)
 
@@ -601,8 +736,11 @@ class AutoTask(AutoOperation, Task):
                 store, part_symb, strategy
             )
             launcher.add_output(store, req, tag=tag)
-            # We update the key partition of a store only when it gets updated
-            store.set_key_partition(store_part.partition)
+            # We update the key partition of a store only when it gets
+            # updated. Images are only valid for the current ranges, so they
+            # never become key partitions.
+            if not isinstance(store_part.partition, Image):
+                store.set_key_partition(store_part.partition)
 
         for ((store, redop), part_symb) in zip(
             self._reductions, self._reduction_parts
@@ -633,6 +771,13 @@ class AutoTask(AutoOperation, Task):
         launch_domain = strategy.launch_domain if strategy.parallel else None
         self._add_communicators(launcher, launch_domain)
 
+        load_balancer = self.context.runtime.load_balancer
+        if load_balancer is not None and launch_domain is not None:
+            self._load_balance_target = load_balancer.select_target(
+                self, strategy
+            )
+        launcher.set_reports_time(self.reports_time)
+
         result: Union[Future, FutureMap]
         if launch_domain is not None:
             result = launcher.execute(launch_domain)
@@ -642,6 +787,153 @@ class AutoTask(AutoOperation, Task):
         self._demux_scalar_stores(result, launch_domain)
 
 
+class FusedTask(AutoTask):
+    """
+    A core task that runs a sequence of fusable tasks of one library back
+    to back on aligned partitions of their stores. The stores and scalar
+    arguments of the fused tasks are passed in order, preceded by a scalar
+    argument that describes how they are split between the tasks.
+    """
+
+    def __init__(
+        self,
+        tasks: list[AutoTask],
+        op_id: int,
+    ) -> None:
+        context = tasks[0].context
+        super().__init__(
+            context=context,
+            task_id=context.runtime.core_library.LEGATE_CORE_FUSED_TASK_ID,
+            mapper_id=tasks[0].mapper_id,
+            op_id=op_id,
+        )
+
+        desc = [len(tasks)]
+        for task in tasks:
+            for store in task.inputs:
+                self.add_input(store)
+            for store in task.outputs:
+                self.add_output(store)
+            desc.extend(
+                (
+                    context.get_task_id(task._task_id),
+                    len(task.inputs),
+                    len(task.outputs),
+                    len(task.reductions),
+                    len(task._scalar_args),
+                )
+            )
+            self._scalar_args.extend(task._scalar_args)
+        self._scalar_args.insert(0, (desc, (ty.int64,)))
+        self._timer = tasks[0]._timer
+
+        stores = list(self.get_all_stores())
+        for store in stores[1:]:
+            self.add_alignment(stores[0], store)
+
+    def get_name(self) -> str:
+        libname = self.context.library.get_name()
+        return f"{libname}.FusedTask(uid:{self._op_id})"
+
+    def _create_launcher(self) -> TaskLauncher:
+        return CoreTaskLauncher(
+            self.context,
+            self._task_id,
+            self.mapper_id,
+            provenance=self.provenance,
+        )
+
+    def find_all_reusable_store_pairs(self, strategy: Strategy) -> None:
+        # The fused tasks run in sequence, so an input of a later task can't
+        # lend its storage to an output of an earlier one
+        pass
+
+
+class TaskFuser:
+    """
+    Groups consecutive fusable tasks into fused tasks. A task joins the
+    current group if it belongs to the same library, all its stores have
+    the group's shape and access each storage through the same view as
+    the rest of the group, and it consumes a store produced in the group.
+    """
+
+    def __init__(self) -> None:
+        self._tasks: list[AutoTask] = []
+        self._views: dict[Storage, tuple[Storage, str]] = {}
+        self._produced: set[Storage] = set()
+
+    @staticmethod
+    def is_fusable(op: Operation) -> bool:
+        if not isinstance(op, AutoTask) or isinstance(op, FusedTask):
+            return False
+        if not op.fusable or op.side_effect or op.concurrent:
+            return False
+        runtime = op.context.runtime
+        if not runtime.task_has_fusable_variants(
+            op.context.get_task_id(op._task_id)
+        ):
+            return False
+        if (
+            op.can_raise_exception
+            or len(op.reductions) > 0
+            or len(op.unbound_outputs) > 0
+            or len(op.outputs) == 0
+            or len(op._comm_args) > 0
+        ):
+            return False
+        if any(not isinstance(c, Alignment) for c in op.constraints):
+            return False
+        shape = op.outputs[0].shape
+        return all(
+            store.kind is not Future and store.shape == shape
+            for store in op.inputs + op.outputs
+        )
+
+    def _can_join(self, task: AutoTask) -> bool:
+        first = self._tasks[0]
+        if (
+            task.context is not first.context
+            or task.mapper_id != first.mapper_id
+            or task.outputs[0].shape != first.outputs[0].shape
+        ):
+            return False
+        consumes = False
+        for store in task.inputs + task.outputs:
+            root = store._storage.get_root()
+            view = self._views.get(root)
+            if view is not None and view != self._get_view(store):
+                return False
+            consumes = consumes or root in self._produced
+        return consumes
+
+    @staticmethod
+    def _get_view(store: Store) -> tuple[Storage, str]:
+        return (store._storage, str(store.transform))
+
+    def try_append(self, op: Operation) -> bool:
+        if not self.is_fusable(op):
+            return False
+        assert isinstance(op, AutoTask)
+        if len(self._tasks) > 0 and not self._can_join(op):
+            return False
+        self._tasks.append(op)
+        for store in op.inputs + op.outputs:
+            self._views[store._storage.get_root()] = self._get_view(store)
+        for store in op.outputs:
+            self._produced.add(store._storage.get_root())
+        return True
+
+    def finish(self) -> list[Operation]:
+        tasks = self._tasks
+        self._tasks = []
+        self._views.clear()
+        self._produced.clear()
+        if len(tasks) < 2:
+            return list(tasks)
+        op_id = tasks[0].context.get_unique_op_id()
+        return [FusedTask(tasks, op_id)]
+
+
 class ManualTask(Operation, Task):
     def __init__(
         self,
@@ -785,6 +1077,8 @@ class ManualTask(Operation, Task):
 
         self._add_communicators(launcher, self._launch_domain)
 
+        launcher.set_reports_time(self.reports_time)
+
         result = launcher.execute(self._launch_domain)
 
         self._demux_scalar_stores(result, self._launch_domain)
@@ -804,6 +1098,9 @@ class Copy(AutoOperation):
         self._target_indirect_parts: list[PartSym] = []
         self._source_indirect_out_of_range = True
         self._target_indirect_out_of_range = True
+        # Set only on copies made by CopyBatcher, whose single indirection
+        # is shared by all their source-target pairs
+        self._shared_indirect = False
 
     def get_name(self) -> str:
         libname = self.context.library.get_name()
@@ -884,7 +1181,11 @@ class Copy(AutoOperation):
                     if len(self._outputs) > 0
                     else self._reduction_parts
                 )
-                for src, tgt in zip(self._source_indirect_parts, output_parts):
+                # A batched copy aligns its only indirection with all targets
+                indirect_parts = self._source_indirect_parts
+                if self._shared_indirect:
+                    indirect_parts = indirect_parts * len(output_parts)
+                for src, tgt in zip(indirect_parts, output_parts):
                     if src.store.shape != tgt.store.shape:
                         raise ValueError(
                             "Each output must have the same shape as the "
@@ -894,9 +1195,10 @@ class Copy(AutoOperation):
                         )
                     constraints.append(src == tgt)
             if len(self._target_indirects) > 0:
-                for src, tgt in zip(
-                    self._input_parts, self._target_indirect_parts
-                ):
+                indirect_parts = self._target_indirect_parts
+                if self._shared_indirect:
+                    indirect_parts = indirect_parts * len(self._input_parts)
+                for src, tgt in zip(self._input_parts, indirect_parts):
                     if src.store.shape != tgt.store.shape:
                         raise ValueError(
                             "Each input must have the same shape as the "
@@ -936,12 +1238,14 @@ class Copy(AutoOperation):
         assert len(self._inputs) == len(self._outputs) or len(
             self._inputs
         ) == len(self._reductions)
+        # Each source-target pair has its own indirection, except in batched
+        # copies, where all the pairs share one
         assert len(self._source_indirects) == 0 or len(
             self._source_indirects
-        ) == len(self._inputs)
+        ) == (1 if self._shared_indirect else len(self._inputs))
         assert len(self._target_indirects) == 0 or len(
             self._target_indirects
-        ) == len(self._outputs)
+        ) == (1 if self._shared_indirect else len(self._outputs))
 
         # FIXME: today a copy is a scatter copy only when a target indirection
         # is given. In the future, we may pass store transforms directly to
@@ -993,6 +1297,101 @@ class Copy(AutoOperation):
             launcher.execute_single()
 
 
+class CopyBatcher:
+    """
+    Groups consecutive indirect copies that share the same indirection
+    store into a single copy with one source-target pair per grouped copy,
+    which Legion performs as one launch. A copy joins the current group
+    only if it has no data dependence on the copies already in the group.
+    """
+
+    def __init__(self) -> None:
+        self._copies: list[Copy] = []
+        self._sources: list[Store] = []
+        self._targets: list[Store] = []
+
+    @staticmethod
+    def _get_indirect(op: Copy) -> Optional[tuple[bool, Store]]:
+        if (
+            len(op._inputs) != 1
+            or len(op._outputs) != 1
+            or len(op._reductions) > 0
+        ):
+            return None
+        if len(op._source_indirects) == 1 and len(op._target_indirects) == 0:
+            return (True, op._source_indirects[0])
+        elif len(op._target_indirects) == 1 and len(op._source_indirects) == 0:
+            return (False, op._target_indirects[0])
+        return None
+
+    @staticmethod
+    def _overlaps(store: Store, others: list[Store]) -> bool:
+        return any(store._storage.overlaps(other._storage) for other in others)
+
+    def _can_join(self, op: Copy, indirect: tuple[bool, Store]) -> bool:
+        first = self._copies[0]
+        first_indirect = self._get_indirect(first)
+        assert first_indirect is not None
+        if (
+            op.context is not first.context
+            or op.mapper_id != first.mapper_id
+            or indirect[0] != first_indirect[0]
+            or indirect[1] is not first_indirect[1]
+            or op._source_indirect_out_of_range
+            != first._source_indirect_out_of_range
+            or op._target_indirect_out_of_range
+            != first._target_indirect_out_of_range
+        ):
+            return False
+        source = op._inputs[0]
+        target = op._outputs[0]
+        return not (
+            self._overlaps(source, self._targets)
+            or self._overlaps(target, self._targets)
+            or self._overlaps(target, self._sources + [indirect[1]])
+        )
+
+    def try_append(self, op: Operation) -> bool:
+        if not isinstance(op, Copy):
+            return False
+        indirect = self._get_indirect(op)
+        if indirect is None:
+            return False
+        if len(self._copies) > 0 and not self._can_join(op, indirect):
+            return False
+        self._copies.append(op)
+        self._sources.append(op._inputs[0])
+        self._targets.append(op._outputs[0])
+        return True
+
+    def finish(self) -> list[Operation]:
+        copies = self._copies
+        self._copies = []
+        self._sources = []
+        self._targets = []
+        if len(copies) < 2:
+            return list(copies)
+        first = copies[0]
+        batched = Copy(
+            first.context, first.mapper_id, first.context.get_unique_op_id()
+        )
+        batched._shared_indirect = True
+        for copy in copies:
+            batched.add_input(copy._inputs[0])
+            batched.add_output(copy._outputs[0])
+        if len(first._source_indirects) > 0:
+            batched.add_source_indirect(first._source_indirects[0])
+        else:
+            batched.add_target_indirect(first._target_indirects[0])
+        batched.set_source_indirect_out_of_range(
+            first._source_indirect_out_of_range
+        )
+        batched.set_target_indirect_out_of_range(
+            first._target_indirect_out_of_range
+        )
+        return [batched]
+
+
 class Fill(AutoOperation):
     def __init__(
         self,
@@ -1050,6 +1449,11 @@ class Fill(AutoOperation):
 
     def launch(self, strategy: Strategy) -> None:
         lhs = self._outputs[0]
+        # A fill of a whole store that has no field yet is deferred until
+        # something needs the field, which often never happens before the
+        # store gets overwritten or freed
+        if not lhs.transformed and lhs._storage.defer_fill(self._inputs[0]):
+            return
         lhs_part_sym = self._output_parts[0]
         lhs_proj, _, lhs_part = self.get_requirement(
             lhs, lhs_part_sym, strategy
@@ -1083,7 +1487,7 @@ class Reduce(AutoOperation):
         self,
         context: Context,
         task_id: int,
-        radix: int,
+        radix: Optional[int],
         mapper_id: int,
         op_id: int,
     ) -> None:
@@ -1096,6 +1500,21 @@ class Reduce(AutoOperation):
         self._radix = radix
         self._task_id = task_id
 
+    def _choose_radix(self, fan_in: int) -> int:
+        if self._radix is not None:
+            return self._radix
+        # Points of each level are sharded in blocks, so as long as there
+        # are several points per node, each group of inputs lives in one
+        # node, and we reduce them with a wide fan-in. Once the levels
+        # cross node boundaries, a narrow fan-in keeps each task from
+        # waiting on many remote inputs.
+        runtime = self._runtime
+        num_nodes = runtime.num_nodes
+        per_node = (fan_in + num_nodes - 1) // num_nodes
+        if per_node > 1:
+            return max(min(per_node, runtime.tree_reduce_node_radix), 2)
+        return max(runtime.tree_reduce_cross_node_radix, 2)
+
     def launch(self, strategy: Strategy) -> None:
         assert len(self._inputs) == 1 and len(self._outputs) == 1
 
@@ -1112,14 +1531,13 @@ class Reduce(AutoOperation):
             launch_domain = strategy.launch_domain
             fan_in = launch_domain.get_volume()
 
-        proj_fns = list(
-            _RadixProj(self._radix, off) for off in range(self._radix)
-        )
-
         while not done:
             input = output
             ipart = opart
 
+            radix = self._choose_radix(fan_in)
+            proj_fns = list(_RadixProj(radix, off) for off in range(radix))
+
             tag = self.context.core_library.LEGATE_CORE_TREE_REDUCE_TAG
             launcher = TaskLauncher(
                 self.context,
@@ -1137,7 +1555,7 @@ class Reduce(AutoOperation):
             field_id = fspace.allocate_field(input.type)
             launcher.add_unbound_output(output, fspace, field_id)
 
-            num_tasks = (fan_in + self._radix - 1) // self._radix
+            num_tasks = (fan_in + radix - 1) // radix
             launch_domain = Rect([num_tasks])
             weights = launcher.execute(launch_domain)
 
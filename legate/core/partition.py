@@ -20,6 +20,7 @@ from typing import TYPE_CHECKING, Optional, Sequence, Type, Union
 
 from . import (
     IndexPartition,
+    PartitionByImageRange,
     PartitionByRestriction,
     PartitionByWeights,
     Rect,
@@ -33,6 +34,7 @@ from .shape import Shape
 
 if TYPE_CHECKING:
     from . import FutureMap, Partition as LegionPartition, Region
+    from .store import Store
 
 
 RequirementType = Union[Type[Broadcast], Type[Partition]]
@@ -430,3 +432,90 @@ class Weighted(PartitionBase):
                 index_space, self, index_partition
             )
         return region.get_child(index_partition)
+
+
+class Image(PartitionBase):
+    """
+    Partitions a 1-D store by the ranges stored in another store: each
+    color of the image holds the union of the ranges found in the same
+    color of the source store's partition. This is how the characters of a
+    string store follow the partition of its ranges. The partition depends
+    on the contents of the source store, so it is cached by the field
+    holding the ranges until that field is written.
+    """
+
+    def __init__(self, store: Store, part: PartitionBase) -> None:
+        self._store = store
+        self._part = part
+
+    @property
+    def color_shape(self) -> Optional[Shape]:
+        return self._part.color_shape
+
+    @property
+    def even(self) -> bool:
+        return False
+
+    @property
+    def requirement(self) -> RequirementType:
+        return Partition
+
+    def __str__(self) -> str:
+        return f"Image(store:{self._store}, part:{self._part})"
+
+    def __repr__(self) -> str:
+        return str(self)
+
+    def needs_delinearization(self, launch_ndim: int) -> bool:
+        assert self.color_shape is not None
+        return launch_ndim != self.color_shape.ndim
+
+    def satisfies_restriction(
+        self, restrictions: Sequence[Restriction]
+    ) -> bool:
+        return all(
+            restriction != Restriction.RESTRICTED
+            for restriction in restrictions
+        )
+
+    def is_complete_for(self, extents: Shape, offsets: Shape) -> bool:
+        # Nothing guarantees that the ranges cover the whole store
+        return False
+
+    def is_disjoint_for(self, launch_domain: Optional[Rect]) -> bool:
+        # Legion computes the disjointness when it creates the partition,
+        # but we can't find it out here without blocking
+        return False
+
+    def translate(self, offset: Shape) -> None:
+        raise NotImplementedError("This method shouldn't be invoked")
+
+    def translate_range(self, offset: Shape) -> None:
+        raise NotImplementedError("This method shouldn't be invoked")
+
+    def construct(
+        self, region: Region, complete: bool = False
+    ) -> Optional[LegionPartition]:
+        source_part = self._store.find_or_create_legion_partition(self._part)
+        if source_part is None:
+            return None
+        source = self._store.storage
+        images = source.field.images  # type: ignore[union-attr]
+        if (part := images.get((source_part, region))) is not None:
+            return part
+        functor = PartitionByImageRange(
+            source_part.parent,
+            source_part.index_partition,
+            source.field.field_id,  # type: ignore[union-attr]
+        )
+        index_partition = IndexPartition(
+            runtime.legion_context,
+            runtime.legion_runtime,
+            region.index_space,
+            source_part.color_space,
+            functor,
+            kind=legion.LEGION_COMPUTE_KIND,
+        )
+        part = region.get_child(index_partition)
+        images[(source_part, region)] = part
+        return part
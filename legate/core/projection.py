@@ -43,6 +43,18 @@ class ProjExpr:
     def is_identity(self, dim: int) -> bool:
         return self._dim == dim and self._weight == 1 and self._offset == 0
 
+    def canonicalize(self) -> ProjExpr:
+        """
+        Returns the canonical form of this expression. Expressions that
+        compute the same coordinate have the same canonical form, so their
+        projections can share a functor.
+        """
+        # A zero weight makes the input coordinate irrelevant, and without
+        # an input coordinate the weight is irrelevant
+        if (self._weight == 0) != (self._dim == -1):
+            return ProjExpr(dim=-1, weight=0, offset=self._offset)
+        return self
+
     def __repr__(self) -> str:
         if self._repr is None:
             s = ""
@@ -22,7 +22,17 @@ import weakref
 from collections import deque
 from dataclasses import dataclass
 from types import ModuleType
-from typing import TYPE_CHECKING, Any, Deque, List, Optional, TypeVar, Union
+from typing import (
+    TYPE_CHECKING,
+    Any,
+    Deque,
+    Hashable,
+    List,
+    Optional,
+    Tuple,
+    TypeVar,
+    Union,
+)
 
 from legion_top import add_cleanup_item, top_level
 
@@ -43,10 +53,11 @@ from . import (
     types as ty,
 )
 from ._legion.env import LEGATE_MAX_FIELDS
-from ._legion.util import Dispatchable
-from .allocation import Attachable
+from ._legion.util import Dispatchable, find_local_memory
+from .allocation import Attachable, DeviceAllocation
 from .communicator import CPUCommunicator, NCCLCommunicator
 from .corelib import core_library
+from .cost_model import DefaultCostModel, enumerate_launch_shapes
 from .cycle_detector import find_cycles
 from .exception import PendingException
 from .projection import is_identity_projection, pack_symbolic_projection_repr
@@ -54,6 +65,7 @@ from .restriction import Restriction
 from .shape import Shape
 
 if TYPE_CHECKING:
+    from ..timing import Timer
     from . import ArgumentMap, Detach, IndexDetach, IndexPartition, Library
     from ._legion import (
         FieldListLike,
@@ -63,10 +75,13 @@ if TYPE_CHECKING:
     from .communicator import Communicator
     from .context import Context
     from .corelib import CoreLib
+    from .load_balancer import LoadBalancer
+    from .cost_model import CostModel
     from .operation import Operation
     from .partition import PartitionBase
     from .projection import ProjExpr
-    from .store import RegionField, Store
+    from .solver import Strategy
+    from .store import RegionField, Storage, Store
 
 from math import prod
 
@@ -79,6 +94,25 @@ assert _sizeof_size_t == 4 or _sizeof_size_t == 8
 
 _LEGATE_FIELD_ID_BASE = 1000
 
+_LEGATE_AUTO_TRACE_ID_BASE = 1 << 20
+
+_MAX_SOLUTION_CACHE_SIZE = 4096
+
+_MAX_REFINED_LAUNCH_SPACE_CACHE_SIZE = 4096
+
+# Number of field allocations, across all field managers, over which the
+# allocation rate of each field manager is measured
+_FIELD_REUSE_WINDOW = 256
+# Field managers always keep at least this many free fields
+_MIN_FREE_FIELDS = 4
+# Largest factor by which a field manager can scale up its match credit
+_MAX_MATCH_CREDIT_SCALE = 16
+# Unless exception traces are precise, the runtime waits on pending
+# exceptions only once this many times the tunable limit is outstanding
+_MAX_PENDING_EXCEPTION_SCALE = 8
+# Number of staging stores the compressed shuffle keeps for reuse
+_MAX_SHUFFLE_STAGING_STORES = 4
+
 ARGS = [
     Argument(
         "consensus",
@@ -120,6 +154,209 @@ ARGS = [
             ),
         ),
     ),
+    Argument(
+        "auto-trace",
+        ArgSpec(
+            action="store_true",
+            default=False,
+            dest="auto_trace",
+            help=(
+                "Automatically recognize sequences of operations that repeat "
+                "back to back, such as the bodies of loops, and issue them in "
+                "Legion traces to memoize their dependence analysis. The "
+                "mapping is memoized as well only when the mapping cache is "
+                "enabled with LEGATE_MAPPING_CACHE=1."
+            ),
+        ),
+    ),
+    Argument(
+        "auto-trace-max-length",
+        ArgSpec(
+            type=int,
+            default=100,
+            dest="auto_trace_max_length",
+            help=(
+                "Maximum number of operations in a sequence recognized by "
+                "-legate:auto-trace."
+            ),
+        ),
+    ),
+    Argument(
+        "fusion",
+        ArgSpec(
+            action="store_true",
+            default=False,
+            dest="fusion",
+            help=(
+                "Fuse consecutive fusable tasks in the scheduling window that "
+                "operate element-wise on aligned stores into single launches. "
+                "Only takes effect with a scheduling window larger than one "
+                "operation (see LEGATE_WINDOW_SIZE)."
+            ),
+        ),
+    ),
+    Argument(
+        "tree-reduce-node-radix",
+        ArgSpec(
+            type=int,
+            default=16,
+            dest="tree_reduce_node_radix",
+            help=(
+                "Maximum radix of the levels of a tree reduction whose "
+                "inputs are produced within the same node"
+            ),
+        ),
+    ),
+    Argument(
+        "tree-reduce-cross-node-radix",
+        ArgSpec(
+            type=int,
+            default=2,
+            dest="tree_reduce_cross_node_radix",
+            help=(
+                "Radix of the levels of a tree reduction whose inputs are "
+                "produced on different nodes"
+            ),
+        ),
+    ),
+    Argument(
+        "batch-copies",
+        ArgSpec(
+            action="store_true",
+            default=False,
+            dest="batch_copies",
+            help=(
+                "Group consecutive independent gather or scatter copies in "
+                "the scheduling window that share the same indirection store "
+                "into single copy launches. Only takes effect with a "
+                "scheduling window larger than one operation."
+            ),
+        ),
+    ),
+    Argument(
+        "max-communicators",
+        ArgSpec(
+            type=int,
+            default=8,
+            dest="max_communicators",
+            help=(
+                "Maximum number of communicators of each kind (NCCL, CPU) to "
+                "keep alive. When a launch needs a communicator over a new "
+                "set of processors beyond this limit, the least recently "
+                "used one is destroyed."
+            ),
+        ),
+    ),
+    Argument(
+        "adaptive-field-reuse",
+        ArgSpec(
+            action="store_true",
+            default=False,
+            dest="adaptive_field_reuse",
+            help=(
+                "Size the list of free fields kept for each shape by the rate "
+                "at which the shape's fields are allocated, and, with control "
+                "replication, scale the consensus match credit of each shape "
+                "by how often its allocations miss freed fields."
+            ),
+        ),
+    ),
+    Argument(
+        "field-matches-in-flight",
+        ArgSpec(
+            type=int,
+            default=0,
+            dest="field_matches_in_flight",
+            help=(
+                "Number of the most recent consensus matches for freed fields "
+                "that field allocations leave in flight instead of waiting "
+                "for them. Only takes effect with control replication."
+            ),
+        ),
+    ),
+    Argument(
+        "lazy-fill",
+        ArgSpec(
+            action="store_true",
+            default=False,
+            dest="lazy_fill",
+            help=(
+                "Defer fills of whole stores that have no field yet until "
+                "something needs the field. Fills overwritten by other "
+                "fills or by attaches before that are never issued."
+            ),
+        ),
+    ),
+    Argument(
+        "adaptive-partitioning",
+        ArgSpec(
+            action="store_true",
+            default=False,
+            dest="adaptive_partitioning",
+            help=(
+                "Rebalance partitions of 1-D stores using the execution times "
+                "of the tasks that last ran on them. Launches over imbalanced "
+                "stores switch to weighted partitions that give slower points "
+                "fewer elements. Only takes effect on a single node, as the "
+                "shards of a multi-node run could see the timings arrive at "
+                "different points and pick different partitions."
+            ),
+        ),
+    ),
+    Argument(
+        "cost-model",
+        ArgSpec(
+            action="store_true",
+            default=False,
+            dest="cost_model",
+            help=(
+                "Pick the launch grids of multi-dimensional stores with a "
+                "cost model that weighs tile sizes, halo exchanges, and "
+                "repartitioning against the memory and bandwidths reported "
+                "by the mapper, instead of only the default heuristic."
+            ),
+        ),
+    ),
+    Argument(
+        "eager-threshold",
+        ArgSpec(
+            type=int,
+            default=0,
+            dest="eager_threshold",
+            help=(
+                "Launch tasks whose stores all have at most this many "
+                "elements right away on the CPUs of the calling node, "
+                "skipping the scheduling window and the partitioner "
+                "(0 disables eager launches)."
+            ),
+        ),
+    ),
+    Argument(
+        "native-launch",
+        ArgSpec(
+            action="store_true",
+            default=False,
+            dest="native_launch",
+            help=(
+                "Launch single tasks whose stores are untransformed region "
+                "fields through the C++ launcher in the core library, which "
+                "packs the task arguments without going through Python."
+            ),
+        ),
+    ),
+    Argument(
+        "adaptive-partitioning-threshold",
+        ArgSpec(
+            type=float,
+            default=0.1,
+            dest="adaptive_partitioning_threshold",
+            help=(
+                "Fraction by which the slowest point of a launch must exceed "
+                "the average time for -legate:adaptive-partitioning to "
+                "rebalance the stores of the launch."
+            ),
+        ),
+    ),
 ]
 
 
@@ -229,6 +466,7 @@ class FieldMatchManager:
         self._matches: Deque[FieldMatch] = deque()
         self._match_counter = 0
         self._match_frequency = runtime.max_field_reuse_frequency
+        self._max_in_flight = max(runtime.field_matches_in_flight, 0)
 
     def add_free_field(
         self, manager: FieldManager, region: Region, field_id: int
@@ -266,10 +504,21 @@ class FieldMatchManager:
         self._match_counter = 0
 
     def update_free_fields(self) -> None:
-        while len(self._matches) > 0:
+        # We leave the most recent matches in flight so that allocations
+        # don't wait for them. Their results are picked up by later
+        # allocations, by which time they have most likely arrived. All
+        # shards issue and consume the matches in the same order, so they
+        # all see the same free fields.
+        while len(self._matches) > self._max_in_flight:
             match = self._matches.popleft()
             match.update_free_fields()
 
+    def destroy(self) -> None:
+        # Matches left in flight still own the fields they carry, so they
+        # need to be consumed before the runtime goes away
+        while len(self._matches) > 0:
+            self._matches.popleft().update_free_fields()
+
 
 # This class keeps track of usage of a single region
 class RegionManager:
@@ -283,6 +532,9 @@ class RegionManager:
         # Fluctuates based on field usage
         self._active_field_count = 0
         self._next_field_id = _LEGATE_FIELD_ID_BASE
+        # Ids of the fields destroyed by field managers, which can be
+        # allocated again
+        self._released_field_ids: List[int] = []
         self._imported = imported
 
     @property
@@ -316,7 +568,10 @@ class RegionManager:
 
     @property
     def has_space(self) -> bool:
-        return self._alloc_field_count < LEGATE_MAX_FIELDS
+        return (
+            self._alloc_field_count < LEGATE_MAX_FIELDS
+            or len(self._released_field_ids) > 0
+        )
 
     def get_next_field_id(self) -> int:
         field_id = self._next_field_id
@@ -324,12 +579,23 @@ class RegionManager:
         return field_id
 
     def allocate_field(self, field_size: Any) -> tuple[Region, int, bool]:
+        if len(self._released_field_ids) > 0:
+            # The slot of a destroyed field is still counted as allocated
+            field_id = self._region.field_space.allocate_field(
+                field_size, self._released_field_ids.pop()
+            )
+            revived = self.increase_active_field_count()
+            return self._region, field_id, revived
         field_id = self._region.field_space.allocate_field(
             field_size, self.get_next_field_id()
         )
         revived = self.increase_field_count()
         return self._region, field_id, revived
 
+    def destroy_field(self, field_id: int, unordered: bool) -> None:
+        self._region.field_space.destroy_field(field_id, unordered=unordered)
+        self._released_field_ids.append(field_id)
+
 
 # This class manages the allocation and reuse of fields
 class FieldManager:
@@ -344,16 +610,51 @@ class FieldManager:
         # guaranteed to be ordered across all the shards even with
         # control replication
         self.free_fields: Deque[tuple[Region, int]] = deque()
+        # With adaptive field reuse, we keep as many free fields as the
+        # largest number of allocations in recent windows. Windows are
+        # counted in allocations issued by the program, so all shards
+        # measure the same rates.
+        self._adaptive = runtime.adaptive_field_reuse
+        self._window = 0
+        self._window_allocations = 0
+        self._peak_allocations = 0
 
     def destroy(self) -> None:
         self.free_fields = deque()
 
+    def _roll_window(self) -> None:
+        window = self.runtime.num_field_allocations // _FIELD_REUSE_WINDOW
+        if window == self._window:
+            return
+        # The peak decays by half for every window that has passed, so the
+        # free list shrinks once the shape falls out of use
+        elapsed = min(window - self._window, 63)
+        self._peak_allocations = max(
+            self._window_allocations, self._peak_allocations >> elapsed
+        )
+        self._window = window
+        self._window_allocations = 0
+
+    def _trim_free_fields(self, ordered: bool) -> None:
+        self._roll_window()
+        capacity = max(
+            _MIN_FREE_FIELDS, self._peak_allocations, self._window_allocations
+        )
+        while len(self.free_fields) > capacity:
+            region, field_id = self.free_fields.popleft()
+            self.runtime.find_region_manager(region).destroy_field(
+                field_id, unordered=not ordered
+            )
+
     def try_reuse_field(self) -> Optional[tuple[Region, int]]:
         return (
             self.free_fields.popleft() if len(self.free_fields) > 0 else None
         )
 
     def allocate_field(self) -> tuple[Region, int]:
+        if self._adaptive:
+            self._roll_window()
+            self._window_allocations += 1
         if (result := self.try_reuse_field()) is not None:
             region_manager = self.runtime.find_region_manager(result[0])
             if region_manager.increase_active_field_count():
@@ -376,6 +677,8 @@ class FieldManager:
             self.runtime.free_region_manager(
                 self.shape, region, unordered=not ordered
             )
+        if self._adaptive:
+            self._trim_free_fields(ordered)
 
     def remove_all_fields(self, region: Region) -> None:
         self.free_fields = deque(f for f in self.free_fields if f[0] != region)
@@ -387,8 +690,25 @@ class ConsensusMatchingFieldManager(FieldManager):
     ) -> None:
         super().__init__(runtime, shape, field_size)
         self._field_match_manager = runtime.field_match_manager
+        # With adaptive field reuse, the credit is scaled up while most
+        # allocations find no free field, so that freed fields are matched
+        # sooner, and scaled back down once allocations stop missing
+        self._credit_scale = 1
+        self._window_misses = 0
         self._update_match_credit()
 
+    def _roll_window(self) -> None:
+        window = self.runtime.num_field_allocations // _FIELD_REUSE_WINDOW
+        if window != self._window:
+            if 2 * self._window_misses > self._window_allocations:
+                self._credit_scale = min(
+                    2 * self._credit_scale, _MAX_MATCH_CREDIT_SCALE
+                )
+            elif self._window_misses == 0:
+                self._credit_scale = max(self._credit_scale // 2, 1)
+            self._window_misses = 0
+        super()._roll_window()
+
     def _update_match_credit(self) -> None:
         if self.shape.fixed:
             size = self.shape.volume() * self.field_size
@@ -409,7 +729,9 @@ class ConsensusMatchingFieldManager(FieldManager):
     def try_reuse_field(self) -> Optional[tuple[Region, int]]:
         if self._need_to_update_match_credit:
             self._update_match_credit()
-        self._field_match_manager.issue_field_match(self._match_credit)
+        self._field_match_manager.issue_field_match(
+            self._match_credit * self._credit_scale
+        )
 
         # First, if we have a free field then we know everyone has one of those
         if len(self.free_fields) > 0:
@@ -418,9 +740,10 @@ class ConsensusMatchingFieldManager(FieldManager):
         self._field_match_manager.update_free_fields()
 
         # Check again to see if we have any free fields
-        return (
-            self.free_fields.popleft() if len(self.free_fields) > 0 else None
-        )
+        if len(self.free_fields) > 0:
+            return self.free_fields.popleft()
+        self._window_misses += 1
+        return None
 
     def free_field(
         self, region: Region, field_id: int, ordered: bool = False
@@ -469,6 +792,9 @@ class AttachmentManager:
             tuple[Attachable, Union[Detach, IndexDetach]]
         ] = list()
         self._pending_detachments: dict[Future, Attachable] = dict()
+        # Keys of the host buffers we page-locked for zero-copy attachments.
+        # They are unpinned once their detachments are done.
+        self._pinned_buffers: set[tuple[int, int]] = set()
 
     def destroy(self) -> None:
         gc.collect()
@@ -488,7 +814,11 @@ class AttachmentManager:
         self._attachments = dict()
 
     @staticmethod
-    def attachment_key(buf: memoryview) -> tuple[int, int]:
+    def attachment_key(
+        buf: Union[memoryview, DeviceAllocation]
+    ) -> tuple[int, int]:
+        if isinstance(buf, DeviceAllocation):
+            return (buf.ptr, buf.nbytes)
         assert isinstance(buf, memoryview)
         ptr = ffi.cast("uintptr_t", ffi.from_buffer(buf))
         base_ptr = int(ptr)  # type: ignore[call-overload]
@@ -500,7 +830,7 @@ class AttachmentManager:
         return attachment is not None and attachment.region_field is not None
 
     def reuse_existing_attachment(
-        self, buf: memoryview
+        self, buf: Union[memoryview, DeviceAllocation]
     ) -> Optional[RegionField]:
         key = self.attachment_key(buf)
         attachment = self._attachments.get(key, None)
@@ -515,7 +845,10 @@ class AttachmentManager:
         return rf if attachment.shareable else None
 
     def _add_attachment(
-        self, buf: memoryview, shareable: bool, region_field: RegionField
+        self,
+        buf: Union[memoryview, DeviceAllocation],
+        shareable: bool,
+        region_field: RegionField,
     ) -> None:
         key = self.attachment_key(buf)
         attachment = self._attachments.get(key, None)
@@ -538,20 +871,67 @@ class AttachmentManager:
     def attach_external_allocation(
         self, alloc: Attachable, region_field: RegionField
     ) -> None:
-        if isinstance(alloc, memoryview):
+        if isinstance(alloc, (memoryview, DeviceAllocation)):
             self._add_attachment(alloc, True, region_field)
         else:
             for buf in alloc.shard_local_buffers.values():
                 self._add_attachment(buf, False, region_field)
 
-    def _remove_attachment(self, buf: memoryview) -> None:
+    def find_attach_memory(
+        self, alloc: Attachable, zero_copy: bool
+    ) -> Optional[Any]:
+        """
+        Finds the memory in which the allocation should be attached in
+        place. Returns None if the allocation should be attached as a system
+        memory instance.
+        """
+        if isinstance(alloc, DeviceAllocation):
+            memory = self._runtime.core_library.legate_find_device_memory(
+                ffi.cast("void*", alloc.ptr)
+            )
+            if memory.id == 0:
+                raise RuntimeError(
+                    "Cannot find the framebuffer memory holding the buffer"
+                )
+            return memory
+        if not zero_copy or not isinstance(alloc, memoryview):
+            return None
+        memory = find_local_memory(legion.Z_COPY_MEM)
+        if memory is None:
+            return None
+        # If the buffer can't be page-locked, we fall back to a system memory
+        # attachment, which GPU tasks can still read through a copy
+        key = self.attachment_key(alloc)
+        result = self._runtime.core_library.legate_pin_host_allocation(
+            ffi.cast("void*", key[0]), key[1]
+        )
+        if result < 0:
+            return None
+        if result > 0:
+            self._pinned_buffers.add(key)
+        return memory
+
+    def _unpin_allocation(self, alloc: Attachable) -> None:
+        if not isinstance(alloc, memoryview):
+            return
+        key = self.attachment_key(alloc)
+        if key not in self._pinned_buffers:
+            return
+        self._pinned_buffers.remove(key)
+        self._runtime.core_library.legate_unpin_host_allocation(
+            ffi.cast("void*", key[0])
+        )
+
+    def _remove_attachment(
+        self, buf: Union[memoryview, DeviceAllocation]
+    ) -> None:
         key = self.attachment_key(buf)
         if key not in self._attachments:
             raise RuntimeError("Unable to find attachment to remove")
         del self._attachments[key]
 
     def _remove_allocation(self, alloc: Attachable) -> None:
-        if isinstance(alloc, memoryview):
+        if isinstance(alloc, (memoryview, DeviceAllocation)):
             self._remove_attachment(alloc)
         else:
             for buf in alloc.shard_local_buffers.values():
@@ -563,7 +943,7 @@ class AttachmentManager:
         detach: Union[Detach, IndexDetach],
         defer: bool = False,
         previously_deferred: bool = False,
-    ) -> None:
+    ) -> Optional[Future]:
         # If the detachment was previously deferred, then we don't
         # need to remove the allocation from the map again.
         if not previously_deferred:
@@ -571,7 +951,7 @@ class AttachmentManager:
         if defer:
             # If we need to defer this until later do that now
             self._deferred_detachments.append((alloc, detach))
-            return
+            return None
         future = self._runtime.dispatch(detach)
         # Dangle a reference to the field off the future to prevent the
         # field from being recycled until the detach is done
@@ -579,8 +959,10 @@ class AttachmentManager:
         future.field_reference = field  # type: ignore[attr-defined]
         # If the future is already ready, then no need to track it
         if future.is_ready():
-            return
+            self._unpin_allocation(alloc)
+            return future
         self._pending_detachments[future] = alloc
+        return future
 
     def register_detachment(self, detach: Union[Detach, IndexDetach]) -> int:
         key = self._next_detachment_key
@@ -607,6 +989,7 @@ class AttachmentManager:
             if future.is_ready():
                 to_remove.append(future)
         for future in to_remove:
+            self._unpin_allocation(self._pending_detachments[future])
             del self._pending_detachments[future]
 
 
@@ -633,26 +1016,16 @@ class PartitionManager:
         ] = {}
         factors = list()
         pieces = self._num_pieces
-        while pieces % 2 == 0:
-            factors.append(2)
-            pieces = pieces // 2
-        while pieces % 3 == 0:
-            factors.append(3)
-            pieces = pieces // 3
-        while pieces % 5 == 0:
-            factors.append(5)
-            pieces = pieces // 5
-        while pieces % 7 == 0:
-            factors.append(7)
-            pieces = pieces // 7
-        while pieces % 11 == 0:
-            factors.append(11)
-            pieces = pieces // 11
+        factor = 2
+        while factor * factor <= pieces:
+            while pieces % factor == 0:
+                factors.append(factor)
+                pieces = pieces // factor
+            factor += 1
+        # Whatever is left is a prime larger than the square root of the
+        # number of pieces
         if pieces > 1:
-            raise ValueError(
-                "legate.numpy currently doesn't support processor "
-                + "counts with large prime factors greater than 11"
-            )
+            factors.append(pieces)
         self._piece_factors = list(reversed(factors))
         self._index_partitions: dict[
             tuple[IndexSpace, PartitionBase], IndexPartition
@@ -663,6 +1036,46 @@ class PartitionManager:
         ] = {}
         self._storage_key_partitions: dict[int, PartitionBase] = {}
         self._store_key_partitions: dict[int, PartitionBase] = {}
+        # Maps canonical descriptions of partitioning problems to their
+        # solutions, in the order they were recorded
+        self._solutions: dict[Hashable, Any] = {}
+        self._cost_model: Optional[CostModel] = None
+        if runtime._args.cost_model:
+            self._cost_model = DefaultCostModel(
+                runtime.core_context.get_tunable(
+                    runtime.core_library.LEGATE_CORE_TUNABLE_PIECE_MEMORY_SIZE,
+                    ty.uint64,
+                ),
+                runtime.core_context.get_tunable(
+                    runtime.core_library.LEGATE_CORE_TUNABLE_LOCAL_BANDWIDTH,
+                    ty.uint32,
+                ),
+                runtime.core_context.get_tunable(
+                    runtime.core_library.LEGATE_CORE_TUNABLE_REMOTE_BANDWIDTH,
+                    ty.uint32,
+                ),
+            )
+        # Maps partitioning problems to the launch shapes picked by the cost
+        # model
+        self._refined_launch_spaces: dict[
+            tuple[
+                tuple[int, ...],
+                tuple[int, ...],
+                int,
+                Optional[tuple[int, ...]],
+            ],
+            tuple[int, ...],
+        ] = {}
+
+    def set_cost_model(self, cost_model: Optional[CostModel]) -> None:
+        """
+        Replaces the cost model used to pick launch shapes. Passing ``None``
+        makes the partition manager use its heuristic choices as they are.
+        """
+        self._cost_model = cost_model
+        # Cached solutions carry the launch shapes the old model picked
+        self._refined_launch_spaces.clear()
+        self._solutions.clear()
 
     def compute_launch_shape(
         self, store: Store, restrictions: tuple[Restriction, ...]
@@ -683,6 +1096,11 @@ class PartitionManager:
         if launch_shape is None:
             return None
 
+        if self._cost_model is not None and len(launch_shape) > 1:
+            launch_shape = self._refine_launch_shape(
+                store, restrictions, to_partition, launch_shape
+            )
+
         idx = 0
         result: tuple[int, ...] = ()
         for restriction in restrictions:
@@ -694,6 +1112,63 @@ class PartitionManager:
 
         return Shape(result)
 
+    def _refine_launch_shape(
+        self,
+        store: Store,
+        restrictions: tuple[Restriction, ...],
+        to_partition: tuple[int, ...],
+        launch_shape: tuple[int, ...],
+    ) -> tuple[int, ...]:
+        from .partition import Tiling
+
+        assert self._cost_model is not None
+        # The store may still have a key partition that doesn't satisfy the
+        # restrictions, in which case we want to stay close to it
+        existing: Optional[tuple[int, ...]] = None
+        partition = self._store_key_partitions.get(store._unique_id)
+        if (
+            isinstance(partition, Tiling)
+            and partition.color_shape is not None
+            and partition.color_shape.ndim == len(restrictions)
+        ):
+            existing = tuple(
+                partition.color_shape[dim]
+                for dim, restriction in enumerate(restrictions)
+                if restriction != Restriction.RESTRICTED
+            )
+
+        itemsize = store.type.size
+        key = (to_partition, launch_shape, itemsize, existing)
+        if key in self._refined_launch_spaces:
+            return self._refined_launch_spaces[key]
+
+        # Only consider grids with as many points as the heuristic picked,
+        # as it has already accounted for the minimum chunk sizes. Ties are
+        # broken in favor of the heuristic's choice.
+        best = launch_shape
+        best_cost = self._cost_model.estimate(
+            to_partition, launch_shape, itemsize, existing
+        )
+        for candidate in enumerate_launch_shapes(
+            to_partition, prod(launch_shape)
+        ):
+            cost = self._cost_model.estimate(
+                to_partition, candidate, itemsize, existing
+            )
+            if cost < best_cost:
+                best = candidate
+                best_cost = cost
+
+        if (
+            len(self._refined_launch_spaces)
+            >= _MAX_REFINED_LAUNCH_SPACE_CACHE_SIZE
+        ):
+            del self._refined_launch_spaces[
+                next(iter(self._refined_launch_spaces))
+            ]
+        self._refined_launch_spaces[key] = best
+        return best
+
     def _compute_launch_shape(
         self, shape: tuple[int, ...]
     ) -> Optional[tuple[int, ...]]:
@@ -913,6 +1388,14 @@ class PartitionManager:
         if storage_id in self._storage_key_partitions:
             del self._storage_key_partitions[storage_id]
 
+    def find_solution(self, key: Hashable) -> Any:
+        return self._solutions.get(key)
+
+    def record_solution(self, key: Hashable, solution: Any) -> None:
+        if len(self._solutions) >= _MAX_SOLUTION_CACHE_SIZE:
+            del self._solutions[next(iter(self._solutions))]
+        self._solutions[key] = solution
+
     def find_legion_partition(
         self, storage_id: int, functor: PartitionBase
     ) -> tuple[Optional[LegionPartition], bool]:
@@ -932,10 +1415,10 @@ class PartitionManager:
 
 
 class CommunicatorManager:
-    def __init__(self, runtime: Runtime) -> None:
+    def __init__(self, runtime: Runtime, capacity: int) -> None:
         self._runtime = runtime
-        self._nccl = NCCLCommunicator(runtime)
-        self._cpu = CPUCommunicator(runtime)
+        self._nccl = NCCLCommunicator(runtime, capacity)
+        self._cpu = CPUCommunicator(runtime, capacity)
 
     def destroy(self) -> None:
         self._nccl.destroy()
@@ -947,6 +1430,205 @@ class CommunicatorManager:
     def get_cpu_communicator(self) -> Communicator:
         return self._cpu
 
+    def describe(self) -> dict[str, dict[str, Any]]:
+        return {"nccl": self._nccl.describe(), "cpu": self._cpu.describe()}
+
+
+# The description of an operation that the auto tracer compares to find
+# repetitions. Signatures are compared as a whole rather than by their hashes,
+# so hash collisions can't put different operations in the same trace.
+OpSignature = Tuple[Any, ...]
+
+
+# A helper class that recognizes sequences of operations repeating back to
+# back (typically the body of a Python loop) and issues each recognized
+# repetition in a Legion trace, so the runtime can replay the dependence
+# analysis of the sequence, and its mapping when the mapping cache is on,
+# instead of recomputing them
+class AutoTracer:
+    def __init__(self, runtime: Runtime, max_length: int) -> None:
+        self._runtime = runtime
+        self._max_length = max_length
+        self._num_ops = 0
+        # Storages are named by their fields when they already have them
+        # on their first appearance, and by their age otherwise, so that
+        # the temporaries each repetition creates get the same names
+        self._storage_names: weakref.WeakKeyDictionary[
+            Storage, Union[int, tuple[int, int]]
+        ] = weakref.WeakKeyDictionary()
+        self._history: List[OpSignature] = []
+        self._trace_ids: dict[tuple[OpSignature, ...], int] = {}
+        self._candidate: Optional[tuple[OpSignature, ...]] = None
+        self._pending: List[tuple[Operation, Strategy, OpSignature]] = []
+        self._in_trace = False
+        self._num_traces = 0
+        # Traces replay the mapping of their operations only when the
+        # mappers agree to memoize it, so they are logical-only otherwise
+        self._logical_only = (
+            runtime.core_library.legate_mapping_cache_enabled() == 0
+        )
+
+    @property
+    def in_trace(self) -> bool:
+        return self._in_trace
+
+    @property
+    def num_traces(self) -> int:
+        """
+        Number of repetitions issued in Legion traces so far
+        """
+        return self._num_traces
+
+    def _get_storage_name(self, storage: Storage) -> Any:
+        root = storage.get_root()
+        name = self._storage_names.get(root)
+        age_limit = 2 * self._max_length
+        if isinstance(name, int) and self._num_ops - name > age_limit:
+            # Any operation this old has been launched, so the storage is
+            # backed by a field by now unless it's a future
+            name = None
+        if name is None:
+            field_key = root.get_field_key()
+            name = self._num_ops if field_key is None else field_key
+            self._storage_names[root] = name
+        if isinstance(name, int):
+            name = self._num_ops - name
+        if root is storage:
+            return name
+        return (name, storage.offsets, storage.extents)
+
+    def _get_signature(
+        self, op: Operation, strategy: Strategy
+    ) -> Optional[OpSignature]:
+        from .operation import AutoOperation
+        from .partition import Replicate, Tiling
+
+        # Output regions and dependent partitioning can't be traced
+        if not isinstance(op, AutoOperation) or len(op.unbound_outputs) > 0:
+            return None
+
+        stores: List[tuple[Any, ...]] = []
+        for privilege, store, redop in (
+            [(0, store, -1) for store in op.inputs]
+            + [(1, store, -1) for store in op.outputs]
+            + [(2, store, redop) for (store, redop) in op.reductions]
+        ):
+            if store.unbound:
+                return None
+            name = self._get_storage_name(store._storage)
+            stores.append(
+                (privilege, redop, name, store.shape, str(store.transform))
+            )
+
+        partitions: List[PartitionBase] = []
+        for part in op.all_unknowns:
+            partition = strategy.get_partition(part)
+            if not isinstance(partition, (Replicate, Tiling)):
+                return None
+            partitions.append(partition)
+
+        return (
+            type(op).__name__,
+            op.mapper_id,
+            getattr(op, "_task_id", -1),
+            str(strategy.launch_domain) if strategy.parallel else None,
+            tuple(stores),
+            tuple(partitions),
+        )
+
+    def _detect_repetition(self) -> None:
+        # A candidate found before the last operation is stale unless the
+        # history still ends with a repetition of it
+        self._candidate = None
+        history = self._history
+        num_entries = len(history)
+        last = history[-1]
+        # Look for the longest sequence that just repeated itself, so loop
+        # bodies that contain repeated operations aren't mistaken for
+        # shorter sequences
+        for length in range(min(num_entries // 2, self._max_length), 0, -1):
+            if history[-1 - length] != last:
+                continue
+            start = num_entries - length
+            if history[start:] == history[start - length : start]:
+                self._candidate = tuple(history[start:])
+                return
+
+    def _launch_untraced(
+        self,
+        op: Operation,
+        strategy: Strategy,
+        signature: Optional[OpSignature],
+    ) -> None:
+        op.launch(strategy)
+        if signature is None:
+            self._history.clear()
+            self._candidate = None
+            return
+        self._history.append(signature)
+        if len(self._history) > 2 * self._max_length:
+            del self._history[0]
+        self._detect_repetition()
+
+    def _launch_traced(self) -> None:
+        assert self._candidate is not None
+        pending = self._pending
+        self._pending = []
+
+        trace_id = self._trace_ids.get(self._candidate)
+        if trace_id is None:
+            trace_id = _LEGATE_AUTO_TRACE_ID_BASE + len(self._trace_ids)
+            self._trace_ids[self._candidate] = trace_id
+
+        # Detachments are not allowed in traces, so we issue the ones
+        # pending before we start the trace
+        runtime = self._runtime
+        runtime.attachment_manager.perform_detachments()
+        runtime.attachment_manager.prune_detachments()
+
+        legion.legion_runtime_begin_trace(
+            runtime.legion_runtime,
+            runtime.legion_context,
+            trace_id,
+            self._logical_only,
+        )
+        self._in_trace = True
+        for op, strategy, _ in pending:
+            op.launch(strategy)
+        self._in_trace = False
+        legion.legion_runtime_end_trace(
+            runtime.legion_runtime, runtime.legion_context, trace_id
+        )
+        self._num_traces += 1
+
+    def launch(self, op: Operation, strategy: Strategy) -> None:
+        signature = self._get_signature(op, strategy)
+        self._num_ops += 1
+
+        # Operations matching the candidate sequence are held back until
+        # the whole sequence shows up, as we can't end a trace early
+        candidate = self._candidate
+        if candidate is not None:
+            if signature == candidate[len(self._pending)]:
+                self._pending.append((op, strategy, signature))
+                if len(self._pending) == len(candidate):
+                    self._launch_traced()
+                return
+            self._candidate = None
+            self.flush()
+
+        self._launch_untraced(op, strategy, signature)
+
+    def flush(self) -> None:
+        # Operations launched in a trace can flush the scheduling window
+        # when they access their stores, but nothing is held back by then
+        if self._in_trace or len(self._pending) == 0:
+            return
+        pending = self._pending
+        self._pending = []
+        for op, strategy, signature in pending:
+            self._launch_untraced(op, strategy, signature)
+
 
 class Runtime:
     _legion_runtime: Union[legion.legion_runtime_t, None]
@@ -1045,6 +1727,22 @@ class Runtime:
                 ty.uint64,
             )
         )
+        self.adaptive_field_reuse: bool = self._args.adaptive_field_reuse
+        self.lazy_fill: bool = self._args.lazy_fill
+        self.native_launch: bool = self._args.native_launch
+        self.eager_threshold: int = self._args.eager_threshold
+        self._has_cpu_variant: dict[int, bool] = {}
+        self._has_fusable_variants: dict[int, bool] = {}
+        self.tree_reduce_node_radix: int = self._args.tree_reduce_node_radix
+        self.tree_reduce_cross_node_radix: int = (
+            self._args.tree_reduce_cross_node_radix
+        )
+        self.field_matches_in_flight: int = (
+            self._args.field_matches_in_flight
+        )
+        # Number of fields allocated so far, which field managers use as
+        # their clock to measure allocation rates
+        self.num_field_allocations = 0
         self._field_manager_class = (
             ConsensusMatchingFieldManager
             if self._num_nodes > 1 or self._args.consensus
@@ -1060,8 +1758,31 @@ class Runtime:
         # Now we initialize managers
         self._attachment_manager = AttachmentManager(self)
         self._partition_manager = PartitionManager(self)
-        self._comm_manager = CommunicatorManager(self)
+        self._comm_manager = CommunicatorManager(
+            self, self._args.max_communicators
+        )
         self._field_match_manager = FieldMatchManager(self)
+        self._auto_tracer = (
+            AutoTracer(self, self._args.auto_trace_max_length)
+            if self._args.auto_trace
+            else None
+        )
+        self._load_balancer: Optional[LoadBalancer] = None
+        # Whether the timings have arrived depends on when each shard looks,
+        # so with control replication the shards would disagree on the
+        # partitions
+        if self._args.adaptive_partitioning and self._num_nodes == 1:
+            from .load_balancer import LoadBalancer
+
+            self._load_balancer = LoadBalancer(
+                self, self._args.adaptive_partitioning_threshold
+            )
+        # Timers that collect the execution times of the tasks issued while
+        # they are active, innermost last
+        self._task_timers: list[Timer] = []
+        # Staging stores of the compressed shuffle, keyed by shape and type,
+        # so that shuffles of the same store don't allocate a new one
+        self._shuffle_staging: dict[tuple[Shape, Any], Store] = {}
         # map shapes to index spaces
         self.index_spaces: dict[Rect, IndexSpace] = {}
         # map from shapes to active region managers
@@ -1142,6 +1863,10 @@ class Runtime:
     def num_gpus(self) -> int:
         return self._num_gpus
 
+    @property
+    def num_nodes(self) -> int:
+        return self._num_nodes
+
     @property
     def core_task_variant_id(self) -> int:
         if self.num_gpus > 0:
@@ -1159,6 +1884,25 @@ class Runtime:
     def partition_manager(self) -> PartitionManager:
         return self._partition_manager
 
+    @property
+    def load_balancer(self) -> Optional[LoadBalancer]:
+        return self._load_balancer
+
+    @property
+    def task_timer(self) -> Optional[Timer]:
+        return self._task_timers[-1] if len(self._task_timers) > 0 else None
+
+    def push_task_timer(self, timer: Timer) -> None:
+        # The operations still in the window were issued before the timer
+        self.flush_scheduling_window()
+        self._task_timers.append(timer)
+
+    def pop_task_timer(self) -> None:
+        # The operations still in the window were issued while the timer was
+        # active, so they must get launched before it goes away
+        self.flush_scheduling_window()
+        self._task_timers.pop()
+
     @property
     def field_match_manager(self) -> FieldMatchManager:
         return self._field_match_manager
@@ -1202,6 +1946,8 @@ class Runtime:
         # Then we also need to raise all exceptions if there were any
         self.raise_exceptions()
 
+        self._field_match_manager.destroy()
+
         self._comm_manager.destroy()
         for barrier in self._barriers:
             legion.legion_phase_barrier_destroy(
@@ -1247,18 +1993,59 @@ class Runtime:
         return self._next_storage_id
 
     def dispatch(self, op: Dispatchable[T]) -> T:
-        self._attachment_manager.perform_detachments()
-        self._attachment_manager.prune_detachments()
+        # Detachments can't be issued in traces, so the auto tracer performs
+        # them before it starts a trace
+        if self._auto_tracer is None or not self._auto_tracer.in_trace:
+            self._attachment_manager.perform_detachments()
+            self._attachment_manager.prune_detachments()
         return op.launch(self.legion_runtime, self.legion_context)
 
     def dispatch_single(self, op: Dispatchable[T]) -> T:
-        self._attachment_manager.perform_detachments()
-        self._attachment_manager.prune_detachments()
+        if self._auto_tracer is None or not self._auto_tracer.in_trace:
+            self._attachment_manager.perform_detachments()
+            self._attachment_manager.prune_detachments()
         return op.launch(self.legion_runtime, self.legion_context)
 
+    def _fuse(self, ops: List[Operation]) -> List[Operation]:
+        from .operation import TaskFuser
+
+        fuser = TaskFuser()
+        result: List[Operation] = []
+        for op in ops:
+            if fuser.try_append(op):
+                continue
+            result.extend(fuser.finish())
+            if not fuser.try_append(op):
+                result.append(op)
+        result.extend(fuser.finish())
+        return result
+
+    def _batch_copies(self, ops: List[Operation]) -> List[Operation]:
+        from .operation import CopyBatcher
+
+        batcher = CopyBatcher()
+        result: List[Operation] = []
+        for op in ops:
+            if batcher.try_append(op):
+                continue
+            result.extend(batcher.finish())
+            if not batcher.try_append(op):
+                result.append(op)
+        result.extend(batcher.finish())
+        return result
+
     def _schedule(self, ops: List[Operation]) -> None:
         from .solver import Partitioner
 
+        if self._args.fusion:
+            ops = self._fuse(ops)
+
+        if self._args.batch_copies:
+            ops = self._batch_copies(ops)
+
+        if self._load_balancer is not None:
+            self._load_balancer.rebalance(ops)
+
         # TODO: For now we run the partitioner for each operation separately.
         #       We will eventually want to compute a trace-wide partitioning
         #       strategy.
@@ -1268,24 +2055,91 @@ class Runtime:
             partitioner = Partitioner([op], must_be_single=must_be_single)
             strategies.append(partitioner.partition_stores())
 
-        for op, strategy in zip(ops, strategies):
-            op.launch(strategy)
+        if self._auto_tracer is not None:
+            for op, strategy in zip(ops, strategies):
+                self._auto_tracer.launch(op, strategy)
+        else:
+            for op, strategy in zip(ops, strategies):
+                op.launch(strategy)
 
-    def flush_scheduling_window(self) -> None:
+    def _flush_outstanding_ops(self) -> None:
         if len(self._outstanding_ops) == 0:
             return
         ops = self._outstanding_ops
         self._outstanding_ops = []
         self._schedule(ops)
 
+    def flush_scheduling_window(self) -> None:
+        self._flush_outstanding_ops()
+        # Someone needs the results of all operations issued so far, so the
+        # auto tracer can't hold any of them back any longer
+        if self._auto_tracer is not None:
+            self._auto_tracer.flush()
+
+    def can_launch_eagerly(self, op: Operation) -> bool:
+        """
+        Returns True if the operation is small enough to be launched right
+        away on the CPUs of the calling node when it is submitted
+        """
+        from .operation import AutoTask, FusedTask
+
+        # Eager launches would keep breaking the traces the auto tracer
+        # records, so the two don't mix
+        if self.eager_threshold <= 0 or self._auto_tracer is not None:
+            return False
+        if not isinstance(op, AutoTask) or isinstance(op, FusedTask):
+            return False
+        if len(op.unbound_outputs) > 0 or op.concurrent:
+            return False
+        if len(op._comm_args) > 0:
+            return False
+        if not all(
+            store.size <= self.eager_threshold
+            for store in op.get_all_stores()
+        ):
+            return False
+        return self._task_has_cpu_variant(op.context.get_task_id(op._task_id))
+
+    def _task_has_cpu_variant(self, task_id: int) -> bool:
+        # Eager launches are mapped to CPUs, so tasks without a CPU variant
+        # must take the usual path
+        if task_id not in self._has_cpu_variant:
+            self._has_cpu_variant[task_id] = bool(
+                self.core_library.legate_has_cpu_variant(task_id)
+            )
+        return self._has_cpu_variant[task_id]
+
+    def task_has_fusable_variants(self, task_id: int) -> bool:
+        # The mapper can send a fused task to any kind of processor, so a
+        # task is fused only if every kind can run it
+        if task_id not in self._has_fusable_variants:
+            self._has_fusable_variants[task_id] = bool(
+                self.core_library.legate_has_fusable_variants(task_id)
+            )
+        return self._has_fusable_variants[task_id]
+
     def submit(self, op: Operation) -> None:
+        from .operation import Task
+
         if op.can_raise_exception and self._precise_exception_trace:
             op.capture_traceback()
-        self._outstanding_ops.append(op)
-        if len(self._outstanding_ops) >= self._window_size:
-            self.flush_scheduling_window()
+        if len(self._task_timers) > 0 and isinstance(op, Task):
+            op.set_timer(self._task_timers[-1])
+        if self.can_launch_eagerly(op):
+            # Operations issued before this one still need to go first
+            self._flush_outstanding_ops()
+            op.launch_eagerly()  # type: ignore[attr-defined]
+        else:
+            self._outstanding_ops.append(op)
+            if len(self._outstanding_ops) >= self._window_size:
+                self._flush_outstanding_ops()
         if len(self._pending_exceptions) >= self._max_pending_exceptions:
-            self.raise_exceptions()
+            # Whether a future is ready can differ between the shards of a
+            # control replicated run, so only a single shard can poll
+            if self._precise_exception_trace or self._num_nodes > 1:
+                self.raise_exceptions()
+            else:
+                self.poll_exceptions()
 
     def _progress_unordered_operations(self) -> None:
         legion.legion_context_progress_unordered_operations(
@@ -1342,13 +2196,22 @@ class Runtime:
         if spec in self._registered_projections:
             return self._registered_projections[spec]
 
-        if is_identity_projection(src_ndim, dims):
-            self._registered_projections[spec] = 0
-            return 0
+        # Projections that compute the same points share one functor, so we
+        # look up the canonical form before registering a new one
+        canonical_dims = tuple(dim.canonicalize() for dim in dims)
+        canonical_spec = (src_ndim, canonical_dims)
+        if canonical_spec in self._registered_projections:
+            proj_id = self._registered_projections[canonical_spec]
+        elif is_identity_projection(src_ndim, canonical_dims):
+            proj_id = 0
+            self._registered_projections[canonical_spec] = proj_id
         else:
-            return self._register_projection_functor(
-                spec, *pack_symbolic_projection_repr(src_ndim, dims)
+            proj_id = self._register_projection_functor(
+                canonical_spec,
+                *pack_symbolic_projection_repr(src_ndim, canonical_dims),
             )
+        self._registered_projections[spec] = proj_id
+        return proj_id
 
     def get_transform_code(self, name: str) -> int:
         return getattr(
@@ -1479,6 +2342,7 @@ class Runtime:
         region = None
         field_id = None
         field_mgr = self.find_or_create_field_manager(shape, dtype.size)
+        self.num_field_allocations += 1
         region, field_id = field_mgr.allocate_field()
         return RegionField.create(region, field_id, dtype.size, shape)
 
@@ -1637,6 +2501,151 @@ class Runtime:
     def get_cpu_communicator(self) -> Communicator:
         return self._comm_manager.get_cpu_communicator()
 
+    def describe_communicators(self) -> dict[str, dict[str, Any]]:
+        """
+        Returns the state of the communicator caches, keyed by backend
+        """
+        return self._comm_manager.describe()
+
+    def compressed_shuffle(
+        self,
+        store: Store,
+        partition: PartitionBase,
+        context: Context,
+        mapper_id: int = 0,
+    ) -> None:
+        """
+        Moves a store from its key partition to another tiling with the same
+        color shape. Each task of the shuffle compresses the parts of its old
+        tile that other tasks need, exchanges them over a communicator, and
+        decompresses the parts of its new tile into a staging store, which
+        then gets copied into the store within each node. The store must
+        pass ``Store.can_compress_transfer`` for the partition.
+
+        The shuffle is mapped by the mapper of the library that needs the
+        store in the new partition, so that its pieces land where the
+        library's tasks run. When there are GPUs, the shuffle exchanges the
+        data with NCCL and is forced onto them. The staging stores are kept
+        for the next shuffles of stores with the same shape and type.
+
+        Parameters
+        ----------
+        store : Store
+            Store to move
+        partition : PartitionBase
+            Partition the store is needed in
+        context : Context
+            Context of the library that needs the store
+        mapper_id : int
+            Id of the mapper within the library
+        """
+        from .launcher import CopyLauncher, CoreTaskLauncher
+
+        assert store.can_compress_transfer(partition)
+        key_partition = self.partition_manager.find_store_key_partition(
+            store._unique_id, ()
+        )
+        assert key_partition is not None
+        assert partition.color_shape is not None
+
+        launch_ndim = store.ndim
+        launch_domain = Rect(hi=partition.color_shape)
+        staging = self._get_shuffle_staging(store)
+        staging_req = staging.partition(partition).get_requirement(launch_ndim)
+
+        # The communicator decides the variant the shuffle must run with
+        if self.num_gpus > 0:
+            comm = self.get_nccl_communicator()
+            tag = self.core_library.LEGATE_CORE_GPU_TASK_TAG
+        else:
+            comm = self.get_cpu_communicator()
+            tag = 0
+
+        task = CoreTaskLauncher(
+            context,
+            self.core_library.LEGATE_CORE_COMPRESSED_SHUFFLE_TASK_ID,
+            mapper_id,
+            tag=tag,
+            provenance=context.provenance,
+        )
+        task.add_input(
+            store, store.partition(key_partition).get_requirement(launch_ndim)
+        )
+        task.add_output(staging, staging_req)
+        task.add_scalar_arg(store.type.size, ty.int32)
+        task.add_communicator(comm.get_handle(launch_domain))
+        if comm.needs_barrier:
+            task.insert_barrier()
+        task.set_concurrent(True)
+        task.execute(launch_domain)
+
+        copy = CopyLauncher(
+            context, mapper_id=mapper_id, provenance=context.provenance
+        )
+        copy.add_input(staging, staging_req)
+        copy.add_output(
+            store, store.partition(partition).get_requirement(launch_ndim)
+        )
+        copy.execute(launch_domain)
+
+        store.set_key_partition(partition)
+
+    def _get_shuffle_staging(self, store: Store) -> Store:
+        key = (store.shape, store.type)
+        staging = self._shuffle_staging.get(key)
+        if staging is None:
+            if len(self._shuffle_staging) >= _MAX_SHUFFLE_STAGING_STORES:
+                del self._shuffle_staging[next(iter(self._shuffle_staging))]
+            staging = self.create_store(store.type, shape=store.shape)
+            self._shuffle_staging[key] = staging
+        return staging
+
+    def task_stats(self) -> str:
+        """
+        Returns the per-task execution statistics collected in this process
+        as CSV text. Statistics are only collected when the LEGATE_TASK_STATS
+        environment variable is set.
+        """
+        size = self.core_library.legate_task_stats_summary(ffi.NULL, 0)
+        buffer = ffi.new("char[]", size)
+        self.core_library.legate_task_stats_summary(buffer, size)
+        return ffi.string(buffer).decode()
+
+    def memory_usage(self) -> list[dict[str, Union[int, str]]]:
+        """
+        Returns the current and peak number of bytes in use in each memory
+        of this process. The query is cheap enough to be sampled
+        periodically while a program runs.
+
+        Each entry has the memory's id (``memory``), kind (``kind``) and
+        capacity in bytes (``capacity``), and a ``category``, which is one of
+        ``total``, ``instances`` (instances cached for stores), ``temporaries``
+        (buffers created by tasks), ``library`` (instances created by the
+        mapper of the library in ``name``), and ``field`` (instances of the
+        field ``name``, given as ``"<tree id>:<field id>"``).
+
+        The accounting is enabled by setting ``LEGATE_MEMORY_USAGE`` to a
+        positive value; otherwise the list is empty.
+        """
+        size = self.core_library.legate_memory_usage_summary(ffi.NULL, 0)
+        buffer = ffi.new("char[]", size)
+        self.core_library.legate_memory_usage_summary(buffer, size)
+        lines = ffi.string(buffer).decode().splitlines()
+        if len(lines) == 0:
+            return []
+        header = lines[0].split(",")
+        result: list[dict[str, Union[int, str]]] = []
+        for line in lines[1:]:
+            entry: dict[str, Union[int, str]] = {}
+            for column, value in zip(header, line.split(",")):
+                numeric = column in ("memory", "capacity")
+                if numeric or column.endswith("bytes"):
+                    entry[column] = int(value, 0)
+                else:
+                    entry[column] = value
+            result.append(entry)
+        return result
+
     def delinearize_future_map(
         self, future_map: FutureMap, new_domain: Rect
     ) -> FutureMap:
@@ -1679,6 +2688,26 @@ class Runtime:
         exn = PendingException(exn_types, future, tb_repr)
         self._pending_exceptions.append(exn)
 
+    def poll_exceptions(self) -> None:
+        # Raises the exceptions of the operations that have already finished,
+        # in program order, without waiting on those still in flight. We
+        # block on the rest only when too many of them have piled up. This
+        # must only be used when the program runs in a single shard, as the
+        # shards would otherwise raise at different points.
+        assert self._num_nodes == 1
+        pending_exceptions = self._pending_exceptions
+        num_ready = 0
+        for pending in pending_exceptions:
+            if not pending.is_ready():
+                break
+            num_ready += 1
+        limit = self._max_pending_exceptions * _MAX_PENDING_EXCEPTION_SCALE
+        if len(pending_exceptions) - num_ready >= limit:
+            num_ready = len(pending_exceptions)
+        self._pending_exceptions = pending_exceptions[num_ready:]
+        for pending in pending_exceptions[:num_ready]:
+            pending.raise_exception()
+
     def raise_exceptions(self) -> None:
         pending_exceptions = self._pending_exceptions
         self._pending_exceptions = []
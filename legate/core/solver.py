@@ -14,17 +14,35 @@
 #
 from __future__ import annotations
 
-from typing import TYPE_CHECKING, Generic, List, Optional, Tuple, TypeVar
+from typing import (
+    TYPE_CHECKING,
+    Generic,
+    Hashable,
+    Iterable,
+    List,
+    Optional,
+    Tuple,
+    TypeVar,
+)
 
 from . import FieldSpace, Future, Rect
-from .constraints import Alignment, Broadcast, Containment, PartSym
+from .constraints import (
+    Alignment,
+    Broadcast,
+    Containment,
+    Image,
+    Lit,
+    PartSym,
+    Scale,
+    Translate,
+)
 from .partition import REPLICATE
 from .runtime import runtime
 from .shape import Shape
 from .utils import OrderedSet
 
 if TYPE_CHECKING:
-    from .constraints import Expr, Lit
+    from .constraints import Expr
     from .operation import Operation
     from .partition import PartitionBase
     from .store import Store
@@ -140,6 +158,16 @@ class Strategy:
         self._key_parts = key_parts
         self._eq_classes = eq_classes
 
+    @staticmethod
+    def replicated(unknowns: Iterable[PartSym]) -> Strategy:
+        """
+        Returns a strategy for a single task that replicates all stores
+        """
+        partitions: dict[PartSym, PartitionBase] = {
+            unknown: REPLICATE for unknown in unknowns
+        }
+        return Strategy(None, partitions, {}, set(), EqClass())
+
     @property
     def parallel(self) -> bool:
         return self._launch_domain is not None
@@ -207,6 +235,9 @@ class Partitioner:
     ):
         self._ops = ops
         self._must_be_single = must_be_single
+        # Set when the solver resets cached key partitions, which makes the
+        # solution depend on more than the problem description
+        self._reset_key_partitions = False
 
     def _solve_constraints_for_futures(
         self,
@@ -341,6 +372,7 @@ class Partitioner:
         if original in must_be_even:
             store = original.store
             store.reset_key_partition()
+            self._reset_key_partitions = True
             return store.compute_key_partition(restrictions), original
         else:
             return chosen_partition, original
@@ -471,6 +503,80 @@ class Partitioner:
 
         return reset_any
 
+    @staticmethod
+    def _canonicalize_expr(
+        expr: Expr, index: dict[PartSym, int]
+    ) -> Optional[Hashable]:
+        if isinstance(expr, PartSym):
+            return index[expr]
+        elif isinstance(expr, Translate):
+            return (
+                "+",
+                Partitioner._canonicalize_expr(expr._expr, index),
+                expr._offset,
+            )
+        elif isinstance(expr, Scale):
+            return (
+                "*",
+                Partitioner._canonicalize_expr(expr._expr, index),
+                expr._scale,
+            )
+        elif isinstance(expr, Image):
+            # Images depend on the contents of the stores, so their
+            # solutions are never reused
+            return None
+        else:
+            assert isinstance(expr, Lit)
+            return ("lit", expr._part)
+
+    def _compute_solution_key(
+        self, unknowns: OrderedSet[PartSym], all_outputs: set[Store]
+    ) -> Optional[Hashable]:
+        # Describes the partitioning problem in terms of the positions of
+        # the partition symbols, so that the same problem posed by another
+        # operation on the same stores gets the same key. The description
+        # includes everything the solver consults about the stores,
+        # including their cached key partitions.
+        index = {unknown: idx for idx, unknown in enumerate(unknowns)}
+        store_ids: dict[Store, int] = {}
+        stores: list[Hashable] = []
+        for unknown in unknowns:
+            store = unknown.store
+            # Unbound stores need fresh field spaces for every operation
+            if store.unbound:
+                return None
+            stores.append(
+                (
+                    store_ids.setdefault(store, len(store_ids)),
+                    store.kind is Future,
+                    store.shape,
+                    store.comm_volume(),
+                    str(store.transform),
+                    store in all_outputs,
+                    store.get_all_key_partitions(),
+                )
+            )
+
+        constraints: list[Hashable] = []
+        for op in self._ops:
+            for c in op.constraints:
+                if isinstance(c, Alignment):
+                    constraints.append(("==", index[c._lhs], index[c._rhs]))
+                elif isinstance(c, Broadcast):
+                    constraints.append(
+                        ("bcast", index[c._expr], c._restrictions)
+                    )
+                elif isinstance(c, Containment):
+                    lhs = self._canonicalize_expr(c._lhs, index)
+                    rhs = self._canonicalize_expr(c._rhs, index)
+                    if lhs is None or rhs is None:
+                        return None
+                    constraints.append(("<=", lhs, rhs))
+                else:
+                    return None
+
+        return (self._must_be_single, tuple(stores), tuple(constraints))
+
     def partition_stores(self) -> Strategy:
         unknowns: OrderedSet[PartSym] = OrderedSet()
         constraints: EqClass[PartSym] = EqClass()
@@ -493,8 +599,11 @@ class Partitioner:
                             "Partitions constrained by multiple constraints "
                             "are not supported yet"
                         )
-                    for unknown in c._rhs.unknowns():
-                        must_be_even.add(unknown)
+                    # Images are computed by Legion, so the ranges can be
+                    # partitioned in any way
+                    if not isinstance(c._rhs, Image):
+                        for unknown in c._rhs.unknowns():
+                            must_be_even.add(unknown)
                     dependent[c._lhs] = c._rhs
                 elif isinstance(c, Containment) and isinstance(
                     c._rhs, PartSym
@@ -504,14 +613,29 @@ class Partitioner:
                             "Partitions constrained by multiple constraints "
                             "are not supported yet"
                         )
-                    for unknown in c._lhs.unknowns():
-                        must_be_even.add(unknown)
+                    if not isinstance(c._lhs, Image):
+                        for unknown in c._lhs.unknowns():
+                            must_be_even.add(unknown)
                     dependent[c._rhs] = c._lhs
         for op in self._ops:
             all_outputs.update(
                 store for store in op.outputs if not store.unbound
             )
 
+        all_unknowns = list(unknowns)
+        key = self._compute_solution_key(unknowns, all_outputs)
+        if key is not None:
+            solution = runtime.partition_manager.find_solution(key)
+            if solution is not None:
+                cached_shape, cached_parts, cached_key_parts = solution
+                return Strategy(
+                    cached_shape,
+                    dict(zip(all_unknowns, cached_parts)),
+                    {},
+                    set(all_unknowns[idx] for idx in cached_key_parts),
+                    constraints,
+                )
+
         if self._must_be_single or len(unknowns) == 0:
             for unknown in unknowns:
                 c = unknown.broadcast()
@@ -576,7 +700,26 @@ class Partitioner:
                 # idempotent.
                 can_retry = False
                 if self._reset_less_optimal_partitions(result):
+                    self._reset_key_partitions = True
                     continue
             break
 
+        if (
+            key is not None
+            and not self._reset_key_partitions
+            and all(unknown in result for unknown in all_unknowns)
+        ):
+            runtime.partition_manager.record_solution(
+                key,
+                (
+                    launch_shape,
+                    tuple(result[unknown] for unknown in all_unknowns),
+                    tuple(
+                        idx
+                        for idx, unknown in enumerate(all_unknowns)
+                        if unknown in key_parts
+                    ),
+                ),
+            )
+
         return Strategy(launch_shape, result, fspaces, key_parts, constraints)
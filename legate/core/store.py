@@ -21,6 +21,7 @@ from . import (
     AffineTransform,
     Attach,
     Detach,
+    Fill,
     Future,
     IndexAttach,
     IndexDetach,
@@ -31,10 +32,11 @@ from . import (
 )
 from .allocation import (
     Attachable,
+    DeviceAllocation,
     DistributedAllocation,
     InlineMappedAllocation,
 )
-from .partition import REPLICATE, PartitionBase, Restriction, Tiling
+from .partition import REPLICATE, Image, PartitionBase, Restriction, Tiling
 from .projection import execute_functor_symbolically
 from .runtime import runtime
 from .shape import Shape
@@ -65,6 +67,13 @@ from math import prod
 
 attachment_manager = runtime.attachment_manager
 
+# Element sizes the compressed shuffle handles. These must be kept in sync
+# with the ones in src/core/comm/compressed_shuffle.cc
+COMPRESSIBLE_TYPE_SIZES = (1, 2, 4, 8, 16)
+# The collectives take byte counts as 32-bit integers, so no task of the
+# compressed shuffle can send or receive more than this many bytes
+MAX_COMPRESSED_SHUFFLE_BYTES = 2**31 - 1
+
 
 # A Field holds a reference to a field in a region tree
 class Field:
@@ -79,6 +88,14 @@ class Field:
         self.field_id = field_id
         self.field_size = field_size
         self.shape = shape
+        # Image partitions computed from the ranges in this field, keyed by
+        # the partition of the field and the region they partition. They
+        # live as long as the field, unless the field may have been written.
+        self.images: dict[tuple[LegionPartition, Region], LegionPartition] = {}
+
+    def invalidate_images(self) -> None:
+        if len(self.images) > 0:
+            self.images = {}
 
     def same_handle(self, other: Field) -> bool:
         return type(self) == type(other) and self.field_id == other.field_id
@@ -118,6 +135,8 @@ class RegionField:
         self.physical_region: Union[None, PhysicalRegion] = None
         self.physical_region_refs = 0
         self.physical_region_mapped = False
+        # Whether the inline mapping is in the framebuffer
+        self.physical_region_on_device = False
 
         self._partitions: dict[Tiling, LegionPartition] = {}
 
@@ -147,7 +166,11 @@ class RegionField:
         )
 
     def attach_external_allocation(
-        self, context: Context, alloc: Attachable, share: bool
+        self,
+        context: Context,
+        alloc: Attachable,
+        share: bool,
+        zero_copy: bool = False,
     ) -> None:
         assert self.parent is None
         # If we already have some memory attached, detach it first
@@ -155,6 +178,7 @@ class RegionField:
             raise RuntimeError("A RegionField cannot be re-attached")
         # All inline mappings should have been unmapped by now
         assert self.physical_region_refs == 0
+        self.field.invalidate_images()
         # Record the attached memory ranges, and confirm no overlaps with
         # previously encountered ranges.
         attachment_manager.attach_external_allocation(alloc, self)
@@ -169,7 +193,32 @@ class RegionField:
             # TODO: This might not be necessary anymore
             self.detach_key = attachment_manager.register_detachment(detach)
 
-        if isinstance(alloc, memoryview):
+        memory = attachment_manager.find_attach_memory(alloc, zero_copy)
+        if memory is not None:
+            # Only index attach operations can name the memory that holds
+            # the buffer, so we attach the buffer to the sole subregion of
+            # a single-color partition. Every shard passes the same
+            # subregion, and the runtime picks one of the buffers.
+            assert not isinstance(alloc, DistributedAllocation)
+            ndim = self.shape.ndim
+            partition = Tiling(self.shape, Shape((1,) * ndim)).construct(
+                self.region
+            )
+            assert partition is not None
+            index_attach = IndexAttach(
+                self.region,
+                self.field.field_id,
+                {partition.get_child(Point([0] * ndim)): alloc},
+                mapper=context.mapper_id,
+                provenance=context.provenance,
+                memory=memory,
+            )
+            index_attach.set_deduplicate_across_shards(True)
+            if not share:
+                index_attach.set_restricted(False)
+            external_resources = runtime.dispatch(index_attach)
+            record_detach(IndexDetach(external_resources, flush=share))
+        elif isinstance(alloc, memoryview):
             # Singleton attachment
             attach = Attach(
                 self.region,
@@ -243,32 +292,63 @@ class RegionField:
 
     def detach_external_allocation(
         self, unordered: bool, defer: bool = False
-    ) -> None:
+    ) -> Optional[Future]:
+        """
+        Detaches the external allocation. Returns a future that completes
+        when the detachment is done, unless the detachment is deferred.
+        """
         assert self.parent is None
         assert self.attached_alloc is not None
         detach = attachment_manager.remove_detachment(self.detach_key)
         detach.unordered = unordered  # type: ignore[union-attr]
-        attachment_manager.detach_external_allocation(
+        future = attachment_manager.detach_external_allocation(
             self.attached_alloc, detach, defer
         )
         self.physical_region = None
         self.physical_region_mapped = False
         self.physical_region_refs = 0
         self.attached_alloc = None
+        return future
 
-    def get_inline_mapped_region(self, context: Context) -> PhysicalRegion:
+    def get_inline_mapped_region(
+        self, context: Context, device: bool = False
+    ) -> PhysicalRegion:
+        # Without GPUs, device mappings are no different from host ones
+        device = device and runtime.num_gpus > 0
         if self.parent is None:
+            if (
+                self.physical_region is not None
+                and self.physical_region_on_device != device
+            ):
+                # Two inline mappings of the same field would wait on each
+                # other, so we can't hand out both kinds at the same time
+                if (
+                    self.physical_region_refs > 0
+                    or self.attached_alloc is not None
+                ):
+                    raise RuntimeError(
+                        "Store is already mapped "
+                        + ("on the host" if device else "on the device")
+                    )
+                self.physical_region = None
             if self.physical_region is None:
                 # We don't have a valid numpy array so we need to do an inline
                 # mapping and then use the buffer to share the storage
+                tag = (
+                    runtime.core_library.LEGATE_CORE_DEVICE_INLINE_MAP_TAG
+                    if device
+                    else 0
+                )
                 mapping = InlineMapping(
                     self.region,
                     self.field.field_id,
                     mapper=context.mapper_id,
+                    tag=tag,
                     provenance=context.provenance,
                 )
                 self.physical_region = runtime.dispatch(mapping)
                 self.physical_region_mapped = True
+                self.physical_region_on_device = device
                 # Wait until it is valid before returning
                 self.physical_region.wait_until_valid()
             elif not self.physical_region_mapped:
@@ -282,7 +362,7 @@ class RegionField:
             self.physical_region_refs += 1
             return self.physical_region
         else:
-            return self.parent.get_inline_mapped_region(context)
+            return self.parent.get_inline_mapped_region(context, device)
 
     def decrement_inline_mapped_ref_count(
         self, unordered: bool = False
@@ -296,6 +376,7 @@ class RegionField:
                 runtime.unmap_region(self.physical_region, unordered=unordered)
                 self.physical_region = None
                 self.physical_region_mapped = False
+                self.physical_region_on_device = False
         else:
             self.parent.decrement_inline_mapped_ref_count(unordered=unordered)
 
@@ -304,10 +385,13 @@ class RegionField:
         shape: Shape,
         context: Optional[Context] = None,
         transform: Optional[AffineTransform] = None,
+        device: bool = False,
     ) -> InlineMappedAllocation:
         context = runtime.core_context if context is None else context
 
-        physical_region = self.get_inline_mapped_region(context)
+        # The caller can write to the allocation
+        self.field.invalidate_images()
+        physical_region = self.get_inline_mapped_region(context, device)
         # We need a pointer to the physical allocation for this physical region
         dim = max(shape.ndim, 1)
         # Build the accessor for this physical region
@@ -361,6 +445,7 @@ class RegionField:
             tuple(shape) if shape.ndim > 0 else (1,),
             int(ptr),  # type: ignore[call-overload]
             strides,
+            on_device=self.physical_region_on_device,
         )
 
     def register_consumer(self, consumer: Any) -> None:
@@ -527,6 +612,11 @@ class Storage:
         self._linear = False
         # True means this storage is transferred
         self._transferred = False
+        # Scalar store holding the value of a fill that hasn't been issued
+        # yet, because nothing has needed the field since.
+        self._fill_value: Optional[Store] = None
+        # True means moves of this storage between nodes are compressed
+        self._compress_transfers = False
 
     def __str__(self) -> str:
         return (
@@ -586,6 +676,8 @@ class Storage:
                 raise ValueError("Illegal to access an uninitialized storage")
             if self._parent is None:
                 self._data = runtime.allocate_field(self.extents, self._dtype)
+                if self._fill_value is not None:
+                    self._materialize_fill()
             else:
                 assert self._color
                 self._data = self._parent.get_child_data(self._color)
@@ -594,13 +686,78 @@ class Storage:
 
     @property
     def has_data(self) -> bool:
-        return self._data is not None
+        # A deferred fill counts as data, so that the storage doesn't get
+        # replaced by another store's
+        return self._data is not None or self._fill_value is not None
+
+    @property
+    def fill_value(self) -> Optional[Store]:
+        """
+        Return the value of the fill that initialized the whole storage, if
+        the fill hasn't been materialized yet
+        """
+        if self._parent is not None:
+            return self.get_root().fill_value
+        return self._fill_value if self._data is None else None
+
+    def defer_fill(self, value: Store) -> bool:
+        """
+        Record a fill of the whole storage without issuing it. The fill is
+        issued only when something needs the field, and is dropped if
+        another fill or an attach overwrites the storage before that.
+        Returns False if the fill must be issued right away.
+        """
+        if (
+            not runtime.lazy_fill
+            or self._parent is not None
+            or self._kind is not RegionField
+            or self._data is not None
+            or self._transferred
+        ):
+            return False
+        self._fill_value = value
+        return True
+
+    def _materialize_fill(self) -> None:
+        assert isinstance(self._data, RegionField)
+        assert self._fill_value is not None
+        value = self._fill_value.storage
+        assert isinstance(value, Future)
+        self._fill_value = None
+        region = self._data.region
+        fill = Fill(
+            region,
+            region.get_root(),
+            self._data.field.field_id,
+            value,
+            runtime.core_context.get_mapper_id(0),
+        )
+        runtime.dispatch(fill)
+
+    def get_field_key(self) -> Optional[tuple[int, int]]:
+        """
+        Return the (region tree id, field id) pair of the field backing this
+        storage, or None if no field has been allocated yet. Unlike `data`,
+        this doesn't flush the scheduling window.
+        """
+        if self._data is None or self._kind is Future:
+            return None
+        assert isinstance(self._data, RegionField)
+        return (self._data.region.handle.tree_id, self._data.field.field_id)
 
     def set_data(self, data: Union[RegionField, Future]) -> None:
         assert (
             self._kind is Future and type(data) is Future
         ) or self._data is None
         self._data = data
+        self._fill_value = None
+
+    @property
+    def compress_transfers(self) -> bool:
+        return self._compress_transfers
+
+    def set_compress_transfers(self, compress: bool) -> None:
+        self._compress_transfers = compress
 
     @property
     def linear(self) -> bool:
@@ -613,8 +770,10 @@ class Storage:
         assert other._linear
         assert other.has_data
         assert not self.has_data
+        # Issue the source's deferred fill, if any, before taking its field
+        data = other.data
         other._transferred = True
-        self._data = other._data
+        self._data = data
         other._data = None
 
     def set_extents(self, extents: Shape) -> None:
@@ -667,20 +826,31 @@ class Storage:
         )
 
     def attach_external_allocation(
-        self, context: Context, alloc: Attachable, share: bool
+        self,
+        context: Context,
+        alloc: Attachable,
+        share: bool,
+        zero_copy: bool = False,
     ) -> None:
+        # The attachment overwrites the whole storage, so a deferred fill is
+        # dropped before anything touches the data, which would issue it
+        self._fill_value = None
         # If the storage has not been set, and this is a non-temporary
         # singleton attachment, we can reuse an existing RegionField that was
         # previously attached to this buffer.
         # This is the only situation where we can attach the same buffer to
         # two Stores, since they are both backed by the same RegionField.
-        if self._data is None and share and isinstance(alloc, memoryview):
+        if (
+            self._data is None
+            and share
+            and isinstance(alloc, (memoryview, DeviceAllocation))
+        ):
             self._data = attachment_manager.reuse_existing_attachment(alloc)
             if self._data is not None:
                 return
         # Force the RegionField to be instantiated, do the attachment normally
         assert isinstance(self.data, RegionField)
-        self.data.attach_external_allocation(context, alloc, share)
+        self.data.attach_external_allocation(context, alloc, share, zero_copy)
 
     def slice(self, tile_shape: Shape, offsets: Shape) -> Storage:
         if self.kind is Future:
@@ -730,10 +900,11 @@ class Storage:
         shape: Shape,
         context: Optional[Context] = None,
         transform: Optional[AffineTransform] = None,
+        device: bool = False,
     ) -> InlineMappedAllocation:
         assert isinstance(self.data, RegionField)
         return self.data.get_inline_allocation(
-            shape, context=context, transform=transform
+            shape, context=context, transform=transform, device=device
         )
 
     def find_key_partition(
@@ -746,6 +917,16 @@ class Storage:
             partition = self._parent.find_key_partition(restrictions)
         return partition
 
+    def get_all_key_partitions(self) -> tuple[Optional[PartitionBase], ...]:
+        # Returns the key partitions of this storage and its ancestors,
+        # regardless of restrictions
+        partition = runtime.partition_manager.find_storage_key_partition(
+            self._unique_id, ()
+        )
+        if self._parent is None:
+            return (partition,)
+        return (partition,) + self._parent.parent.get_all_key_partitions()
+
     def set_key_partition(self, partition: PartitionBase) -> None:
         runtime.partition_manager.record_storage_key_partition(
             self._unique_id, partition
@@ -762,6 +943,10 @@ class Storage:
 
         assert isinstance(self.data, RegionField)
 
+        # Images are cached by the fields holding the ranges
+        if isinstance(functor, Image):
+            return functor.construct(self.data.region, complete=complete)
+
         part, found = runtime.partition_manager.find_legion_partition(
             self._unique_id, functor
         )
@@ -893,6 +1078,70 @@ class Store:
     def move_data(self, other: Store) -> None:
         self._storage.move_data(other._storage)
 
+    @property
+    def compress_transfers(self) -> bool:
+        return self._storage.compress_transfers
+
+    def set_compress_transfers(self, compress: bool = True) -> None:
+        """
+        Hint that the data of this store compresses well, e.g., because it
+        is sparse or holds small integers in a wide type. When a task needs
+        the store in a different tiling than the one it was last written
+        with, the pieces are then sent between the nodes compressed, instead
+        of being copied by Legion as they are.
+
+        Parameters
+        ----------
+        compress : bool
+            Whether transfers of the store should be compressed
+        """
+        self._storage.set_compress_transfers(compress)
+
+    def can_compress_transfer(self, partition: PartitionBase) -> bool:
+        """
+        Return True if moving the store from its key partition to
+        ``partition`` can be done by the compressed shuffle. This requires
+        both to be complete tilings with the same color shape, so that each
+        task of the shuffle sends its old tile and receives its new one, and
+        no tile to be too large for the collectives.
+        """
+        if (
+            not self.compress_transfers
+            or self.unbound
+            or self.kind is not RegionField
+            or self.transformed
+            or self._storage.has_parent
+            or self.ndim == 0
+            or self.type.size not in COMPRESSIBLE_TYPE_SIZES
+            or self._storage.get_field_key() is None
+        ):
+            return False
+        key_partition = runtime.partition_manager.find_store_key_partition(
+            self._unique_id, ()
+        )
+        if (
+            not isinstance(key_partition, Tiling)
+            or not isinstance(partition, Tiling)
+            or key_partition == partition
+            or key_partition.color_shape != partition.color_shape
+        ):
+            return False
+        # Each message is at most one byte larger than the elements it
+        # carries, and a task exchanges one message with every other task
+        tile_volume = max(
+            key_partition.tile_shape.volume(), partition.tile_shape.volume()
+        )
+        num_tasks = partition.color_shape.volume()
+        if (
+            tile_volume * self.type.size + num_tasks
+            > MAX_COMPRESSED_SHUFFLE_BYTES
+        ):
+            return False
+        offsets = Shape((0,) * self.ndim)
+        return key_partition.is_complete_for(
+            self.shape, offsets
+        ) and partition.is_complete_for(self.shape, offsets)
+
     @property
     def shape(self) -> Shape:
         if self._shape is None:
@@ -967,6 +1216,17 @@ class Store:
     def has_storage(self) -> bool:
         return self._storage.has_data
 
+    @property
+    def fill_value(self) -> Optional[Store]:
+        """
+        Return the scalar store the whole store was last filled with, if
+        nothing has needed the store's field since. Libraries can pass the
+        value to their tasks as a scalar instead of reading the store.
+        """
+        if self.unbound or self.kind is Future:
+            return None
+        return self._storage.fill_value
+
     def same_root(self, rhs: Store) -> bool:
         return self._storage.get_root() is rhs._storage.get_root()
 
@@ -983,12 +1243,36 @@ class Store:
         return not self._transform.bottom
 
     def attach_external_allocation(
-        self, context: Context, alloc: Attachable, share: bool
+        self,
+        context: Context,
+        alloc: Attachable,
+        share: bool,
+        zero_copy: bool = False,
     ) -> None:
-        if not isinstance(alloc, (memoryview, DistributedAllocation)):
+        """
+        Attaches an external allocation to the store
+
+        Parameters
+        ----------
+        context : Context
+            Library context that issues the attach operation
+        alloc : Attachable
+            Allocation to attach. A ``DeviceAllocation`` is attached in place
+            as a framebuffer instance.
+        share : bool
+            Whether the store and the allocation should stay coherent
+        zero_copy : bool
+            If ``True``, a memoryview is page-locked and attached as a
+            zero-copy memory instance, which GPU tasks can access directly.
+            Falls back to a system memory attachment when the buffer can't
+            be page-locked.
+        """
+        if not isinstance(
+            alloc, (memoryview, DistributedAllocation, DeviceAllocation)
+        ):
             raise ValueError(
-                f"Only a memoryview or DistributedAllocation object can be "
-                f"attached, but got {alloc}"
+                f"Only a memoryview, DistributedAllocation, or "
+                f"DeviceAllocation object can be attached, but got {alloc}"
             )
         elif self._storage.has_parent:
             raise ValueError("Can only attach buffers to top-level Stores")
@@ -999,13 +1283,17 @@ class Store:
         elif self.unbound:
             raise ValueError("Cannot attach buffers to variable-size stores")
 
-        self._storage.attach_external_allocation(context, alloc, share)
+        self._storage.attach_external_allocation(
+            context, alloc, share, zero_copy
+        )
 
     def has_fake_dims(self) -> bool:
         return self._transform.adds_fake_dims()
 
     def comm_volume(self) -> int:
-        return self._storage.volume()
+        # Counted in bytes, so that the partitioner keeps the stores that
+        # are the most expensive to move over the network stationary
+        return self._storage.volume() * self._dtype.size
 
     def set_storage(self, data: Union[RegionField, Future]) -> None:
         assert not self.linear
@@ -1199,13 +1487,32 @@ class Store:
         )
 
     def get_inline_allocation(
-        self, context: Optional[Context] = None
+        self, context: Optional[Context] = None, device: bool = False
     ) -> InlineMappedAllocation:
+        """
+        Maps the store inline and returns the allocation backing it
+
+        Parameters
+        ----------
+        context : Context, optional
+            Context whose mapper maps the store
+        device : bool
+            If ``True``, the store is mapped to the framebuffer of a local
+            GPU, and the allocation holds a device pointer that can be
+            shared with CUDA-aware libraries such as CuPy or PyTorch. Falls
+            back to a host mapping on machines without GPUs.
+
+        Returns
+        -------
+        InlineMappedAllocation
+            Allocation whose ``on_device`` tells where the data lives
+        """
         assert self.kind is RegionField
         return self._storage.get_inline_allocation(
             self.shape,
             context=context,
             transform=self._transform.get_inverse_transform(self.shape.ndim),
+            device=device,
         )
 
     def overlaps(self, other: Store) -> bool:
@@ -1227,6 +1534,18 @@ class Store:
             self._unique_id, self.find_restrictions()
         )
 
+    def get_all_key_partitions(self) -> tuple[Optional[PartitionBase], ...]:
+        """
+        Return all key partitions the solver can pick for this store: its
+        own, followed by those of its storage and the storage's ancestors.
+        Unlike `get_key_partition`, this doesn't flush the scheduling window
+        or filter the partitions by restrictions.
+        """
+        partition = runtime.partition_manager.find_store_key_partition(
+            self._unique_id, ()
+        )
+        return (partition,) + self._storage.get_all_key_partitions()
+
     def has_key_partition(self, restrictions: tuple[Restriction, ...]) -> bool:
         key_partition = runtime.partition_manager.find_store_key_partition(
             self._unique_id, restrictions
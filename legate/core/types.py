@@ -66,6 +66,28 @@ class Complex128Dtype(pa.ExtensionType):
         return np.dtype(np.complex128)
 
 
+class Rect1Dtype(pa.ExtensionType):
+    # A pair of 64-bit integers describing an inclusive range of points,
+    # laid out the same way as Legion::Rect<1>
+    def __init__(self) -> None:
+        pa.ExtensionType.__init__(self, pa.binary(16), "rect1")
+
+    def __arrow_ext_serialize__(self) -> bytes:
+        return b""
+
+    @classmethod
+    def __arrow_ext_deserialize__(
+        cls, storage_type: pa.lib.DataType, serialized: str
+    ) -> Rect1Dtype:
+        return Rect1Dtype()
+
+    def __hash__(self) -> int:
+        return hash(self.__class__)
+
+    def to_pandas_dtype(self) -> np.dtype[Any]:
+        return np.dtype([("lo", np.int64), ("hi", np.int64)])
+
+
 bool_ = pa.bool_()
 int8 = pa.int8()
 int16 = pa.int16()
@@ -81,6 +103,7 @@ float64 = pa.float64()
 complex64 = Complex64Dtype()
 complex128 = Complex128Dtype()
 string = pa.string()
+rect1 = Rect1Dtype()
 
 
 class _Dtype:
@@ -182,6 +205,7 @@ _CORE_DTYPES = [
     _Dtype(complex64, 8, legion.LEGION_TYPE_COMPLEX64),
     _Dtype(complex128, 16, legion.LEGION_TYPE_COMPLEX128),
     _Dtype(string, -1, legion.LEGION_TYPE_COMPLEX128 + 1),
+    _Dtype(rect1, 16, legion.LEGION_TYPE_COMPLEX128 + 2),
 ]
 
 
@@ -212,7 +236,7 @@ _redops_float = (
 
 _register_reduction_ops(_CORE_DTYPES[:10], ReductionOp)
 _register_reduction_ops(_CORE_DTYPES[10:13], _redops_float)
-_register_reduction_ops(_CORE_DTYPES[13:-1], _redops_float[:4])
+_register_reduction_ops(_CORE_DTYPES[13:15], _redops_float[:4])
 
 
 class TypeSystem:
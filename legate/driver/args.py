@@ -90,6 +90,17 @@ binding.add_argument(
 )
 
 
+binding.add_argument(
+    "--auto-bind",
+    dest="auto_bind",
+    action="store_true",
+    required=False,
+    help="Derive the bindings not given explicitly from the topology of the "
+    "node, so that the cores, memory, GPUs and NICs of each rank are in the "
+    "same NUMA domain. Assumes all nodes have the same topology.",
+)
+
+
 core = parser.add_argument_group("Core alloction")
 core.add_argument(CPUS.name, **CPUS.kwargs)
 core.add_argument(GPUS.name, **GPUS.kwargs)
@@ -0,0 +1,207 @@
+# Copyright 2022 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+"""Derive per-rank hardware bindings from the node topology.
+
+"""
+from __future__ import annotations
+
+from dataclasses import dataclass
+from pathlib import Path
+
+__all__ = ("Topology", "compute_bindings", "read_topology")
+
+
+@dataclass(frozen=True)
+class Topology:
+    """The affinity of the devices on a node to its NUMA domains"""
+
+    #: Cores of each NUMA domain, keyed by the domain's id
+    numa_cpus: dict[int, tuple[int, ...]]
+
+    #: NUMA domain of each GPU, in the order of the CUDA device ids
+    gpu_numa: tuple[int, ...]
+
+    #: NUMA domain of each network interface, keyed by the device name
+    nic_numa: dict[str, int]
+
+
+def _parse_list(text: str) -> tuple[int, ...]:
+    # Parses lists like "0-3,8,10-11" as used in sysfs
+    ids: list[int] = []
+    for part in text.strip().split(","):
+        if not part:
+            continue
+        lo, _, hi = part.partition("-")
+        ids.extend(range(int(lo), int(hi or lo) + 1))
+    return tuple(ids)
+
+
+def _read_numa_node(device: Path, default: int) -> int:
+    try:
+        node = int((device / "numa_node").read_text())
+    except (OSError, ValueError):
+        return default
+    # Devices that aren't attached to a particular domain report -1
+    return node if node >= 0 else default
+
+
+def _read_gpu_numa(sysfs: Path, default: int) -> tuple[int, ...]:
+    try:
+        import pynvml  # type: ignore[import]
+
+        pynvml.nvmlInit()
+    except Exception:
+        return ()
+
+    result = []
+    for i in range(pynvml.nvmlDeviceGetCount()):
+        handle = pynvml.nvmlDeviceGetHandleByIndex(i)
+        bus_id = pynvml.nvmlDeviceGetPciInfo(handle).busId
+        if isinstance(bus_id, bytes):
+            bus_id = bus_id.decode()
+        # NVML reports an 8-digit PCI domain whereas sysfs uses 4 digits
+        device = sysfs / "bus" / "pci" / "devices" / bus_id[-12:].lower()
+        result.append(_read_numa_node(device, default))
+    return tuple(result)
+
+
+def read_topology(sysfs: Path = Path("/sys")) -> Topology:
+    """Read the topology of the node this is running on from sysfs and NVML.
+
+    Nodes are assumed to be homogeneous, as for the binding specifications
+    given by hand.
+
+    Parameters
+    ----------
+    sysfs : Path, optional
+        Where sysfs is mounted
+
+    Returns
+    -------
+        Topology
+
+    """
+    numa_cpus: dict[int, tuple[int, ...]] = {}
+    for node in sorted((sysfs / "devices" / "system" / "node").glob("node*")):
+        cpus = _parse_list((node / "cpulist").read_text())
+        if cpus:
+            numa_cpus[int(node.name[len("node") :])] = cpus
+
+    # Machines without NUMA support don't expose any domain
+    if not numa_cpus:
+        online = sysfs / "devices" / "system" / "cpu" / "online"
+        numa_cpus[0] = _parse_list(online.read_text())
+
+    default = min(numa_cpus)
+
+    nic_numa = {
+        nic.name: _read_numa_node(nic / "device", default)
+        for nic in sorted((sysfs / "class" / "infiniband").glob("*"))
+    }
+
+    return Topology(numa_cpus, _read_gpu_numa(sysfs, default), nic_numa)
+
+
+def _format(ids: list[int] | tuple[int, ...]) -> str:
+    return ",".join(str(i) for i in ids)
+
+
+def compute_bindings(
+    topology: Topology, ranks_per_node: int, gpus_per_rank: int
+) -> dict[str, str]:
+    """Compute the binding specifications that keep each rank's cores,
+    memory, GPUs and NICs in the same NUMA domain.
+
+    When ranks use GPUs, each rank is placed in the domain of its first GPU
+    and GPUs are handed out domain by domain. Otherwise ranks are spread
+    evenly over the domains. The cores of a domain are split evenly among the
+    ranks placed in it, and those ranks share the domain's NICs round-robin,
+    falling back to all NICs of the node if the domain has none.
+
+    Parameters
+    ----------
+    topology : Topology
+        The topology of each node
+
+    ranks_per_node : int
+        The number of ranks on each node
+
+    gpus_per_rank : int
+        The number of GPUs used by each rank
+
+    Returns
+    -------
+        dict[str, str]
+            The specifications, in the format of --cpu-bind and friends,
+            keyed by "cpu", "mem", "gpu" and "nic". Resources the node
+            doesn't have are left out.
+
+    """
+    numa_ids = sorted(topology.numa_cpus)
+
+    gpus: list[list[int]] = []
+    if gpus_per_rank > 0 and topology.gpu_numa:
+        needed = ranks_per_node * gpus_per_rank
+        if needed > len(topology.gpu_numa):
+            raise RuntimeError(
+                f"Cannot bind {ranks_per_node} ranks with {gpus_per_rank} "
+                f"GPUs each to the {len(topology.gpu_numa)} GPUs of the node"
+            )
+        # Stable sort keeps the device order within each domain
+        order = sorted(
+            range(len(topology.gpu_numa)), key=lambda g: topology.gpu_numa[g]
+        )
+        gpus = [
+            order[r * gpus_per_rank : (r + 1) * gpus_per_rank]
+            for r in range(ranks_per_node)
+        ]
+        rank_numa = [topology.gpu_numa[g[0]] for g in gpus]
+    else:
+        rank_numa = [
+            numa_ids[r * len(numa_ids) // ranks_per_node]
+            for r in range(ranks_per_node)
+        ]
+
+    cpus: list[list[int]] = []
+    nics: list[str] = []
+    all_nics = sorted(topology.nic_numa)
+    for rank, numa in enumerate(rank_numa):
+        peers = [r for r, n in enumerate(rank_numa) if n == numa]
+        index = peers.index(rank)
+
+        cores = topology.numa_cpus.get(numa, ())
+        if len(peers) > len(cores):
+            raise RuntimeError(
+                f"Cannot bind {len(peers)} ranks to the {len(cores)} cores "
+                f"of NUMA domain {numa}"
+            )
+        share = len(cores) // len(peers)
+        cpus.append(list(cores[index * share : (index + 1) * share]))
+
+        local_nics = [n for n in all_nics if topology.nic_numa[n] == numa]
+        if local_nics:
+            nics.append(local_nics[index % len(local_nics)])
+        elif all_nics:
+            nics.append(all_nics[rank % len(all_nics)])
+
+    bindings = {
+        "cpu": "/".join(_format(c) for c in cpus),
+        "mem": "/".join(str(n) for n in rank_numa),
+    }
+    if gpus:
+        bindings["gpu"] = "/".join(_format(g) for g in gpus)
+    if nics:
+        bindings["nic"] = "/".join(nics)
+    return bindings
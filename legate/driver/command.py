@@ -17,6 +17,7 @@ from __future__ import annotations
 from typing import TYPE_CHECKING
 
 from ..util.ui import warn
+from .auto_bind import compute_bindings, read_topology
 
 if TYPE_CHECKING:
     from ..util.system import System
@@ -61,6 +62,16 @@ def cmd_bind(
         ("mem", config.binding.mem_bind),
         ("nic", config.binding.nic_bind),
     )
+
+    # Explicit bindings take precedence over the derived ones
+    if config.binding.auto_bind:
+        derived = compute_bindings(
+            read_topology(), ranks_per_node, config.core.gpus
+        )
+        bindings = tuple(
+            (name, derived.get(name) if binding is None else binding)
+            for name, binding in bindings
+        )
     for name, binding in bindings:
         if binding is not None:
             check_bind_ranks(name, binding)
@@ -66,6 +66,7 @@ class Binding(DataclassMixin):
     mem_bind: str | None
     gpu_bind: str | None
     nic_bind: str | None
+    auto_bind: bool
 
 
 @dataclass(frozen=True)
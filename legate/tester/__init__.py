@@ -17,7 +17,7 @@
 """
 from __future__ import annotations
 
-from dataclasses import dataclass
+from dataclasses import dataclass, field
 from typing import Union
 from typing_extensions import Literal, TypeAlias
 
@@ -25,7 +25,11 @@ from ..util.types import ArgList
 
 #: Define the available feature types for tests
 FeatureType: TypeAlias = Union[
-    Literal["cpus"], Literal["cuda"], Literal["eager"], Literal["openmp"]
+    Literal["cpus"],
+    Literal["cuda"],
+    Literal["eager"],
+    Literal["openmp"],
+    Literal["perf"],
 ]
 
 #: Value to use if --cpus is not specified.
@@ -46,6 +50,12 @@ DEFAULT_OMPS_PER_NODE = 1
 #: Value to use if --ompthreads is not specified.
 DEFAULT_OMPTHREADS = 4
 
+#: Value to use if --perf-tolerance is not specified.
+DEFAULT_PERF_TOLERANCE = 0.1
+
+#: Value to use if --perf-repeat is not specified.
+DEFAULT_PERF_REPEAT = 3
+
 #: Default values to apply to normalize the testing environment.
 DEFAULT_PROCESS_ENV = {
     "LEGATE_TEST": "1",
@@ -58,6 +68,7 @@ FEATURES: tuple[FeatureType, ...] = (
     "cuda",
     "eager",
     "openmp",
+    "perf",
 )
 
 #: Paths to test files that should be skipped entirely in all stages.
@@ -85,3 +96,56 @@ class CustomTest:
 #:
 #: Client test scripts should udpate this set with their own customizations.
 CUSTOM_FILES: list[CustomTest] = []
+
+
+@dataclass
+class PerfBenchmark:
+    #: Name to report the benchmark's measurements under
+    name: str
+
+    #: Path to the benchmark, relative to the test root directory
+    file: str
+
+    #: Extra arguments to pass to the benchmark
+    args: ArgList = field(default_factory=list)
+
+    #: Whether the file is a Google Benchmark binary, whose individual
+    #: benchmarks are measured separately, rather than a script run with the
+    #: legate driver, whose wall-clock time is measured
+    gbench: bool = False
+
+    #: Whether the script prints tables of latencies in the style of the OSU
+    #: micro-benchmarks, like benchmarks/coll_bench.py. Each reported latency
+    #: is measured separately, instead of the script's wall-clock time.
+    osu: bool = False
+
+    #: Allowed slowdown relative to the baseline, as a fraction, overriding
+    #: the --perf-tolerance value for this benchmark
+    tolerance: float | None = None
+
+
+#: Benchmarks run by the perf stage. Benchmarks whose file doesn't exist, e.g.
+#: because the microbenchmarks weren't built, are skipped.
+#:
+#: Client test scripts should udpate this list with their own customizations.
+PERF_BENCHMARKS: list[PerfBenchmark] = [
+    PerfBenchmark(
+        "legate_core_bench",
+        "build/benchmarks/legate_core_bench",
+        gbench=True,
+    ),
+    PerfBenchmark(
+        "allreduce_cpu",
+        "benchmarks/coll_bench.py",
+        ["--comm", "cpu", "--ops", "allreduce", "--ranks", "2"]
+        + ["--max-size", "65536", "--iterations", "20"],
+        osu=True,
+    ),
+    PerfBenchmark(
+        "alltoallv_cpu",
+        "benchmarks/coll_bench.py",
+        ["--comm", "cpu", "--ops", "alltoallv", "--ranks", "2"]
+        + ["--max-size", "65536", "--iterations", "20"],
+        osu=True,
+    ),
+]
@@ -30,6 +30,8 @@ from . import (
     DEFAULT_GPUS_PER_NODE,
     DEFAULT_OMPS_PER_NODE,
     DEFAULT_OMPTHREADS,
+    DEFAULT_PERF_REPEAT,
+    DEFAULT_PERF_TOLERANCE,
     FEATURES,
 )
 
@@ -161,6 +163,46 @@ feature_opts.add_argument(
 )
 
 
+perf_opts = parser.add_argument_group("Performance stage options")
+
+
+perf_opts.add_argument(
+    "--perf-baseline",
+    dest="perf_baseline",
+    metavar="FILE",
+    default=None,
+    help="Results of an earlier perf stage to compare against",
+)
+
+
+perf_opts.add_argument(
+    "--perf-results",
+    dest="perf_results",
+    metavar="FILE",
+    default="legate_perf.json",
+    help="Where the perf stage stores its results",
+)
+
+
+perf_opts.add_argument(
+    "--perf-tolerance",
+    dest="perf_tolerance",
+    type=float,
+    default=DEFAULT_PERF_TOLERANCE,
+    help="Slowdown relative to the baseline, as a fraction, beyond which a "
+    "benchmark fails",
+)
+
+
+perf_opts.add_argument(
+    "--perf-repeat",
+    dest="perf_repeat",
+    type=int,
+    default=DEFAULT_PERF_REPEAT,
+    help="Number of times to run each benchmark, keeping the fastest run",
+)
+
+
 test_opts = parser.add_argument_group("Test run configuration options")
 
 
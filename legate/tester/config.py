@@ -64,6 +64,14 @@ class Config:
         self.gpu_delay = args.gpu_delay
         self.ompthreads = args.ompthreads
 
+        # performance stage configuration
+        self.perf_baseline = (
+            Path(args.perf_baseline) if args.perf_baseline else None
+        )
+        self.perf_results = Path(args.perf_results)
+        self.perf_tolerance = args.perf_tolerance
+        self.perf_repeat = args.perf_repeat
+
         # test run configuration
         self.debug = args.debug
         self.dry_run = args.dry_run
@@ -26,9 +26,9 @@ from .test_stage import TestStage
 from .util import log_proc
 
 if sys.platform == "darwin":
-    from ._osx import CPU, Eager, GPU, OMP
+    from ._osx import CPU, Eager, GPU, OMP, Perf
 elif sys.platform.startswith("linux"):
-    from ._linux import CPU, Eager, GPU, OMP
+    from ._linux import CPU, Eager, GPU, OMP, Perf
 else:
     raise RuntimeError(f"unsupported platform: {sys.platform}")
 
@@ -38,4 +38,5 @@ STAGES: Dict[FeatureType, Type[TestStage]] = {
     "cuda": GPU,
     "openmp": OMP,
     "eager": Eager,
+    "perf": Perf,
 }
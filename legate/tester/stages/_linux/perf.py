@@ -0,0 +1,75 @@
+# Copyright 2022 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+from __future__ import annotations
+
+from itertools import chain
+from typing import TYPE_CHECKING
+
+from ..perf import PerfStage
+from ..util import UNPIN_ENV, Shard, StageSpec, adjust_workers
+
+if TYPE_CHECKING:
+    from ....util.types import ArgList, EnvDict
+    from ...config import Config
+    from ...test_system import TestSystem
+
+
+class Perf(PerfStage):
+    """A test stage for detecting performance regressions.
+
+    Parameters
+    ----------
+    config: Config
+        Test runner configuration
+
+    system: TestSystem
+        Process execution wrapper
+
+    """
+
+    def __init__(self, config: Config, system: TestSystem) -> None:
+        self._init(config, system)
+
+    def env(self, config: Config, system: TestSystem) -> EnvDict:
+        return {} if config.cpu_pin == "strict" else dict(UNPIN_ENV)
+
+    def shard_args(self, shard: Shard, config: Config) -> ArgList:
+        args = [
+            "--cpus",
+            str(config.cpus),
+        ]
+        if config.cpu_pin != "none":
+            args += [
+                "--cpu-bind",
+                ",".join(str(x) for x in shard),
+            ]
+        return args
+
+    def gbench_launcher(self, shard: Shard, config: Config) -> ArgList:
+        if config.cpu_pin == "none":
+            return []
+        return ["taskset", "-c", ",".join(str(x) for x in shard)]
+
+    def compute_spec(self, config: Config, system: TestSystem) -> StageSpec:
+        cpus = system.cpus
+
+        # Benchmarks always run one at a time on the same cores, regardless
+        # of the requested workers
+        procs = config.cpus + config.utility + int(config.cpu_pin == "strict")
+        workers = adjust_workers(min(1, len(cpus) // procs), None)
+
+        shard = chain.from_iterable(cpus[j].ids for j in range(procs))
+
+        return StageSpec(workers, [tuple(sorted(shard))])
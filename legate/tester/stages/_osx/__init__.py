@@ -22,3 +22,4 @@ from .cpu import CPU
 from .gpu import GPU
 from .eager import Eager
 from .omp import OMP
+from .perf import Perf
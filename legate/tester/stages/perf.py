@@ -0,0 +1,365 @@
+# Copyright 2022 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+"""Provide a base for the test stages that run the configured benchmarks and
+compare their measurements against a baseline.
+
+"""
+from __future__ import annotations
+
+import json
+import re
+import tempfile
+import time
+from pathlib import Path
+from typing import Any
+
+from ...util.types import ArgList
+from ...util.ui import warn
+from .. import PERF_BENCHMARKS, FeatureType, PerfBenchmark
+from ..config import Config
+from ..logger import LOG
+from ..test_system import ProcessResult, TestSystem
+from .test_stage import TestStage
+from .util import Shard, log_proc
+
+#: Seconds per unit of the times reported by Google Benchmark
+GBENCH_TIME_UNITS = {"ns": 1e-9, "us": 1e-6, "ms": 1e-3, "s": 1.0}
+
+#: The title of a table printed by an OSU-style benchmark, e.g.
+#: "# allreduce on 2 ranks (cpu)"
+OSU_TITLE = re.compile(r"^# (\S+) on (\d+) ranks")
+
+#: A row of a table printed by an OSU-style benchmark: the message size, the
+#: latency in microseconds, and optionally the bandwidth
+OSU_ROW = re.compile(r"^(\d+)\s+([0-9.eE+-]+)(\s+[0-9.eE+-]+)?\s*$")
+
+
+def parse_osu_output(name: str, output: str) -> dict[str, float]:
+    """Collect the latencies an OSU-style benchmark reported.
+
+    Parameters
+    ----------
+    name: str
+        Name of the benchmark, which prefixes the names of the measurements
+
+    output: str
+        Output of the benchmark
+
+    Returns
+    -------
+    dict[str, float]
+        The latency of each collective, rank count and message size, in
+        seconds. Bandwidths are derived from the same latencies, so they
+        aren't compared separately.
+
+    """
+    measurements: dict[str, float] = {}
+    table = None
+    for line in output.splitlines():
+        line = line.strip()
+        if (title := OSU_TITLE.match(line)) is not None:
+            table = f"{name}/{title.group(1)}/{title.group(2)}"
+        elif table is not None and (row := OSU_ROW.match(line)) is not None:
+            latency = float(row.group(2)) * 1e-6
+            measurements[f"{table}/{row.group(1)}"] = latency
+    return measurements
+
+
+def perf_config(config: Config) -> dict[str, Any]:
+    """The parts of the configuration that measurements depend on, which
+    must match for a baseline to be comparable."""
+    return {
+        "cpus": config.cpus,
+        "utility": config.utility,
+        "cpu_pin": config.cpu_pin,
+    }
+
+
+def load_baseline(config: Config) -> dict[str, float]:
+    """Load the measurements to compare against, if a baseline was given.
+
+    Parameters
+    ----------
+    config: Config
+        Test runner configuration
+
+    """
+    if config.perf_baseline is None:
+        return {}
+
+    with open(config.perf_baseline) as f:
+        baseline = json.load(f)
+
+    if baseline.get("config") != perf_config(config):
+        LOG(
+            warn(
+                f"Baseline {config.perf_baseline} was measured with a "
+                "different configuration"
+            )
+        )
+
+    return baseline["measurements"]
+
+
+def save_results(config: Config, measurements: dict[str, float]) -> None:
+    """Store the measurements in a form that can be used as a baseline.
+
+    Parameters
+    ----------
+    config: Config
+        Test runner configuration
+
+    measurements: dict[str, float]
+        Measurements of the benchmarks, in seconds
+
+    """
+    results = {"config": perf_config(config), "measurements": measurements}
+    with open(config.perf_results, "w") as f:
+        json.dump(results, f, indent=2, sort_keys=True)
+
+
+def compare(
+    measurements: dict[str, float],
+    baseline: dict[str, float],
+    tolerance: float,
+) -> tuple[list[str], bool]:
+    """Compare measurements against a baseline.
+
+    Parameters
+    ----------
+    measurements: dict[str, float]
+        Measurements of a benchmark, in seconds
+
+    baseline: dict[str, float]
+        Measurements to compare against. Measurements missing from it are
+        reported but never count as regressions.
+
+    tolerance: float
+        Allowed slowdown relative to the baseline, as a fraction
+
+    Returns
+    -------
+    tuple[list[str], bool]
+        A line describing each measurement, and whether any regressed
+
+    """
+    lines = []
+    regressed = False
+    for name, value in sorted(measurements.items()):
+        line = f"{name}: {value:.6g}s"
+        if name in baseline and baseline[name] > 0:
+            ratio = value / baseline[name]
+            line += f" ({ratio:.2f}x of baseline {baseline[name]:.6g}s)"
+            if ratio > 1 + tolerance:
+                line += " REGRESSED"
+                regressed = True
+        else:
+            line += " (no baseline)"
+        lines.append(line)
+    return lines, regressed
+
+
+class PerfStage(TestStage):
+    """A base for test stages that run the configured benchmarks serially
+    on fixed resources, and fail the benchmarks that got slower than the
+    baseline by more than the allowed tolerance.
+
+    Subclasses decide the resources through ``shard_args`` for benchmarks
+    run with the legate driver, and ``gbench_args`` for Google Benchmark
+    binaries.
+
+    Scripts that report their own measurements, like the OSU-style
+    collective benchmarks, are measured by what they report. Other scripts
+    are measured by their wall-clock time.
+
+    """
+
+    kind: FeatureType = "perf"
+
+    args: ArgList = []
+
+    #: Measurements of all benchmarks in seconds, after the stage completes
+    measurements: dict[str, float]
+
+    def gbench_launcher(self, shard: Shard, config: Config) -> ArgList:
+        """Generate the command that Google Benchmark binaries are started
+        with, which takes the place of the binding the legate driver does
+        for scripts. By default, the binaries are started directly.
+
+        Parameters
+        ----------
+        shard: Shard
+            The shard to be used for the benchmark
+
+        config: Config
+            Test runner configuration
+
+        """
+        return []
+
+    def gbench_args(self, shard: Shard, config: Config) -> ArgList:
+        """Generate the Legion command line arguments for Google Benchmark
+        binaries, which aren't started with the legate driver.
+
+        Parameters
+        ----------
+        shard: Shard
+            The shard to be used for the benchmark
+
+        config: Config
+            Test runner configuration
+
+        """
+        return ["-ll:cpu", str(config.cpus), "-ll:util", str(config.utility)]
+
+    def measure(
+        self,
+        bench: PerfBenchmark,
+        shard: Shard,
+        config: Config,
+        system: TestSystem,
+    ) -> tuple[ProcessResult, dict[str, float]]:
+        """Run a benchmark once and collect its measurements.
+
+        Parameters
+        ----------
+        bench: PerfBenchmark
+            The benchmark to run
+
+        shard: Shard
+            The shard to be used for the benchmark
+
+        config: Config
+            Test runner configuration
+
+        system: TestSystem
+            Process execution wrapper
+
+        """
+        path = config.root_dir / bench.file
+        test_file = Path(bench.name)
+        env = self._env(config, system)
+
+        if not bench.gbench:
+            cmd = [str(config.legate_path), str(path)]
+            cmd += self.shard_args(shard, config) + config.extra_args
+            cmd += bench.args
+            t0 = time.perf_counter()
+            result = system.run(cmd, test_file, env=env)
+            t1 = time.perf_counter()
+            if bench.osu:
+                return result, parse_osu_output(bench.name, result.output)
+            return result, {bench.name: t1 - t0}
+
+        measurements: dict[str, float] = {}
+        with tempfile.TemporaryDirectory() as tmp:
+            out = Path(tmp) / "gbench.json"
+            cmd = self.gbench_launcher(shard, config) + [
+                str(path),
+                f"--benchmark_out={out}",
+                "--benchmark_out_format=json",
+            ]
+            cmd += self.gbench_args(shard, config) + bench.args
+            result = system.run(cmd, test_file, env=env)
+            if result.returncode != 0 or not out.exists():
+                return result, measurements
+            with open(out) as f:
+                data = json.load(f)
+
+        for entry in data["benchmarks"]:
+            # Skip the aggregates that --benchmark_repetitions adds
+            if entry.get("run_type", "iteration") != "iteration":
+                continue
+            unit = GBENCH_TIME_UNITS[entry["time_unit"]]
+            name = f"{bench.name}/{entry['name']}"
+            measurements[name] = entry["real_time"] * unit
+        return result, measurements
+
+    def run_benchmark(
+        self,
+        bench: PerfBenchmark,
+        baseline: dict[str, float],
+        config: Config,
+        system: TestSystem,
+    ) -> ProcessResult:
+        """Run a benchmark the configured number of times and compare its
+        fastest measurements against the baseline.
+
+        Parameters
+        ----------
+        bench: PerfBenchmark
+            The benchmark to run
+
+        baseline: dict[str, float]
+            Measurements to compare against
+
+        config: Config
+            Test runner configuration
+
+        system: TestSystem
+            Process execution wrapper
+
+        """
+        path = config.root_dir / bench.file
+        if not config.dry_run and not path.exists():
+            result = ProcessResult(str(path), Path(bench.name), skipped=True)
+            log_proc(self.name, result, config, verbose=config.verbose)
+            return result
+
+        shard = self.shards.get()
+
+        best: dict[str, float] = {}
+        for _ in range(max(config.perf_repeat, 1)):
+            result, current = self.measure(bench, shard, config, system)
+            if result.skipped or result.returncode != 0:
+                break
+            for name, value in current.items():
+                best[name] = min(best.get(name, value), value)
+
+        self.shards.put(shard)
+
+        if not result.skipped and result.returncode == 0:
+            self.measurements.update(best)
+            tolerance = (
+                config.perf_tolerance
+                if bench.tolerance is None
+                else bench.tolerance
+            )
+            lines, regressed = compare(best, baseline, tolerance)
+            result.output = "\n".join(lines)
+            if regressed:
+                result.returncode = 1
+
+        log_proc(self.name, result, config, verbose=config.verbose)
+
+        return result
+
+    def _launch(
+        self, config: Config, system: TestSystem
+    ) -> list[ProcessResult]:
+        baseline = load_baseline(config)
+
+        self.measurements = {}
+
+        # Benchmarks run one at a time so that they don't interfere
+        results = [
+            self.run_benchmark(bench, baseline, config, system)
+            for bench in PERF_BENCHMARKS
+        ]
+
+        if not config.dry_run:
+            save_results(config, self.measurements)
+
+        return results
@@ -14,4 +14,4 @@
 #
 from __future__ import annotations
 
-from legate.timing.timing import time
+from legate.timing.timing import TaskTimes, Timer, time
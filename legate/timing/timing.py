@@ -15,15 +15,38 @@
 from __future__ import annotations
 
 import struct
-from typing import TYPE_CHECKING, Any, Optional, Type, Union
+from types import TracebackType
+from typing import (
+    TYPE_CHECKING,
+    Any,
+    Iterator,
+    Optional,
+    Sequence,
+    Type,
+    Union,
+)
 
 import numpy
 
-from ..core import Future, get_legion_context, get_legion_runtime, legion
+from ..core import (
+    Future,
+    FutureMap,
+    Point,
+    Rect,
+    ReductionOp,
+    ffi,
+    get_legate_runtime,
+    get_legion_context,
+    get_legion_runtime,
+    legion,
+    uint64,
+)
 
 if TYPE_CHECKING:
     import pyarrow
 
+    from ..core.operation import Task
+
 
 class TimingRuntime:
     def __init__(self) -> None:
@@ -52,6 +75,30 @@ class TimingRuntime:
             )
         )
 
+    def measure(
+        self, units: str, preconditions: Sequence[Future] = ()
+    ) -> Future:
+        # The measurement is taken once the preconditions are complete,
+        # without fencing the operations issued before or after it
+        core_library = get_legate_runtime().core_library
+        unit = {
+            "s": core_library.LEGATE_CORE_TIMING_SECONDS,
+            "us": core_library.LEGATE_CORE_TIMING_MICROSECONDS,
+            "ns": core_library.LEGATE_CORE_TIMING_NANOSECONDS,
+        }[units]
+        handles = ffi.new(
+            "legion_future_t[]", [future.handle for future in preconditions]
+        )
+        return Future(
+            core_library.legate_issue_timing_op(
+                self.runtime,
+                self.context,
+                unit,
+                handles,
+                len(preconditions),
+            )
+        )
+
 
 class Time:
     def __init__(self, future: Future, dtype: Any) -> None:
@@ -138,18 +185,182 @@ class Time:
         return self.value
 
 
+def _check_units(units: str) -> Any:
+    if units == "s":
+        return numpy.float64
+    elif units == "us" or units == "ns":
+        return numpy.int64
+    else:
+        raise ValueError('time units must be one of "s", "us", or "ns"')
+
+
+class TaskTimes:
+    """
+    The time each point of a task launch took to execute, in nanoseconds.
+    GPU variants report the time their work took on the device. None of
+    the times are waited on until their values are read.
+    """
+
+    def __init__(
+        self,
+        name: str,
+        timings: Union[Future, FutureMap],
+        launch_domain: Optional[Rect],
+    ) -> None:
+        self._name = name
+        self._timings = timings
+        self._launch_domain = launch_domain
+        self._max: Optional[Time] = None
+
+    @property
+    def name(self) -> str:
+        return self._name
+
+    @property
+    def launch_domain(self) -> Optional[Rect]:
+        return self._launch_domain
+
+    def __len__(self) -> int:
+        if self._launch_domain is None:
+            return 1
+        return self._launch_domain.get_volume()
+
+    def __getitem__(self, point: Union[int, Sequence[int], Point]) -> Time:
+        if isinstance(self._timings, Future):
+            return Time(self._timings, numpy.int64)
+        if not isinstance(point, Point):
+            point = Point([point] if isinstance(point, int) else point)
+        return Time(self._timings.get_future(point), numpy.int64)
+
+    def __iter__(self) -> Iterator[Time]:
+        if self._launch_domain is None:
+            yield self[0]
+        else:
+            for point in self._launch_domain:
+                yield self[point]
+
+    def values(self) -> list[int]:
+        """
+        Waits for all points and returns their times in the launch order
+        """
+        return [int(time) for time in self]
+
+    def max(self) -> Time:
+        """
+        Returns the time the slowest point took, which is the time the launch
+        took once all of its points started together
+        """
+        if self._max is None:
+            if isinstance(self._timings, Future):
+                future = self._timings
+            else:
+                runtime = get_legate_runtime()
+                redop = runtime.core_context.type_system[
+                    uint64
+                ].reduction_op_id(ReductionOp.MAX)
+                future = runtime.reduce_future_map(self._timings, redop)
+            self._max = Time(future, numpy.int64)
+        return self._max
+
+    def __repr__(self) -> str:
+        return f"TaskTimes({self._name}, points={len(self)})"
+
+
+class Timer:
+    """
+    Times the operations issued in a region of code without fencing them
+    from the operations issued before or after. The region starts when the
+    timer is entered and ends once all tasks issued inside it finished;
+    the time each of these tasks took is recorded as well.
+
+    ::
+
+        with legate.timing.Timer("us") as timer:
+            ...
+        print(timer.elapsed, [t.values() for t in timer.tasks])
+
+    Copies and fills issued in the region do not hold back its end.
+    """
+
+    def __init__(self, units: str = "us") -> None:
+        self._units = units
+        self._dtype = _check_units(units)
+        self._tasks: list[TaskTimes] = []
+        self._start: Optional[Time] = None
+        self._stop: Optional[Time] = None
+
+    def __enter__(self) -> Timer:
+        runtime = get_legate_runtime()
+        runtime.push_task_timer(self)
+        self._start = Time(_timing.measure(self._units), self._dtype)
+        return self
+
+    def __exit__(
+        self,
+        exc_type: Optional[Type[BaseException]],
+        exc_value: Optional[BaseException],
+        traceback: Optional[TracebackType],
+    ) -> None:
+        runtime = get_legate_runtime()
+        runtime.pop_task_timer()
+        # The slowest point of a launch finishes last, so its time is ready
+        # only when the whole launch is done
+        preconditions = [task.max().future for task in self._tasks]
+        self._stop = Time(
+            _timing.measure(self._units, preconditions), self._dtype
+        )
+
+    def record(
+        self,
+        task: Task,
+        timings: Union[Future, FutureMap],
+        launch_domain: Optional[Rect],
+    ) -> None:
+        self._tasks.append(TaskTimes(task.get_name(), timings, launch_domain))
+
+    @property
+    def tasks(self) -> list[TaskTimes]:
+        return self._tasks
+
+    @property
+    def start(self) -> Time:
+        if self._start is None:
+            raise RuntimeError("Timer has not been entered")
+        return self._start
+
+    @property
+    def stop(self) -> Time:
+        if self._stop is None:
+            raise RuntimeError("Timer has not been exited")
+        return self._stop
+
+    @property
+    def elapsed(self) -> Union[int, float]:
+        """
+        Waits for the region to finish and returns the time it took
+        """
+        return self.stop.get_value() - self.start.get_value()
+
+
 _timing = TimingRuntime()
 
 
-def time(units: str = "us") -> Time:
+def time(units: str = "us", fence: bool = True) -> Time:
+    """
+    Returns the current time. By default, the time is taken after all
+    operations issued so far finished, which keeps the operations issued
+    afterwards from starting until then. With ``fence=False``, the time
+    is taken right away and nothing is held back.
+    """
+    dtype = _check_units(units)
+    if not fence:
+        return Time(_timing.measure(units), dtype)
     # Issue a Legion execution fence and then perform a timing operation
     # immediately after it
     _timing.issue_execution_fence()
     if units == "s":
-        return Time(_timing.measure_seconds(), numpy.float64)
+        return Time(_timing.measure_seconds(), dtype)
     elif units == "us":
-        return Time(_timing.measure_microseconds(), numpy.int64)
-    elif units == "ns":
-        return Time(_timing.measure_nanoseconds(), numpy.int64)
+        return Time(_timing.measure_microseconds(), dtype)
     else:
-        raise ValueError('time units must be one of "s", "us", or "ns"')
+        return Time(_timing.measure_nanoseconds(), dtype)
@@ -0,0 +1,219 @@
+# Copyright 2022 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+"""Reader for the mapping traces written when LEGATE_MAPPING_TRACE is set.
+
+Run ``python -m legate.util.mapping_trace legate_mapping.*.bin`` to print a
+summary of the instances the mappers created and where tasks ran.
+"""
+from __future__ import annotations
+
+import argparse
+import struct
+import sys
+from collections import Counter, defaultdict
+from dataclasses import dataclass
+from enum import IntEnum
+from pathlib import Path
+from typing import Iterable, Iterator, NamedTuple
+
+__all__ = (
+    "Event",
+    "EventKind",
+    "MappingTrace",
+    "read_trace",
+    "summarize",
+)
+
+_MAGIC = b"LGMAPTRC"
+_VERSION = 1
+_HEADER = struct.Struct("=8sIIQ")
+_EVENT = struct.Struct("=QQQQQII")
+
+
+class EventKind(IntEnum):
+    """Kinds of the mapping events, matching core/mapping/mapping_trace.h"""
+
+    INSTANCE_CREATED = 0
+    INSTANCE_REUSED = 1
+    INSTANCE_FAILED = 2
+    INSTANCE_EVICTED = 3
+    SOURCE_SELECTED = 4
+    TASK_SLICED = 5
+    VARIANT_SELECTED = 6
+
+
+class Event(NamedTuple):
+    """One mapping decision. The meaning of the fields depends on the kind,
+    as documented in core/mapping/mapping_trace.h"""
+
+    time: int
+    operation: int
+    resource: int
+    instance: int
+    value: int
+    kind: int
+    extra: int
+
+
+@dataclass(frozen=True)
+class MappingTrace:
+    """The events the mappers of one process recorded, in the order each
+    thread recorded them"""
+
+    path: Path
+    node: int
+    events: list[Event]
+
+    def of_kind(self, kind: EventKind) -> list[Event]:
+        return [event for event in self.events if event.kind == kind]
+
+
+def read_trace(path: str | Path) -> MappingTrace:
+    """Read a mapping trace file
+
+    Parameters
+    ----------
+    path : str or Path
+        Location of a file written by a process run with LEGATE_MAPPING_TRACE
+
+    Returns
+    -------
+        MappingTrace
+
+    """
+    path = Path(path)
+    with open(path, "rb") as f:
+        header = f.read(_HEADER.size)
+        if len(header) < _HEADER.size:
+            raise ValueError(f"{path} is not a mapping trace")
+        magic, version, event_size, node = _HEADER.unpack(header)
+        if magic != _MAGIC:
+            raise ValueError(f"{path} is not a mapping trace")
+        if version != _VERSION or event_size != _EVENT.size:
+            raise ValueError(
+                f"{path} has an unsupported mapping trace version {version}"
+            )
+        data = f.read()
+    # A process that didn't shut down cleanly may have left a partial event
+    data = data[: len(data) - len(data) % _EVENT.size]
+    events = [Event(*fields) for fields in _EVENT.iter_unpack(data)]
+    return MappingTrace(path, node, events)
+
+
+def _format_bytes(size: float) -> str:
+    for unit in ("B", "KiB", "MiB", "GiB"):
+        if size < 1024:
+            return f"{size:.1f} {unit}" if unit != "B" else f"{size:.0f} B"
+        size /= 1024
+    return f"{size:.1f} TiB"
+
+
+def _per_memory(trace: MappingTrace, kind: EventKind) -> dict[int, list[int]]:
+    # Number of events and total bytes for each memory
+    result: dict[int, list[int]] = defaultdict(lambda: [0, 0])
+    for event in trace.of_kind(kind):
+        entry = result[event.resource]
+        entry[0] += 1
+        entry[1] += event.value
+    return result
+
+
+def summarize(traces: Iterable[MappingTrace], top: int = 10) -> Iterator[str]:
+    """Yield the lines of a human-readable summary of mapping traces"""
+    for trace in traces:
+        yield f"{trace.path} (node {trace.node}): {len(trace.events)} events"
+
+        created = _per_memory(trace, EventKind.INSTANCE_CREATED)
+        reused = _per_memory(trace, EventKind.INSTANCE_REUSED)
+        evicted = _per_memory(trace, EventKind.INSTANCE_EVICTED)
+        failed = Counter(
+            event.resource
+            for event in trace.of_kind(EventKind.INSTANCE_FAILED)
+        )
+        yield "  Instances per memory:"
+        yield (
+            f"    {'memory':>18} {'created':>8} {'bytes':>11} {'reused':>8} "
+            f"{'evicted':>8} {'failed':>7}"
+        )
+        memories = sorted(
+            set(created) | set(reused) | set(evicted) | set(failed)
+        )
+        for memory in memories:
+            num_created, created_bytes = created.get(memory, [0, 0])
+            yield (
+                f"    {memory:#18x} {num_created:>8} "
+                f"{_format_bytes(created_bytes):>11} "
+                f"{reused.get(memory, [0, 0])[0]:>8} "
+                f"{evicted.get(memory, [0, 0])[0]:>8} {failed[memory]:>7}"
+            )
+
+        creations = Counter(
+            event.operation
+            for event in trace.of_kind(EventKind.INSTANCE_CREATED)
+        )
+        if len(creations) > 0:
+            yield "  Operations creating the most instances:"
+            for op, count in creations.most_common(top):
+                yield f"    {op:>18} {count:>8}"
+
+        # Source events hold the target memory as the resource and the
+        # source memory as the value
+        copies = Counter(
+            (event.value, event.resource)
+            for event in trace.of_kind(EventKind.SOURCE_SELECTED)
+            if event.value != event.resource
+        )
+        if len(copies) > 0:
+            yield "  Most frequent copies between memories:"
+            for (src, dst), count in copies.most_common(top):
+                yield f"    {src:#18x} -> {dst:#18x} {count:>8}"
+
+        slices = Counter(
+            event.resource for event in trace.of_kind(EventKind.TASK_SLICED)
+        )
+        if len(slices) > 0:
+            yield "  Points per processor:"
+            for proc, count in sorted(slices.items()):
+                yield f"    {proc:#18x} {count:>8}"
+
+        choices = Counter(
+            (event.value, event.extra)
+            for event in trace.of_kind(EventKind.VARIANT_SELECTED)
+        )
+        if len(choices) > 0:
+            yield "  Variants chosen per task:"
+            for (task, variant), count in sorted(choices.items()):
+                yield f"    task {task:>10} variant {variant:>3} {count:>8}"
+
+
+def main(argv: list[str] | None = None) -> int:
+    parser = argparse.ArgumentParser(
+        description="Summarize the mapping traces of a Legate run"
+    )
+    parser.add_argument("files", nargs="+", help="mapping trace files")
+    parser.add_argument(
+        "--top",
+        type=int,
+        default=10,
+        help="number of entries to show in the rankings",
+    )
+    args = parser.parse_args(argv)
+    for line in summarize((read_trace(f) for f in args.files), args.top):
+        print(line)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -168,6 +168,14 @@ if(Legion_NETWORKS)
   list(APPEND legate_core_CUDA_DEFS LEGATE_USE_NETWORK)
 endif()
 
+option(legate_core_USE_ITT "Emit ITT ranges for Intel VTune" OFF)
+if(legate_core_USE_ITT)
+  find_path(ITT_INCLUDE_DIR ittnotify.h REQUIRED)
+  find_library(ITT_LIBRARY ittnotify REQUIRED)
+  list(APPEND legate_core_CXX_DEFS LEGATE_USE_ITT)
+  list(APPEND legate_core_CUDA_DEFS LEGATE_USE_ITT)
+endif()
+
 # Change THRUST_DEVICE_SYSTEM for `.cpp` files
 # TODO: This is what we do in cuNumeric, should we do it here as well?
 if(Legion_USE_OpenMP)
@@ -186,27 +194,41 @@ endif()
 list(APPEND legate_core_SOURCES
   src/core/legate_c.cc
   src/core/comm/comm.cc
+  src/core/comm/comm_bench.cc
   src/core/comm/comm_cpu.cc
   src/core/comm/coll.cc
+  src/core/comm/collectives.cc
+  src/core/comm/compressed_shuffle.cc
   src/core/data/allocator.cc
+  src/core/data/buffer_pool.cc
+  src/core/data/growable_buffer.cc
   src/core/data/scalar.cc
   src/core/data/store.cc
+  src/core/data/string_store.cc
   src/core/data/transform.cc
   src/core/mapping/base_mapper.cc
   src/core/mapping/core_mapper.cc
   src/core/mapping/instance_manager.cc
   src/core/mapping/mapping.cc
+  src/core/mapping/mapping_trace.cc
   src/core/mapping/operation.cc
+  src/core/mapping/variant_tuner.cc
   src/core/runtime/context.cc
+  src/core/runtime/launcher.cc
   src/core/runtime/projection.cc
   src/core/runtime/runtime.cc
   src/core/runtime/shard.cc
+  src/core/task/fusion.cc
   src/core/task/return.cc
   src/core/task/task.cc
+  src/core/task/task_stats.cc
+  src/core/utilities/buffer_builder.cc
   src/core/utilities/debug.cc
   src/core/utilities/deserializer.cc
   src/core/utilities/machine.cc
   src/core/utilities/linearize.cc
+  src/core/utilities/memory_usage.cc
+  src/core/utilities/trace.cc
 )
 
 if(Legion_NETWORKS)
@@ -221,7 +243,13 @@ endif()
 if(Legion_USE_CUDA)
   list(APPEND legate_core_SOURCES
     src/core/comm/comm_nccl.cu
-    src/core/cuda/stream_pool.cu)
+    src/core/comm/compressed_shuffle.cu
+    src/core/cuda/graph_cache.cu
+    src/core/cuda/stream_pool.cu
+    src/core/data/reduction.cu)
+else()
+  list(APPEND legate_core_SOURCES
+    src/core/data/reduction.cc)
 endif()
 
 add_library(legate_core ${legate_core_SOURCES})
@@ -264,6 +292,11 @@ target_link_libraries(legate_core
           $<TARGET_NAME_IF_EXISTS:MPI::MPI_CXX>
   PRIVATE $<TARGET_NAME_IF_EXISTS:NCCL::NCCL>)
 
+if(legate_core_USE_ITT)
+  target_include_directories(legate_core PUBLIC ${ITT_INCLUDE_DIR})
+  target_link_libraries(legate_core PUBLIC ${ITT_LIBRARY})
+endif()
+
 target_compile_options(legate_core
   PRIVATE "$<$<COMPILE_LANGUAGE:CXX>:${legate_core_CXX_OPTIONS}>"
           "$<$<COMPILE_LANGUAGE:CUDA>:${legate_core_CUDA_OPTIONS}>")
@@ -293,6 +326,23 @@ SECTIONS
   target_link_options(legate_core PRIVATE "${CMAKE_CURRENT_BINARY_DIR}/fatbin.ld")
 endif()
 
+##############################################################################
+# - benchmarks ---------------------------------------------------------------
+
+if(legate_core_BUILD_BENCHMARKS)
+  include(cmake/thirdparty/get_benchmark.cmake)
+  add_subdirectory(benchmarks)
+endif()
+
+##############################################################################
+# - tests --------------------------------------------------------------------
+
+if(legate_core_BUILD_TESTS)
+  include(cmake/thirdparty/get_gtest.cmake)
+  enable_testing()
+  add_subdirectory(tests/cpp)
+endif()
+
 ##############################################################################
 # - install targets-----------------------------------------------------------
 
@@ -317,22 +367,30 @@ install(
 
 install(
   FILES src/core/comm/coll.h
+        src/core/comm/collectives.h
         src/core/comm/communicator.h
         src/core/comm/pthread_barrier.h
   DESTINATION ${CMAKE_INSTALL_INCLUDEDIR}/legate/core/comm)
 
 install(
   FILES src/core/cuda/cuda_help.h
+        src/core/cuda/graph_cache.h
         src/core/cuda/stream_pool.h
   DESTINATION ${CMAKE_INSTALL_INCLUDEDIR}/legate/core/cuda)
 
 install(
   FILES src/core/data/allocator.h
         src/core/data/buffer.h
+        src/core/data/buffer_pool.h
+        src/core/data/buffer_pool.inl
+        src/core/data/growable_buffer.h
+        src/core/data/growable_buffer.inl
+        src/core/data/reduction.h
         src/core/data/scalar.h
         src/core/data/scalar.inl
         src/core/data/store.h
         src/core/data/store.inl
+        src/core/data/string_store.h
         src/core/data/transform.h
   DESTINATION ${CMAKE_INSTALL_INCLUDEDIR}/legate/core/data)
 
@@ -345,23 +403,30 @@ install(
 
 install(
   FILES src/core/runtime/context.h
+        src/core/runtime/launcher.h
         src/core/runtime/runtime.h
   DESTINATION ${CMAKE_INSTALL_INCLUDEDIR}/legate/core/runtime)
 
 install(
   FILES src/core/task/exception.h
+        src/core/task/fusion.h
         src/core/task/return.h
         src/core/task/task.h
+        src/core/task/task_stats.h
   DESTINATION ${CMAKE_INSTALL_INCLUDEDIR}/legate/core/task)
 
 install(
-  FILES src/core/utilities/debug.h
+  FILES src/core/utilities/buffer_builder.h
+        src/core/utilities/buffer_builder.inl
+        src/core/utilities/debug.h
         src/core/utilities/deserializer.h
         src/core/utilities/deserializer.inl
         src/core/utilities/dispatch.h
         src/core/utilities/machine.h
+        src/core/utilities/memory_usage.h
         src/core/utilities/nvtx_help.h
         src/core/utilities/span.h
+        src/core/utilities/trace.h
         src/core/utilities/type_traits.h
         src/core/utilities/typedefs.h
   DESTINATION ${CMAKE_INSTALL_INCLUDEDIR}/legate/core/utilities)
@@ -19,8 +19,14 @@
 #include <pthread.h>
 #include <stdio.h>
 #include <string.h>
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 
 #ifndef LEGATE_USE_NETWORK
@@ -28,6 +34,7 @@
 #endif
 
 #include "coll.h"
+#include "core/utilities/trace.h"
 #include "legate.h"
 #include "legion.h"
 
@@ -51,7 +58,65 @@ int collCommCreate(CollComm global_comm,
     global_comm, global_comm_size, global_rank, unique_id, mapping_table);
 }
 
-int collCommDestroy(CollComm global_comm) { return backend_network->comm_destroy(global_comm); }
+// A persistent thread that runs the non-blocking collectives of one communicator in the order
+// they were submitted. The threads aren't shared between communicators, as the ranks of a
+// local communicator block on each other and must make progress concurrently.
+class ProgressThread {
+ public:
+  ProgressThread() : thread_([this]() { run(); }) {}
+  ~ProgressThread()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      done_ = true;
+    }
+    cv_.notify_one();
+    thread_.join();
+  }
+
+ public:
+  template <typename Functor>
+  std::future<int> submit(Functor&& functor)
+  {
+    std::packaged_task<int()> work(std::forward<Functor>(functor));
+    auto result = work.get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pending_.push_back(std::move(work));
+    }
+    cv_.notify_one();
+    return result;
+  }
+
+ private:
+  void run()
+  {
+    while (true) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [&]() { return done_ || !pending_.empty(); });
+      if (pending_.empty()) return;
+      auto work = std::move(pending_.front());
+      pending_.pop_front();
+      lock.unlock();
+      work();
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::packaged_task<int()>> pending_;
+  bool done_{false};
+  // Must come last, as the thread uses the other members
+  std::thread thread_;
+};
+
+int collCommDestroy(CollComm global_comm)
+{
+  delete global_comm->progress_thread;
+  global_comm->progress_thread = nullptr;
+  return backend_network->comm_destroy(global_comm);
+}
 
 int collAlltoallv(const void* sendbuf,
                   const int sendcounts[],
@@ -62,6 +127,7 @@ int collAlltoallv(const void* sendbuf,
                   CollDataType type,
                   CollComm global_comm)
 {
+  trace::Range auto_range("legate::coll::alltoallv");
   // IN_PLACE
   if (sendbuf == recvbuf) {
     log_coll.error("Do not support inplace Alltoallv");
@@ -84,6 +150,7 @@ int collAlltoallv(const void* sendbuf,
 int collAlltoall(
   const void* sendbuf, void* recvbuf, int count, CollDataType type, CollComm global_comm)
 {
+  trace::Range auto_range("legate::coll::alltoall");
   // IN_PLACE
   if (sendbuf == recvbuf) {
     log_coll.error("Do not support inplace Alltoall");
@@ -105,6 +172,7 @@ int collAlltoall(
 int collAllgather(
   const void* sendbuf, void* recvbuf, int count, CollDataType type, CollComm global_comm)
 {
+  trace::Range auto_range("legate::coll::allgather");
   log_coll.debug(
     "Allgather: global_rank %d, mpi_rank %d, unique_id %d, comm_size %d, "
     "mpi_comm_size %d %d, nb_threads %d",
@@ -118,6 +186,141 @@ int collAllgather(
   return backend_network->allgather(sendbuf, recvbuf, count, type, global_comm);
 }
 
+int collAllreduce(const void* sendbuf,
+                  void* recvbuf,
+                  int count,
+                  CollDataType type,
+                  CollRedOp redop,
+                  CollComm global_comm)
+{
+  trace::Range auto_range("legate::coll::allreduce");
+  log_coll.debug(
+    "Allreduce: global_rank %d, mpi_rank %d, unique_id %d, comm_size %d, "
+    "mpi_comm_size %d %d, nb_threads %d",
+    global_comm->global_rank,
+    global_comm->mpi_rank,
+    global_comm->unique_id,
+    global_comm->global_comm_size,
+    global_comm->mpi_comm_size,
+    global_comm->mpi_comm_size_actual,
+    global_comm->nb_threads);
+  return backend_network->allreduce(sendbuf, recvbuf, count, type, redop, global_comm);
+}
+
+int collReduceScatter(const void* sendbuf,
+                      void* recvbuf,
+                      int recvcount,
+                      CollDataType type,
+                      CollRedOp redop,
+                      CollComm global_comm)
+{
+  trace::Range auto_range("legate::coll::reduce_scatter");
+  // IN_PLACE
+  if (sendbuf == recvbuf) {
+    log_coll.error("Do not support inplace ReduceScatter");
+    LEGATE_ABORT;
+  }
+  log_coll.debug(
+    "ReduceScatter: global_rank %d, mpi_rank %d, unique_id %d, comm_size %d, "
+    "mpi_comm_size %d %d, nb_threads %d",
+    global_comm->global_rank,
+    global_comm->mpi_rank,
+    global_comm->unique_id,
+    global_comm->global_comm_size,
+    global_comm->mpi_comm_size,
+    global_comm->mpi_comm_size_actual,
+    global_comm->nb_threads);
+  return backend_network->reduce_scatter(sendbuf, recvbuf, recvcount, type, redop, global_comm);
+}
+
+template <typename Functor>
+static int startRequest(CollComm global_comm, CollRequest* request, Functor&& functor)
+{
+  if (nullptr == global_comm->progress_thread) global_comm->progress_thread = new ProgressThread();
+  *request = new Coll_Request{global_comm,
+                              global_comm->progress_thread->submit(std::forward<Functor>(functor))};
+  return CollSuccess;
+}
+
+int collIalltoallv(const void* sendbuf,
+                   const int sendcounts[],
+                   const int sdispls[],
+                   void* recvbuf,
+                   const int recvcounts[],
+                   const int rdispls[],
+                   CollDataType type,
+                   CollComm global_comm,
+                   CollRequest* request)
+{
+  return startRequest(global_comm, request, [=]() {
+    return collAlltoallv(
+      sendbuf, sendcounts, sdispls, recvbuf, recvcounts, rdispls, type, global_comm);
+  });
+}
+
+int collIalltoall(const void* sendbuf,
+                  void* recvbuf,
+                  int count,
+                  CollDataType type,
+                  CollComm global_comm,
+                  CollRequest* request)
+{
+  return startRequest(global_comm, request, [=]() {
+    return collAlltoall(sendbuf, recvbuf, count, type, global_comm);
+  });
+}
+
+int collIallgather(const void* sendbuf,
+                   void* recvbuf,
+                   int count,
+                   CollDataType type,
+                   CollComm global_comm,
+                   CollRequest* request)
+{
+  return startRequest(global_comm, request, [=]() {
+    return collAllgather(sendbuf, recvbuf, count, type, global_comm);
+  });
+}
+
+int collIallreduce(const void* sendbuf,
+                   void* recvbuf,
+                   int count,
+                   CollDataType type,
+                   CollRedOp redop,
+                   CollComm global_comm,
+                   CollRequest* request)
+{
+  return startRequest(global_comm, request, [=]() {
+    return collAllreduce(sendbuf, recvbuf, count, type, redop, global_comm);
+  });
+}
+
+int collIreduceScatter(const void* sendbuf,
+                       void* recvbuf,
+                       int recvcount,
+                       CollDataType type,
+                       CollRedOp redop,
+                       CollComm global_comm,
+                       CollRequest* request)
+{
+  return startRequest(global_comm, request, [=]() {
+    return collReduceScatter(sendbuf, recvbuf, recvcount, type, redop, global_comm);
+  });
+}
+
+int collTest(CollRequest request, bool* done)
+{
+  *done = request->result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+  return CollSuccess;
+}
+
+int collWait(CollRequest request)
+{
+  int result = request->result.get();
+  delete request;
+  return result;
+}
+
 // called from main thread
 int collInit(int argc, char* argv[])
 {
@@ -163,6 +366,148 @@ void* BackendNetwork::allocateInplaceBuffer(const void* recvbuf, size_t size)
   return sendbuf_tmp;
 }
 
+size_t BackendNetwork::getDtypeSize(CollDataType dtype)
+{
+  switch (dtype) {
+    case CollDataType::CollInt8:
+    case CollDataType::CollChar: {
+      return sizeof(char);
+    }
+    case CollDataType::CollUint8: {
+      return sizeof(uint8_t);
+    }
+    case CollDataType::CollInt: {
+      return sizeof(int);
+    }
+    case CollDataType::CollUint32: {
+      return sizeof(uint32_t);
+    }
+    case CollDataType::CollInt64: {
+      return sizeof(int64_t);
+    }
+    case CollDataType::CollUint64: {
+      return sizeof(uint64_t);
+    }
+    case CollDataType::CollFloat: {
+      return sizeof(float);
+    }
+    case CollDataType::CollDouble: {
+      return sizeof(double);
+    }
+    case CollDataType::CollInt16: {
+      return sizeof(int16_t);
+    }
+    case CollDataType::CollUint16: {
+      return sizeof(uint16_t);
+    }
+    case CollDataType::CollHalf: {
+      return sizeof(__half);
+    }
+    default: {
+      log_coll.fatal("Unknown datatype");
+      LEGATE_ABORT;
+      return 0;
+    }
+  }
+}
+
+template <typename T>
+static void reduce_typed(T* dst, const T* src, int count, CollRedOp redop)
+{
+  switch (redop) {
+    case CollRedOp::CollSum: {
+      for (int i = 0; i < count; i++) dst[i] = dst[i] + src[i];
+      break;
+    }
+    case CollRedOp::CollProd: {
+      for (int i = 0; i < count; i++) dst[i] = dst[i] * src[i];
+      break;
+    }
+    case CollRedOp::CollMax: {
+      for (int i = 0; i < count; i++) dst[i] = std::max(dst[i], src[i]);
+      break;
+    }
+    case CollRedOp::CollMin: {
+      for (int i = 0; i < count; i++) dst[i] = std::min(dst[i], src[i]);
+      break;
+    }
+    default: {
+      log_coll.fatal("Unknown reduction operator");
+      LEGATE_ABORT;
+    }
+  }
+}
+
+// The host has no half-precision arithmetic, so half values are reduced in single precision
+static void reduce_half(__half* dst, const __half* src, int count, CollRedOp redop)
+{
+  for (int i = 0; i < count; i++) {
+    float lhs = static_cast<float>(dst[i]);
+    float rhs = static_cast<float>(src[i]);
+    reduce_typed(&lhs, &rhs, 1, redop);
+    dst[i] = static_cast<__half>(lhs);
+  }
+}
+
+void BackendNetwork::reduceBuffer(
+  void* dst, const void* src, int count, CollDataType type, CollRedOp redop)
+{
+  switch (type) {
+    case CollDataType::CollInt8: {
+      reduce_typed(static_cast<int8_t*>(dst), static_cast<const int8_t*>(src), count, redop);
+      break;
+    }
+    case CollDataType::CollChar: {
+      reduce_typed(static_cast<char*>(dst), static_cast<const char*>(src), count, redop);
+      break;
+    }
+    case CollDataType::CollUint8: {
+      reduce_typed(static_cast<uint8_t*>(dst), static_cast<const uint8_t*>(src), count, redop);
+      break;
+    }
+    case CollDataType::CollInt: {
+      reduce_typed(static_cast<int*>(dst), static_cast<const int*>(src), count, redop);
+      break;
+    }
+    case CollDataType::CollUint32: {
+      reduce_typed(static_cast<uint32_t*>(dst), static_cast<const uint32_t*>(src), count, redop);
+      break;
+    }
+    case CollDataType::CollInt64: {
+      reduce_typed(static_cast<int64_t*>(dst), static_cast<const int64_t*>(src), count, redop);
+      break;
+    }
+    case CollDataType::CollUint64: {
+      reduce_typed(static_cast<uint64_t*>(dst), static_cast<const uint64_t*>(src), count, redop);
+      break;
+    }
+    case CollDataType::CollFloat: {
+      reduce_typed(static_cast<float*>(dst), static_cast<const float*>(src), count, redop);
+      break;
+    }
+    case CollDataType::CollDouble: {
+      reduce_typed(static_cast<double*>(dst), static_cast<const double*>(src), count, redop);
+      break;
+    }
+    case CollDataType::CollInt16: {
+      reduce_typed(static_cast<int16_t*>(dst), static_cast<const int16_t*>(src), count, redop);
+      break;
+    }
+    case CollDataType::CollUint16: {
+      reduce_typed(static_cast<uint16_t*>(dst), static_cast<const uint16_t*>(src), count, redop);
+      break;
+    }
+    case CollDataType::CollHalf: {
+      reduce_half(static_cast<__half*>(dst), static_cast<const __half*>(src), count, redop);
+      break;
+    }
+    default: {
+      log_coll.fatal("Unknown datatype");
+      LEGATE_ABORT;
+    }
+  }
+}
+
 }  // namespace coll
 }  // namespace comm
 }  // namespace legate
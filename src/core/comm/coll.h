@@ -18,6 +18,9 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <future>
+#include <mutex>
 #include <vector>
 
 #ifdef LEGATE_USE_NETWORK
@@ -50,6 +53,14 @@ struct ThreadComm {
   bool ready_flag;
   const void** buffers;
   const int** displs;
+  void** recvbuffers;
+  // Used by LocalNetwork to synchronize the collectives: each rank bumps its entry of
+  // 'ready_epochs' once its buffers are published, and the last rank to finish a collective
+  // advances 'done_epoch'. Both only move forward, so no reset rounds are needed.
+  volatile uint32_t* ready_epochs;
+  volatile uint32_t done_count;
+  volatile uint32_t done_epoch;
+  volatile int num_waiters;
 };
 
 enum class CollDataType : int {
@@ -62,6 +73,16 @@ enum class CollDataType : int {
   CollUint64 = 6,
   CollFloat  = 7,
   CollDouble = 8,
+  CollInt16  = 9,
+  CollUint16 = 10,
+  CollHalf   = 11,
+};
+
+enum class CollRedOp : int {
+  CollSum  = 0,
+  CollProd = 1,
+  CollMax  = 2,
+  CollMin  = 3,
 };
 
 enum CollStatus : int {
@@ -74,6 +95,8 @@ enum CollCommType : int {
   CollLocal = 1,
 };
 
+class ProgressThread;
+
 struct Coll_Comm {
 #ifdef LEGATE_USE_NETWORK
   MPI_Comm mpi_comm;
@@ -88,10 +111,24 @@ struct Coll_Comm {
   int nb_threads;
   int unique_id;
   bool status;
+  // Runs the non-blocking collectives of this communicator. Created on the first request.
+  ProgressThread* progress_thread;
 };
 
 typedef Coll_Comm* CollComm;
 
+// A handle to a non-blocking collective, which runs on the communicator's progress thread so
+// that the caller can overlap the exchange with its own work. Requests on a communicator run
+// one at a time in the order they were started, so every rank must start them in the same
+// order. The communicator must not be used for blocking collectives until all of its
+// requests complete.
+struct Coll_Request {
+  CollComm global_comm;
+  std::future<int> result;
+};
+
+typedef Coll_Request* CollRequest;
+
 class BackendNetwork {
  public:
   BackendNetwork();
@@ -121,9 +158,30 @@ class BackendNetwork {
   virtual int allgather(
     const void* sendbuf, void* recvbuf, int count, CollDataType type, CollComm global_comm) = 0;
 
+  virtual int allreduce(const void* sendbuf,
+                        void* recvbuf,
+                        int count,
+                        CollDataType type,
+                        CollRedOp redop,
+                        CollComm global_comm) = 0;
+
+  // Reduces 'recvcount * global_comm_size' elements from each rank and scatters the result in
+  // blocks of 'recvcount' elements, such that rank i receives the i-th block
+  virtual int reduce_scatter(const void* sendbuf,
+                             void* recvbuf,
+                             int recvcount,
+                             CollDataType type,
+                             CollRedOp redop,
+                             CollComm global_comm) = 0;
+
  protected:
   int collGetUniqueId(int* id);
 
+  size_t getDtypeSize(CollDataType dtype);
+
+  // Reduces 'count' elements of the source buffer into the destination buffer
+  void reduceBuffer(void* dst, const void* src, int count, CollDataType type, CollRedOp redop);
+
   void* allocateInplaceBuffer(const void* recvbuf, size_t size);
 
  public:
@@ -166,7 +224,32 @@ class MPINetwork : public BackendNetwork {
   int allgather(
     const void* sendbuf, void* recvbuf, int count, CollDataType type, CollComm global_comm);
 
+  int allreduce(const void* sendbuf,
+                void* recvbuf,
+                int count,
+                CollDataType type,
+                CollRedOp redop,
+                CollComm global_comm);
+
+  int reduce_scatter(const void* sendbuf,
+                     void* recvbuf,
+                     int recvcount,
+                     CollDataType type,
+                     CollRedOp redop,
+                     CollComm global_comm);
+
  protected:
+  // Reduce-scatters the blocks of 'buffer' over the ring of all ranks. Each rank ends up with
+  // the reduction of block (rank + shift) % global_comm_size in its own buffer.
+  void ringReduceScatter(char* buffer,
+                         const int* offsets,
+                         MPI_Aint type_extent,
+                         CollDataType type,
+                         CollRedOp redop,
+                         int shift,
+                         int tag_base,
+                         CollComm global_comm);
+
   int gather(const void* sendbuf,
              void* recvbuf,
              int count,
@@ -186,10 +269,24 @@ class MPINetwork : public BackendNetwork {
 
   int generateGatherTag(int rank, CollComm global_comm);
 
+  int generateRingTag(int rank1, int rank2, int tag_base, CollComm global_comm);
+
+  // Synchronizes the ranks that live in the same process as the caller
+  void barrierLocal(CollComm global_comm);
+
+  ThreadComm* getThreadComm(int unique_id);
+
  private:
   int mpi_tag_ub;
   bool self_init_mpi;
+  // Maximum number of point-to-point exchanges in flight in alltoallv
+  int p2p_window;
   std::vector<MPI_Comm> mpi_comms;
+  // Used for exchanging data between ranks in the same process through shared memory. New
+  // communicators can be initialized while the ranks of others look theirs up, so accesses to
+  // the list go through the mutex.
+  std::vector<ThreadComm*> thread_comms;
+  std::mutex thread_comms_mutex;
 };
 #endif
 
@@ -224,19 +321,48 @@ class LocalNetwork : public BackendNetwork {
   int allgather(
     const void* sendbuf, void* recvbuf, int count, CollDataType type, CollComm global_comm);
 
+  int allreduce(const void* sendbuf,
+                void* recvbuf,
+                int count,
+                CollDataType type,
+                CollRedOp redop,
+                CollComm global_comm);
+
+  int reduce_scatter(const void* sendbuf,
+                     void* recvbuf,
+                     int recvcount,
+                     CollDataType type,
+                     CollRedOp redop,
+                     CollComm global_comm);
+
  protected:
-  size_t getDtypeSize(CollDataType dtype);
+  // Announces that this rank's buffers are published and returns the epoch of the
+  // current collective
+  uint32_t publishLocal(CollComm global_comm);
 
-  void resetLocalBuffer(CollComm global_comm);
+  // Waits until 'peer' has published its buffers for the collective in 'epoch'
+  void waitForPeer(CollComm global_comm, int peer, uint32_t epoch);
+
+  // Waits until every rank has finished the collective in 'epoch'
+  void completeLocal(CollComm global_comm, uint32_t epoch);
+
+  // Copies a segment out of a peer's buffer, using streaming stores for large segments
+  void copySegment(void* dst, const void* src, size_t bytes);
 
   void barrierLocal(CollComm global_comm);
 
  private:
   std::vector<ThreadComm*> thread_comms;
+  // segments of at least this many bytes are copied with non-temporal stores
+  size_t stream_threshold;
 };
 
 extern BackendNetwork* backend_network;
 
+// Copies 'bytes' bytes from 'src' to 'dst', with non-temporal stores when 'bytes' is at least
+// 'stream_threshold' and plain memcpy otherwise
+void streamCopy(void* dst, const void* src, size_t bytes, size_t stream_threshold);
+
 int collCommCreate(CollComm global_comm,
                    int global_comm_size,
                    int global_rank,
@@ -260,6 +386,68 @@ int collAlltoall(
 int collAllgather(
   const void* sendbuf, void* recvbuf, int count, CollDataType type, CollComm global_comm);
 
+int collAllreduce(const void* sendbuf,
+                  void* recvbuf,
+                  int count,
+                  CollDataType type,
+                  CollRedOp redop,
+                  CollComm global_comm);
+
+int collReduceScatter(const void* sendbuf,
+                      void* recvbuf,
+                      int recvcount,
+                      CollDataType type,
+                      CollRedOp redop,
+                      CollComm global_comm);
+
+// Non-blocking variants of the collectives above. The buffers must stay alive and untouched
+// until the request completes. The request is released by collWait.
+int collIalltoallv(const void* sendbuf,
+                   const int sendcounts[],
+                   const int sdispls[],
+                   void* recvbuf,
+                   const int recvcounts[],
+                   const int rdispls[],
+                   CollDataType type,
+                   CollComm global_comm,
+                   CollRequest* request);
+
+int collIalltoall(const void* sendbuf,
+                  void* recvbuf,
+                  int count,
+                  CollDataType type,
+                  CollComm global_comm,
+                  CollRequest* request);
+
+int collIallgather(const void* sendbuf,
+                   void* recvbuf,
+                   int count,
+                   CollDataType type,
+                   CollComm global_comm,
+                   CollRequest* request);
+
+int collIallreduce(const void* sendbuf,
+                   void* recvbuf,
+                   int count,
+                   CollDataType type,
+                   CollRedOp redop,
+                   CollComm global_comm,
+                   CollRequest* request);
+
+int collIreduceScatter(const void* sendbuf,
+                       void* recvbuf,
+                       int recvcount,
+                       CollDataType type,
+                       CollRedOp redop,
+                       CollComm global_comm,
+                       CollRequest* request);
+
+// Sets 'done' to true if the request has completed, without blocking
+int collTest(CollRequest request, bool* done);
+
+// Blocks until the request completes and returns the status of the collective
+int collWait(CollRequest request);
+
 int collInit(int argc, char* argv[]);
 
 int collFinalize();
@@ -0,0 +1,288 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/comm/collectives.h"
+#include "legate.h"
+
+#include "core/comm/coll.h"
+#ifdef LEGATE_USE_CUDA
+#include "core/comm/comm_nccl.h"
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace legate {
+namespace comm {
+
+static size_t type_size(LegateTypeCode code)
+{
+  switch (code) {
+    case BOOL_LT:
+    case INT8_LT:
+    case UINT8_LT: return 1;
+    case INT16_LT:
+    case UINT16_LT:
+    case HALF_LT: return 2;
+    case INT32_LT:
+    case UINT32_LT:
+    case FLOAT_LT: return 4;
+    case INT64_LT:
+    case UINT64_LT:
+    case DOUBLE_LT:
+    case COMPLEX64_LT: return 8;
+    case COMPLEX128_LT: return 16;
+    default: break;
+  }
+  log_legate.error("Unsupported type code %d for collectives", code);
+  LEGATE_ABORT;
+  return 0;
+}
+
+// Collectives that only move data do not care about the element type, so types that the
+// backends do not know about are sent as bytes
+static LegateTypeCode normalize_for_movement(LegateTypeCode code, size_t& scale)
+{
+  switch (code) {
+    case INT8_LT:
+    case UINT8_LT:
+    case INT32_LT:
+    case UINT32_LT:
+    case INT64_LT:
+    case UINT64_LT:
+    case FLOAT_LT:
+    case DOUBLE_LT: {
+      scale = 1;
+      return code;
+    }
+    default: break;
+  }
+  scale = type_size(code);
+  return UINT8_LT;
+}
+
+static coll::CollDataType to_coll_type(LegateTypeCode code)
+{
+  switch (code) {
+    case INT8_LT: return coll::CollDataType::CollInt8;
+    case UINT8_LT: return coll::CollDataType::CollUint8;
+    case INT16_LT: return coll::CollDataType::CollInt16;
+    case UINT16_LT: return coll::CollDataType::CollUint16;
+    case HALF_LT: return coll::CollDataType::CollHalf;
+    case INT32_LT: return coll::CollDataType::CollInt;
+    case UINT32_LT: return coll::CollDataType::CollUint32;
+    case INT64_LT: return coll::CollDataType::CollInt64;
+    case UINT64_LT: return coll::CollDataType::CollUint64;
+    case FLOAT_LT: return coll::CollDataType::CollFloat;
+    case DOUBLE_LT: return coll::CollDataType::CollDouble;
+    default: break;
+  }
+  log_legate.error("Type code %d is not supported by the CPU collectives", code);
+  LEGATE_ABORT;
+  return coll::CollDataType::CollInt8;
+}
+
+static coll::CollRedOp to_coll_op(CollectiveOp op)
+{
+  switch (op) {
+    case CollectiveOp::SUM: return coll::CollRedOp::CollSum;
+    case CollectiveOp::PROD: return coll::CollRedOp::CollProd;
+    case CollectiveOp::MAX: return coll::CollRedOp::CollMax;
+    case CollectiveOp::MIN: return coll::CollRedOp::CollMin;
+  }
+  LEGATE_ABORT;
+  return coll::CollRedOp::CollSum;
+}
+
+Collectives::Collectives(const Communicator& comm)
+  : comm_(comm),
+    use_nccl_(Legion::Processor::get_executing_processor().kind() == Legion::Processor::TOC_PROC)
+{
+#ifndef LEGATE_USE_CUDA
+  if (use_nccl_) {
+    log_legate.error("Legate was built without CUDA support");
+    LEGATE_ABORT;
+  }
+#endif
+}
+
+Collectives::~Collectives() { flush(); }
+
+void Collectives::allreduce(
+  const void* sendbuf, void* recvbuf, size_t count, LegateTypeCode code, CollectiveOp op)
+{
+#ifdef LEGATE_USE_CUDA
+  if (use_nccl_) {
+    nccl::allreduce(comm_, sendbuf, recvbuf, count, code, op);
+    return;
+  }
+#endif
+  coll::collAllreduce(sendbuf,
+                      recvbuf,
+                      static_cast<int>(count),
+                      to_coll_type(code),
+                      to_coll_op(op),
+                      comm_.get<coll::CollComm>());
+}
+
+void Collectives::allgather(const void* sendbuf, void* recvbuf, size_t count, LegateTypeCode code)
+{
+  size_t scale = 1;
+  code         = normalize_for_movement(code, scale);
+  count *= scale;
+#ifdef LEGATE_USE_CUDA
+  if (use_nccl_) {
+    nccl::allgather(comm_, sendbuf, recvbuf, count, code);
+    return;
+  }
+#endif
+  coll::collAllgather(
+    sendbuf, recvbuf, static_cast<int>(count), to_coll_type(code), comm_.get<coll::CollComm>());
+}
+
+void Collectives::alltoallv(const void* sendbuf,
+                            const int32_t* sendcounts,
+                            const int32_t* sdispls,
+                            void* recvbuf,
+                            const int32_t* recvcounts,
+                            const int32_t* rdispls,
+                            LegateTypeCode code)
+{
+  size_t scale = 1;
+  code         = normalize_for_movement(code, scale);
+
+  std::vector<int32_t> scaled;
+  if (scale > 1) {
+    auto num_ranks = size();
+    scaled.resize(4 * num_ranks);
+    for (int32_t idx = 0; idx < num_ranks; ++idx) {
+      scaled[idx]                 = sendcounts[idx] * scale;
+      scaled[num_ranks + idx]     = sdispls[idx] * scale;
+      scaled[2 * num_ranks + idx] = recvcounts[idx] * scale;
+      scaled[3 * num_ranks + idx] = rdispls[idx] * scale;
+    }
+    sendcounts = scaled.data();
+    sdispls    = scaled.data() + num_ranks;
+    recvcounts = scaled.data() + 2 * num_ranks;
+    rdispls    = scaled.data() + 3 * num_ranks;
+  }
+
+#ifdef LEGATE_USE_CUDA
+  if (use_nccl_) {
+    nccl::alltoallv(comm_, sendbuf, sendcounts, sdispls, recvbuf, recvcounts, rdispls, code);
+    return;
+  }
+#endif
+  coll::collAlltoallv(sendbuf,
+                      sendcounts,
+                      sdispls,
+                      recvbuf,
+                      recvcounts,
+                      rdispls,
+                      to_coll_type(code),
+                      comm_.get<coll::CollComm>());
+}
+
+void Collectives::alltoall(const void* sendbuf, void* recvbuf, size_t count, LegateTypeCode code)
+{
+  size_t scale = 1;
+  code         = normalize_for_movement(code, scale);
+  count *= scale;
+#ifdef LEGATE_USE_CUDA
+  if (use_nccl_) {
+    // NCCL has no all-to-all, so we exchange blocks of the same size point to point
+    auto num_ranks = size();
+    std::vector<int32_t> counts(num_ranks, static_cast<int32_t>(count));
+    std::vector<int32_t> displs(num_ranks);
+    for (int32_t idx = 0; idx < num_ranks; ++idx) displs[idx] = idx * counts[idx];
+    nccl::alltoallv(
+      comm_, sendbuf, counts.data(), displs.data(), recvbuf, counts.data(), displs.data(), code);
+    return;
+  }
+#endif
+  coll::collAlltoall(
+    sendbuf, recvbuf, static_cast<int>(count), to_coll_type(code), comm_.get<coll::CollComm>());
+}
+
+void Collectives::broadcast(void* buffer, size_t count, int32_t root, LegateTypeCode code)
+{
+  size_t scale = 1;
+  code         = normalize_for_movement(code, scale);
+  count *= scale;
+#ifdef LEGATE_USE_CUDA
+  if (use_nccl_) {
+    nccl::broadcast(comm_, buffer, count, root, code);
+    return;
+  }
+#endif
+  // The coll library has no broadcast, so we express it as an all-to-all where only the root
+  // sends anything. The root cannot alias its send and receive buffers, so it sends a copy.
+  auto comm      = comm_.get<coll::CollComm>();
+  auto num_ranks = comm->global_comm_size;
+  auto my_rank   = comm->global_rank;
+  auto dtype     = to_coll_type(code);
+
+  std::vector<int32_t> sendcounts(num_ranks, 0);
+  std::vector<int32_t> recvcounts(num_ranks, 0);
+  std::vector<int32_t> displs(num_ranks, 0);
+  recvcounts[root] = static_cast<int32_t>(count);
+
+  void* sendbuf = nullptr;
+  if (my_rank == root) {
+    auto bytes = count * type_size(code);
+    sendbuf    = malloc(bytes);
+    memcpy(sendbuf, buffer, bytes);
+    std::fill(sendcounts.begin(), sendcounts.end(), static_cast<int32_t>(count));
+  }
+  // Non-root ranks send nothing, but still need a send buffer distinct from the receive buffer
+  char dummy;
+  coll::collAlltoallv(sendbuf != nullptr ? sendbuf : &dummy,
+                      sendcounts.data(),
+                      displs.data(),
+                      buffer,
+                      recvcounts.data(),
+                      displs.data(),
+                      dtype,
+                      comm);
+  if (sendbuf != nullptr) free(sendbuf);
+}
+
+void Collectives::flush()
+{
+#ifdef LEGATE_USE_CUDA
+  if (use_nccl_) nccl::flush();
+#endif
+}
+
+int32_t Collectives::rank() const
+{
+#ifdef LEGATE_USE_CUDA
+  if (use_nccl_) return nccl::rank(comm_);
+#endif
+  return comm_.get<coll::CollComm>()->global_rank;
+}
+
+int32_t Collectives::size() const
+{
+#ifdef LEGATE_USE_CUDA
+  if (use_nccl_) return nccl::size(comm_);
+#endif
+  return comm_.get<coll::CollComm>()->global_comm_size;
+}
+
+}  // namespace comm
+}  // namespace legate
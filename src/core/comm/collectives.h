@@ -0,0 +1,110 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "core/comm/communicator.h"
+#include "core/utilities/type_traits.h"
+
+namespace legate {
+namespace comm {
+
+enum class CollectiveOp : int32_t {
+  SUM  = 0,
+  PROD = 1,
+  MAX  = 2,
+  MIN  = 3,
+};
+
+// A typed front end for the collectives on a communicator passed to a task. GPU variants run
+// the collectives with NCCL on a leased stream, while CPU and OpenMP variants use the coll
+// library. On GPUs, back-to-back calls are batched into one NCCL group that is launched by
+// flush() or when the object is destroyed, and the results can't be read before that. The
+// coll backend runs each call as it is made.
+//
+// Counts and displacements are in elements of the value type, not in bytes.
+class Collectives {
+ public:
+  Collectives(const Communicator& comm);
+  ~Collectives();
+
+ public:
+  Collectives(const Collectives&)            = delete;
+  Collectives& operator=(const Collectives&) = delete;
+
+ public:
+  template <typename T>
+  void allreduce(const T* sendbuf, T* recvbuf, size_t count, CollectiveOp op)
+  {
+    allreduce(sendbuf, recvbuf, count, legate_type_code_of<T>, op);
+  }
+  template <typename T>
+  void allgather(const T* sendbuf, T* recvbuf, size_t count)
+  {
+    allgather(sendbuf, recvbuf, count, legate_type_code_of<T>);
+  }
+  template <typename T>
+  void alltoallv(const T* sendbuf,
+                 const int32_t* sendcounts,
+                 const int32_t* sdispls,
+                 T* recvbuf,
+                 const int32_t* recvcounts,
+                 const int32_t* rdispls)
+  {
+    alltoallv(
+      sendbuf, sendcounts, sdispls, recvbuf, recvcounts, rdispls, legate_type_code_of<T>);
+  }
+  template <typename T>
+  void alltoall(const T* sendbuf, T* recvbuf, size_t count)
+  {
+    alltoall(sendbuf, recvbuf, count, legate_type_code_of<T>);
+  }
+  template <typename T>
+  void broadcast(T* buffer, size_t count, int32_t root)
+  {
+    broadcast(buffer, count, root, legate_type_code_of<T>);
+  }
+
+ public:
+  void allreduce(
+    const void* sendbuf, void* recvbuf, size_t count, LegateTypeCode code, CollectiveOp op);
+  void allgather(const void* sendbuf, void* recvbuf, size_t count, LegateTypeCode code);
+  void alltoallv(const void* sendbuf,
+                 const int32_t* sendcounts,
+                 const int32_t* sdispls,
+                 void* recvbuf,
+                 const int32_t* recvcounts,
+                 const int32_t* rdispls,
+                 LegateTypeCode code);
+  // Sends 'count' elements to each rank; the blocks for rank i start at element i * count
+  void alltoall(const void* sendbuf, void* recvbuf, size_t count, LegateTypeCode code);
+  void broadcast(void* buffer, size_t count, int32_t root, LegateTypeCode code);
+
+ public:
+  // Launches the batched collectives and orders the task's stream after them
+  void flush();
+
+ public:
+  int32_t rank() const;
+  int32_t size() const;
+
+ private:
+  Communicator comm_;
+  bool use_nccl_;
+};
+
+}  // namespace comm
+}  // namespace legate
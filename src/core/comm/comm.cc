@@ -18,7 +18,9 @@
 #ifdef LEGATE_USE_CUDA
 #include "core/comm/comm_nccl.h"
 #endif
+#include "core/comm/comm_bench.h"
 #include "core/comm/comm_cpu.h"
+#include "core/comm/compressed_shuffle.h"
 
 namespace legate {
 namespace comm {
@@ -31,6 +33,8 @@ void register_tasks(Legion::Machine machine,
   nccl::register_tasks(machine, runtime, context);
 #endif
   cpu::register_tasks(machine, runtime, context);
+  bench::register_tasks(machine, runtime, context);
+  shuffle::register_tasks(machine, runtime, context);
 }
 
 }  // namespace comm
@@ -0,0 +1,157 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "core/comm/collectives.h"
+#include "core/comm/comm_bench.h"
+#include "core/data/buffer.h"
+#include "core/runtime/context.h"
+#include "core/utilities/machine.h"
+
+#ifdef LEGATE_USE_CUDA
+#include "core/cuda/cuda_help.h"
+#include "core/cuda/stream_pool.h"
+#endif
+
+using namespace Legion;
+
+namespace legate {
+namespace comm {
+namespace bench {
+
+// Collectives on GPUs are asynchronous, so we have to wait for them before reading the clock
+static void synchronize(bool on_device)
+{
+#ifdef LEGATE_USE_CUDA
+  if (on_device) {
+    auto stream = cuda::StreamPool::get_stream_pool().get_stream();
+    CHECK_CUDA(cudaStreamSynchronize(stream));
+  }
+#endif
+}
+
+static double time_collective(const Legion::Task* task,
+                              const std::vector<Legion::PhysicalRegion>& regions,
+                              Legion::Context legion_context,
+                              Legion::Runtime* runtime)
+{
+  Core::show_progress(task, legion_context, runtime, task->get_task_name());
+
+  TaskContext context(task, regions, legion_context, runtime);
+  auto& scalars         = context.scalars();
+  auto collective       = static_cast<BenchCollective>(scalars[0].value<int32_t>());
+  const auto bytes      = static_cast<size_t>(scalars[1].value<int64_t>());
+  const auto warmup     = scalars[2].value<int32_t>();
+  const auto iterations = scalars[3].value<int32_t>();
+
+  Collectives collectives(context.communicators()[0]);
+  const auto num_ranks = static_cast<size_t>(collectives.size());
+
+  size_t send_size = bytes;
+  size_t recv_size = bytes;
+  switch (collective) {
+    case BenchCollective::ALLTOALLV:
+    case BenchCollective::ALLTOALL: {
+      send_size = bytes * num_ranks;
+      recv_size = bytes * num_ranks;
+      break;
+    }
+    case BenchCollective::ALLGATHER: {
+      recv_size = bytes * num_ranks;
+      break;
+    }
+    case BenchCollective::ALLREDUCE:
+    case BenchCollective::BROADCAST: break;
+  }
+
+  auto kind      = find_memory_kind_for_executing_processor(false /*host_accessible*/);
+  bool on_device = kind == Memory::Kind::GPU_FB_MEM;
+  auto sendbuf   = create_buffer<int8_t>(send_size, kind);
+  auto recvbuf   = create_buffer<int8_t>(recv_size, kind);
+  auto send_ptr  = sendbuf.ptr(0);
+  auto recv_ptr  = recvbuf.ptr(0);
+
+  std::vector<int32_t> counts(num_ranks, static_cast<int32_t>(bytes));
+  std::vector<int32_t> displs(num_ranks);
+  for (size_t idx = 0; idx < num_ranks; ++idx) displs[idx] = static_cast<int32_t>(idx * bytes);
+
+  auto run = [&]() {
+    switch (collective) {
+      case BenchCollective::ALLTOALLV: {
+        collectives.alltoallv(
+          send_ptr, counts.data(), displs.data(), recv_ptr, counts.data(), displs.data());
+        break;
+      }
+      case BenchCollective::ALLTOALL: {
+        collectives.alltoall(send_ptr, recv_ptr, bytes);
+        break;
+      }
+      case BenchCollective::ALLGATHER: {
+        collectives.allgather(send_ptr, recv_ptr, bytes);
+        break;
+      }
+      case BenchCollective::ALLREDUCE: {
+        collectives.allreduce(send_ptr, recv_ptr, bytes, CollectiveOp::SUM);
+        break;
+      }
+      case BenchCollective::BROADCAST: {
+        collectives.broadcast(recv_ptr, bytes, 0 /*root*/);
+        break;
+      }
+    }
+    // Each iteration is timed as a collective of its own rather than batched with the others
+    collectives.flush();
+  };
+
+  for (int32_t idx = 0; idx < warmup; ++idx) run();
+  synchronize(on_device);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int32_t idx = 0; idx < iterations; ++idx) run();
+  synchronize(on_device);
+  auto stop = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double>(stop - start).count() / std::max(iterations, 1);
+}
+
+void register_tasks(Legion::Machine machine,
+                    Legion::Runtime* runtime,
+                    const LibraryContext& context)
+{
+  const TaskID task_id  = context.get_task_id(LEGATE_CORE_COLL_BENCH_TASK_ID);
+  const char* task_name = "core::comm::bench::time_collective";
+  runtime->attach_name(task_id, task_name, false /*mutable*/, true /*local only*/);
+
+  auto register_variant = [&](auto proc_kind, auto variant_id) {
+    TaskVariantRegistrar registrar(task_id, task_name);
+    registrar.add_constraint(ProcessorConstraint(proc_kind));
+    registrar.set_leaf(true);
+    registrar.global_registration = false;
+    runtime->register_task_variant<double, time_collective>(registrar, variant_id);
+  };
+  register_variant(Processor::LOC_PROC, LEGATE_CPU_VARIANT);
+  register_variant(Processor::OMP_PROC, LEGATE_OMP_VARIANT);
+#ifdef LEGATE_USE_CUDA
+  register_variant(Processor::TOC_PROC, LEGATE_GPU_VARIANT);
+#endif
+}
+
+}  // namespace bench
+}  // namespace comm
+}  // namespace legate
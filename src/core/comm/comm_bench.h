@@ -0,0 +1,45 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "core/runtime/context.h"
+#include "legate.h"
+
+namespace legate {
+namespace comm {
+namespace bench {
+
+// Collectives timed by the benchmark task. These must be kept in sync with the ones in
+// benchmarks/coll_bench.py.
+enum class BenchCollective : int32_t {
+  ALLTOALLV = 0,
+  ALLTOALL  = 1,
+  ALLGATHER = 2,
+  ALLREDUCE = 3,
+  BROADCAST = 4,
+};
+
+// Registers the task that times a collective on the communicator passed to it. The task takes
+// the collective, the message size in bytes, and the numbers of warm-up and timed iterations
+// as scalars, and returns the average time per iteration in seconds as a double.
+void register_tasks(Legion::Machine machine,
+                    Legion::Runtime* runtime,
+                    const LibraryContext& context);
+
+}  // namespace bench
+}  // namespace comm
+}  // namespace legate
@@ -17,11 +17,12 @@
 #include "core/comm/comm_nccl.h"
 #include "core/cuda/cuda_help.h"
 #include "core/cuda/stream_pool.h"
-#include "core/utilities/nvtx_help.h"
+#include "core/utilities/trace.h"
 #include "legate.h"
 
 #include <cuda.h>
 #include <nccl.h>
+#include <optional>
 
 using namespace Legion;
 
@@ -57,7 +58,7 @@ static ncclUniqueId init_nccl_id(const Legion::Task* task,
                                  Legion::Context context,
                                  Legion::Runtime* runtime)
 {
-  legate::nvtx::Range auto_range("core::comm::nccl::init_id");
+  legate::trace::Range auto_range("core::comm::nccl::init_id");
 
   Core::show_progress(task, context, runtime, task->get_task_name());
 
@@ -72,7 +73,7 @@ static ncclComm_t* init_nccl(const Legion::Task* task,
                              Legion::Context context,
                              Legion::Runtime* runtime)
 {
-  legate::nvtx::Range auto_range("core::comm::nccl::init");
+  legate::trace::Range auto_range("core::comm::nccl::init");
 
   Core::show_progress(task, context, runtime, task->get_task_name());
 
@@ -88,7 +89,8 @@ static ncclComm_t* init_nccl(const Legion::Task* task,
 
   if (num_ranks == 1) return comm;
 
-  auto stream = cuda::StreamPool::get_stream_pool().get_stream();
+  // The warm-up runs on a leased stream, which joins back into the primary stream at the end
+  auto stream = cuda::StreamPool::get_stream_pool().lease_stream();
 
   // Perform a warm-up all-to-all
 
@@ -117,7 +119,7 @@ static void finalize_nccl(const Legion::Task* task,
                           Legion::Context context,
                           Legion::Runtime* runtime)
 {
-  legate::nvtx::Range auto_range("core::comm::nccl::finalize");
+  legate::trace::Range auto_range("core::comm::nccl::finalize");
 
   Core::show_progress(task, context, runtime, task->get_task_name());
 
@@ -171,6 +173,172 @@ void register_tasks(Legion::Machine machine,
   }
 }
 
+static ncclDataType_t to_nccl_type(LegateTypeCode code)
+{
+  switch (code) {
+    case INT8_LT: return ncclInt8;
+    case UINT8_LT: return ncclUint8;
+    case INT32_LT: return ncclInt32;
+    case UINT32_LT: return ncclUint32;
+    case INT64_LT: return ncclInt64;
+    case UINT64_LT: return ncclUint64;
+    case HALF_LT: return ncclFloat16;
+    case FLOAT_LT: return ncclFloat32;
+    case DOUBLE_LT: return ncclFloat64;
+    default: break;
+  }
+  log_legate.error("Type code %d is not supported by NCCL", code);
+  LEGATE_ABORT;
+  return ncclInt8;
+}
+
+static size_t nccl_type_size(ncclDataType_t type)
+{
+  switch (type) {
+    case ncclInt8:
+    case ncclUint8: return 1;
+    case ncclFloat16: return 2;
+    case ncclInt32:
+    case ncclUint32:
+    case ncclFloat32: return 4;
+    default: return 8;
+  }
+}
+
+static ncclRedOp_t to_nccl_op(CollectiveOp op)
+{
+  switch (op) {
+    case CollectiveOp::SUM: return ncclSum;
+    case CollectiveOp::PROD: return ncclProd;
+    case CollectiveOp::MAX: return ncclMax;
+    case CollectiveOp::MIN: return ncclMin;
+  }
+  LEGATE_ABORT;
+  return ncclSum;
+}
+
+namespace {
+
+// The collectives a task issued since its last flush. They are enqueued on a leased stream
+// inside one NCCL group, so back-to-back collectives go out as one batch without queueing up
+// behind the task's own kernels.
+struct PendingGroup {
+  std::optional<cuda::StreamView> stream{};
+};
+
+PendingGroup& get_pending_group()
+{
+  static PendingGroup groups[LEGION_MAX_NUM_PROCS];
+  const auto proc = Processor::get_executing_processor();
+  return groups[proc.id & (LEGION_MAX_NUM_PROCS - 1)];
+}
+
+// Opens the pending group if needed and returns its stream, ordered after the work enqueued
+// on the task's stream so far so that the collective sees the buffers the task produced
+cudaStream_t enqueue()
+{
+  auto& group = get_pending_group();
+  if (!group.stream.has_value()) {
+    group.stream.emplace(cuda::StreamPool::get_stream_pool().lease_stream());
+    CHECK_NCCL(ncclGroupStart());
+  } else if (group.stream->parent() != nullptr)
+    group.stream->wait_for(group.stream->parent());
+  return *group.stream;
+}
+
+}  // namespace
+
+void flush()
+{
+  auto& group = get_pending_group();
+  if (!group.stream.has_value()) return;
+  CHECK_NCCL(ncclGroupEnd());
+  // Releasing the lease orders the task's stream after the collectives
+  group.stream.reset();
+}
+
+void allreduce(const Communicator& comm,
+               const void* sendbuf,
+               void* recvbuf,
+               size_t count,
+               LegateTypeCode code,
+               CollectiveOp op)
+{
+  auto stream = enqueue();
+  CHECK_NCCL(ncclAllReduce(
+    sendbuf, recvbuf, count, to_nccl_type(code), to_nccl_op(op), *comm.get<ncclComm_t*>(), stream));
+}
+
+void allgather(
+  const Communicator& comm, const void* sendbuf, void* recvbuf, size_t count, LegateTypeCode code)
+{
+  auto stream = enqueue();
+  CHECK_NCCL(
+    ncclAllGather(sendbuf, recvbuf, count, to_nccl_type(code), *comm.get<ncclComm_t*>(), stream));
+}
+
+void alltoallv(const Communicator& comm,
+               const void* sendbuf,
+               const int32_t* sendcounts,
+               const int32_t* sdispls,
+               void* recvbuf,
+               const int32_t* recvcounts,
+               const int32_t* rdispls,
+               LegateTypeCode code)
+{
+  auto stream     = enqueue();
+  auto nccl_comm  = *comm.get<ncclComm_t*>();
+  auto type       = to_nccl_type(code);
+  auto type_size  = nccl_type_size(type);
+  int32_t n_ranks = 0;
+  CHECK_NCCL(ncclCommCount(nccl_comm, &n_ranks));
+
+  auto send_base = static_cast<const int8_t*>(sendbuf);
+  auto recv_base = static_cast<int8_t*>(recvbuf);
+  // This nests inside the pending group, so the point-to-point exchanges go out in the same
+  // batch as the collectives around them
+  CHECK_NCCL(ncclGroupStart());
+  for (int32_t idx = 0; idx < n_ranks; ++idx) {
+    if (sendcounts[idx] > 0)
+      CHECK_NCCL(ncclSend(send_base + static_cast<size_t>(sdispls[idx]) * type_size,
+                          sendcounts[idx],
+                          type,
+                          idx,
+                          nccl_comm,
+                          stream));
+    if (recvcounts[idx] > 0)
+      CHECK_NCCL(ncclRecv(recv_base + static_cast<size_t>(rdispls[idx]) * type_size,
+                          recvcounts[idx],
+                          type,
+                          idx,
+                          nccl_comm,
+                          stream));
+  }
+  CHECK_NCCL(ncclGroupEnd());
+}
+
+void broadcast(
+  const Communicator& comm, void* buffer, size_t count, int32_t root, LegateTypeCode code)
+{
+  auto stream = enqueue();
+  CHECK_NCCL(ncclBroadcast(
+    buffer, buffer, count, to_nccl_type(code), root, *comm.get<ncclComm_t*>(), stream));
+}
+
+int32_t rank(const Communicator& comm)
+{
+  int32_t rank = 0;
+  CHECK_NCCL(ncclCommUserRank(*comm.get<ncclComm_t*>(), &rank));
+  return rank;
+}
+
+int32_t size(const Communicator& comm)
+{
+  int32_t size = 0;
+  CHECK_NCCL(ncclCommCount(*comm.get<ncclComm_t*>(), &size));
+  return size;
+}
+
 bool needs_barrier()
 {
   int32_t ver;
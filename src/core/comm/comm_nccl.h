@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "core/comm/collectives.h"
 #include "core/runtime/context.h"
 #include "legate.h"
 
@@ -29,6 +30,30 @@ void register_tasks(Legion::Machine machine,
 
 bool needs_barrier();
 
+// Backend of comm::Collectives for GPU variants. The collectives are batched in one NCCL group
+// on a leased stream until flush() launches them and orders the task's stream after them.
+void allreduce(const Communicator& comm,
+               const void* sendbuf,
+               void* recvbuf,
+               size_t count,
+               LegateTypeCode code,
+               CollectiveOp op);
+void allgather(
+  const Communicator& comm, const void* sendbuf, void* recvbuf, size_t count, LegateTypeCode code);
+void alltoallv(const Communicator& comm,
+               const void* sendbuf,
+               const int32_t* sendcounts,
+               const int32_t* sdispls,
+               void* recvbuf,
+               const int32_t* recvcounts,
+               const int32_t* rdispls,
+               LegateTypeCode code);
+void broadcast(
+  const Communicator& comm, void* buffer, size_t count, int32_t root, LegateTypeCode code);
+void flush();
+int32_t rank(const Communicator& comm);
+int32_t size(const Communicator& comm);
+
 }  // namespace nccl
 }  // namespace comm
 }  // namespace legate
@@ -0,0 +1,164 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <string.h>
+
+#include "core/comm/compressed_shuffle.h"
+#include "core/comm/compressed_shuffle_template.inl"
+
+using namespace Legion;
+
+namespace legate {
+namespace comm {
+namespace shuffle {
+
+// Runs the codec on the host, for CPU and OpenMP variants
+struct HostCodec {
+  Memory::Kind kind{find_memory_kind_for_executing_processor()};
+
+  void to_buffer(void* dst, const void* src, size_t bytes) { memcpy(dst, src, bytes); }
+  void from_buffer(void* dst, const void* src, size_t bytes) { memcpy(dst, src, bytes); }
+  void synchronize() {}
+
+  template <typename VAL, int DIM>
+  size_t compress(const AccessorRO<VAL, DIM>& acc, const Rect<DIM>& rect, uint8_t* message)
+  {
+    const size_t volume = rect.volume();
+    const size_t size   = volume * sizeof(VAL);
+
+    std::vector<uint8_t> shuffled(size);
+    for (size_t idx = 0; idx < volume; ++idx) {
+      const VAL& value = acc[delinearize_point(rect, idx)];
+      for (size_t byte = 0; byte < sizeof(VAL); ++byte)
+        shuffled[byte * volume + idx] = value.bytes[byte];
+    }
+
+    std::vector<bool> nonzero(num_blocks(size), false);
+    size_t compressed = bitmap_size(size);
+    for (size_t block = 0; block < nonzero.size(); ++block) {
+      const size_t lo = block * BLOCK_SIZE;
+      const size_t hi = std::min(lo + BLOCK_SIZE, size);
+      for (size_t pos = lo; pos < hi && !nonzero[block]; ++pos) nonzero[block] = shuffled[pos] != 0;
+      if (nonzero[block]) compressed += hi - lo;
+    }
+
+    if (compressed >= size) {
+      message[0] = RAW;
+      memcpy(message + 1, shuffled.data(), size);
+      return 1 + size;
+    }
+
+    const size_t bitmap = bitmap_size(size);
+    std::vector<uint8_t> bits(bitmap, 0);
+    for (size_t block = 0; block < nonzero.size(); ++block)
+      if (nonzero[block]) bits[block / 8] |= static_cast<uint8_t>(1 << (block % 8));
+
+    size_t offset = 1 + bitmap;
+    for (size_t block = 0; block < nonzero.size(); ++block) {
+      if (!nonzero[block]) continue;
+      const size_t lo = block * BLOCK_SIZE;
+      const size_t hi = std::min(lo + BLOCK_SIZE, size);
+      memcpy(message + offset, shuffled.data() + lo, hi - lo);
+      offset += hi - lo;
+    }
+    message[0] = BLOCKS;
+    memcpy(message + 1, bits.data(), bitmap);
+    return offset;
+  }
+
+  template <typename VAL, int DIM>
+  void decompress(const uint8_t* message,
+                  size_t length,
+                  const AccessorWO<VAL, DIM>& acc,
+                  const Rect<DIM>& rect)
+  {
+    const size_t volume = rect.volume();
+    const size_t size   = volume * sizeof(VAL);
+
+    const uint8_t* shuffled = message + 1;
+    std::vector<uint8_t> expanded;
+    if (message[0] == BLOCKS) {
+      expanded.resize(size, 0);
+      const uint8_t* bits = message + 1;
+      size_t offset       = 1 + bitmap_size(size);
+      for (size_t block = 0; block < num_blocks(size); ++block) {
+        if (!(bits[block / 8] & (1 << (block % 8)))) continue;
+        const size_t lo = block * BLOCK_SIZE;
+        const size_t hi = std::min(lo + BLOCK_SIZE, size);
+        memcpy(expanded.data() + lo, message + offset, hi - lo);
+        offset += hi - lo;
+      }
+#ifdef DEBUG_LEGATE
+      assert(offset == length);
+#endif
+      shuffled = expanded.data();
+    }
+#ifdef DEBUG_LEGATE
+    else
+      assert(1 + size == length);
+#endif
+
+    for (size_t idx = 0; idx < volume; ++idx) {
+      VAL value;
+      for (size_t byte = 0; byte < sizeof(VAL); ++byte)
+        value.bytes[byte] = shuffled[byte * volume + idx];
+      acc[delinearize_point(rect, idx)] = value;
+    }
+  }
+};
+
+static void cpu_shuffle(const Legion::Task* task,
+                        const std::vector<Legion::PhysicalRegion>& regions,
+                        Legion::Context legion_context,
+                        Legion::Runtime* runtime)
+{
+  shuffle_template<HostCodec>(task, regions, legion_context, runtime);
+}
+
+void register_tasks(Legion::Machine machine,
+                    Legion::Runtime* runtime,
+                    const LibraryContext& context)
+{
+  const TaskID task_id  = context.get_task_id(LEGATE_CORE_COMPRESSED_SHUFFLE_TASK_ID);
+  const char* task_name = "core::comm::shuffle::compressed_shuffle";
+  runtime->attach_name(task_id, task_name, false /*mutable*/, true /*local only*/);
+
+  auto make_registrar = [&](auto proc_kind) {
+    TaskVariantRegistrar registrar(task_id, task_name);
+    registrar.add_constraint(ProcessorConstraint(proc_kind));
+    registrar.set_leaf(true);
+    registrar.global_registration = false;
+    return registrar;
+  };
+  {
+    auto registrar = make_registrar(Processor::LOC_PROC);
+    runtime->register_task_variant<cpu_shuffle>(registrar, LEGATE_CPU_VARIANT);
+  }
+  {
+    auto registrar = make_registrar(Processor::OMP_PROC);
+    runtime->register_task_variant<cpu_shuffle>(registrar, LEGATE_OMP_VARIANT);
+  }
+#ifdef LEGATE_USE_CUDA
+  {
+    auto registrar = make_registrar(Processor::TOC_PROC);
+    runtime->register_task_variant<gpu_shuffle>(registrar, LEGATE_GPU_VARIANT);
+  }
+#endif
+}
+
+}  // namespace shuffle
+}  // namespace comm
+}  // namespace legate
@@ -0,0 +1,202 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/comm/compressed_shuffle.h"
+#include "core/comm/compressed_shuffle_template.inl"
+#include "core/cuda/cuda_help.h"
+#include "core/cuda/stream_pool.h"
+
+using namespace Legion;
+
+namespace legate {
+namespace comm {
+namespace shuffle {
+
+static constexpr size_t THREADS_PER_BLOCK = 256;
+
+static_assert(BLOCK_SIZE == THREADS_PER_BLOCK, "Each thread block checks one block of data");
+
+template <typename VAL, int DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, 4)
+  gather_shuffled(AccessorRO<VAL, DIM> acc, Rect<DIM> rect, size_t volume, uint8_t* shuffled)
+{
+  const size_t idx = static_cast<size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  if (idx >= volume) return;
+  const VAL& value = acc[delinearize_point(rect, idx)];
+  for (size_t byte = 0; byte < sizeof(VAL); ++byte)
+    shuffled[byte * volume + idx] = value.bytes[byte];
+}
+
+template <typename VAL, int DIM>
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, 4)
+  scatter_shuffled(AccessorWO<VAL, DIM> acc, Rect<DIM> rect, size_t volume, const uint8_t* shuffled)
+{
+  const size_t idx = static_cast<size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  if (idx >= volume) return;
+  VAL value;
+  for (size_t byte = 0; byte < sizeof(VAL); ++byte)
+    value.bytes[byte] = shuffled[byte * volume + idx];
+  acc[delinearize_point(rect, idx)] = value;
+}
+
+// Each thread block checks one block of data
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, 4)
+  find_nonzero_blocks(const uint8_t* data, size_t size, uint8_t* nonzero)
+{
+  const size_t pos = static_cast<size_t>(blockIdx.x) * BLOCK_SIZE + threadIdx.x;
+  const int value  = pos < size && data[pos] != 0;
+  const int any    = __syncthreads_or(value);
+  if (threadIdx.x == 0) nonzero[blockIdx.x] = any;
+}
+
+// Moves each block of data to its offset, skipping the blocks whose offset is negative
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, 4)
+  compact_blocks(const uint8_t* data, size_t size, const int64_t* offsets, uint8_t* out)
+{
+  const int64_t offset = offsets[blockIdx.x];
+  const size_t pos     = static_cast<size_t>(blockIdx.x) * BLOCK_SIZE + threadIdx.x;
+  if (offset < 0 || pos >= size) return;
+  out[offset + threadIdx.x] = data[pos];
+}
+
+// Inverse of compact_blocks, which zeroes the blocks whose offset is negative
+static __global__ void __launch_bounds__(THREADS_PER_BLOCK, 4)
+  expand_blocks(const uint8_t* in, size_t size, const int64_t* offsets, uint8_t* data)
+{
+  const int64_t offset = offsets[blockIdx.x];
+  const size_t pos     = static_cast<size_t>(blockIdx.x) * BLOCK_SIZE + threadIdx.x;
+  if (pos >= size) return;
+  data[pos] = offset < 0 ? 0 : in[offset + threadIdx.x];
+}
+
+// Runs the codec on the device. The bitmaps and block offsets are computed on the host, which
+// only sees one byte per block of data.
+struct DeviceCodec {
+  Memory::Kind kind{Memory::Kind::GPU_FB_MEM};
+  cuda::StreamView stream{cuda::StreamPool::get_stream_pool().get_stream()};
+
+  void to_buffer(void* dst, const void* src, size_t bytes)
+  {
+    CHECK_CUDA(cudaMemcpyAsync(dst, src, bytes, cudaMemcpyHostToDevice, stream));
+  }
+  void from_buffer(void* dst, const void* src, size_t bytes)
+  {
+    CHECK_CUDA(cudaMemcpyAsync(dst, src, bytes, cudaMemcpyDeviceToHost, stream));
+    CHECK_CUDA(cudaStreamSynchronize(stream));
+  }
+  void synchronize() { CHECK_CUDA(cudaStreamSynchronize(stream)); }
+
+  template <typename VAL, int DIM>
+  size_t compress(const AccessorRO<VAL, DIM>& acc, const Rect<DIM>& rect, uint8_t* message)
+  {
+    const size_t volume = rect.volume();
+    const size_t size   = volume * sizeof(VAL);
+    const size_t blocks = num_blocks(size);
+
+    auto shuffled = create_buffer<uint8_t>(size, kind);
+    auto nonzero  = create_buffer<uint8_t>(blocks, kind);
+    const size_t grid = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+    gather_shuffled<VAL, DIM>
+      <<<grid, THREADS_PER_BLOCK, 0, stream>>>(acc, rect, volume, shuffled.ptr(0));
+    find_nonzero_blocks<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      shuffled.ptr(0), size, nonzero.ptr(0));
+
+    std::vector<uint8_t> flags(blocks);
+    from_buffer(flags.data(), nonzero.ptr(0), blocks);
+
+    const size_t bitmap = bitmap_size(size);
+    std::vector<uint8_t> header(1 + bitmap, 0);
+    std::vector<int64_t> offsets(blocks, -1);
+    size_t offset = 1 + bitmap;
+    for (size_t block = 0; block < blocks; ++block) {
+      if (!flags[block]) continue;
+      header[1 + block / 8] |= static_cast<uint8_t>(1 << (block % 8));
+      offsets[block] = static_cast<int64_t>(offset);
+      offset += std::min(BLOCK_SIZE, size - block * BLOCK_SIZE);
+    }
+
+    if (offset - 1 >= size) {
+      const uint8_t mode = RAW;
+      to_buffer(message, &mode, 1);
+      CHECK_CUDA(cudaMemcpyAsync(
+        message + 1, shuffled.ptr(0), size, cudaMemcpyDeviceToDevice, stream));
+      return 1 + size;
+    }
+
+    header[0] = BLOCKS;
+    to_buffer(message, header.data(), header.size());
+    auto device_offsets = create_buffer<int64_t>(blocks, kind);
+    to_buffer(device_offsets.ptr(0), offsets.data(), blocks * sizeof(int64_t));
+    compact_blocks<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      shuffled.ptr(0), size, device_offsets.ptr(0), message);
+    return offset;
+  }
+
+  template <typename VAL, int DIM>
+  void decompress(const uint8_t* message,
+                  size_t length,
+                  const AccessorWO<VAL, DIM>& acc,
+                  const Rect<DIM>& rect)
+  {
+    const size_t volume = rect.volume();
+    const size_t size   = volume * sizeof(VAL);
+    const size_t blocks = num_blocks(size);
+    const size_t grid   = (volume + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK;
+
+    std::vector<uint8_t> header(1 + bitmap_size(size));
+    from_buffer(header.data(), message, header.size());
+
+    if (header[0] == RAW) {
+#ifdef DEBUG_LEGATE
+      assert(1 + size == length);
+#endif
+      scatter_shuffled<VAL, DIM>
+        <<<grid, THREADS_PER_BLOCK, 0, stream>>>(acc, rect, volume, message + 1);
+      return;
+    }
+
+    std::vector<int64_t> offsets(blocks, -1);
+    size_t offset = header.size();
+    for (size_t block = 0; block < blocks; ++block) {
+      if (!(header[1 + block / 8] & (1 << (block % 8)))) continue;
+      offsets[block] = static_cast<int64_t>(offset);
+      offset += std::min(BLOCK_SIZE, size - block * BLOCK_SIZE);
+    }
+#ifdef DEBUG_LEGATE
+    assert(offset == length);
+#endif
+
+    auto device_offsets = create_buffer<int64_t>(blocks, kind);
+    auto expanded       = create_buffer<uint8_t>(size, kind);
+    to_buffer(device_offsets.ptr(0), offsets.data(), blocks * sizeof(int64_t));
+    expand_blocks<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      message, size, device_offsets.ptr(0), expanded.ptr(0));
+    scatter_shuffled<VAL, DIM>
+      <<<grid, THREADS_PER_BLOCK, 0, stream>>>(acc, rect, volume, expanded.ptr(0));
+  }
+};
+
+void gpu_shuffle(const Legion::Task* task,
+                 const std::vector<Legion::PhysicalRegion>& regions,
+                 Legion::Context legion_context,
+                 Legion::Runtime* runtime)
+{
+  shuffle_template<DeviceCodec>(task, regions, legion_context, runtime);
+}
+
+}  // namespace shuffle
+}  // namespace comm
+}  // namespace legate
@@ -0,0 +1,45 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "core/runtime/context.h"
+#include "legate.h"
+
+namespace legate {
+namespace comm {
+namespace shuffle {
+
+// Registers the task that moves a store between two tilings with the same color shape. Each
+// point task reads its tile of the old tiling and writes its tile of the new tiling into a
+// staging store. The parts of the old tile needed by other points are compressed, exchanged
+// over the communicator passed to the task, and decompressed at the destination. The task
+// takes the size of the store's elements as a scalar.
+void register_tasks(Legion::Machine machine,
+                    Legion::Runtime* runtime,
+                    const LibraryContext& context);
+
+#ifdef LEGATE_USE_CUDA
+// GPU variant, which runs the codec on the device
+void gpu_shuffle(const Legion::Task* task,
+                 const std::vector<Legion::PhysicalRegion>& regions,
+                 Legion::Context legion_context,
+                 Legion::Runtime* runtime);
+#endif
+
+}  // namespace shuffle
+}  // namespace comm
+}  // namespace legate
@@ -0,0 +1,246 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+// Useful for IDEs
+#include "core/comm/compressed_shuffle.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "core/comm/collectives.h"
+#include "core/data/buffer.h"
+#include "core/data/store.h"
+#include "core/utilities/dispatch.h"
+#include "core/utilities/machine.h"
+#include "core/utilities/memory_usage.h"
+
+namespace legate {
+namespace comm {
+namespace shuffle {
+
+// The message for each pair of points holds the elements in the intersection of the sender's
+// old tile and the receiver's new tile, in the order of delinearize_point. Its first byte is
+// the mode. In RAW mode, the rest of the message is the shuffled bytes of the elements, where
+// byte b of element i goes to position b * volume + i. Shuffling puts the bytes of the same
+// significance next to each other, which turns small values in wide types into runs of zeros.
+// In BLOCKS mode, the shuffled bytes are cut into blocks of BLOCK_SIZE bytes, and the message
+// holds a bitmap of the blocks with a nonzero byte followed by those blocks. The sender picks
+// BLOCKS mode only when it makes the message smaller, so a message is never more than one
+// byte larger than the data.
+enum Mode : uint8_t {
+  RAW    = 0,
+  BLOCKS = 1,
+};
+
+constexpr size_t BLOCK_SIZE = 256;
+
+__CUDA_HD__ inline size_t num_blocks(size_t size) { return (size + BLOCK_SIZE - 1) / BLOCK_SIZE; }
+
+__CUDA_HD__ inline size_t bitmap_size(size_t size) { return (num_blocks(size) + 7) / 8; }
+
+// Upper bound of the size of a message carrying 'size' bytes of data
+inline size_t max_message_size(size_t size) { return size == 0 ? 0 : size + 1; }
+
+// Elements are moved as opaque bytes, so stores of any type with the same size share the code
+template <int32_t SIZE>
+struct Element {
+  uint8_t bytes[SIZE];
+};
+
+template <int DIM>
+__CUDA_HD__ inline Legion::Point<DIM> delinearize_point(const Legion::Rect<DIM>& rect, size_t idx)
+{
+  Legion::Point<DIM> point;
+  for (int32_t dim = 0; dim < DIM; ++dim) {
+    const size_t extent = rect.hi[dim] - rect.lo[dim] + 1;
+    point[dim]          = rect.lo[dim] + static_cast<Legion::coord_t>(idx % extent);
+    idx /= extent;
+  }
+  return point;
+}
+
+// Gathers 'count' values from every rank. Collectives on GPUs need device buffers, so the
+// values are staged through buffers in the memory the codec works in.
+template <typename Codec, typename T>
+std::vector<T> allgather(Collectives& collectives, Codec& codec, const std::vector<T>& values)
+{
+  const size_t count     = values.size();
+  const size_t num_ranks = static_cast<size_t>(collectives.size());
+  auto sendbuf           = create_buffer<T>(count, codec.kind);
+  auto recvbuf           = create_buffer<T>(count * num_ranks, codec.kind);
+  codec.to_buffer(sendbuf.ptr(0), values.data(), count * sizeof(T));
+  collectives.allgather(sendbuf.ptr(0), recvbuf.ptr(0), count);
+  collectives.flush();
+  std::vector<T> result(count * num_ranks);
+  codec.from_buffer(result.data(), recvbuf.ptr(0), result.size() * sizeof(T));
+  sendbuf.destroy();
+  recvbuf.destroy();
+  return result;
+}
+
+// Sends values[i] to rank i and returns the values received from each rank
+template <typename Codec, typename T>
+std::vector<T> alltoall(Collectives& collectives, Codec& codec, const std::vector<T>& values)
+{
+  const size_t num_ranks = values.size();
+  auto sendbuf           = create_buffer<T>(num_ranks, codec.kind);
+  auto recvbuf           = create_buffer<T>(num_ranks, codec.kind);
+  codec.to_buffer(sendbuf.ptr(0), values.data(), num_ranks * sizeof(T));
+  collectives.alltoall(sendbuf.ptr(0), recvbuf.ptr(0), 1);
+  collectives.flush();
+  std::vector<T> result(num_ranks);
+  codec.from_buffer(result.data(), recvbuf.ptr(0), num_ranks * sizeof(T));
+  sendbuf.destroy();
+  recvbuf.destroy();
+  return result;
+}
+
+template <int DIM>
+Legion::Rect<DIM> unpack_rect(const std::vector<int64_t>& values, size_t offset)
+{
+  Legion::Rect<DIM> rect;
+  for (int32_t dim = 0; dim < DIM; ++dim) {
+    rect.lo[dim] = values[offset + dim];
+    rect.hi[dim] = values[offset + DIM + dim];
+  }
+  return rect;
+}
+
+template <typename Codec, int32_t SIZE, int DIM>
+void shuffle(TaskContext& context, Codec& codec)
+{
+  using VAL = Element<SIZE>;
+
+  auto& input  = context.inputs()[0];
+  auto& output = context.outputs()[0];
+
+  Collectives collectives(context.communicators()[0]);
+  const auto num_ranks = static_cast<size_t>(collectives.size());
+
+  auto old_tile = input.shape<DIM>();
+  auto new_tile = output.shape<DIM>();
+  auto in_acc   = input.read_accessor<VAL, DIM>();
+  auto out_acc  = output.write_accessor<VAL, DIM>();
+
+  // Every point learns the old and the new tile of every other point
+  std::vector<int64_t> local(4 * DIM);
+  for (int32_t dim = 0; dim < DIM; ++dim) {
+    local[dim]           = old_tile.lo[dim];
+    local[DIM + dim]     = old_tile.hi[dim];
+    local[2 * DIM + dim] = new_tile.lo[dim];
+    local[3 * DIM + dim] = new_tile.hi[dim];
+  }
+  auto tiles = allgather(collectives, codec, local);
+
+  // The messages are packed back to back, each one bounded by the size of its data plus one
+  std::vector<Legion::Rect<DIM>> send_rects(num_ranks);
+  size_t capacity = 0;
+  for (size_t rank = 0; rank < num_ranks; ++rank) {
+    send_rects[rank] = old_tile.intersection(unpack_rect<DIM>(tiles, rank * 4 * DIM + 2 * DIM));
+    if (!send_rects[rank].empty()) capacity += max_message_size(send_rects[rank].volume() * SIZE);
+  }
+  // The collectives take counts and displacements as 32-bit integers
+  if (capacity > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+    log_legate.error("Compressed shuffle cannot send more than 2GB from a single tile");
+    LEGATE_ABORT;
+  }
+
+  auto sendbuf = create_buffer<int8_t>(std::max<size_t>(capacity, 1), codec.kind);
+  std::vector<int32_t> sendcounts(num_ranks, 0);
+  std::vector<int32_t> sdispls(num_ranks, 0);
+  size_t offset = 0;
+  for (size_t rank = 0; rank < num_ranks; ++rank) {
+    sdispls[rank] = static_cast<int32_t>(offset);
+    if (send_rects[rank].empty()) continue;
+    auto message     = reinterpret_cast<uint8_t*>(sendbuf.ptr(0) + offset);
+    sendcounts[rank] = static_cast<int32_t>(codec.compress(in_acc, send_rects[rank], message));
+    offset += sendcounts[rank];
+  }
+
+  auto recvcounts = alltoall(collectives, codec, sendcounts);
+  std::vector<int32_t> rdispls(num_ranks, 0);
+  size_t total = 0;
+  for (size_t rank = 0; rank < num_ranks; ++rank) {
+    if (total + recvcounts[rank] > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+      log_legate.error("Compressed shuffle cannot receive more than 2GB into a single tile");
+      LEGATE_ABORT;
+    }
+    rdispls[rank] = static_cast<int32_t>(total);
+    total += recvcounts[rank];
+  }
+  auto recvbuf = create_buffer<int8_t>(std::max<size_t>(total, 1), codec.kind);
+
+  collectives.alltoallv(sendbuf.ptr(0),
+                        sendcounts.data(),
+                        sdispls.data(),
+                        recvbuf.ptr(0),
+                        recvcounts.data(),
+                        rdispls.data());
+  collectives.flush();
+
+  for (size_t rank = 0; rank < num_ranks; ++rank) {
+    auto rect = unpack_rect<DIM>(tiles, rank * 4 * DIM).intersection(new_tile);
+    if (rect.empty()) continue;
+    auto message = reinterpret_cast<const uint8_t*>(recvbuf.ptr(0) + rdispls[rank]);
+    codec.decompress(message, recvcounts[rank], out_acc, rect);
+  }
+
+  codec.synchronize();
+  sendbuf.destroy();
+  recvbuf.destroy();
+}
+
+template <typename Codec>
+struct shuffle_fn {
+  template <int DIM>
+  void operator()(TaskContext& context, Codec& codec, int32_t size)
+  {
+    // These must be kept in sync with COMPRESSIBLE_TYPE_SIZES in legate/core/store.py
+    switch (size) {
+      case 1: shuffle<Codec, 1, DIM>(context, codec); return;
+      case 2: shuffle<Codec, 2, DIM>(context, codec); return;
+      case 4: shuffle<Codec, 4, DIM>(context, codec); return;
+      case 8: shuffle<Codec, 8, DIM>(context, codec); return;
+      case 16: shuffle<Codec, 16, DIM>(context, codec); return;
+    }
+    log_legate.error("Compressed shuffle doesn't support elements of %d bytes", size);
+    LEGATE_ABORT;
+  }
+};
+
+template <typename Codec>
+void shuffle_template(const Legion::Task* task,
+                      const std::vector<Legion::PhysicalRegion>& regions,
+                      Legion::Context legion_context,
+                      Legion::Runtime* runtime)
+{
+  Core::show_progress(task, legion_context, runtime, task->get_task_name());
+
+  TaskContext context(task, regions, legion_context, runtime);
+  const auto size = context.scalars()[0].value<int32_t>();
+
+  Codec codec;
+  dim_dispatch(context.inputs()[0].dim(), shuffle_fn<Codec>{}, context, codec, size);
+
+  MemoryUsage::release_task_temporaries();
+}
+
+}  // namespace shuffle
+}  // namespace comm
+}  // namespace legate
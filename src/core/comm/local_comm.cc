@@ -18,6 +18,20 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
+#include <climits>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <sched.h>
+#endif
 
 #include "coll.h"
 #include "legate.h"
@@ -32,7 +46,9 @@ extern Logger log_coll;
 
 // public functions start from here
 
-LocalNetwork::LocalNetwork(int argc, char* argv[]) : BackendNetwork()
+LocalNetwork::LocalNetwork(int argc, char* argv[])
+  : BackendNetwork(),
+    stream_threshold(extract_env("LEGATE_COLL_STREAM_THRESHOLD", 1 << 20, 4096))
 {
   log_coll.debug("Enable LocalNetwork");
   assert(current_unique_id == 0);
@@ -63,6 +79,7 @@ int LocalNetwork::comm_create(CollComm global_comm,
   global_comm->global_rank      = global_rank;
   global_comm->status           = true;
   global_comm->unique_id        = unique_id;
+  global_comm->progress_thread  = nullptr;
   assert(mapping_table == nullptr);
   global_comm->mpi_comm_size        = 1;
   global_comm->mpi_comm_size_actual = 1;
@@ -75,10 +92,19 @@ int LocalNetwork::comm_create(CollComm global_comm,
       (const void**)malloc(sizeof(void*) * global_comm_size);
     thread_comms[global_comm->unique_id]->displs =
       (const int**)malloc(sizeof(int*) * global_comm_size);
+    thread_comms[global_comm->unique_id]->recvbuffers =
+      (void**)malloc(sizeof(void*) * global_comm_size);
+    thread_comms[global_comm->unique_id]->ready_epochs =
+      (uint32_t*)malloc(sizeof(uint32_t) * global_comm_size);
     for (int i = 0; i < global_comm_size; i++) {
-      thread_comms[global_comm->unique_id]->buffers[i] = nullptr;
-      thread_comms[global_comm->unique_id]->displs[i]  = nullptr;
+      thread_comms[global_comm->unique_id]->buffers[i]      = nullptr;
+      thread_comms[global_comm->unique_id]->displs[i]       = nullptr;
+      thread_comms[global_comm->unique_id]->recvbuffers[i]  = nullptr;
+      thread_comms[global_comm->unique_id]->ready_epochs[i] = 0;
     }
+    thread_comms[global_comm->unique_id]->done_count  = 0;
+    thread_comms[global_comm->unique_id]->done_epoch  = 0;
+    thread_comms[global_comm->unique_id]->num_waiters = 0;
     __sync_synchronize();
     thread_comms[global_comm->unique_id]->ready_flag = true;
   }
@@ -103,6 +129,10 @@ int LocalNetwork::comm_destroy(CollComm global_comm)
     thread_comms[global_comm->unique_id]->buffers = nullptr;
     free(thread_comms[global_comm->unique_id]->displs);
     thread_comms[global_comm->unique_id]->displs = nullptr;
+    free(thread_comms[global_comm->unique_id]->recvbuffers);
+    thread_comms[global_comm->unique_id]->recvbuffers = nullptr;
+    free(const_cast<uint32_t*>(thread_comms[global_comm->unique_id]->ready_epochs));
+    thread_comms[global_comm->unique_id]->ready_epochs = nullptr;
     __sync_synchronize();
     thread_comms[global_comm->unique_id]->ready_flag = false;
   }
@@ -120,9 +150,11 @@ int LocalNetwork::init_comm()
   assert(thread_comms.size() == id);
   // create thread comm
   ThreadComm* thread_comm = (ThreadComm*)malloc(sizeof(ThreadComm));
-  thread_comm->ready_flag = false;
-  thread_comm->buffers    = nullptr;
-  thread_comm->displs     = nullptr;
+  thread_comm->ready_flag   = false;
+  thread_comm->buffers      = nullptr;
+  thread_comm->displs       = nullptr;
+  thread_comm->recvbuffers  = nullptr;
+  thread_comm->ready_epochs = nullptr;
   thread_comms.push_back(thread_comm);
   log_coll.debug("Init comm id %d", id);
   return id;
@@ -146,7 +178,7 @@ int LocalNetwork::alltoallv(const void* sendbuf,
 
   global_comm->local_comm->displs[global_rank]  = sdispls;
   global_comm->local_comm->buffers[global_rank] = sendbuf;
-  __sync_synchronize();
+  uint32_t epoch                                = publishLocal(global_comm);
 
   int recvfrom_global_rank;
   int recvfrom_seg_id  = global_rank;
@@ -155,9 +187,7 @@ int LocalNetwork::alltoallv(const void* sendbuf,
   for (int i = 1; i < total_size + 1; i++) {
     recvfrom_global_rank = (global_rank + total_size - i) % total_size;
     // wait for other threads to update the buffer address
-    while (global_comm->local_comm->buffers[recvfrom_global_rank] == nullptr ||
-           global_comm->local_comm->displs[recvfrom_global_rank] == nullptr)
-      ;
+    waitForPeer(global_comm, recvfrom_global_rank, epoch);
     src_base  = global_comm->local_comm->buffers[recvfrom_global_rank];
     displs    = global_comm->local_comm->displs[recvfrom_global_rank];
     char* src = static_cast<char*>(const_cast<void*>(src_base)) +
@@ -181,15 +211,10 @@ int LocalNetwork::alltoallv(const void* sendbuf,
       rdispls[recvfrom_global_rank],
       dst);
 #endif
-    memcpy(dst, src, recvcounts[recvfrom_global_rank] * type_extent);
+    copySegment(dst, src, recvcounts[recvfrom_global_rank] * type_extent);
   }
 
-  barrierLocal(global_comm);
-
-  __sync_synchronize();
-
-  resetLocalBuffer(global_comm);
-  barrierLocal(global_comm);
+  completeLocal(global_comm, epoch);
 
   return CollSuccess;
 }
@@ -205,7 +230,7 @@ int LocalNetwork::alltoall(
   int type_extent = getDtypeSize(type);
 
   global_comm->local_comm->buffers[global_rank] = sendbuf;
-  __sync_synchronize();
+  uint32_t epoch                                = publishLocal(global_comm);
 
   int recvfrom_global_rank;
   int recvfrom_seg_id  = global_rank;
@@ -213,8 +238,7 @@ int LocalNetwork::alltoall(
   for (int i = 1; i < total_size + 1; i++) {
     recvfrom_global_rank = (global_rank + total_size - i) % total_size;
     // wait for other threads to update the buffer address
-    while (global_comm->local_comm->buffers[recvfrom_global_rank] == nullptr)
-      ;
+    waitForPeer(global_comm, recvfrom_global_rank, epoch);
     src_base  = global_comm->local_comm->buffers[recvfrom_global_rank];
     char* src = static_cast<char*>(const_cast<void*>(src_base)) +
                 static_cast<ptrdiff_t>(recvfrom_seg_id) * type_extent * count;
@@ -234,15 +258,10 @@ int LocalNetwork::alltoall(
       recvfrom_global_rank,
       dst);
 #endif
-    memcpy(dst, src, count * type_extent);
+    copySegment(dst, src, count * type_extent);
   }
 
-  barrierLocal(global_comm);
-
-  __sync_synchronize();
-
-  resetLocalBuffer(global_comm);
-  barrierLocal(global_comm);
+  completeLocal(global_comm, epoch);
 
   return CollSuccess;
 }
@@ -261,12 +280,11 @@ int LocalNetwork::allgather(
   if (sendbuf == recvbuf) { sendbuf_tmp = allocateInplaceBuffer(recvbuf, type_extent * count); }
 
   global_comm->local_comm->buffers[global_rank] = sendbuf_tmp;
-  __sync_synchronize();
+  uint32_t epoch                                = publishLocal(global_comm);
 
   for (int recvfrom_global_rank = 0; recvfrom_global_rank < total_size; recvfrom_global_rank++) {
     // wait for other threads to update the buffer address
-    while (global_comm->local_comm->buffers[recvfrom_global_rank] == nullptr)
-      ;
+    waitForPeer(global_comm, recvfrom_global_rank, epoch);
     const void* src = global_comm->local_comm->buffers[recvfrom_global_rank];
     char* dst       = static_cast<char*>(recvbuf) +
                 static_cast<ptrdiff_t>(recvfrom_global_rank) * type_extent * count;
@@ -281,63 +299,176 @@ int LocalNetwork::allgather(
       global_rank,
       dst);
 #endif
-    memcpy(dst, src, count * type_extent);
+    copySegment(dst, src, count * type_extent);
   }
 
-  barrierLocal(global_comm);
+  completeLocal(global_comm, epoch);
   if (sendbuf == recvbuf) { free(const_cast<void*>(sendbuf_tmp)); }
 
-  __sync_synchronize();
+  return CollSuccess;
+}
 
-  resetLocalBuffer(global_comm);
-  barrierLocal(global_comm);
+int LocalNetwork::allreduce(const void* sendbuf,
+                            void* recvbuf,
+                            int count,
+                            CollDataType type,
+                            CollRedOp redop,
+                            CollComm global_comm)
+{
+  int total_size  = global_comm->global_comm_size;
+  int global_rank = global_comm->global_rank;
+
+  int type_extent = getDtypeSize(type);
+
+  global_comm->local_comm->buffers[global_rank]     = sendbuf;
+  global_comm->local_comm->recvbuffers[global_rank] = recvbuf;
+  uint32_t epoch                                    = publishLocal(global_comm);
+
+  // Each rank reduces its own chunk of the buffers from all ranks and writes the result
+  // to every rank's receive buffer. No rank reads the chunk that another rank writes to,
+  // so this also works in place.
+  int chunk_lo = static_cast<int>(static_cast<int64_t>(count) * global_rank / total_size);
+  int chunk_hi = static_cast<int>(static_cast<int64_t>(count) * (global_rank + 1) / total_size);
+  int chunk    = chunk_hi - chunk_lo;
+  ptrdiff_t chunk_offset = static_cast<ptrdiff_t>(chunk_lo) * type_extent;
+
+  for (int i = 0; i < total_size; i++) waitForPeer(global_comm, i, epoch);
+
+  if (chunk > 0) {
+    char* result = static_cast<char*>(malloc(chunk * type_extent));
+    assert(result != nullptr);
+    memcpy(result, static_cast<const char*>(sendbuf) + chunk_offset, chunk * type_extent);
+    for (int i = 1; i < total_size; i++) {
+      int peer        = (global_rank + i) % total_size;
+      const char* src = static_cast<const char*>(global_comm->local_comm->buffers[peer]);
+      reduceBuffer(result, src + chunk_offset, chunk, type, redop);
+    }
+#ifdef DEBUG_LEGATE
+    log_coll.debug("AllreduceLocal: global_rank %d, dtype %d, reduced elements [%d, %d)",
+                   global_rank,
+                   type_extent,
+                   chunk_lo,
+                   chunk_hi);
+#endif
+    for (int i = 0; i < total_size; i++) {
+      char* dst = static_cast<char*>(global_comm->local_comm->recvbuffers[i]);
+      copySegment(dst + chunk_offset, result, chunk * type_extent);
+    }
+    free(result);
+  }
+
+  completeLocal(global_comm, epoch);
+
+  return CollSuccess;
+}
+
+int LocalNetwork::reduce_scatter(const void* sendbuf,
+                                 void* recvbuf,
+                                 int recvcount,
+                                 CollDataType type,
+                                 CollRedOp redop,
+                                 CollComm global_comm)
+{
+  int total_size  = global_comm->global_comm_size;
+  int global_rank = global_comm->global_rank;
+
+  int type_extent = getDtypeSize(type);
+
+  global_comm->local_comm->buffers[global_rank] = sendbuf;
+  uint32_t epoch                                = publishLocal(global_comm);
+
+  ptrdiff_t block_offset = static_cast<ptrdiff_t>(global_rank) * recvcount * type_extent;
+  memcpy(recvbuf, static_cast<const char*>(sendbuf) + block_offset, recvcount * type_extent);
+  for (int i = 1; i < total_size; i++) {
+    int peer = (global_rank + i) % total_size;
+    // wait for other threads to update the buffer address
+    waitForPeer(global_comm, peer, epoch);
+    const char* src = static_cast<const char*>(global_comm->local_comm->buffers[peer]);
+    reduceBuffer(recvbuf, src + block_offset, recvcount, type, redop);
+  }
+
+  completeLocal(global_comm, epoch);
 
   return CollSuccess;
 }
 
 // protected functions start from here
 
-size_t LocalNetwork::getDtypeSize(CollDataType dtype)
+static constexpr int SPIN_COUNT = 4096;
+
+static inline void cpu_relax()
 {
-  switch (dtype) {
-    case CollDataType::CollInt8:
-    case CollDataType::CollChar: {
-      return sizeof(char);
-    }
-    case CollDataType::CollUint8: {
-      return sizeof(uint8_t);
-    }
-    case CollDataType::CollInt: {
-      return sizeof(int);
-    }
-    case CollDataType::CollUint32: {
-      return sizeof(uint32_t);
-    }
-    case CollDataType::CollInt64: {
-      return sizeof(int64_t);
-    }
-    case CollDataType::CollUint64: {
-      return sizeof(uint64_t);
-    }
-    case CollDataType::CollFloat: {
-      return sizeof(float);
-    }
-    case CollDataType::CollDouble: {
-      return sizeof(double);
-    }
-    default: {
-      log_coll.fatal("Unknown datatype");
-      LEGATE_ABORT;
-      return 0;
-    }
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield" ::: "memory");
+#endif
+}
+
+// Spins for a while on 'addr' and then falls back to sleeping in the kernel until the word
+// reaches 'target'. Values stored to the word only ever move forward, so we can always sleep
+// on whatever value we last observed.
+static void wait_for_epoch(volatile uint32_t* addr, uint32_t target, volatile int* num_waiters)
+{
+  for (int i = 0; i < SPIN_COUNT; i++) {
+    if (__atomic_load_n(addr, __ATOMIC_ACQUIRE) == target) return;
+    cpu_relax();
   }
+  while (true) {
+    uint32_t observed = __atomic_load_n(addr, __ATOMIC_SEQ_CST);
+    if (observed == target) return;
+    __atomic_add_fetch(num_waiters, 1, __ATOMIC_SEQ_CST);
+#ifdef __linux__
+    syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, observed, nullptr, nullptr, 0);
+#else
+    sched_yield();
+#endif
+    __atomic_sub_fetch(num_waiters, 1, __ATOMIC_SEQ_CST);
+  }
+}
+
+static void store_epoch(volatile uint32_t* addr, uint32_t value, volatile int* num_waiters)
+{
+  __atomic_store_n(addr, value, __ATOMIC_SEQ_CST);
+#ifdef __linux__
+  // only pay for the system call when somebody has actually gone to sleep
+  if (__atomic_load_n(num_waiters, __ATOMIC_SEQ_CST) > 0)
+    syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#endif
 }
 
-void LocalNetwork::resetLocalBuffer(CollComm global_comm)
+uint32_t LocalNetwork::publishLocal(CollComm global_comm)
 {
-  int global_rank                               = global_comm->global_rank;
-  global_comm->local_comm->buffers[global_rank] = nullptr;
-  global_comm->local_comm->displs[global_rank]  = nullptr;
+  ThreadComm* local_comm = const_cast<ThreadComm*>(global_comm->local_comm);
+  // The epoch can only advance once every rank, including this one, has finished the
+  // current collective, so it is stable for the whole call.
+  uint32_t epoch = __atomic_load_n(&local_comm->done_epoch, __ATOMIC_ACQUIRE);
+  store_epoch(
+    &local_comm->ready_epochs[global_comm->global_rank], epoch + 1, &local_comm->num_waiters);
+  return epoch;
+}
+
+void LocalNetwork::waitForPeer(CollComm global_comm, int peer, uint32_t epoch)
+{
+  ThreadComm* local_comm = const_cast<ThreadComm*>(global_comm->local_comm);
+  wait_for_epoch(&local_comm->ready_epochs[peer], epoch + 1, &local_comm->num_waiters);
+}
+
+void LocalNetwork::completeLocal(CollComm global_comm, uint32_t epoch)
+{
+  ThreadComm* local_comm = const_cast<ThreadComm*>(global_comm->local_comm);
+  uint32_t arrived       = __atomic_add_fetch(&local_comm->done_count, 1, __ATOMIC_ACQ_REL);
+  if (arrived == static_cast<uint32_t>(global_comm->global_comm_size)) {
+    // Nobody can touch the counter again before the epoch moves, so a plain reset is safe
+    __atomic_store_n(&local_comm->done_count, 0, __ATOMIC_RELAXED);
+    store_epoch(&local_comm->done_epoch, epoch + 1, &local_comm->num_waiters);
+  } else
+    wait_for_epoch(&local_comm->done_epoch, epoch + 1, &local_comm->num_waiters);
+}
+
+void LocalNetwork::copySegment(void* dst, const void* src, size_t bytes)
+{
+  streamCopy(dst, src, bytes, stream_threshold);
 }
 
 void LocalNetwork::barrierLocal(CollComm global_comm)
@@ -346,6 +477,34 @@ void LocalNetwork::barrierLocal(CollComm global_comm)
   pthread_barrier_wait(const_cast<pthread_barrier_t*>(&(global_comm->local_comm->barrier)));
 }
 
+void streamCopy(void* dst, const void* src, size_t bytes, size_t stream_threshold)
+{
+#ifdef __SSE2__
+  if (bytes >= stream_threshold) {
+    // Large segments are written with non-temporal stores, which skip the read-for-ownership
+    // of the destination lines and keep the receive buffer from evicting the rest of the
+    // cache. This matters most when the source lives on the other socket.
+    char* d       = static_cast<char*>(dst);
+    const char* s = static_cast<const char*>(src);
+    size_t head   = std::min(bytes, (16 - (reinterpret_cast<uintptr_t>(d) & 15)) & 15);
+    memcpy(d, s, head);
+    d += head;
+    s += head;
+    bytes -= head;
+    size_t num_vecs = bytes / 16;
+    for (size_t i = 0; i < num_vecs; i++) {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s) + i);
+      _mm_stream_si128(reinterpret_cast<__m128i*>(d) + i, v);
+    }
+    memcpy(d + num_vecs * 16, s + num_vecs * 16, bytes - num_vecs * 16);
+    // make the streaming stores visible before the peers are told we are done
+    _mm_sfence();
+    return;
+  }
+#endif
+  memcpy(dst, src, bytes);
+}
+
 }  // namespace coll
 }  // namespace comm
 }  // namespace legate
\ No newline at end of file
@@ -15,9 +15,12 @@
  */
 
 #include <assert.h>
+#include <sched.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
+#include <vector>
 
 #include "coll.h"
 #include "legate.h"
@@ -31,11 +34,13 @@ using namespace Legion;
 extern Logger log_coll;
 
 enum CollTag : int {
-  BCAST_TAG     = 0,
-  GATHER_TAG    = 1,
-  ALLTOALL_TAG  = 2,
-  ALLTOALLV_TAG = 3,
-  MAX_TAG       = 10,
+  BCAST_TAG          = 0,
+  GATHER_TAG         = 1,
+  ALLTOALL_TAG       = 2,
+  ALLTOALLV_TAG      = 3,
+  ALLREDUCE_TAG      = 4,
+  REDUCE_SCATTER_TAG = 5,
+  MAX_TAG            = 10,
 };
 
 static inline std::pair<int, int> mostFrequent(const int* arr, int n);
@@ -60,10 +65,25 @@ inline void check_mpi(int error, const char* file, int line)
     check_mpi(result, __FILE__, __LINE__); \
   } while (false)
 
+static constexpr int SPIN_COUNT = 4096;
+
+// Spins for a while until 'done' returns true and then yields the processor between checks, so
+// ranks waiting on a peer thread don't starve it of its core
+template <typename Done>
+static void spin_wait(Done&& done)
+{
+  for (int i = 0; i < SPIN_COUNT; i++)
+    if (done()) return;
+  while (!done()) sched_yield();
+}
+
 // public functions start from here
 
 MPINetwork::MPINetwork(int argc, char* argv[])
-  : BackendNetwork(), mpi_tag_ub(0), self_init_mpi(false)
+  : BackendNetwork(),
+    mpi_tag_ub(0),
+    self_init_mpi(false),
+    p2p_window(std::max<int>(extract_env("LEGATE_COLL_P2P_WINDOW", 8, 2), 1))
 {
   log_coll.debug("Enable MPINetwork");
   assert(current_unique_id == 0);
@@ -99,6 +119,11 @@ MPINetwork::~MPINetwork()
   assert(BackendNetwork::coll_inited == true);
   for (MPI_Comm& mpi_comm : mpi_comms) { CHECK_MPI(MPI_Comm_free(&mpi_comm)); }
   mpi_comms.clear();
+  for (ThreadComm* thread_comm : thread_comms) {
+    assert(!thread_comm->ready_flag);
+    free(thread_comm);
+  }
+  thread_comms.clear();
   int fina_flag = 0;
   CHECK_MPI(MPI_Finalized(&fina_flag));
   if (fina_flag == 1) {
@@ -128,6 +153,17 @@ int MPINetwork::init_comm()
   MPI_Comm mpi_comm;
   CHECK_MPI(MPI_Comm_dup(MPI_COMM_WORLD, &mpi_comm));
   mpi_comms.push_back(mpi_comm);
+  // create thread comm for the ranks in this process
+  ThreadComm* thread_comm = (ThreadComm*)malloc(sizeof(ThreadComm));
+  thread_comm->ready_flag  = false;
+  thread_comm->buffers     = nullptr;
+  thread_comm->displs      = nullptr;
+  thread_comm->recvbuffers = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(thread_comms_mutex);
+    assert(thread_comms.size() == id);
+    thread_comms.push_back(thread_comm);
+  }
   log_coll.debug("Init comm id %d", id);
   return id;
 }
@@ -142,6 +178,7 @@ int MPINetwork::comm_create(CollComm global_comm,
   global_comm->global_rank      = global_rank;
   global_comm->status           = true;
   global_comm->unique_id        = unique_id;
+  global_comm->progress_thread  = nullptr;
   int mpi_rank, mpi_comm_size;
   int *tag_ub, flag;
   int compare_result;
@@ -162,11 +199,55 @@ int MPINetwork::comm_create(CollComm global_comm,
   std::pair<int, int> p             = mostFrequent(mapping_table, global_comm_size);
   global_comm->nb_threads           = p.first;
   global_comm->mpi_comm_size_actual = p.second;
+
+  // The lowest global rank in this process sets up the shared state for the ranks in the process
+  int num_local_ranks  = 0;
+  int first_local_rank = -1;
+  for (int i = 0; i < global_comm_size; i++) {
+    if (mapping_table[i] != mpi_rank) continue;
+    if (first_local_rank == -1) first_local_rank = i;
+    ++num_local_ranks;
+  }
+  ThreadComm* thread_comm = getThreadComm(unique_id);
+  if (global_rank == first_local_rank) {
+    pthread_barrier_init((pthread_barrier_t*)&(thread_comm->barrier), nullptr, num_local_ranks);
+    thread_comm->buffers = (const void**)malloc(sizeof(void*) * global_comm_size);
+    thread_comm->displs  = (const int**)malloc(sizeof(int*) * global_comm_size);
+    for (int i = 0; i < global_comm_size; i++) {
+      thread_comm->buffers[i] = nullptr;
+      thread_comm->displs[i]  = nullptr;
+    }
+    __sync_synchronize();
+    thread_comm->ready_flag = true;
+  }
+  __sync_synchronize();
+  volatile ThreadComm* data = thread_comm;
+  spin_wait([&] { return data->ready_flag == true; });
+  global_comm->local_comm = thread_comm;
+  barrierLocal(global_comm);
   return CollSuccess;
 }
 
 int MPINetwork::comm_destroy(CollComm global_comm)
 {
+  barrierLocal(global_comm);
+  int first_local_rank = -1;
+  for (int i = 0; i < global_comm->global_comm_size && first_local_rank == -1; i++)
+    if (global_comm->mapping_table.mpi_rank[i] == global_comm->mpi_rank) first_local_rank = i;
+  ThreadComm* thread_comm = getThreadComm(global_comm->unique_id);
+  if (global_comm->global_rank == first_local_rank) {
+    pthread_barrier_destroy((pthread_barrier_t*)&(thread_comm->barrier));
+    free(thread_comm->buffers);
+    thread_comm->buffers = nullptr;
+    free(thread_comm->displs);
+    thread_comm->displs = nullptr;
+    __sync_synchronize();
+    thread_comm->ready_flag = false;
+  }
+  __sync_synchronize();
+  volatile ThreadComm* data = thread_comm;
+  spin_wait([&] { return data->ready_flag == false; });
+
   if (global_comm->mapping_table.global_rank != nullptr) {
     free(global_comm->mapping_table.global_rank);
     global_comm->mapping_table.global_rank = nullptr;
@@ -188,25 +269,37 @@ int MPINetwork::alltoallv(const void* sendbuf,
                           CollDataType type,
                           CollComm global_comm)
 {
-  MPI_Status status;
-
   int total_size  = global_comm->global_comm_size;
   int global_rank = global_comm->global_rank;
+  int mpi_rank    = global_comm->mpi_rank;
 
   MPI_Datatype mpi_type = dtypeToMPIDtype(type);
 
   MPI_Aint lb, type_extent;
   MPI_Type_get_extent(mpi_type, &lb, &type_extent);
 
+  // Segments for the ranks in the same process are copied directly from their send buffers,
+  // so we publish our send buffer to them first
+  volatile ThreadComm* local_comm  = global_comm->local_comm;
+  local_comm->displs[global_rank]  = sdispls;
+  local_comm->buffers[global_rank] = sendbuf;
+  __sync_synchronize();
+
+  // Segments for the ranks in the other processes are exchanged with non-blocking messages,
+  // with at most p2p_window exchanges in flight.
+  // TODO: Each rank still sends its own message to each remote rank. Packing the segments of
+  // all ranks in this process into one message per process pair needs the counts of the peers
+  // on both sides and is left for a follow-up.
+  std::vector<MPI_Request> requests;
+  requests.reserve(2 * p2p_window);
+  int num_inflight = 0;
+
   int sendto_global_rank, recvfrom_global_rank, sendto_mpi_rank, recvfrom_mpi_rank;
   for (int i = 1; i < total_size + 1; i++) {
     sendto_global_rank   = (global_rank + i) % total_size;
     recvfrom_global_rank = (global_rank + total_size - i) % total_size;
-    char* src            = static_cast<char*>(const_cast<void*>(sendbuf)) +
-                static_cast<ptrdiff_t>(sdispls[sendto_global_rank]) * type_extent;
-    char* dst = static_cast<char*>(recvbuf) +
+    char* dst            = static_cast<char*>(recvbuf) +
                 static_cast<ptrdiff_t>(rdispls[recvfrom_global_rank]) * type_extent;
-    int scount        = sendcounts[sendto_global_rank];
     int rcount        = recvcounts[recvfrom_global_rank];
     sendto_mpi_rank   = global_comm->mapping_table.mpi_rank[sendto_global_rank];
     recvfrom_mpi_rank = global_comm->mapping_table.mpi_rank[recvfrom_global_rank];
@@ -222,7 +315,7 @@ int MPINetwork::alltoallv(const void* sendbuf,
       "recv_tag %d",
       i,
       global_rank,
-      global_comm->mpi_rank,
+      mpi_rank,
       sendto_global_rank,
       sendto_mpi_rank,
       send_tag,
@@ -230,19 +323,55 @@ int MPINetwork::alltoallv(const void* sendbuf,
       recvfrom_mpi_rank,
       recv_tag);
 #endif
-    CHECK_MPI(MPI_Sendrecv(src,
-                           scount,
-                           mpi_type,
-                           sendto_mpi_rank,
-                           send_tag,
-                           dst,
-                           rcount,
-                           mpi_type,
-                           recvfrom_mpi_rank,
-                           recv_tag,
-                           global_comm->mpi_comm,
-                           &status));
+    if (sendto_mpi_rank != mpi_rank) {
+      char* src = static_cast<char*>(const_cast<void*>(sendbuf)) +
+                  static_cast<ptrdiff_t>(sdispls[sendto_global_rank]) * type_extent;
+      requests.emplace_back();
+      CHECK_MPI(MPI_Isend(src,
+                          sendcounts[sendto_global_rank],
+                          mpi_type,
+                          sendto_mpi_rank,
+                          send_tag,
+                          global_comm->mpi_comm,
+                          &requests.back()));
+    }
+    if (recvfrom_mpi_rank != mpi_rank) {
+      requests.emplace_back();
+      CHECK_MPI(MPI_Irecv(dst,
+                          rcount,
+                          mpi_type,
+                          recvfrom_mpi_rank,
+                          recv_tag,
+                          global_comm->mpi_comm,
+                          &requests.back()));
+    } else {
+      // wait for the other thread to update the buffer address
+      spin_wait([&] {
+        return local_comm->buffers[recvfrom_global_rank] != nullptr &&
+               local_comm->displs[recvfrom_global_rank] != nullptr;
+      });
+      const void* src_base = local_comm->buffers[recvfrom_global_rank];
+      const int* displs    = local_comm->displs[recvfrom_global_rank];
+      const char* src      = static_cast<const char*>(src_base) +
+                        static_cast<ptrdiff_t>(displs[global_rank]) * type_extent;
+      memcpy(dst, src, rcount * type_extent);
+    }
+
+    if (requests.size() > 0 && ++num_inflight == p2p_window) {
+      CHECK_MPI(MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE));
+      requests.clear();
+      num_inflight = 0;
+    }
   }
+  if (!requests.empty())
+    CHECK_MPI(MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE));
+
+  // The other ranks in this process may still be reading from our send buffer
+  barrierLocal(global_comm);
+  __sync_synchronize();
+  local_comm->buffers[global_rank] = nullptr;
+  local_comm->displs[global_rank]  = nullptr;
+  barrierLocal(global_comm);
 
   return CollSuccess;
 }
@@ -332,6 +461,112 @@ int MPINetwork::allgather(
   return CollSuccess;
 }
 
+int MPINetwork::allreduce(const void* sendbuf,
+                          void* recvbuf,
+                          int count,
+                          CollDataType type,
+                          CollRedOp redop,
+                          CollComm global_comm)
+{
+  MPI_Status status;
+
+  int total_size  = global_comm->global_comm_size;
+  int global_rank = global_comm->global_rank;
+
+  MPI_Datatype mpi_type = dtypeToMPIDtype(type);
+
+  MPI_Aint lb, type_extent;
+  MPI_Type_get_extent(mpi_type, &lb, &type_extent);
+
+  if (sendbuf != recvbuf) memcpy(recvbuf, sendbuf, type_extent * count);
+  if (total_size == 1) return CollSuccess;
+
+  // split the buffer into one block per rank
+  std::vector<int> offsets(total_size + 1);
+  for (int i = 0; i <= total_size; i++)
+    offsets[i] = static_cast<int>(static_cast<int64_t>(count) * i / total_size);
+
+  char* buffer = static_cast<char*>(recvbuf);
+
+  // after this, each rank holds the fully reduced block (global_rank + 1)
+  ringReduceScatter(
+    buffer, offsets.data(), type_extent, type, redop, 1, CollTag::ALLREDUCE_TAG, global_comm);
+
+  // circulate the reduced blocks around the ring
+  int sendto_global_rank   = (global_rank + 1) % total_size;
+  int recvfrom_global_rank = (global_rank + total_size - 1) % total_size;
+  int sendto_mpi_rank      = global_comm->mapping_table.mpi_rank[sendto_global_rank];
+  int recvfrom_mpi_rank    = global_comm->mapping_table.mpi_rank[recvfrom_global_rank];
+  int send_tag =
+    generateRingTag(sendto_global_rank, global_rank, CollTag::ALLREDUCE_TAG, global_comm);
+  int recv_tag =
+    generateRingTag(global_rank, recvfrom_global_rank, CollTag::ALLREDUCE_TAG, global_comm);
+  for (int step = 0; step < total_size - 1; step++) {
+    int send_block = (global_rank + 1 - step + total_size) % total_size;
+    int recv_block = (global_rank - step + total_size) % total_size;
+#ifdef DEBUG_LEGATE
+    log_coll.debug(
+      "AllreduceMPI step: %d === global_rank %d, send block %d to %d, recv block %d from %d",
+      step,
+      global_rank,
+      send_block,
+      sendto_global_rank,
+      recv_block,
+      recvfrom_global_rank);
+#endif
+    CHECK_MPI(MPI_Sendrecv(buffer + static_cast<ptrdiff_t>(offsets[send_block]) * type_extent,
+                           offsets[send_block + 1] - offsets[send_block],
+                           mpi_type,
+                           sendto_mpi_rank,
+                           send_tag,
+                           buffer + static_cast<ptrdiff_t>(offsets[recv_block]) * type_extent,
+                           offsets[recv_block + 1] - offsets[recv_block],
+                           mpi_type,
+                           recvfrom_mpi_rank,
+                           recv_tag,
+                           global_comm->mpi_comm,
+                           &status));
+  }
+
+  return CollSuccess;
+}
+
+int MPINetwork::reduce_scatter(const void* sendbuf,
+                               void* recvbuf,
+                               int recvcount,
+                               CollDataType type,
+                               CollRedOp redop,
+                               CollComm global_comm)
+{
+  int total_size  = global_comm->global_comm_size;
+  int global_rank = global_comm->global_rank;
+
+  MPI_Datatype mpi_type = dtypeToMPIDtype(type);
+
+  MPI_Aint lb, type_extent;
+  MPI_Type_get_extent(mpi_type, &lb, &type_extent);
+
+  size_t block_size = static_cast<size_t>(type_extent) * recvcount;
+  if (total_size == 1) {
+    memcpy(recvbuf, sendbuf, block_size);
+    return CollSuccess;
+  }
+
+  // the ring reduces in place, so work on a copy of the send buffer
+  char* buffer = static_cast<char*>(allocateInplaceBuffer(sendbuf, block_size * total_size));
+
+  std::vector<int> offsets(total_size + 1);
+  for (int i = 0; i <= total_size; i++) offsets[i] = i * recvcount;
+
+  ringReduceScatter(
+    buffer, offsets.data(), type_extent, type, redop, 0, CollTag::REDUCE_SCATTER_TAG, global_comm);
+
+  memcpy(recvbuf, buffer + block_size * global_rank, block_size);
+  free(buffer);
+
+  return CollSuccess;
+}
+
 int MPINetwork::gather(
   const void* sendbuf, void* recvbuf, int count, CollDataType type, int root, CollComm global_comm)
 {
@@ -534,6 +769,16 @@ MPI_Datatype MPINetwork::dtypeToMPIDtype(CollDataType dtype)
     case CollDataType::CollDouble: {
       return MPI_DOUBLE;
     }
+    case CollDataType::CollInt16: {
+      return MPI_INT16_T;
+    }
+    case CollDataType::CollUint16: {
+      return MPI_UINT16_T;
+    }
+    // MPI has no half type, but it only moves the values; the reductions happen in reduceBuffer
+    case CollDataType::CollHalf: {
+      return MPI_UINT16_T;
+    }
     default: {
       log_coll.fatal("Unknown datatype");
       LEGATE_ABORT;
@@ -542,6 +787,86 @@ MPI_Datatype MPINetwork::dtypeToMPIDtype(CollDataType dtype)
   }
 }
 
+void MPINetwork::ringReduceScatter(char* buffer,
+                                   const int* offsets,
+                                   MPI_Aint type_extent,
+                                   CollDataType type,
+                                   CollRedOp redop,
+                                   int shift,
+                                   int tag_base,
+                                   CollComm global_comm)
+{
+  MPI_Status status;
+
+  int total_size  = global_comm->global_comm_size;
+  int global_rank = global_comm->global_rank;
+
+  MPI_Datatype mpi_type = dtypeToMPIDtype(type);
+
+  int max_block = 0;
+  for (int i = 0; i < total_size; i++) max_block = std::max(max_block, offsets[i + 1] - offsets[i]);
+  char* tmp = static_cast<char*>(malloc(std::max<size_t>(max_block * type_extent, 1)));
+  assert(tmp != nullptr);
+
+  int sendto_global_rank   = (global_rank + 1) % total_size;
+  int recvfrom_global_rank = (global_rank + total_size - 1) % total_size;
+  int sendto_mpi_rank      = global_comm->mapping_table.mpi_rank[sendto_global_rank];
+  int recvfrom_mpi_rank    = global_comm->mapping_table.mpi_rank[recvfrom_global_rank];
+
+  int send_tag = generateRingTag(sendto_global_rank, global_rank, tag_base, global_comm);
+  int recv_tag = generateRingTag(global_rank, recvfrom_global_rank, tag_base, global_comm);
+
+  // block b travels from rank b - shift + 1 around the ring, picking up one contribution
+  // per hop, and arrives fully reduced at rank b - shift after total_size - 1 steps
+  for (int step = 0; step < total_size - 1; step++) {
+    int send_block = ((global_rank + shift - 1 - step) % total_size + total_size) % total_size;
+    int recv_block = ((global_rank + shift - 2 - step) % total_size + total_size) % total_size;
+    int recv_count = offsets[recv_block + 1] - offsets[recv_block];
+#ifdef DEBUG_LEGATE
+    log_coll.debug(
+      "RingReduceScatterMPI step: %d === global_rank %d, send block %d to %d, recv block %d "
+      "from %d",
+      step,
+      global_rank,
+      send_block,
+      sendto_global_rank,
+      recv_block,
+      recvfrom_global_rank);
+#endif
+    CHECK_MPI(MPI_Sendrecv(buffer + static_cast<ptrdiff_t>(offsets[send_block]) * type_extent,
+                           offsets[send_block + 1] - offsets[send_block],
+                           mpi_type,
+                           sendto_mpi_rank,
+                           send_tag,
+                           tmp,
+                           recv_count,
+                           mpi_type,
+                           recvfrom_mpi_rank,
+                           recv_tag,
+                           global_comm->mpi_comm,
+                           &status));
+    reduceBuffer(buffer + static_cast<ptrdiff_t>(offsets[recv_block]) * type_extent,
+                 tmp,
+                 recv_count,
+                 type,
+                 redop);
+  }
+
+  free(tmp);
+}
+
+void MPINetwork::barrierLocal(CollComm global_comm)
+{
+  assert(BackendNetwork::coll_inited == true);
+  pthread_barrier_wait(const_cast<pthread_barrier_t*>(&(global_comm->local_comm->barrier)));
+}
+
+ThreadComm* MPINetwork::getThreadComm(int unique_id)
+{
+  std::lock_guard<std::mutex> lock(thread_comms_mutex);
+  return thread_comms[unique_id];
+}
+
 int MPINetwork::generateAlltoallTag(int rank1, int rank2, CollComm global_comm)
 {
   int tag = match2ranks(rank1, rank2, global_comm) * CollTag::MAX_TAG + CollTag::ALLTOALL_TAG;
@@ -570,6 +895,13 @@ int MPINetwork::generateGatherTag(int rank, CollComm global_comm)
   return tag;
 }
 
+int MPINetwork::generateRingTag(int rank1, int rank2, int tag_base, CollComm global_comm)
+{
+  int tag = match2ranks(rank1, rank2, global_comm) * CollTag::MAX_TAG + tag_base;
+  assert(tag <= mpi_tag_ub && tag > 0);
+  return tag;
+}
+
 }  // namespace coll
 }  // namespace comm
-}  // namespace legate
\ No newline at end of file
+}  // namespace legate
@@ -0,0 +1,167 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include "core/cuda/cuda_help.h"
+#include "core/cuda/graph_cache.h"
+#include "core/cuda/stream_pool.h"
+#include "core/data/scalar.h"
+#include "core/data/store.h"
+#include "core/runtime/context.h"
+
+namespace legate {
+namespace cuda {
+
+using namespace Legion;
+
+// Maximum number of graphs cached for each GPU
+static constexpr size_t MAX_CACHED_GRAPHS = 64;
+
+namespace {
+
+struct GraphKey {
+  LegateVariantImpl body;
+  std::vector<int8_t> signature;
+
+  bool operator<(const GraphKey& other) const
+  {
+    return std::tie(body, signature) < std::tie(other.body, other.signature);
+  }
+};
+
+struct GraphCache {
+  // Each GPU has its own cache, so GPUs never contend for the lock
+  std::mutex lock{};
+  std::map<GraphKey, cudaGraphExec_t> graphs{};
+  // Keys of the graphs in the order they were cached, so the oldest can be evicted first
+  std::deque<GraphKey> order{};
+  // Signatures that ran once without being captured
+  std::set<GraphKey> seen{};
+};
+
+GraphCache& get_graph_cache()
+{
+  static GraphCache caches[LEGION_MAX_NUM_PROCS];
+  const auto proc = Processor::get_executing_processor();
+  return caches[proc.id & (LEGION_MAX_NUM_PROCS - 1)];
+}
+
+}  // namespace
+
+static void append(std::vector<int8_t>& signature, const void* ptr, size_t size)
+{
+  auto bytes = static_cast<const int8_t*>(ptr);
+  signature.insert(signature.end(), bytes, bytes + size);
+}
+
+static bool compute_signature(TaskContext& context, std::vector<int8_t>& signature)
+{
+  if (!context.reductions().empty() || !context.communicators().empty()) return false;
+  // A body that can raise an exception can't have its checks replayed
+  if (context.can_raise_exception()) return false;
+
+  for (auto* stores : {&context.inputs(), &context.outputs()})
+    for (auto& store : *stores) {
+      // Futures and unbound stores get new buffers every time, and transforms change how the
+      // body indexes the instance without showing up in the shape
+      if (store.is_future() || store.is_output_store() || store.transformed()) return false;
+      auto domain = store.domain();
+      auto code   = store.code<int32_t>();
+      // Kernels bake in the strides along with the base address, so an instance reallocated
+      // at the same address with a different layout needs a different graph
+      size_t strides[LEGION_MAX_DIM] = {0};
+      auto ptr                       = store.untyped_ptr(strides);
+      append(signature, &domain.dim, sizeof(domain.dim));
+      for (int32_t idx = 0; idx < domain.dim; ++idx) {
+        auto lo = domain.lo()[idx];
+        auto hi = domain.hi()[idx];
+        append(signature, &lo, sizeof(lo));
+        append(signature, &hi, sizeof(hi));
+      }
+      append(signature, &code, sizeof(code));
+      append(signature, &ptr, sizeof(ptr));
+      append(signature, strides, sizeof(size_t) * domain.dim);
+    }
+  for (auto& scalar : context.scalars()) append(signature, scalar.ptr(), scalar.size());
+  return true;
+}
+
+void run_graph_variant(TaskContext& context, LegateVariantImpl body)
+{
+  GraphKey key{body, {}};
+  if (!compute_signature(context, key.signature)) {
+    body(context);
+    return;
+  }
+
+  auto& cache          = get_graph_cache();
+  cudaGraphExec_t exec = nullptr;
+  bool capture         = false;
+  {
+    std::lock_guard<std::mutex> guard(cache.lock);
+    auto finder = cache.graphs.find(key);
+    if (finder != cache.graphs.end())
+      exec = finder->second;
+    else if (cache.seen.find(key) != cache.seen.end())
+      capture = true;
+    else {
+      // Signatures that never repeat shouldn't pile up
+      if (cache.seen.size() >= MAX_CACHED_GRAPHS) cache.seen.clear();
+      cache.seen.insert(key);
+    }
+  }
+
+  // From here on, the view's destructor synchronizes the stream or orders the task after it,
+  // as it does for any task body
+  auto stream = StreamPool::get_stream_pool().get_stream();
+
+  if (nullptr == exec && !capture) {
+    body(context);
+    return;
+  }
+
+  if (capture) {
+    // Nothing the body enqueues runs until the graph is launched below
+    CHECK_CUDA(cudaStreamBeginCapture(stream, cudaStreamCaptureModeThreadLocal));
+    body(context);
+    cudaGraph_t graph;
+    CHECK_CUDA(cudaStreamEndCapture(stream, &graph));
+    CHECK_CUDA(cudaGraphInstantiateWithFlags(&exec, graph, 0));
+    CHECK_CUDA(cudaGraphDestroy(graph));
+
+    std::lock_guard<std::mutex> guard(cache.lock);
+    cache.seen.erase(key);
+    if (cache.order.size() >= MAX_CACHED_GRAPHS) {
+      auto& oldest = cache.order.front();
+      CHECK_CUDA(cudaGraphExecDestroy(cache.graphs[oldest]));
+      cache.graphs.erase(oldest);
+      cache.order.pop_front();
+    }
+    cache.graphs[key] = exec;
+    cache.order.push_back(key);
+  }
+
+  CHECK_CUDA(cudaGraphLaunch(exec, stream));
+}
+
+}  // namespace cuda
+}  // namespace legate
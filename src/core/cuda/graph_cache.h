@@ -0,0 +1,43 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "core/task/fusion.h"
+
+namespace legate {
+
+class TaskContext;
+
+namespace cuda {
+
+// GPU variants registered with VariantOptions::cuda_graph have the stream work of their bodies
+// captured into a CUDA graph, which later executions replay instead of running the body again.
+// Such a body must only enqueue work on the primary stream, or on streams leased from the pool,
+// and that work must be fully determined by the shapes and instances of its stores and by its
+// scalar arguments. In particular, the body must not allocate temporary buffers. The option is
+// baked into the task wrapper of the variant when it is registered, so other variants don't
+// pay for it.
+
+// Runs the body of a graph variant. The first execution with a given signature, which is made
+// of the scalar arguments and the shapes and instances of the stores, runs the body as is, the
+// second one captures its stream work into a graph, and the rest replay that graph. Tasks whose
+// signature can't be computed, such as those with futures, reductions or communicators, always
+// run the body.
+void run_graph_variant(TaskContext& context, LegateVariantImpl body);
+
+}  // namespace cuda
+}  // namespace legate
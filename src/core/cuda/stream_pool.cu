@@ -14,25 +14,57 @@
  *
  */
 
+#include <algorithm>
+
 #include "core/cuda/cuda_help.h"
 #include "core/cuda/stream_pool.h"
 #include "core/runtime/runtime.h"
 
+#include "realm/cuda/cuda_module.h"
+
 namespace legate {
 namespace cuda {
 
+// Makes the waiter stream wait for the work enqueued on the signaler stream so far
+static void order_streams(cudaStream_t waiter, cudaStream_t signaler)
+{
+  if (waiter == signaler) return;
+  auto& pool = StreamPool::get_stream_pool();
+  auto event = pool.get_event();
+  CHECK_CUDA(cudaEventRecord(event, signaler));
+  CHECK_CUDA(cudaStreamWaitEvent(waiter, event, 0));
+  // The wait above captures the state of the event at the time of the call,
+  // so the event can be recycled right away
+  pool.release_event(event);
+}
+
 StreamView::~StreamView()
 {
-  if (valid_ && Core::synchronize_stream_view) {
+  if (!valid_) return;
+  // A leased stream is joined back into its parent, so completing the parent suffices
+  if (parent_ != nullptr) order_streams(parent_, stream_);
+  auto stream = parent_ != nullptr ? parent_ : stream_;
+  // Work captured into a CUDA graph runs only when the graph is launched, and the stream can't
+  // be synchronized in the meantime
+  cudaStreamCaptureStatus capture_status;
+  CHECK_CUDA(cudaStreamIsCapturing(stream, &capture_status));
+  if (capture_status != cudaStreamCaptureStatusNone) return;
+  if (Core::synchronize_stream_view) {
 #ifdef DEBUG_LEGATE
-    CHECK_CUDA_STREAM(stream_);
+    CHECK_CUDA_STREAM(stream);
 #else
-    CHECK_CUDA(cudaStreamSynchronize(stream_));
+    CHECK_CUDA(cudaStreamSynchronize(stream));
 #endif
-  }
+  } else if (Core::async_stream_view)
+    // Instead of blocking the processor thread, we make Realm's task stream wait for
+    // this stream, which makes the stream's work a precondition of the task's completion.
+    // Only variants that do all their GPU work through stream views can then skip the
+    // context synchronization at the end of the task (see skip_context_synchronization).
+    order_streams(Realm::Cuda::get_task_cuda_stream(), stream);
 }
 
-StreamView::StreamView(StreamView&& rhs) : valid_(rhs.valid_), stream_(rhs.stream_)
+StreamView::StreamView(StreamView&& rhs)
+  : valid_(rhs.valid_), stream_(rhs.stream_), parent_(rhs.parent_)
 {
   rhs.valid_ = false;
 }
@@ -41,23 +73,121 @@ StreamView& StreamView::operator=(StreamView&& rhs)
 {
   valid_     = rhs.valid_;
   stream_    = rhs.stream_;
+  parent_    = rhs.parent_;
   rhs.valid_ = false;
   return *this;
 }
 
+void StreamView::wait_for(cudaStream_t other) const { order_streams(stream_, other); }
+
+StreamTimer::StreamTimer(cudaStream_t stream) : stream_(stream)
+{
+  auto& pool = StreamPool::get_stream_pool();
+  start_     = pool.get_timing_event();
+  stop_      = pool.get_timing_event();
+  CHECK_CUDA(cudaEventRecord(start_, stream_));
+}
+
+StreamTimer::~StreamTimer()
+{
+  // The timer lives within a task, so the pool is still the one of the executing processor
+  auto& pool = StreamPool::get_stream_pool();
+  pool.release_timing_event(start_);
+  pool.release_timing_event(stop_);
+}
+
+static void CUDART_CB trigger_user_event(void* args)
+{
+  auto event = static_cast<Realm::UserEvent*>(args);
+  event->trigger();
+  delete event;
+}
+
+Realm::Event record_completion_event(cudaStream_t stream)
+{
+  // A host callback enqueued on the stream triggers the event
+  auto event = Realm::UserEvent::create_user_event();
+  CHECK_CUDA(cudaLaunchHostFunc(stream, trigger_user_event, new Realm::UserEvent(event)));
+  return event;
+}
+
+void skip_context_synchronization()
+{
+  if (Core::async_stream_view) Realm::Cuda::set_task_ctxsync_required(false);
+}
+
+uint64_t StreamTimer::elapsed_ns() const
+{
+  CHECK_CUDA(cudaEventRecord(stop_, stream_));
+  // Waiting on a Realm event suspends the task, so Realm can run other tasks on the processor
+  record_completion_event(stream_).wait();
+  float elapsed_ms = 0.0;
+  CHECK_CUDA(cudaEventElapsedTime(&elapsed_ms, start_, stop_));
+  return static_cast<uint64_t>(static_cast<double>(elapsed_ms) * 1e6);
+}
+
+StreamPool::StreamPool()
+  : cached_streams_(std::max<uint32_t>(extract_env("LEGATE_NUM_STREAMS", 4, 2), 1), nullptr)
+{
+}
+
 StreamPool::~StreamPool()
 {
-  if (cached_stream_ != nullptr) CHECK_CUDA(cudaStreamDestroy(*cached_stream_));
+  for (auto stream : cached_streams_)
+    if (stream != nullptr) CHECK_CUDA(cudaStreamDestroy(stream));
+  for (auto event : cached_events_) CHECK_CUDA(cudaEventDestroy(event));
+  for (auto event : cached_timing_events_) CHECK_CUDA(cudaEventDestroy(event));
+}
+
+cudaStream_t StreamPool::get_cached_stream(uint32_t idx)
+{
+  auto& stream = cached_streams_[idx];
+  if (nullptr == stream) CHECK_CUDA(cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking));
+  return stream;
+}
+
+StreamView StreamPool::get_stream() { return StreamView(get_cached_stream(0)); }
+
+StreamView StreamPool::lease_stream()
+{
+  auto primary = get_cached_stream(0);
+  if (cached_streams_.size() == 1) return StreamView(primary);
+
+  const uint32_t num_leases = cached_streams_.size() - 1;
+  auto leased               = get_cached_stream(1 + next_lease_++ % num_leases);
+  order_streams(leased, primary);
+  return StreamView(leased, primary);
 }
 
-StreamView StreamPool::get_stream()
+cudaEvent_t StreamPool::get_event()
 {
-  if (nullptr == cached_stream_) {
-    cudaStream_t stream;
-    CHECK_CUDA(cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking));
-    cached_stream_ = std::make_unique<cudaStream_t>(stream);
+  if (cached_events_.empty()) {
+    cudaEvent_t event;
+    CHECK_CUDA(cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+    return event;
   }
-  return StreamView(*cached_stream_);
+  auto event = cached_events_.back();
+  cached_events_.pop_back();
+  return event;
+}
+
+void StreamPool::release_event(cudaEvent_t event) { cached_events_.push_back(event); }
+
+cudaEvent_t StreamPool::get_timing_event()
+{
+  if (cached_timing_events_.empty()) {
+    cudaEvent_t event;
+    CHECK_CUDA(cudaEventCreate(&event));
+    return event;
+  }
+  auto event = cached_timing_events_.back();
+  cached_timing_events_.pop_back();
+  return event;
+}
+
+void StreamPool::release_timing_event(cudaEvent_t event)
+{
+  cached_timing_events_.push_back(event);
 }
 
 /*static*/ StreamPool& StreamPool::get_stream_pool()
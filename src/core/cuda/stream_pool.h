@@ -17,6 +17,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <cuda_runtime.h>
 #include "legion.h"
@@ -27,6 +28,11 @@ namespace cuda {
 struct StreamView {
  public:
   StreamView(cudaStream_t stream) : valid_(true), stream_(stream) {}
+  // A leased view joins back into the parent stream when it is destroyed
+  StreamView(cudaStream_t stream, cudaStream_t parent)
+    : valid_(true), stream_(stream), parent_(parent)
+  {
+  }
   ~StreamView();
 
  public:
@@ -39,26 +45,85 @@ struct StreamView {
 
  public:
   operator cudaStream_t() const { return stream_; }
+  // Returns the stream a leased view joins back into, or null if the view isn't leased
+  cudaStream_t parent() const { return parent_; }
+
+ public:
+  // Makes this stream wait for the work enqueued on the other stream so far
+  void wait_for(cudaStream_t other) const;
 
  private:
   bool valid_;
   cudaStream_t stream_;
+  cudaStream_t parent_{nullptr};
+};
+
+// Returns a Realm event that triggers once the work enqueued on the stream so far completes
+Realm::Event record_completion_event(cudaStream_t stream);
+
+// With LEGATE_ASYNC_STREAM_VIEW, lets the executing GPU task complete once Realm's task stream
+// drains, without the context synchronization. This is only safe when the stream views the
+// task used cover all of its GPU work, as they are what orders the task stream after it.
+void skip_context_synchronization();
+
+// Measures how long the work enqueued on a stream takes on the device
+struct StreamTimer {
+ public:
+  // The timer starts once the work enqueued on the stream so far completes
+  StreamTimer(cudaStream_t stream);
+  ~StreamTimer();
+
+ public:
+  StreamTimer(const StreamTimer&)            = delete;
+  StreamTimer& operator=(const StreamTimer&) = delete;
+
+ public:
+  // Waits until the work enqueued on the stream so far completes and returns the time it took
+  // since the timer started. The task is suspended during the wait rather than blocking the
+  // processor thread.
+  uint64_t elapsed_ns() const;
+
+ private:
+  cudaStream_t stream_;
+  cudaEvent_t start_;
+  cudaEvent_t stop_;
 };
 
 struct StreamPool {
  public:
-  StreamPool() {}
+  StreamPool();
   ~StreamPool();
 
  public:
+  // Returns a view of the primary stream of the executing processor
   StreamView get_stream();
+  // Leases one of the auxiliary streams in the pool in a round-robin fashion. The leased stream
+  // is ordered after the work enqueued on the primary stream so far, and the primary stream is
+  // ordered after the leased stream once the lease is released. When the pool has only one
+  // stream, the lease is simply a view of the primary stream.
+  StreamView lease_stream();
+
+ public:
+  // Events are recycled so that ordering streams does not create a new event every time
+  cudaEvent_t get_event();
+  void release_event(cudaEvent_t event);
+  // Same as above, for the events that record timestamps
+  cudaEvent_t get_timing_event();
+  void release_timing_event(cudaEvent_t event);
 
  public:
   static StreamPool& get_stream_pool();
 
  private:
-  // For now we keep only one stream in the pool
-  std::unique_ptr<cudaStream_t> cached_stream_{nullptr};
+  cudaStream_t get_cached_stream(uint32_t idx);
+
+ private:
+  // The first stream is the primary stream and the rest are handed out as leases.
+  // Streams are created lazily on first use.
+  std::vector<cudaStream_t> cached_streams_;
+  uint32_t next_lease_{0};
+  std::vector<cudaEvent_t> cached_events_{};
+  std::vector<cudaEvent_t> cached_timing_events_{};
 };
 
 }  // namespace cuda
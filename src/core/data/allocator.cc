@@ -19,23 +19,65 @@
 
 namespace legate {
 
-ScopedAllocator::ScopedAllocator(Legion::Memory::Kind kind, bool scoped, size_t alignment)
-  : target_kind_(kind), scoped_(scoped), alignment_(alignment)
+ScopedAllocator::ScopedAllocator(Legion::Memory::Kind kind,
+                                 bool scoped,
+                                 size_t alignment,
+                                 size_t chunk_size)
+  : target_kind_(kind), scoped_(scoped), alignment_(alignment), chunk_size_(chunk_size)
 {
 }
 
 ScopedAllocator::~ScopedAllocator()
 {
   if (scoped_) {
-    for (auto& pair : buffers_) { pair.second.destroy(); }
+    for (auto& pair : buffers_) {
+      MemoryUsage::remove_temporary(pair.first);
+      pair.second.destroy();
+    }
     buffers_.clear();
+    for (auto& chunk : chunks_) {
+      MemoryUsage::remove_temporary(chunk.base);
+      chunk.buffer.destroy();
+    }
+    chunks_.clear();
+    arena_allocations_.clear();
   }
 }
 
+void* ScopedAllocator::allocate_from_arena(size_t bytes)
+{
+  bytes = (bytes + alignment_ - 1) / alignment_ * alignment_;
+
+  // Most recently created chunks are the likeliest to have room, so we search backwards
+  size_t chunk_idx = chunks_.size();
+  for (size_t idx = chunks_.size(); idx > 0; --idx) {
+    auto& chunk = chunks_[idx - 1];
+    if (chunk.offset + bytes <= chunk_size_) {
+      chunk_idx = idx - 1;
+      break;
+    }
+  }
+
+  if (chunk_idx == chunks_.size()) {
+    ByteBuffer buffer = create_buffer<int8_t>(chunk_size_, target_kind_, alignment_);
+    chunks_.push_back(Chunk{buffer, buffer.ptr(0), 0, 0});
+  }
+
+  auto& chunk = chunks_[chunk_idx];
+  void* ptr   = chunk.base + chunk.offset;
+  chunk.offset += bytes;
+  ++chunk.num_live_allocations;
+
+  arena_allocations_[ptr] = chunk_idx;
+  return ptr;
+}
+
 void* ScopedAllocator::allocate(size_t bytes)
 {
   if (bytes == 0) return nullptr;
 
+  if (chunk_size_ > 0 && bytes <= chunk_size_ / 4) return allocate_from_arena(bytes);
+
   ByteBuffer buffer = create_buffer<int8_t>(bytes, target_kind_, alignment_);
 
   void* ptr = buffer.ptr(0);
@@ -46,6 +88,15 @@ void* ScopedAllocator::allocate(size_t bytes)
 
 void ScopedAllocator::deallocate(void* ptr)
 {
+  auto arena_finder = arena_allocations_.find(ptr);
+  if (arena_finder != arena_allocations_.end()) {
+    auto& chunk = chunks_[arena_finder->second];
+    arena_allocations_.erase(arena_finder);
+    // The chunk can be reused from the beginning once it has no live allocations
+    if (--chunk.num_live_allocations == 0) chunk.offset = 0;
+    return;
+  }
+
   ByteBuffer buffer;
   auto finder = buffers_.find(ptr);
   assert(finder != buffers_.end());
@@ -56,6 +107,7 @@ void ScopedAllocator::deallocate(void* ptr)
 
   buffer = finder->second;
   buffers_.erase(finder);
+  MemoryUsage::remove_temporary(ptr);
   buffer.destroy();
 }
 
@@ -19,6 +19,7 @@
 #include "core/data/buffer.h"
 
 #include <unordered_map>
+#include <vector>
 
 namespace legate {
 
@@ -31,18 +32,40 @@ class ScopedAllocator {
 
   // Iff 'scoped', all allocations will be released upon destruction.
   // Otherwise this is up to the runtime after the task has finished.
-  ScopedAllocator(Legion::Memory::Kind kind, bool scoped = true, size_t alignment = 16);
+  //
+  // A non-zero 'chunk_size' enables the arena mode, where allocations of up to a quarter of
+  // the chunk size are carved out of chunks of that size instead of getting their own buffers.
+  // A chunk is recycled once all allocations from it are deallocated.
+  ScopedAllocator(Legion::Memory::Kind kind,
+                  bool scoped       = true,
+                  size_t alignment  = 16,
+                  size_t chunk_size = 0);
   ~ScopedAllocator();
 
  public:
   void* allocate(size_t bytes);
   void deallocate(void* ptr);
 
+ private:
+  struct Chunk {
+    ByteBuffer buffer;
+    int8_t* base;
+    size_t offset;
+    size_t num_live_allocations;
+  };
+
+ private:
+  void* allocate_from_arena(size_t bytes);
+
  private:
   Legion::Memory::Kind target_kind_{Legion::Memory::Kind::SYSTEM_MEM};
   bool scoped_;
   size_t alignment_;
+  size_t chunk_size_{0};
   std::unordered_map<const void*, ByteBuffer> buffers_{};
+  std::vector<Chunk> chunks_{};
+  // Maps each allocation from the arena to the index of the chunk it belongs to
+  std::unordered_map<const void*, size_t> arena_allocations_{};
 };
 
 }  // namespace legate
\ No newline at end of file
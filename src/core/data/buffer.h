@@ -19,6 +19,7 @@
 #include "legion.h"
 
 #include "core/utilities/machine.h"
+#include "core/utilities/memory_usage.h"
 
 namespace legate {
 
@@ -36,7 +37,9 @@ Buffer<VAL, DIM> create_buffer(const Legion::Point<DIM>& extents,
   // We just avoid creating empty buffers, as they cause all sorts of headaches.
   for (int32_t idx = 0; idx < DIM; ++idx) hi[idx] = std::max<int64_t>(hi[idx], 0);
   Rect<DIM> bounds(Point<DIM>::ZEROES(), hi);
-  return Buffer<VAL, DIM>(bounds, kind, nullptr, alignment);
+  Buffer<VAL, DIM> buffer(bounds, kind, nullptr, alignment);
+  MemoryUsage::add_temporary(buffer.ptr(bounds.lo), kind, bounds.volume() * sizeof(VAL));
+  return buffer;
 }
 
 template <typename VAL>
@@ -0,0 +1,141 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/data/buffer_pool.h"
+#include "core/runtime/runtime.h"
+#include "legate.h"
+
+using namespace Legion;
+
+namespace legate {
+
+static constexpr size_t MIN_BUCKET_SIZE = 256;
+
+static size_t get_bucket_size(size_t bytes)
+{
+  size_t bucket = MIN_BUCKET_SIZE;
+  while (bucket < bytes) bucket <<= 1;
+  return bucket;
+}
+
+BufferPool::BufferPool()
+  : high_water_mark_(static_cast<size_t>(extract_env("LEGATE_BUFFER_POOL_LIMIT", 256, 16)) << 20)
+{
+}
+
+BufferPool::FreeList& BufferPool::get_free_list(Memory::Kind kind)
+{
+  auto finder = free_lists_.find(kind);
+  if (finder != free_lists_.end()) return finder->second;
+
+  auto& free_list = free_lists_[kind];
+  auto proc       = Processor::get_executing_processor();
+  free_list.memory =
+    Machine::MemoryQuery(Machine::get_machine()).only_kind(kind).best_affinity_to(proc).first();
+  if (!free_list.memory.exists()) {
+    log_legate.error("Failed to find a memory of kind %d for processor " IDFMT, kind, proc.id);
+    LEGATE_ABORT;
+  }
+  return free_list;
+}
+
+Realm::RegionInstance BufferPool::allocate(size_t bytes, Memory::Kind kind, void*& base)
+{
+  const size_t bucket_size = get_bucket_size(bytes);
+
+  std::lock_guard<std::mutex> guard(lock_);
+  auto& free_list = get_free_list(kind);
+
+  Realm::RegionInstance instance;
+  auto finder = free_list.buckets.find(bucket_size);
+  if (finder != free_list.buckets.end() && !finder->second.empty()) {
+    instance = finder->second.back();
+    finder->second.pop_back();
+    free_list.cached_bytes -= bucket_size;
+  } else {
+    const Realm::IndexSpace<1> space(Rect<1>(0, bucket_size - 1));
+    const std::vector<size_t> field_sizes(1, 1);
+    Realm::RegionInstance::create_instance(
+      instance, free_list.memory, space, field_sizes, 0 /*SOA*/, Realm::ProfilingRequestSet())
+      .wait();
+    if (!instance.exists()) {
+      log_legate.error("Failed to allocate a pooled buffer of %zu bytes", bucket_size);
+      LEGATE_ABORT;
+    }
+  }
+
+  base = instance.pointer_untyped(0, bucket_size);
+  return instance;
+}
+
+void BufferPool::release(Realm::RegionInstance instance, size_t bytes, Memory::Kind kind)
+{
+  const size_t bucket_size = get_bucket_size(bytes);
+
+  std::lock_guard<std::mutex> guard(lock_);
+  auto& free_list = get_free_list(kind);
+  if (free_list.cached_bytes + bucket_size > high_water_mark_) {
+    instance.destroy();
+    return;
+  }
+  free_list.buckets[bucket_size].push_back(instance);
+  free_list.cached_bytes += bucket_size;
+}
+
+void BufferPool::trim(FreeList& free_list, size_t target_bytes)
+{
+  // Larger allocations are trimmed first
+  for (auto it = free_list.buckets.rbegin();
+       it != free_list.buckets.rend() && free_list.cached_bytes > target_bytes;
+       ++it) {
+    auto& instances = it->second;
+    while (!instances.empty() && free_list.cached_bytes > target_bytes) {
+      instances.back().destroy();
+      instances.pop_back();
+      free_list.cached_bytes -= it->first;
+    }
+  }
+}
+
+void BufferPool::trim(size_t target_bytes)
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  for (auto& pair : free_lists_) trim(pair.second, target_bytes);
+}
+
+size_t BufferPool::cached_bytes(Memory::Kind kind) const
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  auto finder = free_lists_.find(kind);
+  return finder != free_lists_.end() ? finder->second.cached_bytes : 0;
+}
+
+void BufferPool::set_high_water_mark(size_t bytes)
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  high_water_mark_ = bytes;
+  for (auto& pair : free_lists_) trim(pair.second, high_water_mark_);
+}
+
+/*static*/ BufferPool& BufferPool::get_buffer_pool()
+{
+  static BufferPool pools[LEGION_MAX_NUM_PROCS];
+  const auto proc = Processor::get_executing_processor();
+  auto proc_id    = proc.id & (LEGION_MAX_NUM_PROCS - 1);
+  return pools[proc_id];
+}
+
+}  // namespace legate
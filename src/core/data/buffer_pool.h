@@ -0,0 +1,115 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "legion.h"
+
+#include "core/utilities/machine.h"
+
+namespace legate {
+
+// A buffer allocated from the buffer pool of the executing processor. Unlike buffers created
+// by create_buffer, a pooled buffer outlives the task that created it and must be returned to
+// the pool explicitly by calling release(). The buffer is laid out in the C order.
+template <typename VAL, int32_t DIM = 1>
+class PooledBuffer {
+ public:
+  PooledBuffer() = default;
+  PooledBuffer(const Legion::Rect<DIM>& bounds,
+               Legion::Memory::Kind kind,
+               Realm::RegionInstance instance,
+               void* base);
+
+ public:
+  VAL* ptr(const Legion::Point<DIM>& p) const;
+  const Legion::Rect<DIM>& bounds() const { return bounds_; }
+  Legion::Memory::Kind memory_kind() const { return kind_; }
+
+ public:
+  // Returns the buffer to the pool of the executing processor
+  void release();
+
+ private:
+  Legion::Rect<DIM> bounds_{};
+  Legion::Memory::Kind kind_{Legion::Memory::Kind::NO_MEMKIND};
+  Realm::RegionInstance instance_{Realm::RegionInstance::NO_INST};
+  VAL* base_{nullptr};
+  size_t strides_[DIM];
+};
+
+// A size-bucketed cache of allocations, one per processor, that recycles released buffers to
+// later tasks running on the same processor. The cache holds on to released allocations
+// until their total size per memory exceeds the high-water mark (LEGATE_BUFFER_POOL_LIMIT
+// in MiB), after which released allocations are destroyed instead.
+class BufferPool {
+ public:
+  // Cached allocations are left for Realm to reclaim at shutdown
+  BufferPool();
+
+ public:
+  BufferPool(const BufferPool&)            = delete;
+  BufferPool& operator=(const BufferPool&) = delete;
+
+ public:
+  Realm::RegionInstance allocate(size_t bytes, Legion::Memory::Kind kind, void*& base);
+  void release(Realm::RegionInstance instance, size_t bytes, Legion::Memory::Kind kind);
+  // Destroys cached allocations until each memory caches at most 'target_bytes'
+  void trim(size_t target_bytes = 0);
+
+ public:
+  size_t cached_bytes(Legion::Memory::Kind kind) const;
+  size_t high_water_mark() const { return high_water_mark_; }
+  void set_high_water_mark(size_t bytes);
+
+ public:
+  static BufferPool& get_buffer_pool();
+
+ private:
+  struct FreeList {
+    Legion::Memory memory{Legion::Memory::NO_MEMORY};
+    size_t cached_bytes{0};
+    // Released allocations keyed by their bucket sizes
+    std::map<size_t, std::vector<Realm::RegionInstance>> buckets{};
+  };
+
+ private:
+  FreeList& get_free_list(Legion::Memory::Kind kind);
+  void trim(FreeList& free_list, size_t target_bytes);
+
+ private:
+  size_t high_water_mark_;
+  std::unordered_map<Legion::Memory::Kind, FreeList> free_lists_{};
+  mutable std::mutex lock_{};
+};
+
+template <typename VAL, int32_t DIM>
+PooledBuffer<VAL, DIM> create_pooled_buffer(
+  const Legion::Point<DIM>& extents,
+  Legion::Memory::Kind kind = Legion::Memory::Kind::NO_MEMKIND);
+
+template <typename VAL>
+PooledBuffer<VAL> create_pooled_buffer(
+  size_t size, Legion::Memory::Kind kind = Legion::Memory::Kind::NO_MEMKIND);
+
+}  // namespace legate
+
+#include "core/data/buffer_pool.inl"
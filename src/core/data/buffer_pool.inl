@@ -0,0 +1,75 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+namespace legate {
+
+template <typename VAL, int32_t DIM>
+PooledBuffer<VAL, DIM>::PooledBuffer(const Legion::Rect<DIM>& bounds,
+                                     Legion::Memory::Kind kind,
+                                     Realm::RegionInstance instance,
+                                     void* base)
+  : bounds_(bounds), kind_(kind), instance_(instance), base_(static_cast<VAL*>(base))
+{
+  size_t stride = 1;
+  for (int32_t dim = DIM - 1; dim >= 0; --dim) {
+    strides_[dim] = stride;
+    stride *= static_cast<size_t>(bounds_.hi[dim] - bounds_.lo[dim] + 1);
+  }
+}
+
+template <typename VAL, int32_t DIM>
+VAL* PooledBuffer<VAL, DIM>::ptr(const Legion::Point<DIM>& p) const
+{
+#ifdef DEBUG_LEGATE
+  assert(bounds_.contains(p));
+#endif
+  size_t offset = 0;
+  for (int32_t dim = 0; dim < DIM; ++dim) offset += (p[dim] - bounds_.lo[dim]) * strides_[dim];
+  return base_ + offset;
+}
+
+template <typename VAL, int32_t DIM>
+void PooledBuffer<VAL, DIM>::release()
+{
+  if (!instance_.exists()) return;
+  BufferPool::get_buffer_pool().release(instance_, bounds_.volume() * sizeof(VAL), kind_);
+  instance_ = Realm::RegionInstance::NO_INST;
+  base_     = nullptr;
+}
+
+template <typename VAL, int32_t DIM>
+PooledBuffer<VAL, DIM> create_pooled_buffer(const Legion::Point<DIM>& extents,
+                                            Legion::Memory::Kind kind)
+{
+  using namespace Legion;
+  if (Memory::Kind::NO_MEMKIND == kind) kind = find_memory_kind_for_executing_processor(false);
+  auto hi = extents - Point<DIM>::ONES();
+  // We just avoid creating empty buffers, as they cause all sorts of headaches.
+  for (int32_t idx = 0; idx < DIM; ++idx) hi[idx] = std::max<int64_t>(hi[idx], 0);
+  Rect<DIM> bounds(Point<DIM>::ZEROES(), hi);
+
+  void* base    = nullptr;
+  auto instance = BufferPool::get_buffer_pool().allocate(bounds.volume() * sizeof(VAL), kind, base);
+  return PooledBuffer<VAL, DIM>(bounds, kind, instance, base);
+}
+
+template <typename VAL>
+PooledBuffer<VAL> create_pooled_buffer(size_t size, Legion::Memory::Kind kind)
+{
+  return create_pooled_buffer<VAL, 1>(Legion::Point<1>(size), kind);
+}
+
+}  // namespace legate
@@ -0,0 +1,43 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cstring>
+
+#include "core/data/growable_buffer.h"
+
+#ifdef LEGATE_USE_CUDA
+#include "core/cuda/cuda_help.h"
+#include "core/cuda/stream_pool.h"
+#endif
+
+using namespace Legion;
+
+namespace legate {
+
+Realm::Event copy_buffer_data(void* dst, const void* src, size_t bytes, Memory::Kind kind)
+{
+#ifdef LEGATE_USE_CUDA
+  if (kind == Memory::Kind::GPU_FB_MEM) {
+    auto stream = cuda::StreamPool::get_stream_pool().get_stream();
+    CHECK_CUDA(cudaMemcpyAsync(dst, src, bytes, cudaMemcpyDeviceToDevice, stream));
+    return cuda::record_completion_event(stream);
+  }
+#endif
+  memcpy(dst, src, bytes);
+  return Realm::Event::NO_EVENT;
+}
+
+}  // namespace legate
@@ -0,0 +1,83 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "legion.h"
+
+#include "core/data/buffer.h"
+
+namespace legate {
+
+// A buffer for the output of an unbound store whose size isn't known up front. The buffer grows
+// along its first dimension, whose entries we call rows, while the other dimensions keep the
+// extents it was created with. The capacity doubles whenever the buffer runs out of rows, so
+// appending rows costs amortized constant time, and the final buffer is handed off to the store
+// with Store::return_data without a copy. The buffer is laid out in the C order.
+template <typename VAL, int32_t DIM = 1>
+class GrowableBuffer {
+ public:
+  // 'extents[0]' is the initial number of rows the buffer can hold without growing
+  GrowableBuffer(const Legion::Point<DIM>& extents,
+                 Legion::Memory::Kind kind = Legion::Memory::Kind::NO_MEMKIND);
+
+ public:
+  GrowableBuffer(GrowableBuffer&&)            = default;
+  GrowableBuffer& operator=(GrowableBuffer&&) = default;
+
+ private:
+  GrowableBuffer(const GrowableBuffer&)            = delete;
+  GrowableBuffer& operator=(const GrowableBuffer&) = delete;
+
+ public:
+  size_t size() const { return size_; }
+  size_t capacity() const { return capacity_; }
+  // Number of elements in each row
+  size_t row_volume() const { return row_volume_; }
+
+ public:
+  // Makes sure the buffer can hold 'rows' rows without growing
+  void reserve(size_t rows);
+  // Appends 'rows' uninitialized rows and returns a pointer to the first of them. The pointer is
+  // valid until the buffer grows again.
+  VAL* append(size_t rows);
+  // Appends a single element. Only available for 1-D buffers in host-accessible memory.
+  void push_back(const VAL& value);
+  VAL* ptr(size_t row) const { return base_ + row * row_volume_; }
+
+ public:
+  // Extents of the rows appended so far
+  Legion::Point<DIM> extents() const;
+  Buffer<VAL, DIM>& buffer() { return buffer_; }
+
+ private:
+  Legion::Memory::Kind kind_;
+  Legion::Point<DIM> extents_;
+  size_t row_volume_{1};
+  size_t size_{0};
+  size_t capacity_{0};
+  Buffer<VAL, DIM> buffer_{};
+  VAL* base_{nullptr};
+};
+
+// Copies 'bytes' bytes between two buffers in memory of the given kind, on the stream of the
+// executing processor if the memory is a framebuffer. Returns an event that triggers once the
+// copy is done.
+Realm::Event copy_buffer_data(void* dst, const void* src, size_t bytes, Legion::Memory::Kind kind);
+
+}  // namespace legate
+
+#include "core/data/growable_buffer.inl"
@@ -0,0 +1,80 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+namespace legate {
+
+template <typename VAL, int32_t DIM>
+GrowableBuffer<VAL, DIM>::GrowableBuffer(const Legion::Point<DIM>& extents,
+                                         Legion::Memory::Kind kind)
+  : kind_(kind), extents_(extents)
+{
+  if (Legion::Memory::Kind::NO_MEMKIND == kind_)
+    kind_ = find_memory_kind_for_executing_processor(false);
+  for (int32_t dim = 1; dim < DIM; ++dim) row_volume_ *= static_cast<size_t>(extents_[dim]);
+  reserve(std::max<int64_t>(extents_[0], 1));
+}
+
+template <typename VAL, int32_t DIM>
+void GrowableBuffer<VAL, DIM>::reserve(size_t rows)
+{
+  if (rows <= capacity_) return;
+
+  auto extents = extents_;
+  extents[0]   = static_cast<Legion::coord_t>(rows);
+  auto buffer  = create_buffer<VAL, DIM>(extents, kind_);
+  auto base    = buffer.ptr(Legion::Point<DIM>::ZEROES());
+  auto copied  = Realm::Event::NO_EVENT;
+  if (size_ > 0) copied = copy_buffer_data(base, base_, size_ * row_volume_ * sizeof(VAL), kind_);
+  // A framebuffer copy may still be reading the old buffer, so the buffer is freed once the copy
+  // is done rather than right away
+  if (capacity_ > 0) {
+    MemoryUsage::remove_temporary(base_);
+    buffer_.destroy(copied);
+  }
+
+  buffer_   = buffer;
+  base_     = base;
+  capacity_ = rows;
+}
+
+template <typename VAL, int32_t DIM>
+VAL* GrowableBuffer<VAL, DIM>::append(size_t rows)
+{
+  if (size_ + rows > capacity_) reserve(std::max(size_ + rows, 2 * capacity_));
+  auto result = ptr(size_);
+  size_ += rows;
+  return result;
+}
+
+template <typename VAL, int32_t DIM>
+void GrowableBuffer<VAL, DIM>::push_back(const VAL& value)
+{
+  static_assert(DIM == 1, "push_back is only available for 1-D buffers");
+#ifdef DEBUG_LEGATE
+  assert(kind_ != Legion::Memory::Kind::GPU_FB_MEM);
+#endif
+  *append(1) = value;
+}
+
+template <typename VAL, int32_t DIM>
+Legion::Point<DIM> GrowableBuffer<VAL, DIM>::extents() const
+{
+  auto extents = extents_;
+  extents[0]   = static_cast<Legion::coord_t>(size_);
+  return extents;
+}
+
+}  // namespace legate
@@ -0,0 +1,70 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/data/reduction.h"
+#include "core/runtime/context.h"
+#include "core/utilities/dispatch.h"
+
+namespace legate {
+
+static Legion::ReductionOpID first_builtin_redop_id = 0;
+
+template <ReductionOpKind KIND>
+struct register_builtin_reduction_fn {
+  template <LegateTypeCode CODE,
+            std::enable_if_t<is_builtin_reduction_supported<KIND, CODE>>* = nullptr>
+  void operator()(const LibraryContext& context)
+  {
+    using REDOP   = builtin_reduction_t<KIND, CODE>;
+    auto redop_id = context.get_reduction_op_id(builtin_reduction_op_local_id(KIND, CODE));
+    Legion::Runtime::register_reduction_op<REDOP>(redop_id);
+  }
+
+  template <LegateTypeCode CODE,
+            std::enable_if_t<!is_builtin_reduction_supported<KIND, CODE>>* = nullptr>
+  void operator()(const LibraryContext& context)
+  {
+  }
+};
+
+template <ReductionOpKind KIND>
+static void register_reduction_ops_of_kind(const LibraryContext& context)
+{
+  for (int32_t code = 0; code < STRING_LT; ++code)
+    type_dispatch(
+      static_cast<LegateTypeCode>(code), register_builtin_reduction_fn<KIND>{}, context);
+}
+
+void register_builtin_reduction_ops(const LibraryContext& context)
+{
+  first_builtin_redop_id = context.get_reduction_op_id(LEGATE_CORE_FIRST_BUILTIN_REDOP);
+  register_reduction_ops_of_kind<ReductionOpKind::ADD>(context);
+  register_reduction_ops_of_kind<ReductionOpKind::MUL>(context);
+  register_reduction_ops_of_kind<ReductionOpKind::MAX>(context);
+  register_reduction_ops_of_kind<ReductionOpKind::MIN>(context);
+}
+
+Legion::ReductionOpID builtin_reduction_op_id(ReductionOpKind kind, LegateTypeCode code)
+{
+#ifdef DEBUG_LEGATE
+  assert(first_builtin_redop_id != 0);
+  assert(code != STRING_LT && code < MAX_TYPE_NUMBER);
+#endif
+  return first_builtin_redop_id + builtin_reduction_op_local_id(kind, code) -
+         LEGATE_CORE_FIRST_BUILTIN_REDOP;
+}
+
+}  // namespace legate
@@ -0,0 +1,181 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <type_traits>
+
+#include "legion.h"
+
+#include "core/legate_c.h"
+#include "core/utilities/type_traits.h"
+#include "core/utilities/typedefs.h"
+
+namespace legate {
+
+// The core registers one reduction operator for each kind and type below, so libraries
+// don't need to register their own. The global operator id is looked up with
+// builtin_reduction_op_id once the core library has been registered.
+enum class ReductionOpKind : int32_t {
+  ADD = LEGATE_CORE_REDOP_ADD,
+  MUL = LEGATE_CORE_REDOP_MUL,
+  MAX = LEGATE_CORE_REDOP_MAX,
+  MIN = LEGATE_CORE_REDOP_MIN,
+};
+
+#if defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 700
+// Lanes updating the same location first combine their values within the warp, so that
+// a highly contended reduction issues one atomic per warp instead of one per lane.
+// Returns the lanes sharing the location with this lane, and whether this lane issues the atomic.
+__device__ inline unsigned find_warp_peers(const void* ptr, bool& leader)
+{
+  const unsigned active = __activemask();
+  const unsigned peers  = __match_any_sync(active, reinterpret_cast<unsigned long long>(ptr));
+  unsigned lane;
+  asm("mov.u32 %0, %%laneid;" : "=r"(lane));
+  leader = lane == __ffs(peers) - 1;
+  return peers;
+}
+
+template <typename T>
+__device__ inline T warp_sum(unsigned peers, T value)
+{
+  T total = 0;
+  for (unsigned remaining = peers; remaining != 0; remaining &= remaining - 1)
+    total += __shfl_sync(peers, value, __ffs(remaining) - 1);
+  return total;
+}
+
+template <typename T>
+__device__ inline void warp_aggregated_atomic_add(T* ptr, T value)
+{
+  bool leader;
+  const unsigned peers = find_warp_peers(ptr, leader);
+  const T total        = warp_sum(peers, value);
+  if (leader) atomicAdd(ptr, total);
+}
+
+// Half-precision values are combined in single precision
+__device__ inline void warp_aggregated_atomic_add(__half* ptr, __half value)
+{
+  bool leader;
+  const unsigned peers = find_warp_peers(ptr, leader);
+  const float total    = warp_sum(peers, __half2float(value));
+  if (leader) atomicAdd(ptr, __float2half(total));
+}
+
+// The real and imaginary parts of complex numbers are updated by separate atomics, as in
+// Legion's SumReduction
+template <typename T>
+__device__ inline void warp_aggregated_atomic_add(complex<T>* ptr, complex<T> value)
+{
+  bool leader;
+  const unsigned peers = find_warp_peers(ptr, leader);
+  const T real         = warp_sum(peers, value.real());
+  const T imag         = warp_sum(peers, value.imag());
+  if (leader) {
+    T* parts = reinterpret_cast<T*>(ptr);
+    atomicAdd(parts, real);
+    atomicAdd(parts + 1, imag);
+  }
+}
+#endif
+
+template <typename T>
+constexpr bool has_native_atomic_add =
+  std::is_same<T, int32_t>::value || std::is_same<T, uint32_t>::value ||
+  std::is_same<T, float>::value || std::is_same<T, double>::value ||
+  std::is_same<T, __half>::value || std::is_same<T, complex<float>>::value ||
+  std::is_same<T, complex<double>>::value;
+
+// Same as Legion's SumReduction, except that non-exclusive updates on the GPU are warp
+// aggregated for the types with native atomics on their elements
+template <typename T>
+struct SumReduction : public Legion::SumReduction<T> {
+  using BASE = Legion::SumReduction<T>;
+  using LHS  = typename BASE::LHS;
+  using RHS  = typename BASE::RHS;
+
+  template <bool EXCLUSIVE>
+  __CUDA_HD__ inline static void apply(LHS& lhs, RHS rhs)
+  {
+#if defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 700
+    if constexpr (!EXCLUSIVE && has_native_atomic_add<T>) {
+      warp_aggregated_atomic_add(&lhs, rhs);
+      return;
+    }
+#endif
+    BASE::template apply<EXCLUSIVE>(lhs, rhs);
+  }
+
+  template <bool EXCLUSIVE>
+  __CUDA_HD__ inline static void fold(RHS& rhs1, RHS rhs2)
+  {
+#if defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 700
+    if constexpr (!EXCLUSIVE && has_native_atomic_add<T>) {
+      warp_aggregated_atomic_add(&rhs1, rhs2);
+      return;
+    }
+#endif
+    BASE::template fold<EXCLUSIVE>(rhs1, rhs2);
+  }
+};
+
+template <ReductionOpKind KIND, typename T>
+struct BuiltinReduction;
+
+template <typename T>
+struct BuiltinReduction<ReductionOpKind::ADD, T> {
+  using type = SumReduction<T>;
+};
+
+template <typename T>
+struct BuiltinReduction<ReductionOpKind::MUL, T> {
+  using type = Legion::ProdReduction<T>;
+};
+
+template <typename T>
+struct BuiltinReduction<ReductionOpKind::MAX, T> {
+  using type = Legion::MaxReduction<T>;
+};
+
+template <typename T>
+struct BuiltinReduction<ReductionOpKind::MIN, T> {
+  using type = Legion::MinReduction<T>;
+};
+
+template <ReductionOpKind KIND, LegateTypeCode CODE>
+using builtin_reduction_t = typename BuiltinReduction<KIND, legate_type_of<CODE>>::type;
+
+// Complex numbers have no ordering, so they only support ADD and MUL
+template <ReductionOpKind KIND, LegateTypeCode CODE>
+constexpr bool is_builtin_reduction_supported =
+  CODE != STRING_LT &&
+  !((CODE == COMPLEX64_LT || CODE == COMPLEX128_LT) &&
+    (KIND == ReductionOpKind::MAX || KIND == ReductionOpKind::MIN));
+
+constexpr int64_t builtin_reduction_op_local_id(ReductionOpKind kind, LegateTypeCode code)
+{
+  return LEGATE_CORE_FIRST_BUILTIN_REDOP + static_cast<int64_t>(kind) * MAX_TYPE_NUMBER + code;
+}
+
+Legion::ReductionOpID builtin_reduction_op_id(ReductionOpKind kind, LegateTypeCode code);
+
+class LibraryContext;
+
+void register_builtin_reduction_ops(const LibraryContext& context);
+
+}  // namespace legate
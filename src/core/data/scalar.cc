@@ -24,20 +24,23 @@ Scalar::Scalar(const Scalar& other) : own_(other.own_), tuple_(other.tuple_), co
   copy(other);
 }
 
-Scalar::Scalar(bool tuple, LegateTypeCode code, const void* data)
-  : tuple_(tuple), code_(code), data_(data)
+Scalar::Scalar(Scalar&& other) noexcept
+  : own_(other.own_), tuple_(other.tuple_), code_(other.code_)
 {
+  move(std::move(other));
 }
 
-Scalar::~Scalar()
+Scalar::Scalar(bool tuple, LegateTypeCode code, const void* data)
+  : tuple_(tuple), code_(code), data_(data)
 {
-  if (own_)
-    // We know we own this buffer
-    free(const_cast<void*>(data_));
 }
 
+Scalar::~Scalar() { release(); }
+
 Scalar& Scalar::operator=(const Scalar& other)
 {
+  if (this == &other) return *this;
+  release();
   own_   = other.own_;
   tuple_ = other.tuple_;
   code_  = other.code_;
@@ -45,17 +48,55 @@ Scalar& Scalar::operator=(const Scalar& other)
   return *this;
 }
 
+Scalar& Scalar::operator=(Scalar&& other) noexcept
+{
+  if (this == &other) return *this;
+  release();
+  own_   = other.own_;
+  tuple_ = other.tuple_;
+  code_  = other.code_;
+  move(std::move(other));
+  return *this;
+}
+
+void* Scalar::allocate(size_t size)
+{
+  if (size <= INLINE_CAPACITY) return inline_;
+  return malloc(size);
+}
+
+void Scalar::release()
+{
+  if (own_ && !is_inline())
+    // We know we own this buffer
+    free(const_cast<void*>(data_));
+  own_  = false;
+  data_ = nullptr;
+}
+
 void Scalar::copy(const Scalar& other)
 {
   if (other.own_) {
     auto size   = other.size();
-    auto buffer = malloc(size);
+    auto buffer = allocate(size);
     memcpy(buffer, other.data_, size);
     data_ = buffer;
   } else
     data_ = other.data_;
 }
 
+void Scalar::move(Scalar&& other) noexcept
+{
+  if (other.own_ && other.is_inline()) {
+    memcpy(inline_, other.inline_, INLINE_CAPACITY);
+    data_ = inline_;
+  } else
+    data_ = other.data_;
+  // The other scalar no longer owns anything, so its destructor becomes a no-op
+  other.own_  = false;
+  other.data_ = nullptr;
+}
+
 struct elem_size_fn {
   template <LegateTypeCode CODE>
   size_t operator()()
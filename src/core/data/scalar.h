@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include "core/utilities/span.h"
 #include "core/utilities/type_traits.h"
 #include "core/utilities/typedefs.h"
@@ -23,9 +25,16 @@
 namespace legate {
 
 class Scalar {
+ public:
+  // Owned values up to this many bytes are stored inline, without a heap allocation.
+  // Scalars unpacked from task arguments never own their data and instead point into the
+  // argument buffer, which outlives the task.
+  static constexpr size_t INLINE_CAPACITY = 32;
+
  public:
   Scalar() = default;
   Scalar(const Scalar& other);
+  Scalar(Scalar&& other) noexcept;
   Scalar(bool tuple, LegateTypeCode code, const void* data);
   ~Scalar();
 
@@ -37,12 +46,18 @@ class Scalar {
 
  public:
   Scalar& operator=(const Scalar& other);
+  Scalar& operator=(Scalar&& other) noexcept;
 
  private:
+  void* allocate(size_t size);
+  void release();
   void copy(const Scalar& other);
+  void move(Scalar&& other) noexcept;
+  bool is_inline() const { return data_ == inline_; }
 
  public:
   bool is_tuple() const { return tuple_; }
+  LegateTypeCode code() const { return code_; }
   size_t size() const;
 
  public:
@@ -56,7 +71,8 @@ class Scalar {
   bool own_{false};
   bool tuple_{false};
   LegateTypeCode code_{MAX_TYPE_NUMBER};
-  const void* data_;
+  const void* data_{nullptr};
+  alignas(std::max_align_t) int8_t inline_[INLINE_CAPACITY];
 };
 
 }  // namespace legate
@@ -17,11 +17,15 @@
 #include "core/data/store.h"
 
 #include "core/data/buffer.h"
+#include "core/data/buffer_pool.h"
 #include "core/utilities/dispatch.h"
 #include "core/utilities/machine.h"
 #include "legate_defines.h"
 
 #ifdef LEGATE_USE_CUDA
+#include <map>
+#include <mutex>
+
 #include "core/cuda/cuda_help.h"
 #include "core/cuda/stream_pool.h"
 #endif
@@ -64,6 +68,11 @@ bool RegionField::valid() const { return pr_.get_logical_region() != LogicalRegi
 
 Domain RegionField::domain() const { return dim_dispatch(dim_, get_domain_fn{}, pr_); }
 
+const void* RegionField::untyped_ptr(size_t* strides) const
+{
+  return dim_dispatch(dim_, untyped_ptr_fn{}, pr_, fid_, strides);
+}
+
 OutputRegionField::OutputRegionField(const OutputRegion& out, FieldID fid)
   : out_(out),
     fid_(fid),
@@ -182,6 +191,34 @@ FutureWrapper& FutureWrapper::operator=(const FutureWrapper& other) noexcept
 
 Domain FutureWrapper::domain() const { return domain_; }
 
+#ifdef LEGATE_USE_CUDA
+// Returns a copy of the reduction's identity in the framebuffer of the executing processor.
+// Copying the identity from the host would synchronize the stream on every point task, so each
+// processor keeps its own copy that is made once on its stream and then reused with
+// device-to-device copies on the same stream. The copies are pooled buffers that are never
+// released, so Realm reclaims them at shutdown.
+static const void* get_device_identity(int32_t redop_id,
+                                       const void* identity,
+                                       size_t size,
+                                       cudaStream_t stream)
+{
+  static std::mutex lock;
+  static std::map<std::pair<Processor, int32_t>, PooledBuffer<int8_t>> identities;
+
+  auto key = std::make_pair(Processor::get_executing_processor(), redop_id);
+
+  std::lock_guard<std::mutex> guard(lock);
+  auto finder = identities.find(key);
+  if (finder != identities.end()) return finder->second.ptr(0);
+
+  auto device_identity = create_pooled_buffer<int8_t>(size, Memory::Kind::GPU_FB_MEM);
+  CHECK_CUDA(
+    cudaMemcpyAsync(device_identity.ptr(0), identity, size, cudaMemcpyHostToDevice, stream));
+  identities[key] = device_identity;
+  return device_identity.ptr(0);
+}
+#endif
+
 void FutureWrapper::initialize_with_identity(int32_t redop_id)
 {
   auto untyped_acc = AccessorWO<int8_t, 1>(buffer_, field_size_);
@@ -194,8 +231,10 @@ void FutureWrapper::initialize_with_identity(int32_t redop_id)
   auto identity = redop->identity;
 #ifdef LEGATE_USE_CUDA
   if (buffer_.get_instance().get_location().kind() == Memory::Kind::GPU_FB_MEM) {
-    auto stream = cuda::StreamPool::get_stream_pool().get_stream();
-    CHECK_CUDA(cudaMemcpyAsync(ptr, identity, field_size_, cudaMemcpyHostToDevice, stream));
+    auto stream          = cuda::StreamPool::get_stream_pool().get_stream();
+    auto device_identity = get_device_identity(redop_id, identity, field_size_, stream);
+    CHECK_CUDA(
+      cudaMemcpyAsync(ptr, device_identity, field_size_, cudaMemcpyDeviceToDevice, stream));
   } else
 #endif
     memcpy(ptr, identity, field_size_);
@@ -235,6 +274,7 @@ Store::Store(int32_t dim,
   readable_  = region_field_.is_readable();
   writable_  = region_field_.is_writable();
   reducible_ = region_field_.is_reducible();
+  collapse_transform();
 }
 
 Store::Store(int32_t dim,
@@ -261,6 +301,8 @@ Store::Store(Store&& other) noexcept
     region_field_(std::forward<RegionField>(other.region_field_)),
     output_field_(std::forward<OutputRegionField>(other.output_field_)),
     transform_(std::move(other.transform_)),
+    has_inverse_transform_(other.has_inverse_transform_),
+    inverse_transform_(other.inverse_transform_),
     readable_(other.readable_),
     writable_(other.writable_),
     reducible_(other.reducible_)
@@ -280,10 +322,12 @@ Store& Store::operator=(Store&& other) noexcept
     output_field_ = std::move(other.output_field_);
   else
     region_field_ = std::move(other.region_field_);
-  transform_ = std::move(other.transform_);
-  readable_  = other.readable_;
-  writable_  = other.writable_;
-  reducible_ = other.reducible_;
+  transform_             = std::move(other.transform_);
+  has_inverse_transform_ = other.has_inverse_transform_;
+  inverse_transform_     = other.inverse_transform_;
+  readable_              = other.readable_;
+  writable_              = other.writable_;
+  reducible_             = other.reducible_;
   return *this;
 }
 
@@ -302,6 +346,14 @@ Domain Store::domain() const
   return result;
 }
 
+const void* Store::untyped_ptr(size_t* strides) const
+{
+#ifdef DEBUG_LEGATE
+  assert(!is_future_ && !is_output_store_);
+#endif
+  return region_field_.untyped_ptr(strides);
+}
+
 void Store::make_empty()
 {
 #ifdef DEBUG_LEGATE
@@ -316,6 +368,26 @@ void Store::remove_transform()
   assert(transformed());
 #endif
   dim_ = transform_->pop()->target_ndim(dim_);
+  if (!is_future_ && !is_output_store_) collapse_transform();
+}
+
+void Store::collapse_transform()
+{
+  has_inverse_transform_ = false;
+  if (transform_ == nullptr || transform_->identity()) return;
+
+  inverse_transform_ = transform_->inverse_transform(dim_);
+  // Stacks such as a zero shift or an identity transpose collapse to the identity map, in
+  // which case the plain accessors can be used
+  auto& matrix  = inverse_transform_.transform;
+  auto& offset  = inverse_transform_.offset;
+  bool identity = matrix.m == matrix.n;
+  for (int32_t i = 0; identity && i < matrix.m; ++i) {
+    if (offset[i] != 0) identity = false;
+    for (int32_t j = 0; identity && j < matrix.n; ++j)
+      if (matrix.matrix[i * matrix.n + j] != (i == j ? 1 : 0)) identity = false;
+  }
+  has_inverse_transform_ = !identity;
 }
 
 void Store::check_valid_return() const
@@ -17,9 +17,11 @@
 #pragma once
 
 #include "core/data/buffer.h"
+#include "core/data/growable_buffer.h"
 #include "core/data/transform.h"
 #include "core/task/return.h"
 #include "core/utilities/machine.h"
+#include "core/utilities/span.h"
 #include "core/utilities/typedefs.h"
 #include "legate_defines.h"
 #include "legion.h"
@@ -90,6 +92,19 @@ class RegionField {
     }
   };
 
+  struct untyped_ptr_fn {
+    template <int32_t DIM>
+    const void* operator()(const Legion::PhysicalRegion& pr, Legion::FieldID fid, size_t* strides)
+    {
+      auto bounds = pr.get_bounds<DIM, Legion::coord_t>().bounds;
+      if (bounds.empty()) return nullptr;
+      using ACC = Realm::AffineAccessor<int8_t, DIM, Legion::coord_t>;
+      Legion::UnsafeFieldAccessor<int8_t, DIM, Legion::coord_t, ACC> acc(pr, fid, bounds);
+      if (nullptr == strides) return acc.ptr(bounds.lo);
+      return acc.ptr(bounds, strides);
+    }
+  };
+
  public:
   template <typename T, int32_t DIM>
   AccessorRO<T, DIM> read_accessor() const;
@@ -138,10 +153,34 @@ class RegionField {
     const Legion::Rect<DIM>& bounds,
     const Legion::DomainAffineTransform& transform) const;
 
+ public:
+  template <typename T, int32_t DIM>
+  TiledAccessorRO<T, DIM> read_tiled_accessor(const Legion::Rect<DIM>& bounds) const;
+  template <typename T, int32_t DIM>
+  TiledAccessorWO<T, DIM> write_tiled_accessor(const Legion::Rect<DIM>& bounds) const;
+  template <typename T, int32_t DIM>
+  TiledAccessorRW<T, DIM> read_write_tiled_accessor(const Legion::Rect<DIM>& bounds) const;
+
+ public:
+  template <typename T, int32_t DIM>
+  TiledAccessorRO<T, DIM> read_tiled_accessor(
+    const Legion::Rect<DIM>& bounds, const Legion::DomainAffineTransform& transform) const;
+  template <typename T, int32_t DIM>
+  TiledAccessorWO<T, DIM> write_tiled_accessor(
+    const Legion::Rect<DIM>& bounds, const Legion::DomainAffineTransform& transform) const;
+  template <typename T, int32_t DIM>
+  TiledAccessorRW<T, DIM> read_write_tiled_accessor(
+    const Legion::Rect<DIM>& bounds, const Legion::DomainAffineTransform& transform) const;
+
  public:
   template <int32_t DIM>
   Legion::Rect<DIM> shape() const;
   Legion::Domain domain() const;
+  // Returns the address of the first element of the instance, or null when the region is
+  // empty. The address only tells instances apart and must not be used to access the data.
+  // When `strides` is given, it receives the byte stride of each dimension of a non-empty
+  // region.
+  const void* untyped_ptr(size_t* strides = nullptr) const;
 
  public:
   bool is_readable() const { return readable_; }
@@ -315,6 +354,29 @@ class Store {
   template <typename OP, bool EXCLUSIVE, int32_t DIM>
   AccessorRD<OP, EXCLUSIVE, DIM> reduce_accessor(const Legion::Rect<DIM>& bounds) const;
 
+ public:
+  // Accessors for stores mapped with a tiled layout, which the affine accessors above can't
+  // index. They also work on untiled instances, at the cost of a piece lookup per access.
+  template <typename T, int32_t DIM>
+  TiledAccessorRO<T, DIM> read_tiled_accessor() const;
+  template <typename T, int32_t DIM>
+  TiledAccessorWO<T, DIM> write_tiled_accessor() const;
+  template <typename T, int32_t DIM>
+  TiledAccessorRW<T, DIM> read_write_tiled_accessor() const;
+
+ public:
+  // Return a span over the elements in 'bounds' when the store's instance holds them
+  // contiguously in row-major order, after transforms are applied. The span is empty
+  // otherwise; use for_each_dense_run on an accessor to walk such stores.
+  template <typename T, int32_t DIM>
+  Span<const T> dense_read_span(const Legion::Rect<DIM>& bounds) const;
+  template <typename T, int32_t DIM>
+  Span<T> dense_write_span(const Legion::Rect<DIM>& bounds) const;
+  template <typename T, int32_t DIM>
+  Span<T> dense_read_write_span(const Legion::Rect<DIM>& bounds) const;
+  template <typename OP, bool EXCLUSIVE, int32_t DIM>
+  Span<typename OP::RHS> dense_reduce_span(const Legion::Rect<DIM>& bounds) const;
+
  public:
   template <typename T, int32_t DIM>
   Buffer<T, DIM> create_output_buffer(const Legion::Point<DIM>& extents,
@@ -324,6 +386,9 @@ class Store {
   template <int32_t DIM>
   Legion::Rect<DIM> shape() const;
   Legion::Domain domain() const;
+  // Returns the address of the instance backing a store that is neither a future nor unbound,
+  // and optionally the byte strides of its dimensions
+  const void* untyped_ptr(size_t* strides = nullptr) const;
 
  public:
   bool is_readable() const { return readable_; }
@@ -337,6 +402,10 @@ class Store {
  public:
   template <typename T, int32_t DIM>
   void return_data(Buffer<T, DIM>& buffer, const Legion::Point<DIM>& extents);
+  // Hands off the rows appended to the buffer so far. The buffer may hold more rows than it has
+  // appended, and the leftover rows are simply ignored.
+  template <typename T, int32_t DIM>
+  void return_data(GrowableBuffer<T, DIM>& buffer);
   void make_empty();
 
  public:
@@ -355,6 +424,7 @@ class Store {
   void check_valid_return() const;
   void check_buffer_dimension(const int32_t dim) const;
   void check_accessor_dimension(const int32_t dim) const;
+  void collapse_transform();
 
  private:
   bool is_future_{false};
@@ -370,6 +440,10 @@ class Store {
 
  private:
   std::shared_ptr<TransformStack> transform_{nullptr};
+  // The inverse of the transform stack folded into a single affine map when the store is
+  // created, so accessors do not recompose it. Unset when the map is the identity.
+  bool has_inverse_transform_{false};
+  Legion::DomainAffineTransform inverse_transform_{};
 
  private:
   bool readable_{false};
@@ -377,6 +451,13 @@ class Store {
   bool reducible_{false};
 };
 
+// Calls 'fn(point, span)' on runs of elements of 'bounds' that are contiguous in the
+// accessor's instance, where 'point' is the first point of the run. A dense row-major
+// instance yields a single run; otherwise each run is a row along the last dimension, or a
+// single element when rows are strided.
+template <typename VAL, int32_t DIM, typename ACC, typename Fn>
+void for_each_dense_run(const ACC& accessor, const Legion::Rect<DIM>& bounds, Fn&& fn);
+
 }  // namespace legate
 
 #include "core/data/store.inl"
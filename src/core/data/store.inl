@@ -134,6 +134,52 @@ AccessorRD<OP, EXCLUSIVE, DIM> RegionField::reduce_accessor(
     transform.transform.m, trans_accessor_fn<ACC, DIM>{}, pr_, fid_, redop_id, transform, bounds);
 }
 
+template <typename T, int32_t DIM>
+TiledAccessorRO<T, DIM> RegionField::read_tiled_accessor(const Legion::Rect<DIM>& bounds) const
+{
+  return TiledAccessorRO<T, DIM>(pr_, fid_, bounds);
+}
+
+template <typename T, int32_t DIM>
+TiledAccessorWO<T, DIM> RegionField::write_tiled_accessor(const Legion::Rect<DIM>& bounds) const
+{
+  return TiledAccessorWO<T, DIM>(pr_, fid_, bounds);
+}
+
+template <typename T, int32_t DIM>
+TiledAccessorRW<T, DIM> RegionField::read_write_tiled_accessor(
+  const Legion::Rect<DIM>& bounds) const
+{
+  return TiledAccessorRW<T, DIM>(pr_, fid_, bounds);
+}
+
+template <typename T, int32_t DIM>
+TiledAccessorRO<T, DIM> RegionField::read_tiled_accessor(
+  const Legion::Rect<DIM>& bounds, const Legion::DomainAffineTransform& transform) const
+{
+  using ACC = TiledAccessorRO<T, DIM>;
+  return dim_dispatch(
+    transform.transform.m, trans_accessor_fn<ACC, DIM>{}, pr_, fid_, transform, bounds);
+}
+
+template <typename T, int32_t DIM>
+TiledAccessorWO<T, DIM> RegionField::write_tiled_accessor(
+  const Legion::Rect<DIM>& bounds, const Legion::DomainAffineTransform& transform) const
+{
+  using ACC = TiledAccessorWO<T, DIM>;
+  return dim_dispatch(
+    transform.transform.m, trans_accessor_fn<ACC, DIM>{}, pr_, fid_, transform, bounds);
+}
+
+template <typename T, int32_t DIM>
+TiledAccessorRW<T, DIM> RegionField::read_write_tiled_accessor(
+  const Legion::Rect<DIM>& bounds, const Legion::DomainAffineTransform& transform) const
+{
+  using ACC = TiledAccessorRW<T, DIM>;
+  return dim_dispatch(
+    transform.transform.m, trans_accessor_fn<ACC, DIM>{}, pr_, fid_, transform, bounds);
+}
+
 template <int32_t DIM>
 Legion::Rect<DIM> RegionField::shape() const
 {
@@ -281,10 +327,8 @@ AccessorRO<T, DIM> Store::read_accessor() const
 
   if (is_future_) return future_.read_accessor<T, DIM>(shape<DIM>());
 
-  if (!transform_->identity()) {
-    auto transform = transform_->inverse_transform(dim_);
-    return region_field_.read_accessor<T, DIM>(shape<DIM>(), transform);
-  }
+  if (has_inverse_transform_)
+    return region_field_.read_accessor<T, DIM>(shape<DIM>(), inverse_transform_);
   return region_field_.read_accessor<T, DIM>(shape<DIM>());
 }
 
@@ -297,10 +341,8 @@ AccessorWO<T, DIM> Store::write_accessor() const
 
   if (is_future_) return future_.write_accessor<T, DIM>(shape<DIM>());
 
-  if (!transform_->identity()) {
-    auto transform = transform_->inverse_transform(dim_);
-    return region_field_.write_accessor<T, DIM>(shape<DIM>(), transform);
-  }
+  if (has_inverse_transform_)
+    return region_field_.write_accessor<T, DIM>(shape<DIM>(), inverse_transform_);
   return region_field_.write_accessor<T, DIM>(shape<DIM>());
 }
 
@@ -313,10 +355,8 @@ AccessorRW<T, DIM> Store::read_write_accessor() const
 
   if (is_future_) return future_.read_write_accessor<T, DIM>(shape<DIM>());
 
-  if (!transform_->identity()) {
-    auto transform = transform_->inverse_transform(dim_);
-    return region_field_.read_write_accessor<T, DIM>(shape<DIM>(), transform);
-  }
+  if (has_inverse_transform_)
+    return region_field_.read_write_accessor<T, DIM>(shape<DIM>(), inverse_transform_);
   return region_field_.read_write_accessor<T, DIM>(shape<DIM>());
 }
 
@@ -329,10 +369,9 @@ AccessorRD<OP, EXCLUSIVE, DIM> Store::reduce_accessor() const
 
   if (is_future_) return future_.reduce_accessor<OP, EXCLUSIVE, DIM>(redop_id_, shape<DIM>());
 
-  if (!transform_->identity()) {
-    auto transform = transform_->inverse_transform(dim_);
-    return region_field_.reduce_accessor<OP, EXCLUSIVE, DIM>(redop_id_, shape<DIM>(), transform);
-  }
+  if (has_inverse_transform_)
+    return region_field_.reduce_accessor<OP, EXCLUSIVE, DIM>(
+      redop_id_, shape<DIM>(), inverse_transform_);
   return region_field_.reduce_accessor<OP, EXCLUSIVE, DIM>(redop_id_, shape<DIM>());
 }
 
@@ -345,10 +384,8 @@ AccessorRO<T, DIM> Store::read_accessor(const Legion::Rect<DIM>& bounds) const
 
   if (is_future_) return future_.read_accessor<T, DIM>(bounds);
 
-  if (!transform_->identity()) {
-    auto transform = transform_->inverse_transform(dim_);
-    return region_field_.read_accessor<T, DIM>(bounds, transform);
-  }
+  if (has_inverse_transform_)
+    return region_field_.read_accessor<T, DIM>(bounds, inverse_transform_);
   return region_field_.read_accessor<T, DIM>(bounds);
 }
 
@@ -361,10 +398,8 @@ AccessorWO<T, DIM> Store::write_accessor(const Legion::Rect<DIM>& bounds) const
 
   if (is_future_) return future_.write_accessor<T, DIM>(bounds);
 
-  if (!transform_->identity()) {
-    auto transform = transform_->inverse_transform(dim_);
-    return region_field_.write_accessor<T, DIM>(bounds, transform);
-  }
+  if (has_inverse_transform_)
+    return region_field_.write_accessor<T, DIM>(bounds, inverse_transform_);
   return region_field_.write_accessor<T, DIM>(bounds);
 }
 
@@ -377,10 +412,8 @@ AccessorRW<T, DIM> Store::read_write_accessor(const Legion::Rect<DIM>& bounds) c
 
   if (is_future_) return future_.read_write_accessor<T, DIM>(bounds);
 
-  if (!transform_->identity()) {
-    auto transform = transform_->inverse_transform(dim_);
-    return region_field_.read_write_accessor<T, DIM>(bounds, transform);
-  }
+  if (has_inverse_transform_)
+    return region_field_.read_write_accessor<T, DIM>(bounds, inverse_transform_);
   return region_field_.read_write_accessor<T, DIM>(bounds);
 }
 
@@ -393,13 +426,50 @@ AccessorRD<OP, EXCLUSIVE, DIM> Store::reduce_accessor(const Legion::Rect<DIM>& b
 
   if (is_future_) return future_.reduce_accessor<OP, EXCLUSIVE, DIM>(redop_id_, bounds);
 
-  if (!transform_->identity()) {
-    auto transform = transform_->inverse_transform(dim_);
-    return region_field_.reduce_accessor<OP, EXCLUSIVE, DIM>(redop_id_, bounds, transform);
-  }
+  if (has_inverse_transform_)
+    return region_field_.reduce_accessor<OP, EXCLUSIVE, DIM>(redop_id_, bounds, inverse_transform_);
   return region_field_.reduce_accessor<OP, EXCLUSIVE, DIM>(redop_id_, bounds);
 }
 
+template <typename T, int32_t DIM>
+TiledAccessorRO<T, DIM> Store::read_tiled_accessor() const
+{
+#ifdef DEBUG_LEGATE
+  assert(!is_future_);
+  check_accessor_dimension(DIM);
+#endif
+
+  if (has_inverse_transform_)
+    return region_field_.read_tiled_accessor<T, DIM>(shape<DIM>(), inverse_transform_);
+  return region_field_.read_tiled_accessor<T, DIM>(shape<DIM>());
+}
+
+template <typename T, int32_t DIM>
+TiledAccessorWO<T, DIM> Store::write_tiled_accessor() const
+{
+#ifdef DEBUG_LEGATE
+  assert(!is_future_);
+  check_accessor_dimension(DIM);
+#endif
+
+  if (has_inverse_transform_)
+    return region_field_.write_tiled_accessor<T, DIM>(shape<DIM>(), inverse_transform_);
+  return region_field_.write_tiled_accessor<T, DIM>(shape<DIM>());
+}
+
+template <typename T, int32_t DIM>
+TiledAccessorRW<T, DIM> Store::read_write_tiled_accessor() const
+{
+#ifdef DEBUG_LEGATE
+  assert(!is_future_);
+  check_accessor_dimension(DIM);
+#endif
+
+  if (has_inverse_transform_)
+    return region_field_.read_write_tiled_accessor<T, DIM>(shape<DIM>(), inverse_transform_);
+  return region_field_.read_write_tiled_accessor<T, DIM>(shape<DIM>());
+}
+
 template <typename T, int32_t DIM>
 Buffer<T, DIM> Store::create_output_buffer(const Legion::Point<DIM>& extents,
                                            bool return_buffer /*= false*/)
@@ -450,4 +520,67 @@ void Store::return_data(Buffer<T, DIM>& buffer, const Legion::Point<DIM>& extent
   output_field_.return_data(buffer, extents);
 }
 
+template <typename T, int32_t DIM>
+void Store::return_data(GrowableBuffer<T, DIM>& buffer)
+{
+#ifdef DEBUG_LEGATE
+  check_valid_return();
+  check_buffer_dimension(DIM);
+#endif
+  auto extents = buffer.extents();
+  output_field_.return_data(buffer.buffer(), extents);
+}
+
+template <typename VAL, typename ACC, int32_t DIM>
+static Span<VAL> make_dense_span(const ACC& accessor, const Legion::Rect<DIM>& bounds)
+{
+  if (bounds.empty() || !accessor.accessor.is_dense_row_major(bounds)) return Span<VAL>();
+  return Span<VAL>(accessor.ptr(bounds.lo), bounds.volume());
+}
+
+template <typename T, int32_t DIM>
+Span<const T> Store::dense_read_span(const Legion::Rect<DIM>& bounds) const
+{
+  return make_dense_span<const T>(read_accessor<T, DIM>(bounds), bounds);
+}
+
+template <typename T, int32_t DIM>
+Span<T> Store::dense_write_span(const Legion::Rect<DIM>& bounds) const
+{
+  return make_dense_span<T>(write_accessor<T, DIM>(bounds), bounds);
+}
+
+template <typename T, int32_t DIM>
+Span<T> Store::dense_read_write_span(const Legion::Rect<DIM>& bounds) const
+{
+  return make_dense_span<T>(read_write_accessor<T, DIM>(bounds), bounds);
+}
+
+template <typename OP, bool EXCLUSIVE, int32_t DIM>
+Span<typename OP::RHS> Store::dense_reduce_span(const Legion::Rect<DIM>& bounds) const
+{
+  return make_dense_span<typename OP::RHS>(reduce_accessor<OP, EXCLUSIVE, DIM>(bounds), bounds);
+}
+
+template <typename VAL, int32_t DIM, typename ACC, typename Fn>
+void for_each_dense_run(const ACC& accessor, const Legion::Rect<DIM>& bounds, Fn&& fn)
+{
+  if (bounds.empty()) return;
+
+  if (accessor.accessor.is_dense_row_major(bounds)) {
+    fn(bounds.lo, Span<VAL>(accessor.ptr(bounds.lo), bounds.volume()));
+    return;
+  }
+
+  // Rows along the last dimension are contiguous as long as that dimension is packed
+  bool packed_rows  = accessor.accessor.strides[DIM - 1] == sizeof(VAL);
+  size_t run_length = packed_rows ? bounds.hi[DIM - 1] - bounds.lo[DIM - 1] + 1 : 1;
+  auto starts       = bounds;
+  if (packed_rows) starts.hi[DIM - 1] = bounds.lo[DIM - 1];
+
+  for (Legion::PointInRectIterator<DIM> it(starts, false /*column_major_order*/); it.valid();
+       it.step())
+    fn(*it, Span<VAL>(accessor.ptr(*it), run_length));
+}
+
 }  // namespace legate
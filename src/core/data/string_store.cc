@@ -0,0 +1,51 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/data/string_store.h"
+#include "core/runtime/runtime.h"
+#include "legate_defines.h"
+
+using namespace Legion;
+
+namespace legate {
+
+StringStoreView::StringStoreView(const Store& ranges, const Store& chars)
+{
+  if (ranges.code() != RECT1_LT || ranges.dim() != 1) {
+    log_legate.error("Ranges of a string store must be a 1-D store of type rect1");
+    LEGATE_ABORT;
+  }
+  if (chars.code() != INT8_LT || chars.dim() != 1) {
+    log_legate.error("Characters of a string store must be a 1-D store of type int8");
+    LEGATE_ABORT;
+  }
+  shape_       = ranges.shape<1>();
+  chars_shape_ = chars.shape<1>();
+  if (!shape_.empty()) ranges_ = ranges.read_accessor<Rect<1>, 1>(shape_);
+  if (!chars_shape_.empty()) chars_ = chars.read_accessor<int8_t, 1>(chars_shape_);
+}
+
+std::string_view StringStoreView::operator[](const Point<1>& p) const
+{
+  auto range = ranges_[p];
+  if (range.empty()) return std::string_view();
+#ifdef DEBUG_LEGATE
+  assert(chars_shape_.contains(range));
+#endif
+  return std::string_view(reinterpret_cast<const char*>(chars_.ptr(range.lo)), range.volume());
+}
+
+}  // namespace legate
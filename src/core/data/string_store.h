@@ -0,0 +1,51 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <string_view>
+
+#include "core/data/store.h"
+
+namespace legate {
+
+// A read-only view of a string store, which consists of a 1-D store of ranges and a 1-D store of
+// characters. Each element of the ranges store is the inclusive range of points in the character
+// store holding one string. The task sees the characters of all the strings in its piece of the
+// ranges only when the operation partitions the characters by the image of the ranges, which
+// the Python side does with Operation.add_image. Both stores are 1-D, so their instances are
+// always dense and each string is a contiguous run of characters.
+class StringStoreView {
+ public:
+  StringStoreView(const Store& ranges, const Store& chars);
+
+ public:
+  Legion::Rect<1> shape() const { return shape_; }
+  bool empty() const { return shape_.empty(); }
+
+ public:
+  Legion::Rect<1> range(const Legion::Point<1>& p) const { return ranges_[p]; }
+  size_t size(const Legion::Point<1>& p) const { return range(p).volume(); }
+  std::string_view operator[](const Legion::Point<1>& p) const;
+
+ private:
+  Legion::Rect<1> shape_;
+  Legion::Rect<1> chars_shape_;
+  AccessorRO<Legion::Rect<1>, 1> ranges_;
+  AccessorRO<int8_t, 1> chars_;
+};
+
+}  // namespace legate
@@ -81,13 +81,21 @@ std::unique_ptr<StoreTransform> TransformStack::pop()
   assert(transform_ != nullptr);
 #endif
   auto result = std::move(transform_);
-  if (parent_ != nullptr) {
+  // The parent may be the shared identity stack, which must never be modified
+  if (parent_ != nullptr && !parent_->identity()) {
     transform_ = std::move(parent_->transform_);
     parent_    = std::move(parent_->parent_);
-  }
+  } else
+    parent_ = nullptr;
   return std::move(result);
 }
 
+/*static*/ std::shared_ptr<TransformStack> TransformStack::identity_stack()
+{
+  static const auto identity = std::make_shared<TransformStack>();
+  return identity;
+}
+
 void TransformStack::dump() const { std::cerr << *this << std::endl; }
 
 Shift::Shift(int32_t dim, int64_t offset) : dim_(dim), offset_(offset) {}
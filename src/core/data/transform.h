@@ -48,6 +48,10 @@ struct TransformStack : public Transform {
   std::unique_ptr<StoreTransform> pop();
   bool identity() const { return nullptr == transform_; }
 
+ public:
+  // Returns a stack with no transforms, shared by every untransformed store
+  static std::shared_ptr<TransformStack> identity_stack();
+
  public:
   void dump() const;
 
@@ -14,8 +14,183 @@
  *
  */
 
+#include <algorithm>
+#include <cstring>
+
+#include "core/runtime/launcher.h"
 #include "core/runtime/runtime.h"
+#include "core/task/fusion.h"
+#include "core/task/task.h"
+#include "core/task/task_stats.h"
+#include "core/utilities/memory_usage.h"
+
+#include "legion/legion_c_util.h"
+
+#ifdef LEGATE_USE_CUDA
+#include "core/cuda/cuda_help.h"
+#include "realm/cuda/cuda_access.h"
+#endif
 
 void legate_parse_config(void) { legate::Core::parse_config(); }
 
 void legate_shutdown(void) { legate::Core::shutdown(); }
+
+static size_t copy_summary(const std::string& summary, char* buffer, size_t size)
+{
+  if (size > 0) {
+    auto to_copy = std::min(size - 1, summary.size());
+    memcpy(buffer, summary.c_str(), to_copy);
+    buffer[to_copy] = '\0';
+  }
+  return summary.size() + 1;
+}
+
+size_t legate_task_stats_summary(char* buffer, size_t size)
+{
+  return copy_summary(legate::TaskStats::summary(), buffer, size);
+}
+
+size_t legate_memory_usage_summary(char* buffer, size_t size)
+{
+  return copy_summary(legate::MemoryUsage::summary(), buffer, size);
+}
+
+int32_t legate_mapping_cache_enabled(void)
+{
+  return static_cast<int32_t>(legate::extract_env("LEGATE_MAPPING_CACHE", 0, 0) != 0);
+}
+
+int32_t legate_pin_host_allocation(void* ptr, size_t size)
+{
+#ifdef LEGATE_USE_CUDA
+  // The allocation is registered as portable so that it is pinned for all devices, and as
+  // mapped so that kernels can address it with the same pointer
+  auto result = cudaHostRegister(ptr, size, cudaHostRegisterPortable | cudaHostRegisterMapped);
+  if (result == cudaSuccess) return 1;
+  // Clear the error so that it isn't reported by unrelated CUDA calls
+  cudaGetLastError();
+  return result == cudaErrorHostMemoryAlreadyRegistered ? 0 : -1;
+#else
+  return -1;
+#endif
+}
+
+void legate_unpin_host_allocation(void* ptr)
+{
+#ifdef LEGATE_USE_CUDA
+  CHECK_CUDA(cudaHostUnregister(ptr));
+#endif
+}
+
+legion_memory_t legate_find_device_memory(const void* ptr)
+{
+  auto memory = Legion::Memory::NO_MEMORY;
+#ifdef LEGATE_USE_CUDA
+  cudaPointerAttributes attrs;
+  if (cudaPointerGetAttributes(&attrs, ptr) != cudaSuccess) {
+    cudaGetLastError();
+    return Legion::CObjectWrapper::wrap(memory);
+  }
+  if (attrs.type != cudaMemoryTypeDevice) return Legion::CObjectWrapper::wrap(memory);
+  // Realm doesn't number GPUs the way CUDA does, so we look for the processor driving the
+  // device and take the framebuffer it has affinity to
+  auto machine = Legion::Machine::get_machine();
+  Legion::Machine::ProcessorQuery gpus(machine);
+  gpus.local_address_space().only_kind(Legion::Processor::TOC_PROC);
+  for (auto gpu : gpus) {
+    int device = -1;
+    if (!Realm::Cuda::get_cuda_device_id(gpu, &device) || device != attrs.device) continue;
+    Legion::Machine::MemoryQuery fbs(machine);
+    fbs.only_kind(Legion::Memory::GPU_FB_MEM).best_affinity_to(gpu);
+    if (fbs.count() > 0) memory = fbs.first();
+    break;
+  }
+#endif
+  return Legion::CObjectWrapper::wrap(memory);
+}
+
+bool legate_has_cpu_variant(legion_task_id_t task_id)
+{
+  return legate::LegateTaskRegistrar::has_registered_variant(task_id, Legion::Processor::LOC_PROC);
+}
+
+bool legate_has_fusable_variants(legion_task_id_t task_id)
+{
+  return legate::fusion::has_fusable_variants(task_id);
+}
+
+static legate::TaskLauncher::RegionStore to_region_store(const legate_store_arg_t& arg)
+{
+  legate::TaskLauncher::RegionStore store;
+  store.region   = Legion::CObjectWrapper::unwrap(arg.region);
+  store.field_id = arg.field_id;
+  store.code     = static_cast<legate::LegateTypeCode>(arg.code);
+  store.tag      = arg.tag;
+  store.flags    = static_cast<Legion::RegionFlags>(arg.flags);
+  return store;
+}
+
+legion_future_t legate_launch_single_task(legion_runtime_t runtime_,
+                                          legion_context_t ctx_,
+                                          legion_task_id_t task_id,
+                                          legion_mapper_id_t mapper_id,
+                                          legion_mapping_tag_id_t tag,
+                                          const legate_store_arg_t* inputs,
+                                          size_t num_inputs,
+                                          const legate_store_arg_t* outputs,
+                                          size_t num_outputs,
+                                          const legate_store_arg_t* reductions,
+                                          size_t num_reductions,
+                                          const legate_scalar_arg_t* scalars,
+                                          size_t num_scalars,
+                                          bool can_raise_exception,
+                                          bool reports_time,
+                                          bool side_effect,
+                                          const char* provenance)
+{
+  auto runtime = Legion::CObjectWrapper::unwrap(runtime_);
+  auto ctx     = Legion::CObjectWrapper::unwrap(ctx_)->context();
+
+  legate::TaskLauncher launcher(task_id, mapper_id, tag);
+  for (size_t idx = 0; idx < num_inputs; ++idx) launcher.add_input(to_region_store(inputs[idx]));
+  for (size_t idx = 0; idx < num_outputs; ++idx)
+    launcher.add_output(to_region_store(outputs[idx]));
+  for (size_t idx = 0; idx < num_reductions; ++idx)
+    launcher.add_reduction(to_region_store(reductions[idx]), reductions[idx].redop);
+  // The scalars point to the caller's values, which stay alive until the arguments are packed
+  for (size_t idx = 0; idx < num_scalars; ++idx)
+    launcher.add_scalar(legate::Scalar(
+      false /*tuple*/, static_cast<legate::LegateTypeCode>(scalars[idx].code), scalars[idx].value));
+  launcher.set_can_raise_exception(can_raise_exception);
+  launcher.set_reports_time(reports_time);
+  launcher.set_side_effect(side_effect);
+  if (provenance != nullptr) launcher.set_provenance(provenance);
+
+  auto future = launcher.execute_single(runtime, ctx);
+  return Legion::CObjectWrapper::wrap(new Legion::Future(future));
+}
+
+legion_future_t legate_issue_timing_op(legion_runtime_t runtime_,
+                                       legion_context_t ctx_,
+                                       int32_t unit,
+                                       const legion_future_t* preconditions,
+                                       size_t num_preconditions)
+{
+  auto runtime = Legion::CObjectWrapper::unwrap(runtime_);
+  auto ctx     = Legion::CObjectWrapper::unwrap(ctx_)->context();
+
+  Legion::TimingMeasurement measurement;
+  switch (unit) {
+    case LEGATE_CORE_TIMING_SECONDS: measurement = LEGION_MEASURE_SECONDS; break;
+    case LEGATE_CORE_TIMING_MICROSECONDS: measurement = LEGION_MEASURE_MICRO_SECONDS; break;
+    case LEGATE_CORE_TIMING_NANOSECONDS: measurement = LEGION_MEASURE_NANO_SECONDS; break;
+    default: LEGATE_ABORT;
+  }
+
+  Legion::TimingLauncher launcher(measurement);
+  for (size_t idx = 0; idx < num_preconditions; ++idx)
+    launcher.add_precondition(*Legion::CObjectWrapper::unwrap(preconditions[idx]));
+
+  auto future = runtime->issue_timing_measurement(ctx, launcher);
+  return Legion::CObjectWrapper::wrap(new Legion::Future(future));
+}
@@ -18,6 +18,7 @@
 #define __LEGATE_C_H__
 
 #ifndef LEGATE_USE_PYTHON_CFFI
+#include "legion/legion_c.h"
 #include "legion/legion_config.h"
 //
 #include <cstdint>
@@ -31,6 +32,9 @@ typedef enum legate_core_task_id_t {
   LEGATE_CORE_INIT_CPUCOLL_MAPPING_TASK_ID,
   LEGATE_CORE_INIT_CPUCOLL_TASK_ID,
   LEGATE_CORE_FINALIZE_CPUCOLL_TASK_ID,
+  LEGATE_CORE_FUSED_TASK_ID,
+  LEGATE_CORE_COLL_BENCH_TASK_ID,
+  LEGATE_CORE_COMPRESSED_SHUFFLE_TASK_ID,
   LEGATE_CORE_NUM_TASK_IDS,  // must be last
 } legate_core_task_id_t;
 
@@ -44,6 +48,8 @@ typedef enum legate_core_proj_id_t {
 typedef enum legate_core_shard_id_t {
   LEGATE_CORE_TOPLEVEL_TASK_SHARD_ID = 0,
   LEGATE_CORE_LINEARIZE_SHARD_ID     = 1,
+  LEGATE_CORE_TILED_SHARD_ID         = 2,
+  LEGATE_CORE_MORTON_SHARD_ID        = 3,
   // All sharding functors starting from LEGATE_CORE_FIRST_DYNAMIC_FUNCTOR should match the
   // projection functor of the same id. The sharding functor limit is thus the same as the
   // projection functor limit.
@@ -64,6 +70,9 @@ typedef enum legate_core_tunable_t {
   LEGATE_CORE_TUNABLE_FIELD_REUSE_FREQUENCY,
   LEGATE_CORE_TUNABLE_MAX_LRU_LENGTH,
   LEGATE_CORE_TUNABLE_NCCL_NEEDS_BARRIER,
+  LEGATE_CORE_TUNABLE_PIECE_MEMORY_SIZE,
+  LEGATE_CORE_TUNABLE_LOCAL_BANDWIDTH,
+  LEGATE_CORE_TUNABLE_REMOTE_BANDWIDTH,
 } legate_core_tunable_t;
 
 typedef enum legate_core_variant_t {
@@ -90,6 +99,7 @@ typedef enum legate_core_type_code_t {
   COMPLEX64_LT  = LEGION_TYPE_COMPLEX64,
   COMPLEX128_LT = LEGION_TYPE_COMPLEX128,
   STRING_LT     = COMPLEX128_LT + 1,
+  RECT1_LT      = STRING_LT + 1,
   MAX_TYPE_NUMBER,
 } legate_core_type_code_t;
 
@@ -106,13 +116,50 @@ typedef enum legate_core_mapping_tag_t {
   LEGATE_CORE_MANUAL_PARALLEL_LAUNCH_TAG = 2,
   LEGATE_CORE_TREE_REDUCE_TAG            = 3,
   LEGATE_CORE_JOIN_EXCEPTION_TAG         = 4,
+  LEGATE_CORE_DEVICE_INLINE_MAP_TAG      = 5,
+  LEGATE_CORE_EAGER_TASK_TAG             = 6,
+  LEGATE_CORE_GPU_TASK_TAG               = 7,
 } legate_core_mapping_tag_t;
 
+typedef enum legate_core_redop_kind_t {
+  LEGATE_CORE_REDOP_ADD = 0,
+  LEGATE_CORE_REDOP_MUL,
+  LEGATE_CORE_REDOP_MAX,
+  LEGATE_CORE_REDOP_MIN,
+  LEGATE_CORE_NUM_REDOP_KINDS,
+} legate_core_redop_kind_t;
+
 typedef enum legate_core_reduction_op_id_t {
-  LEGATE_CORE_JOIN_EXCEPTION_OP   = 0,
-  LEGATE_CORE_MAX_REDUCTION_OP_ID = 1,
+  LEGATE_CORE_JOIN_EXCEPTION_OP = 0,
+  // Built-in reduction operators take one id per (kind, type) pair starting from here
+  LEGATE_CORE_FIRST_BUILTIN_REDOP = 1,
+  LEGATE_CORE_MAX_REDUCTION_OP_ID =
+    LEGATE_CORE_FIRST_BUILTIN_REDOP + LEGATE_CORE_NUM_REDOP_KINDS * MAX_TYPE_NUMBER,
 } legate_core_reduction_op_id_t;
 
+typedef enum legate_core_timing_unit_t {
+  LEGATE_CORE_TIMING_SECONDS = 0,
+  LEGATE_CORE_TIMING_MICROSECONDS,
+  LEGATE_CORE_TIMING_NANOSECONDS,
+} legate_core_timing_unit_t;
+
+// A store backed by a region field, passed to legate_launch_single_task
+typedef struct legate_store_arg_t {
+  legion_logical_region_t region;
+  legion_field_id_t field_id;
+  int32_t code;
+  // Reduction operator of the store, which is ignored unless the store is a reduction
+  legion_reduction_op_id_t redop;
+  legion_mapping_tag_id_t tag;
+  uint32_t flags;
+} legate_store_arg_t;
+
+// A scalar of a fixed-size primitive type, passed to legate_launch_single_task
+typedef struct legate_scalar_arg_t {
+  int32_t code;
+  const void* value;
+} legate_scalar_arg_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -120,6 +167,17 @@ extern "C" {
 void legate_parse_config(void);
 void legate_shutdown(void);
 
+// Copies the task statistics table into the buffer, truncating it to the buffer size, and
+// returns the number of bytes needed to hold it including the terminating null character
+size_t legate_task_stats_summary(char* buffer, size_t size);
+
+// Same as legate_task_stats_summary, but for the current and peak memory usage of this process
+size_t legate_memory_usage_summary(char* buffer, size_t size);
+
+// Returns nonzero if the mappers memoize their mappings (LEGATE_MAPPING_CACHE=1), in which case
+// traces can replay the mappings along with the dependence analysis
+int32_t legate_mapping_cache_enabled(void);
+
 void legate_core_perform_registration(void);
 
 void legate_register_affine_projection_functor(
@@ -134,6 +192,53 @@ void legate_cpucoll_finalize(void);
 
 int legate_cpucoll_initcomm(void);
 
+// Page-locks a host allocation so that GPUs can access it directly. Returns 1 if the call
+// pinned the allocation, 0 if the allocation was already page-locked, and -1 if it cannot be
+// pinned, which is always the case when Legate is built without CUDA support.
+int32_t legate_pin_host_allocation(void* ptr, size_t size);
+
+void legate_unpin_host_allocation(void* ptr);
+
+// Returns the local framebuffer memory that holds the allocation, or a null memory if the
+// allocation is not in the memory of a GPU this process drives
+legion_memory_t legate_find_device_memory(const void* ptr);
+
+// Returns true if the task has a CPU variant registered on this node. The task id is a global id.
+bool legate_has_cpu_variant(legion_task_id_t task_id);
+
+// Returns true if the task has a fusable variant for every kind of processor on this node. The
+// task id is a global id.
+bool legate_has_fusable_variants(legion_task_id_t task_id);
+
+// Packs the arguments and launches a single task in one call. The stores are passed to the
+// task without transformations. The task id and mapper id are global ids.
+legion_future_t legate_launch_single_task(legion_runtime_t runtime,
+                                          legion_context_t ctx,
+                                          legion_task_id_t task_id,
+                                          legion_mapper_id_t mapper_id,
+                                          legion_mapping_tag_id_t tag,
+                                          const legate_store_arg_t* inputs,
+                                          size_t num_inputs,
+                                          const legate_store_arg_t* outputs,
+                                          size_t num_outputs,
+                                          const legate_store_arg_t* reductions,
+                                          size_t num_reductions,
+                                          const legate_scalar_arg_t* scalars,
+                                          size_t num_scalars,
+                                          bool can_raise_exception,
+                                          bool reports_time,
+                                          bool side_effect,
+                                          const char* provenance);
+
+// Issues a timing measurement that is taken once all the precondition futures are complete.
+// Unlike a measurement following an execution fence, this doesn't hold back the operations
+// issued afterwards. The unit is one of legate_core_timing_unit_t.
+legion_future_t legate_issue_timing_op(legion_runtime_t runtime,
+                                       legion_context_t ctx,
+                                       int32_t unit,
+                                       const legion_future_t* preconditions,
+                                       size_t num_preconditions);
+
 #ifdef __cplusplus
 }
 #endif
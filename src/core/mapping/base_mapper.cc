@@ -14,7 +14,9 @@
  *
  */
 
+#include <algorithm>
 #include <cstdlib>
+#include <limits>
 #include <sstream>
 #include <unordered_map>
 
@@ -24,10 +26,16 @@
 #include "core/data/store.h"
 #include "core/mapping/base_mapper.h"
 #include "core/mapping/instance_manager.h"
+#include "core/mapping/mapping_trace.h"
 #include "core/mapping/operation.h"
+#include "core/mapping/variant_tuner.h"
 #include "core/runtime/projection.h"
+#include "core/runtime/runtime.h"
 #include "core/runtime/shard.h"
 #include "core/utilities/linearize.h"
+#include "core/utilities/machine.h"
+#include "core/utilities/memory_usage.h"
+#include "core/utilities/trace.h"
 #include "legate_defines.h"
 
 using LegionTask = Legion::Task;
@@ -81,63 +89,32 @@ BaseMapper::BaseMapper(Runtime* rt, Machine m, const LibraryContext& ctx)
     machine(m),
     context(ctx),
     local_node(get_local_node()),
-    total_nodes(get_total_nodes(m)),
+    total_nodes(LocalMachine::get_local_machine().total_nodes),
     mapper_name(std::move(create_name(local_node))),
     logger(create_logger_name().c_str()),
-    local_instances(InstanceManager::get_instance_manager())
-{
-  // Query to find all our local processors
-  Machine::ProcessorQuery local_procs(machine);
-  local_procs.local_address_space();
-  for (auto local_proc : local_procs) {
-    switch (local_proc.kind()) {
-      case Processor::LOC_PROC: {
-        local_cpus.push_back(local_proc);
-        break;
-      }
-      case Processor::TOC_PROC: {
-        local_gpus.push_back(local_proc);
-        break;
-      }
-      case Processor::OMP_PROC: {
-        local_omps.push_back(local_proc);
-        break;
-      }
-      default: break;
-    }
-  }
-  // Now do queries to find all our local memories
-  Machine::MemoryQuery local_sysmem(machine);
-  local_sysmem.local_address_space();
-  local_sysmem.only_kind(Memory::SYSTEM_MEM);
-  assert(local_sysmem.count() > 0);
-  local_system_memory = local_sysmem.first();
-  if (!local_gpus.empty()) {
-    Machine::MemoryQuery local_zcmem(machine);
-    local_zcmem.local_address_space();
-    local_zcmem.only_kind(Memory::Z_COPY_MEM);
-    assert(local_zcmem.count() > 0);
-    local_zerocopy_memory = local_zcmem.first();
-  }
-  for (auto& local_gpu : local_gpus) {
-    Machine::MemoryQuery local_framebuffer(machine);
-    local_framebuffer.local_address_space();
-    local_framebuffer.only_kind(Memory::GPU_FB_MEM);
-    local_framebuffer.best_affinity_to(local_gpu);
-    assert(local_framebuffer.count() > 0);
-    local_frame_buffers[local_gpu] = local_framebuffer.first();
-  }
-  for (auto& local_omp : local_omps) {
-    Machine::MemoryQuery local_numa(machine);
-    local_numa.local_address_space();
-    local_numa.only_kind(Memory::SOCKET_MEM);
-    local_numa.best_affinity_to(local_omp);
-    if (local_numa.count() > 0)  // if we have NUMA memories then use them
-      local_numa_domains[local_omp] = local_numa.first();
-    else  // Otherwise we just use the local system memory
-      local_numa_domains[local_omp] = local_system_memory;
-  }
-  generate_prime_factors();
+    local_instances(InstanceManager::get_instance_manager()),
+    memoize_mappings(static_cast<bool>(extract_env("LEGATE_MAPPING_CACHE", 0, 0))),
+    enable_stealing(static_cast<bool>(extract_env("LEGATE_WORK_STEALING", 0, 0))),
+    min_steal_backlog(extract_env("LEGATE_MIN_STEAL_BACKLOG", 2, 2)),
+    numa_aware_slicing(static_cast<bool>(extract_env("LEGATE_NUMA_AWARE_SLICING", 1, 1))),
+    enable_spilling(static_cast<bool>(extract_env("LEGATE_SPILLING", 0, 0)))
+{
+  // The processors and memories come from the machine model shared by all mappers
+  auto& local_machine   = LocalMachine::get_local_machine();
+  local_cpus            = local_machine.cpus;
+  local_gpus            = local_machine.gpus;
+  local_omps            = local_machine.omps;
+  local_system_memory   = local_machine.system_memory;
+  local_zerocopy_memory = local_machine.zerocopy_memory;
+  local_frame_buffers   = local_machine.frame_buffers;
+  local_numa_domains    = local_machine.numa_domains;
+  for (auto& local_omp : local_omps)
+    numa_domain_processors[local_numa_domains[local_omp]].push_back(local_omp);
+  numa_aware_slicing = numa_aware_slicing && numa_domain_processors.size() > 1;
+  // Runtimes differ between nodes, so the tuner would make different choices on each shard
+  if (static_cast<bool>(extract_env("LEGATE_AUTOTUNE_VARIANTS", 0, 0)) && total_nodes == 1)
+    variant_tuner = std::make_unique<VariantTuner>(extract_env("LEGATE_AUTOTUNE_WARMUP", 3, 1));
+  if (enable_stealing) steal_timings = std::make_unique<VariantTuner>(1);
 }
 
 BaseMapper::~BaseMapper(void)
@@ -173,13 +150,9 @@ BaseMapper::~BaseMapper(void)
   return p.address_space();
 }
 
-/*static*/ size_t BaseMapper::get_total_nodes(Machine m)
+/*static*/ size_t BaseMapper::get_total_nodes(Machine /*m*/)
 {
-  Machine::ProcessorQuery query(m);
-  query.only_kind(Processor::LOC_PROC);
-  std::set<AddressSpace> spaces;
-  for (auto proc : query) spaces.insert(proc.address_space());
-  return spaces.size();
+  return LocalMachine::get_local_machine().total_nodes;
 }
 
 std::string BaseMapper::create_name(AddressSpace node) const
@@ -207,6 +180,26 @@ void BaseMapper::select_task_options(const MapperContext ctx,
                                      const LegionTask& task,
                                      TaskOptions& output)
 {
+  // We never want valid instances
+  output.valid_instances = false;
+  // Eager tasks only touch tiny stores, which are cheapest to process on the CPUs of this node.
+  // Those without a CPU variant go through the usual selection.
+  if (task.tag == LEGATE_CORE_EAGER_TASK_TAG && !task.is_index_space && !local_cpus.empty() &&
+      has_variant(ctx, task, Processor::LOC_PROC)) {
+    output.initial_proc = local_cpus.front();
+    return;
+  }
+  // Tasks handed resources that only GPUs can use, such as NCCL communicators, must run on GPUs
+  if (task.tag == LEGATE_CORE_GPU_TASK_TAG) {
+    if (local_gpus.empty() || !has_variant(ctx, task, Processor::TOC_PROC)) {
+      logger.error("Task %s must run on a GPU, but there is none it can run on",
+                   task.get_task_name());
+      LEGATE_ABORT;
+    }
+    output.initial_proc = local_gpus.front();
+    return;
+  }
+
   std::vector<TaskTarget> options;
   if (!local_gpus.empty() && has_variant(ctx, task, Processor::TOC_PROC))
     options.push_back(TaskTarget::GPU);
@@ -216,10 +209,57 @@ void BaseMapper::select_task_options(const MapperContext ctx,
 
   Task legate_task(&task, context, runtime, ctx);
   auto target = task_target(legate_task, options);
+  if (variant_tuner != nullptr && options.size() > 1)
+    target = tune_task_target(ctx, task, options, target);
 
   dispatch(target, [&output](auto& procs) { output.initial_proc = procs.front(); });
-  // We never want valid instances
-  output.valid_instances = false;
+}
+
+size_t BaseMapper::get_point_bytes(const MapperContext ctx, const LegionTask& task)
+{
+  size_t num_points = task.is_index_space ? task.index_domain.get_volume() : 1;
+  size_t bytes      = 0;
+  for (auto& req : task.regions) {
+    // Requirements of index tasks that are projected from partitions cover the whole store,
+    // which is split between the points
+    bool partitioned = req.handle_type == LEGION_PARTITION_PROJECTION;
+    auto region      = partitioned ? runtime->get_parent_logical_region(ctx, req.partition)
+                                   : req.region;
+    if (!region.exists()) continue;
+    size_t volume = runtime->get_index_space_domain(ctx, region.get_index_space()).get_volume();
+    if (partitioned) volume = (volume + num_points - 1) / num_points;
+    for (auto fid : req.instance_fields)
+      bytes += volume * runtime->get_field_size(ctx, region.get_field_space(), fid);
+  }
+  return bytes;
+}
+
+TaskTarget BaseMapper::tune_task_target(const MapperContext ctx,
+                                        const LegionTask& task,
+                                        const std::vector<TaskTarget>& options,
+                                        TaskTarget fallback)
+{
+  auto bytes = get_point_bytes(ctx, task);
+
+  // The data is most likely where the library's choice of target would have put it, so any other
+  // target needs to move the data in and out first
+  auto get_memory = [&](TaskTarget target) {
+    auto proc = dispatch(target, [](auto& procs) { return procs.front(); });
+    return get_target_memory(proc, default_store_targets(proc.kind()).front());
+  };
+  auto fallback_memory = get_memory(fallback);
+  // get_copy_cost estimates the time to copy a nominal megabyte
+  double megabytes = static_cast<double>(bytes) / (1 << 20);
+
+  std::vector<double> penalties;
+  for (auto& option : options) {
+    auto memory = get_memory(option);
+    penalties.push_back(memory == fallback_memory
+                          ? 0.0
+                          : megabytes * (get_copy_cost(fallback_memory, memory) +
+                                         get_copy_cost(memory, fallback_memory)));
+  }
+  return variant_tuner->select_target(task.task_id, bytes, options, penalties, fallback);
 }
 
 void BaseMapper::premap_task(const MapperContext ctx,
@@ -230,15 +270,21 @@ void BaseMapper::premap_task(const MapperContext ctx,
   // NO-op since we know that all our futures should be mapped in the system memory
 }
 
+// Bounds the processors recorded for the points of tree reduction levels
+static constexpr size_t MAX_TREE_REDUCE_PROCS = 4096;
+
 void BaseMapper::slice_auto_task(const MapperContext ctx,
                                  const LegionTask& task,
                                  const SliceTaskInput& input,
                                  SliceTaskOutput& output)
 {
-  ProjectionID projection = 0;
+  trace::Range auto_range("legate::mapper::slice_task");
+  ProjectionID projection                 = 0;
+  const Legion::RegionRequirement* key_req = nullptr;
   for (auto& req : task.regions)
     if (req.tag == LEGATE_CORE_KEY_STORE_TAG) {
       projection = req.projection;
+      key_req    = &req;
       break;
     }
   auto key_functor = find_legate_projection_functor(projection);
@@ -253,71 +299,179 @@ void BaseMapper::slice_auto_task(const MapperContext ctx,
   if (task.sharding_space.exists())
     sharding_domain = runtime->get_index_space_domain(ctx, task.sharding_space);
 
+  bool stealable = is_stealable(task);
+
+  bool tree_reduce = task.tag == LEGATE_CORE_TREE_REDUCE_TAG;
+
+  // OpenMP points go to the processor whose NUMA domain already holds the instance of the key
+  // store's subregion for the point, if there is one. Otherwise, they are round-robined and
+  // their outputs get created in the NUMA domain of the processor they first run on.
+  bool numa_aware = numa_aware_slicing && task.target_proc.kind() == Processor::OMP_PROC &&
+                    key_req != nullptr && key_req->handle_type == LEGION_PARTITION_PROJECTION &&
+                    !key_req->instance_fields.empty();
+
   auto round_robin = [&](auto& procs) {
     auto lo = key_functor->project_point(sharding_domain.lo(), sharding_domain);
     auto hi = key_functor->project_point(sharding_domain.hi(), sharding_domain);
     for (Domain::DomainPointIterator itr(input.domain); itr; itr++) {
-      auto p   = key_functor->project_point(itr.p, sharding_domain);
-      auto idx = linearize(lo, hi, p);
-      output.slices.push_back(TaskSlice(
-        Domain(itr.p, itr.p), procs[idx % procs.size()], false /*recurse*/, false /*stealable*/));
+      auto p    = key_functor->project_point(itr.p, sharding_domain);
+      auto idx  = linearize(lo, hi, p);
+      auto proc = procs[idx % procs.size()];
+      if (tree_reduce) {
+        proc = find_tree_reduce_processor(ctx, task, itr.p, procs, proc);
+        // The outputs of the final level are never looked up, so the table is cleared whenever
+        // it grows too large
+        if (tree_reduce_procs.size() >= MAX_TREE_REDUCE_PROCS) tree_reduce_procs.clear();
+        for (auto& req : task.output_regions)
+          tree_reduce_procs[std::make_pair(req.region.get_tree_id(), itr.p[0])] = proc;
+      } else if (numa_aware) {
+        auto color = key_functor->project_point(itr.p, task.index_domain);
+        proc       = find_numa_affine_processor(ctx, *key_req, color, idx, proc);
+      }
+      // Points of tree reductions go where their inputs were produced, so they are never stolen
+      output.slices.push_back(
+        TaskSlice(Domain(itr.p, itr.p), proc, false /*recurse*/, stealable && !tree_reduce));
     }
   };
 
   dispatch(task.target_proc.kind(), round_robin);
 }
 
-void BaseMapper::generate_prime_factor(const std::vector<Processor>& processors,
-                                       Processor::Kind kind)
+Processor BaseMapper::find_numa_affine_processor(const MapperContext ctx,
+                                                 const Legion::RegionRequirement& key_req,
+                                                 const DomainPoint& color,
+                                                 uint64_t idx,
+                                                 Processor fallback)
 {
-  std::vector<int32_t>& factors = all_factors[kind];
-  int32_t num_procs             = static_cast<int32_t>(processors.size());
+  if (!runtime->has_logical_subregion_by_color(ctx, key_req.partition, color)) return fallback;
+  auto region   = runtime->get_logical_subregion_by_color(ctx, key_req.partition, color);
+  auto field_id = *key_req.instance_fields.begin();
+  auto policy   = InstanceMappingPolicy::default_policy(StoreTarget::SOCKETMEM);
 
-  auto generate_factors = [&](int32_t factor) {
-    while (num_procs % factor == 0) {
-      factors.push_back(factor);
-      num_procs /= factor;
-    }
+  // Slicing only looks for the instances, which mustn't make them look recently used to the
+  // eviction, as the task may not end up using them
+  auto has_instance = [&](Memory memory) {
+    AutoLock lock(ctx, local_instances->manager_lock(memory));
+    PhysicalInstance instance;
+    return local_instances->peek_instance(region, field_id, memory, instance, policy);
   };
-  generate_factors(2);
-  generate_factors(3);
-  generate_factors(5);
-  generate_factors(7);
-  generate_factors(11);
-}
 
-void BaseMapper::generate_prime_factors()
-{
-  if (local_gpus.size() > 0) generate_prime_factor(local_gpus, Processor::TOC_PROC);
-  if (local_omps.size() > 0) generate_prime_factor(local_omps, Processor::OMP_PROC);
-  if (local_cpus.size() > 0) generate_prime_factor(local_cpus, Processor::LOC_PROC);
+  auto fallback_memory = local_numa_domains[fallback];
+  if (has_instance(fallback_memory)) return fallback;
+
+  for (auto& pair : numa_domain_processors) {
+    if (pair.first == fallback_memory) continue;
+    if (!has_instance(pair.first)) continue;
+    // Points are still round-robined over the processors that share the NUMA domain
+    auto& procs = pair.second;
+    return procs[idx % procs.size()];
+  }
+  return fallback;
+}
+
+Processor BaseMapper::find_tree_reduce_processor(const MapperContext ctx,
+                                                 const LegionTask& task,
+                                                 const DomainPoint& point,
+                                                 const std::vector<Processor>& procs,
+                                                 Processor fallback)
+{
+  // Each point of a tree reduction level reads a contiguous range of the outputs of the previous
+  // level, and we recorded where the points of that level went when we sliced it. The point goes
+  // to the local processor that produced the most of its inputs.
+  std::vector<std::pair<Processor, uint32_t>> counts;
+  for (auto& req : task.regions) {
+    if (req.handle_type != LEGION_PARTITION_PROJECTION) continue;
+    auto* functor = find_legate_projection_functor(req.projection);
+    auto color    = functor->project_point(point, task.index_domain);
+    // The last point of a level can have fewer inputs than the radix
+    if (!runtime->has_logical_subregion_by_color(ctx, req.partition, color)) continue;
+    // Inputs produced on other nodes or by tasks that aren't tree reductions are unknown
+    auto producer = tree_reduce_procs.find(std::make_pair(req.partition.get_tree_id(), color[0]));
+    if (producer == tree_reduce_procs.end()) continue;
+    auto proc = producer->second;
+    tree_reduce_procs.erase(producer);
+    if (std::find(procs.begin(), procs.end(), proc) == procs.end()) continue;
+    auto found = std::find_if(
+      counts.begin(), counts.end(), [&proc](const auto& pair) { return pair.first == proc; });
+    if (found == counts.end())
+      counts.push_back(std::make_pair(proc, 1));
+    else
+      ++found->second;
+  }
+  if (counts.empty()) return fallback;
+  // Ties go to the processor of the first input
+  auto best = std::max_element(counts.begin(), counts.end(), [](const auto& a, const auto& b) {
+    return a.second < b.second;
+  });
+  return best->first;
+}
+
+static void enumerate_processor_grids(
+  int32_t num_procs,
+  std::vector<int32_t>& grid,
+  int32_t dim,
+  const std::function<void(const std::vector<int32_t>&)>& callback)
+{
+  if (dim + 1 == static_cast<int32_t>(grid.size())) {
+    grid[dim] = num_procs;
+    callback(grid);
+    return;
+  }
+  for (int32_t factor = 1; factor <= num_procs; ++factor) {
+    if (num_procs % factor != 0) continue;
+    grid[dim] = factor;
+    enumerate_processor_grids(num_procs / factor, grid, dim + 1, callback);
+  }
 }
 
-const std::vector<int32_t> BaseMapper::get_processor_grid(Legion::Processor::Kind kind,
-                                                          int32_t ndim)
+const std::vector<int32_t>& BaseMapper::get_processor_grid(Legion::Processor::Kind kind,
+                                                           const Domain& domain)
 {
-  auto key    = std::make_pair(kind, ndim);
+  int32_t ndim = domain.dim;
+  std::vector<int64_t> extents(ndim);
+  for (int32_t dim = 0; dim < ndim; ++dim)
+    extents[dim] = domain.hi()[dim] - domain.lo()[dim] + 1;
+
+  auto key    = std::make_pair(kind, extents);
   auto finder = proc_grids.find(key);
   if (finder != proc_grids.end()) return finder->second;
 
   int32_t num_procs = dispatch(kind, [](auto& procs) { return procs.size(); });
 
-  std::vector<int32_t> grid;
-  auto factor_it = all_factors[kind].begin();
-  grid.resize(ndim, 1);
-
-  while (num_procs > 1) {
-    auto min_it = std::min_element(grid.begin(), grid.end());
-    auto factor = *factor_it++;
-    (*min_it) *= factor;
-    num_procs /= factor;
-  }
-
-  auto& pitches = proc_grids[key];
-  pitches.resize(ndim, 1);
-  for (int32_t dim = 1; dim < ndim; ++dim) pitches[dim] = pitches[dim - 1] * grid[dim - 1];
+  // We pick the grid that keeps the most processors busy and, among those, gives each processor
+  // the block of points with the smallest surface area, so that the grid follows the aspect ratio
+  // of the launch domain
+  std::vector<int32_t> best(ndim, 1);
+  int64_t best_used    = 0;
+  int64_t best_surface = std::numeric_limits<int64_t>::max();
+
+  std::vector<int32_t> grid(ndim, 1);
+  enumerate_processor_grids(num_procs, grid, 0, [&](const std::vector<int32_t>& candidate) {
+    int64_t used = 1;
+    std::vector<int64_t> block(ndim);
+    for (int32_t dim = 0; dim < ndim; ++dim) {
+      used *= std::min<int64_t>(candidate[dim], extents[dim]);
+      block[dim] = (extents[dim] + candidate[dim] - 1) / candidate[dim];
+    }
+    int64_t surface = 0;
+    for (int32_t dim = 0; dim < ndim; ++dim) {
+      int64_t face = 1;
+      for (int32_t other = 0; other < ndim; ++other)
+        if (other != dim) face *= block[other];
+      surface += face;
+    }
+    if (used > best_used || (used == best_used && surface < best_surface)) {
+      best         = candidate;
+      best_used    = used;
+      best_surface = surface;
+    }
+  });
 
-  return pitches;
+  // Launch domains of many different shapes would grow the cache without bound
+  if (proc_grids.size() >= MAX_PROC_GRIDS) proc_grids.clear();
+  auto& result = proc_grids[key];
+  result.swap(best);
+  return result;
 }
 
 void BaseMapper::slice_manual_task(const MapperContext ctx,
@@ -329,10 +483,17 @@ void BaseMapper::slice_manual_task(const MapperContext ctx,
 
   auto distribute = [&](auto& procs) {
     auto ndim       = input.domain.dim;
-    auto& proc_grid = get_processor_grid(task.target_proc.kind(), ndim);
+    auto& proc_grid = get_processor_grid(task.target_proc.kind(), input.domain);
+    auto lo         = input.domain.lo();
+    auto hi         = input.domain.hi();
+    // Points are distributed in blocks, so neighboring points go to the same processor or to
+    // processors next to each other in the grid
     for (Domain::DomainPointIterator itr(input.domain); itr; itr++) {
-      int32_t idx = 0;
-      for (int32_t dim = 0; dim < ndim; ++dim) idx += proc_grid[dim] * itr.p[dim];
+      int64_t idx = 0;
+      for (int32_t dim = 0; dim < ndim; ++dim) {
+        int64_t extent = hi[dim] - lo[dim] + 1;
+        idx            = idx * proc_grid[dim] + (itr.p[dim] - lo[dim]) * proc_grid[dim] / extent;
+      }
       output.slices.push_back(TaskSlice(
         Domain(itr.p, itr.p), procs[idx % procs.size()], false /*recurse*/, false /*stealable*/));
     }
@@ -350,6 +511,18 @@ void BaseMapper::slice_task(const MapperContext ctx,
     slice_manual_task(ctx, task, input, output);
   else
     slice_auto_task(ctx, task, input, output);
+
+  if (mapping_trace::enabled) {
+    auto lo = task.index_domain.lo();
+    auto hi = task.index_domain.hi();
+    for (auto& slice : output.slices)
+      mapping_trace::record(mapping_trace::EventKind::TASK_SLICED,
+                            task.get_unique_id(),
+                            slice.proc.id,
+                            0,
+                            linearize(lo, hi, slice.domain.lo()),
+                            task.task_id);
+  }
 }
 
 bool BaseMapper::has_variant(const MapperContext ctx, const LegionTask& task, Processor::Kind kind)
@@ -387,11 +560,22 @@ std::optional<VariantID> BaseMapper::find_variant(const MapperContext ctx,
   return result;
 }
 
+static constexpr size_t MAX_MAPPING_CACHE_SIZE = 4096;
+
+static std::pair<bool, RegionField::Id> get_cached_store_id(const Store& store)
+{
+  if (store.is_future())
+    return std::make_pair(true, RegionField::Id(false, store.future_index(), 0));
+  else
+    return std::make_pair(false, store.unique_region_field_id());
+}
+
 void BaseMapper::map_task(const MapperContext ctx,
                           const LegionTask& task,
                           const MapTaskInput& input,
                           MapTaskOutput& output)
 {
+  trace::Range auto_range("legate::mapper::map_task");
 #ifdef DEBUG_LEGATE
   logger.debug() << "Entering map_task for " << Utilities::to_string(runtime, ctx, task);
 #endif
@@ -407,10 +591,117 @@ void BaseMapper::map_task(const MapperContext ctx,
   output.chosen_variant = *variant;
   // Just put our target proc in the target processors for now
   output.target_procs.push_back(task.target_proc);
+  if (mapping_trace::enabled)
+    mapping_trace::record(mapping_trace::EventKind::VARIANT_SELECTED,
+                          task.get_unique_id(),
+                          task.target_proc.id,
+                          0,
+                          task.task_id,
+                          *variant);
+  if (variant_tuner != nullptr || (steal_timings != nullptr && is_stealable(task)))
+    output.task_prof_requests.add_measurement<Realm::ProfilingMeasurements::OperationTimeline>();
 
   Task legate_task(&task, context, runtime, ctx);
 
-  const auto& options = default_store_targets(task.target_proc.kind());
+  std::vector<StoreMapping> for_futures, for_unbound_stores, for_stores;
+
+  TaskSignature signature;
+  if (memoize_mappings) signature = make_task_signature(task, legate_task, *variant);
+  auto cached = memoize_mappings ? mapping_cache.find(signature) : mapping_cache.end();
+
+  if (cached != mapping_cache.end()) {
+    // The task has the same signature as one we mapped before, so we skip the client mapper
+    // and the default mapping generation and go straight to the instance selection
+    std::map<std::pair<bool, RegionField::Id>, const Store*> stores;
+    auto index_stores = [&stores](const auto& to_index) {
+      for (auto& store : to_index) stores[get_cached_store_id(store)] = &store;
+    };
+    index_stores(legate_task.inputs());
+    index_stores(legate_task.outputs());
+    index_stores(legate_task.reductions());
+
+    auto instantiate = [&stores](const auto& cached_mappings, auto& mappings) {
+      for (auto& cached_mapping : cached_mappings) {
+        StoreMapping mapping;
+        mapping.policy = cached_mapping.policy;
+        for (auto& id : cached_mapping.stores) mapping.stores.push_back(*stores.at(id));
+        mappings.push_back(std::move(mapping));
+      }
+    };
+    instantiate(cached->second.for_futures, for_futures);
+    instantiate(cached->second.for_unbound_stores, for_unbound_stores);
+    instantiate(cached->second.for_stores, for_stores);
+  } else {
+    generate_store_mappings(
+      legate_task, task.target_proc.kind(), for_futures, for_unbound_stores, for_stores);
+
+    if (memoize_mappings) {
+      auto record = [](const auto& mappings, auto& cached_mappings) {
+        for (auto& mapping : mappings) {
+          CachedStoreMapping cached_mapping;
+          cached_mapping.policy = mapping.policy;
+          for (auto& store : mapping.stores)
+            cached_mapping.stores.push_back(get_cached_store_id(store));
+          cached_mappings.push_back(std::move(cached_mapping));
+        }
+      };
+      // The cache is simply flushed when it gets too big, as the signatures of a steady-state
+      // iteration are recorded again right away
+      if (mapping_cache.size() >= MAX_MAPPING_CACHE_SIZE) mapping_cache.clear();
+      auto& entry = mapping_cache[signature];
+      record(for_futures, entry.for_futures);
+      record(for_unbound_stores, entry.for_unbound_stores);
+      record(for_stores, entry.for_stores);
+    }
+  }
+
+  // Map future-backed stores
+  auto map_futures = [&](auto& mappings) {
+    for (auto& mapping : mappings) {
+      StoreTarget target = mapping.policy.target;
+#ifdef LEGATE_NO_FUTURES_ON_FB
+      if (target == StoreTarget::FBMEM) target = StoreTarget::ZCMEM;
+#endif
+      output.future_locations.push_back(get_target_memory(task.target_proc, target));
+    }
+  };
+  map_futures(for_futures);
+
+  // Map unbound stores
+  auto map_unbound_stores = [&](auto& mappings) {
+    for (auto& mapping : mappings) {
+      auto req_idx                   = mapping.requirement_index();
+      output.output_targets[req_idx] = get_target_memory(task.target_proc, mapping.policy.target);
+      auto ndim                      = mapping.store().dim();
+      // Output instances of unbound stores of any dimension are laid out in the C order, which
+      // is the layout of the buffers tasks create for them, so the buffers are handed off
+      // without a copy
+      std::vector<DimensionKind> dimension_ordering;
+      for (int32_t dim = ndim - 1; dim >= 0; --dim)
+        dimension_ordering.push_back(
+          static_cast<DimensionKind>(static_cast<int32_t>(DimensionKind::LEGION_DIM_X) + dim));
+      dimension_ordering.push_back(DimensionKind::LEGION_DIM_F);
+      output.output_constraints[req_idx].ordering_constraint =
+        OrderingConstraint(dimension_ordering, false);
+    }
+  };
+  map_unbound_stores(for_unbound_stores);
+
+  output.chosen_instances.resize(task.regions.size());
+  std::map<const RegionRequirement*, std::vector<PhysicalInstance>*> output_map;
+  for (uint32_t idx = 0; idx < task.regions.size(); ++idx)
+    output_map[&task.regions[idx]] = &output.chosen_instances[idx];
+
+  map_legate_stores(ctx, task, for_stores, task.target_proc, output_map);
+}
+
+void BaseMapper::generate_store_mappings(const Task& legate_task,
+                                         Processor::Kind kind,
+                                         std::vector<StoreMapping>& for_futures,
+                                         std::vector<StoreMapping>& for_unbound_stores,
+                                         std::vector<StoreMapping>& for_stores)
+{
+  const auto& options = default_store_targets(kind);
 
   auto mappings = store_mappings(legate_task, options);
 
@@ -437,7 +728,6 @@ void BaseMapper::map_task(const MapperContext ctx,
   for (auto& mapping : mappings) validate_colocation(mapping);
 #endif
 
-  std::vector<StoreMapping> for_futures, for_unbound_stores, for_stores;
   std::set<uint32_t> mapped_futures;
   std::set<RegionField::Id> mapped_regions;
 
@@ -496,43 +786,57 @@ void BaseMapper::map_task(const MapperContext ctx,
   generate_default_mappings(legate_task.inputs(), false);
   generate_default_mappings(legate_task.outputs(), false);
   generate_default_mappings(legate_task.reductions(), false);
+}
 
-  // Map future-backed stores
-  auto map_futures = [&](auto& mappings) {
-    for (auto& mapping : mappings) {
-      StoreTarget target = mapping.policy.target;
-#ifdef LEGATE_NO_FUTURES_ON_FB
-      if (target == StoreTarget::FBMEM) target = StoreTarget::ZCMEM;
-#endif
-      output.future_locations.push_back(get_target_memory(task.target_proc, target));
-    }
-  };
-  map_futures(for_futures);
-
-  // Map unbound stores
-  auto map_unbound_stores = [&](auto& mappings) {
-    for (auto& mapping : mappings) {
-      auto req_idx                   = mapping.requirement_index();
-      output.output_targets[req_idx] = get_target_memory(task.target_proc, mapping.policy.target);
-      auto ndim                      = mapping.store().dim();
-      // FIXME: Unbound stores can have more than one dimension later
-      std::vector<DimensionKind> dimension_ordering;
-      for (int32_t dim = ndim - 1; dim >= 0; --dim)
-        dimension_ordering.push_back(
-          static_cast<DimensionKind>(static_cast<int32_t>(DimensionKind::LEGION_DIM_X) + dim));
-      dimension_ordering.push_back(DimensionKind::LEGION_DIM_F);
-      output.output_constraints[req_idx].ordering_constraint =
-        OrderingConstraint(dimension_ordering, false);
+BaseMapper::TaskSignature BaseMapper::make_task_signature(const LegionTask& task,
+                                                          const Task& legate_task,
+                                                          VariantID variant) const
+{
+  TaskSignature signature{static_cast<int64_t>(task.task_id),
+                          static_cast<int64_t>(variant),
+                          static_cast<int64_t>(task.target_proc.id),
+                          static_cast<int64_t>(task.tag)};
+  auto add_stores = [&signature](const auto& stores) {
+    signature.push_back(stores.size());
+    for (auto& store : stores) {
+      signature.push_back(store.is_future());
+      signature.push_back(store.unbound());
+      signature.push_back(store.dim());
+      signature.push_back(store.redop());
+      if (store.is_future())
+        signature.push_back(store.future_index());
+      else {
+        auto& rf = store.region_field();
+        signature.push_back(rf.index());
+        signature.push_back(rf.field_id());
+      }
+      if (store.unbound()) continue;
+      auto domain = store.domain();
+      for (int32_t dim = 0; dim < domain.dim; ++dim) {
+        signature.push_back(domain.lo()[dim]);
+        signature.push_back(domain.hi()[dim]);
+      }
     }
   };
-  map_unbound_stores(for_unbound_stores);
-
-  output.chosen_instances.resize(task.regions.size());
-  std::map<const RegionRequirement*, std::vector<PhysicalInstance>*> output_map;
-  for (uint32_t idx = 0; idx < task.regions.size(); ++idx)
-    output_map[&task.regions[idx]] = &output.chosen_instances[idx];
-
-  map_legate_stores(ctx, task, for_stores, task.target_proc, output_map);
+  add_stores(legate_task.inputs());
+  add_stores(legate_task.outputs());
+  add_stores(legate_task.reductions());
+  // Client mappers can also read the scalar arguments and the point of the task
+  auto& scalars = legate_task.scalars();
+  signature.push_back(scalars.size());
+  for (auto& scalar : scalars) {
+    signature.push_back(scalar.is_tuple());
+    signature.push_back(static_cast<int64_t>(scalar.code()));
+    auto size = scalar.size();
+    signature.push_back(size);
+    auto offset = signature.size();
+    signature.resize(offset + (size + sizeof(int64_t) - 1) / sizeof(int64_t), 0);
+    memcpy(signature.data() + offset, scalar.ptr(), size);
+  }
+  auto point = legate_task.point();
+  signature.push_back(point.get_dim());
+  for (int32_t dim = 0; dim < point.get_dim(); ++dim) signature.push_back(point[dim]);
+  return std::move(signature);
 }
 
 void BaseMapper::map_replicate_task(const MapperContext ctx,
@@ -563,10 +867,14 @@ void BaseMapper::map_legate_stores(const MapperContext ctx,
                                    Processor target_proc,
                                    OutputMap& output_map)
 {
-  auto try_mapping = [&](bool can_fail) {
+  resolve_dimension_orderings(mappings);
+
+  // When the mapping fails, 'failed' is set to the index of the mapping that failed
+  auto try_mapping = [&](bool can_fail, uint32_t& failed) {
     const PhysicalInstance NO_INST{};
     std::vector<PhysicalInstance> instances;
-    for (auto& mapping : mappings) {
+    for (uint32_t idx = 0; idx < mappings.size(); ++idx) {
+      auto& mapping           = mappings[idx];
       PhysicalInstance result = NO_INST;
       auto reqs               = mapping.requirements();
       while (map_legate_store(ctx, mappable, mapping, reqs, target_proc, result, can_fail)) {
@@ -575,6 +883,7 @@ void BaseMapper::map_legate_stores(const MapperContext ctx,
           assert(can_fail);
 #endif
           for (auto& instance : instances) runtime->release_instance(ctx, instance);
+          failed = idx;
           return false;
         }
 #ifdef DEBUG_LEGATE
@@ -592,7 +901,7 @@ void BaseMapper::map_legate_stores(const MapperContext ctx,
         logger.debug() << log_mappable(mappable) << ": failed to acquire instance " << result
                        << " for reqs:" << reqs_ss.str();
 #endif
-        AutoLock lock(ctx, local_instances->manager_lock());
+        AutoLock lock(ctx, local_instances->manager_lock(result.get_location()));
         local_instances->erase(result);
         result = NO_INST;
       }
@@ -610,20 +919,162 @@ void BaseMapper::map_legate_stores(const MapperContext ctx,
 
   // We can retry the mapping with tightened policies only if at least one of the policies
   // is lenient
-  bool can_fail = false;
-  for (auto& mapping : mappings) can_fail = can_fail || !mapping.policy.exact;
+  bool can_tighten = false;
+  for (auto& mapping : mappings) can_tighten = can_tighten || !mapping.policy.exact;
+
+  // The cached instances in the target memory, especially the bloated ones for large region
+  // groups, can be what's keeping us from creating new instances. We evict the least recently
+  // used ones and make them collectable, just enough to make room for the instance that
+  // failed, and retry until the mapping succeeds or there is nothing left to evict. This
+  // doesn't affect the correctness, as the runtime never collects instances that are still
+  // in use.
+  auto evict_and_retry = [&](uint32_t& failed) {
+    while (true) {
+      auto& mapping = mappings[failed];
+      auto memory   = get_target_memory(target_proc, mapping.policy.target);
+      size_t num_evicted;
+      {
+        AutoLock lock(ctx, local_instances->manager_lock(memory));
+        auto usage  = local_instances->get_memory_usage(memory);
+        auto needed = get_instance_bytes(ctx, mapping);
+        num_evicted = evict_cached_instances(ctx, memory, usage > needed ? usage - needed : 0);
+      }
+      if (0 == num_evicted) return false;
+      if (try_mapping(true, failed)) return true;
+    }
+  };
 
-  if (!try_mapping(can_fail)) {
+  uint32_t failed = 0;
+  if (try_mapping(true, failed)) return;
 #ifdef DEBUG_LEGATE
-    logger.debug() << log_mappable(mappable) << " failed to map all stores, retrying with "
-                   << "tighter policies";
+  logger.debug() << log_mappable(mappable) << " failed to map all stores, retrying after "
+                 << "evicting cached instances";
 #endif
-    // If instance creation failed we try mapping all stores again, but request tight instances for
-    // write requirements. The hope is that these write requirements cover the entire region (i.e.
-    // they use a complete partition), so the new tight instances will invalidate any pre-existing
-    // "bloated" instances for the same region, freeing up enough memory so that mapping can succeed
+  if (evict_and_retry(failed)) return;
+
+  // If instance creation failed we try mapping all stores again, but request tight instances for
+  // write requirements. The hope is that these write requirements cover the entire region (i.e.
+  // they use a complete partition), so the new tight instances will invalidate any pre-existing
+  // "bloated" instances for the same region, freeing up enough memory so that mapping can succeed
+  if (can_tighten) {
     tighten_write_policies(mappable, mappings);
-    try_mapping(false);
+    if (try_mapping(true, failed) || evict_and_retry(failed)) return;
+  }
+
+  // With spilling, we move the stores that still don't fit one at a time to the next memory
+  // tier until the mapping succeeds or there is no tier left to spill to. The runtime copies
+  // the data back to the original target memory when a later task maps it there.
+  while (enable_spilling) {
+    auto& policy = mappings[failed].policy;
+    StoreTarget spill_target;
+    if (!find_spill_target(policy.target, spill_target)) break;
+#ifdef DEBUG_LEGATE
+    std::stringstream reqs_ss;
+    for (auto req_idx : mappings[failed].requirement_indices()) reqs_ss << " " << req_idx;
+    logger.debug() << log_mappable(mappable) << ": spilled reqs:" << reqs_ss.str()
+                   << " from target " << static_cast<int32_t>(policy.target) << " to target "
+                   << static_cast<int32_t>(spill_target);
+#endif
+    policy.target = spill_target;
+    // The cached instances in the spill memory are evicted for the same reason as above
+    if (try_mapping(true, failed) || evict_and_retry(failed)) return;
+  }
+  try_mapping(false, failed);
+}
+
+size_t BaseMapper::get_instance_bytes(const MapperContext ctx, const StoreMapping& mapping)
+{
+  size_t bytes = 0;
+  for (auto& store : mapping.stores) {
+    if (store.is_future() || store.unbound()) continue;
+    auto& region_field = store.region_field();
+    auto& region       = region_field.get_requirement()->region;
+    auto fid           = region_field.field_id();
+    auto domain        = runtime->get_index_space_domain(ctx, region.get_index_space());
+    bytes += domain.get_volume() * runtime->get_field_size(ctx, region.get_field_space(), fid);
+  }
+  return bytes;
+}
+
+void BaseMapper::resolve_dimension_orderings(std::vector<StoreMapping>& mappings)
+{
+  for (auto& mapping : mappings) {
+    if (mapping.for_future() || mapping.for_unbound_store()) continue;
+    auto& store = mapping.stores.front();
+    auto dim    = store.region_field().dim();
+    if (dim <= 1) continue;
+
+    auto& ordering = mapping.policy.ordering;
+    FieldKey key(store.region_field().get_requirement()->region.get_tree_id(),
+                 store.region_field().field_id());
+    if (ordering.kind != DimOrdering::Kind::ANY) {
+      if (!ordering.requested) continue;
+      // Stores come and go, so the votes are simply dropped once they cover too many of them
+      if (ordering_votes.size() >= MAX_ORDERING_VOTES && ordering_votes.count(key) == 0)
+        ordering_votes.clear();
+      ++ordering_votes[key][ordering.dimensions(dim)];
+      continue;
+    }
+
+    // Without votes, new instances fall back to the C order
+    auto finder = ordering_votes.find(key);
+    if (finder == ordering_votes.end()) continue;
+    auto best = std::max_element(
+      finder->second.begin(), finder->second.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.second < rhs.second;
+      });
+    ordering.dims = best->first;
+  }
+}
+
+bool BaseMapper::find_spill_target(StoreTarget target, StoreTarget& spill_target) const
+{
+  switch (target) {
+    case StoreTarget::FBMEM: {
+      if (!local_zerocopy_memory.exists()) return false;
+      spill_target = StoreTarget::ZCMEM;
+      return true;
+    }
+    case StoreTarget::SOCKETMEM: {
+      spill_target = StoreTarget::SYSMEM;
+      return true;
+    }
+    default: break;
+  }
+  return false;
+}
+
+size_t BaseMapper::evict_cached_instances(const MapperContext ctx,
+                                          Memory memory,
+                                          size_t target_bytes,
+                                          const std::set<PhysicalInstance>& pinned)
+{
+  auto evicted = local_instances->evict_instances(memory, target_bytes, pinned);
+  for (auto& instance : evicted) {
+#ifdef DEBUG_LEGATE
+    logger.debug() << "evicted cached instance " << instance << " from memory " << memory;
+#endif
+    if (mapping_trace::enabled)
+      mapping_trace::record(mapping_trace::EventKind::INSTANCE_EVICTED,
+                            0,
+                            memory.id,
+                            instance.get_instance_id(),
+                            instance.get_instance_size(),
+                            0);
+    runtime->set_garbage_collection_priority(ctx, instance, LEGION_GC_FIRST_PRIORITY);
+  }
+  return evicted.size();
+}
+
+void BaseMapper::prune_collected_instances(const MapperContext ctx, Memory memory)
+{
+  if (!MemoryUsage::enabled()) return;
+  // An instance that can't be acquired has been collected
+  for (auto& instance : local_instances->tracked_instances(memory)) {
+    if (runtime->acquire_instance(ctx, instance))
+      runtime->release_instance(ctx, instance);
+    else
+      local_instances->erase(instance);
   }
 }
 
@@ -649,6 +1100,21 @@ void BaseMapper::tighten_write_policies(const Mappable& mappable,
   }
 }
 
+static void record_instance_event(mapping_trace::EventKind kind,
+                                  const Mappable& mappable,
+                                  const StoreMapping& mapping,
+                                  Memory memory,
+                                  const PhysicalInstance& instance,
+                                  size_t size)
+{
+  mapping_trace::record(kind,
+                        mappable.get_unique_id(),
+                        memory.id,
+                        instance.exists() ? instance.get_instance_id() : 0,
+                        size,
+                        mapping.requirement_index());
+}
+
 bool BaseMapper::map_legate_store(const MapperContext ctx,
                                   const Mappable& mappable,
                                   const StoreMapping& mapping,
@@ -657,6 +1123,7 @@ bool BaseMapper::map_legate_store(const MapperContext ctx,
                                   PhysicalInstance& result,
                                   bool can_fail)
 {
+  trace::Range auto_range("legate::mapper::map_legate_store");
   if (reqs.empty()) return false;
 
   const auto& policy = mapping.policy;
@@ -683,9 +1150,38 @@ bool BaseMapper::map_legate_store(const MapperContext ctx,
   LayoutConstraintSet layout_constraints;
   mapping.populate_layout_constraints(layout_constraints);
 
-  // If we're making a reduction instance, we should just make it now
+  // Reduction instances don't go through region groups, but we can still reuse the one
+  // made for the same region in a previous launch
   if (redop != 0) {
     layout_constraints.add_constraint(SpecializedConstraint(REDUCTION_FOLD_SPECIALIZE, redop));
+
+    const auto& fields = layout_constraints.field_constraint.field_set;
+    bool cacheable     = fields.size() == 1 && regions.size() == 1 &&
+                         policy.allocation != AllocPolicy::MUST_ALLOC;
+
+    AutoLock lock(ctx, local_instances->manager_lock(target_memory));
+    runtime->disable_reentrant(ctx);
+    if (cacheable &&
+        local_instances->find_reduction_instance(
+          regions.front(), fields.front(), redop, target_memory, result) &&
+        result.entails(layout_constraints)) {
+#ifdef DEBUG_LEGATE
+      logger.debug() << "Operation " << mappable.get_unique_id()
+                     << ": reused cached reduction instance " << result << " for "
+                     << regions.front();
+#endif
+      if (mapping_trace::enabled)
+        record_instance_event(mapping_trace::EventKind::INSTANCE_REUSED,
+                              mappable,
+                              mapping,
+                              target_memory,
+                              result,
+                              result.get_instance_size());
+      runtime->enable_reentrant(ctx);
+      // Needs acquire to keep the runtime happy
+      return true;
+    }
+
     size_t footprint = 0;
     if (runtime->create_physical_instance(ctx,
                                           target_memory,
@@ -703,9 +1199,30 @@ bool BaseMapper::map_legate_store(const MapperContext ctx,
       for (LogicalRegion r : regions) msg << " " << r;
       msg << " (size: " << footprint << " bytes, memory: " << target_memory << ")";
 #endif
+      if (mapping_trace::enabled)
+        record_instance_event(mapping_trace::EventKind::INSTANCE_CREATED,
+                              mappable,
+                              mapping,
+                              target_memory,
+                              result,
+                              footprint);
+      if (cacheable) {
+        local_instances->record_reduction_instance(
+          regions.front(), fields.front(), redop, result, context.get_library_name());
+        auto budget = local_instances->get_budget(target_memory);
+        if (budget > 0 && local_instances->get_memory_usage(target_memory) > budget)
+          evict_cached_instances(ctx, target_memory, budget, {result});
+      }
+      prune_collected_instances(ctx, target_memory);
+      runtime->enable_reentrant(ctx);
       // We already did the acquire
       return false;
     }
+    runtime->enable_reentrant(ctx);
+    result = PhysicalInstance();
+    if (mapping_trace::enabled)
+      record_instance_event(
+        mapping_trace::EventKind::INSTANCE_FAILED, mappable, mapping, target_memory, result, 0);
     if (!can_fail)
       report_failed_mapping(mappable, mapping.requirement_index(), target_memory, redop);
     return true;
@@ -713,8 +1230,9 @@ bool BaseMapper::map_legate_store(const MapperContext ctx,
 
   auto& fields = layout_constraints.field_constraint.field_set;
 
-  // We need to hold the instance manager lock as we're about to try to find an instance
-  AutoLock lock(ctx, local_instances->manager_lock());
+  // We need to hold the instance manager lock for the target memory as we're about to try to
+  // find an instance
+  AutoLock lock(ctx, local_instances->manager_lock(target_memory));
 
   // This whole process has to appear atomic
   runtime->disable_reentrant(ctx);
@@ -727,6 +1245,13 @@ bool BaseMapper::map_legate_store(const MapperContext ctx,
     logger.debug() << "Operation " << mappable.get_unique_id() << ": reused cached instance "
                    << result << " for " << regions.front();
 #endif
+    if (mapping_trace::enabled)
+      record_instance_event(mapping_trace::EventKind::INSTANCE_REUSED,
+                            mappable,
+                            mapping,
+                            target_memory,
+                            result,
+                            result.get_instance_size());
     runtime->enable_reentrant(ctx);
     // Needs acquire to keep the runtime happy
     return true;
@@ -796,12 +1321,26 @@ bool BaseMapper::map_legate_store(const MapperContext ctx,
                      << " for " << *group;
     }
 #endif
+    if (mapping_trace::enabled)
+      record_instance_event(created ? mapping_trace::EventKind::INSTANCE_CREATED
+                                    : mapping_trace::EventKind::INSTANCE_REUSED,
+                            mappable,
+                            mapping,
+                            target_memory,
+                            result,
+                            created ? footprint : result.get_instance_size());
     // Only save the result for future use if it is not an external instance
     if (!result.is_external_instance() && group != nullptr) {
       assert(fields.size() == 1);
       auto fid = fields.front();
-      local_instances->record_instance(group, fid, result, policy);
+      local_instances->record_instance(group, fid, result, context.get_library_name(), policy);
+      // Keep the cached instances in the memory within its budget, if there is one
+      auto budget = local_instances->get_budget(target_memory);
+      if (budget > 0 && local_instances->get_memory_usage(target_memory) > budget)
+        evict_cached_instances(ctx, target_memory, budget, {result});
     }
+    // Legion may have collected instances to make room for the new one
+    if (created) prune_collected_instances(ctx, target_memory);
     runtime->enable_reentrant(ctx);
     // We made it so no need for an acquire
     return false;
@@ -810,6 +1349,9 @@ bool BaseMapper::map_legate_store(const MapperContext ctx,
   runtime->enable_reentrant(ctx);
 
   // If we make it here then we failed entirely
+  if (mapping_trace::enabled)
+    record_instance_event(
+      mapping_trace::EventKind::INSTANCE_FAILED, mappable, mapping, target_memory, result, 0);
   if (!can_fail) {
     auto req_indices = mapping.requirement_indices();
     for (auto req_idx : req_indices) report_failed_mapping(mappable, req_idx, target_memory, redop);
@@ -881,64 +1423,138 @@ void BaseMapper::select_task_sources(const MapperContext ctx,
                                      const SelectTaskSrcInput& input,
                                      SelectTaskSrcOutput& output)
 {
-  legate_select_sources(ctx, input.target, input.source_instances, output.chosen_ranking);
+  legate_select_sources(ctx, task, input.target, input.source_instances, output.chosen_ranking);
+}
+
+// Copy costs are estimated in nanoseconds for copying 1 MB of data,
+// which takes NOMINAL_COPY_TIME / B nanoseconds on a link of B MB/s
+static constexpr uint64_t NOMINAL_COPY_TIME = 1000000000;
+static constexpr uint64_t UNREACHABLE_COST  = std::numeric_limits<uint32_t>::max();
+// Penalty paid for a source instance whose layout differs from the target's,
+// as the DMA system then needs to transpose the data
+static constexpr uint64_t TRANSPOSE_PENALTY = 2;
+// A link picked this many times recently costs twice as much as an idle one
+static constexpr uint32_t LINK_LOAD_SCALE = 8;
+// Link loads decay by half after this many source selections
+static constexpr uint32_t LINK_LOAD_DECAY_PERIOD = 256;
+
+enum class LayoutKind : int32_t {
+  UNKNOWN = 0,
+  C       = 1,
+  FORTRAN = 2,
+};
+
+static LayoutKind classify_layout(const PhysicalInstance& instance)
+{
+  auto dim = instance.get_instance_domain().get_dim();
+  if (dim <= 1) return LayoutKind::UNKNOWN;
+
+  std::vector<DimensionKind> c_order, fortran_order;
+  for (int32_t idx = dim - 1; idx >= 0; --idx)
+    c_order.push_back(static_cast<DimensionKind>(DIM_X + idx));
+  for (int32_t idx = 0; idx < dim; ++idx)
+    fortran_order.push_back(static_cast<DimensionKind>(DIM_X + idx));
+  c_order.push_back(DIM_F);
+  fortran_order.push_back(DIM_F);
+
+  LayoutConstraintSet c_constraints, fortran_constraints;
+  c_constraints.add_constraint(OrderingConstraint(c_order, false /*contiguous*/));
+  fortran_constraints.add_constraint(OrderingConstraint(fortran_order, false /*contiguous*/));
+  if (instance.entails(c_constraints)) return LayoutKind::C;
+  if (instance.entails(fortran_constraints)) return LayoutKind::FORTRAN;
+  return LayoutKind::UNKNOWN;
+}
+
+uint64_t BaseMapper::get_direct_copy_cost(Memory source, Memory target)
+{
+  std::vector<MemoryMemoryAffinity> affinity;
+  machine.get_mem_mem_affinity(affinity, source, target, false /*not just local affinities*/);
+  if (affinity.empty() || affinity[0].bandwidth == 0) return UNREACHABLE_COST;
+  return affinity[0].latency + NOMINAL_COPY_TIME / affinity[0].bandwidth;
+}
+
+uint64_t BaseMapper::get_copy_cost(Memory source, Memory target)
+{
+  if (source == target) return 0;
+
+  auto key    = std::make_pair(source, target);
+  auto finder = copy_costs.find(key);
+  if (finder != copy_costs.end()) return finder->second;
+
+  uint64_t cost = get_direct_copy_cost(source, target);
+  if (cost == UNREACHABLE_COST) {
+    // If there's no direct path between the memories, the data should be staged in an
+    // intermediate memory (e.g., the system memory for two GPUs without peer access)
+    std::vector<MemoryMemoryAffinity> affinities;
+    machine.get_mem_mem_affinity(affinities, source, Memory::NO_MEMORY, false);
+    for (auto& affinity : affinities) {
+      if (affinity.m2 == target || affinity.bandwidth == 0) continue;
+      uint64_t second_hop = get_direct_copy_cost(affinity.m2, target);
+      if (second_hop == UNREACHABLE_COST) continue;
+      cost = std::min(cost, affinity.latency + NOMINAL_COPY_TIME / affinity.bandwidth + second_hop);
+    }
+  }
+
+  copy_costs[key] = cost;
+  return cost;
 }
 
 void BaseMapper::legate_select_sources(const MapperContext ctx,
+                                       const Mappable& mappable,
                                        const PhysicalInstance& target,
                                        const std::vector<PhysicalInstance>& sources,
                                        std::deque<PhysicalInstance>& ranking)
 {
-  std::map<Memory, uint32_t /*bandwidth*/> source_memories;
-  // For right now we'll rank instances by the bandwidth of the memory
-  // they are in to the destination, we'll only rank sources from the
-  // local node if there are any
-  bool all_local = false;
-  // TODO: consider layouts when ranking source to help out the DMA system
+  trace::Range auto_range("legate::mapper::select_sources");
+  // We rank instances by the cost of copying data from their memories to the destination,
+  // which is estimated from the topology and then adjusted by the layout compatibility and
+  // the current load of the link. We'll only rank sources from the local node if there are any.
+  bool all_local            = false;
   Memory destination_memory = target.get_location();
-  std::vector<MemoryMemoryAffinity> affinity(1);
-  // fill in a vector of the sources with their bandwidths and sort them
-  std::vector<std::pair<PhysicalInstance, uint32_t /*bandwidth*/>> band_ranking;
+  auto target_layout        = classify_layout(target);
+
+  if (++num_source_selections % LINK_LOAD_DECAY_PERIOD == 0)
+    for (auto& pair : link_loads) pair.second /= 2;
+
+  std::vector<std::pair<uint64_t /*cost*/, uint32_t /*index*/>> cost_ranking;
   for (uint32_t idx = 0; idx < sources.size(); idx++) {
     const PhysicalInstance& instance = sources[idx];
     Memory location                  = instance.get_location();
     if (location.address_space() == local_node) {
       if (!all_local) {
-        source_memories.clear();
-        band_ranking.clear();
+        cost_ranking.clear();
         all_local = true;
       }
     } else if (all_local)  // Skip any remote instances once we're local
       continue;
-    auto finder = source_memories.find(location);
-    if (finder == source_memories.end()) {
-      affinity.clear();
-      machine.get_mem_mem_affinity(
-        affinity, location, destination_memory, false /*not just local affinities*/);
-      uint32_t memory_bandwidth = 0;
-      if (!affinity.empty()) {
-        assert(affinity.size() == 1);
-        memory_bandwidth = affinity[0].bandwidth;
-      }
-      source_memories[location] = memory_bandwidth;
-      band_ranking.push_back(std::pair<PhysicalInstance, uint32_t>(instance, memory_bandwidth));
-    } else
-      band_ranking.push_back(std::pair<PhysicalInstance, uint32_t>(instance, finder->second));
+
+    uint64_t cost = get_copy_cost(location, destination_memory);
+    if (target_layout != LayoutKind::UNKNOWN) {
+      auto source_layout = classify_layout(instance);
+      if (source_layout != LayoutKind::UNKNOWN && source_layout != target_layout)
+        cost *= TRANSPOSE_PENALTY;
+    }
+    auto finder = link_loads.find(std::make_pair(location, destination_memory));
+    if (finder != link_loads.end()) cost += cost * finder->second / LINK_LOAD_SCALE;
+    cost_ranking.push_back(std::make_pair(cost, idx));
   }
   // If there aren't any sources (for example if there are some collective views
   // to choose from, not yet in this branch), just return nothing and let the
   // runtime pick something for us.
-  if (band_ranking.empty()) { return; }
-  // Easy case of only one instance
-  if (band_ranking.size() == 1) {
-    ranking.push_back(band_ranking.begin()->first);
-    return;
-  }
-  // Sort them by bandwidth
-  std::sort(band_ranking.begin(), band_ranking.end(), physical_sort_func);
-  // Iterate from largest bandwidth to smallest
-  for (auto it = band_ranking.rbegin(); it != band_ranking.rend(); ++it)
-    ranking.push_back(it->first);
+  if (cost_ranking.empty()) { return; }
+  // Iterate from the lowest cost to the highest
+  std::sort(cost_ranking.begin(), cost_ranking.end());
+  for (auto& pair : cost_ranking) ranking.push_back(sources[pair.second]);
+
+  ++link_loads[std::make_pair(ranking.front().get_location(), destination_memory)];
+
+  if (mapping_trace::enabled)
+    mapping_trace::record(mapping_trace::EventKind::SOURCE_SELECTED,
+                          mappable.get_unique_id(),
+                          destination_memory.id,
+                          ranking.front().get_instance_id(),
+                          ranking.front().get_location().id,
+                          sources.size());
 }
 
 void BaseMapper::speculate(const MapperContext ctx,
@@ -948,12 +1564,37 @@ void BaseMapper::speculate(const MapperContext ctx,
   output.speculate = false;
 }
 
+static TaskTarget to_task_target(Processor::Kind kind)
+{
+  switch (kind) {
+    case Processor::TOC_PROC: return TaskTarget::GPU;
+    case Processor::OMP_PROC: return TaskTarget::OMP;
+    default: return TaskTarget::CPU;
+  }
+}
+
 void BaseMapper::report_profiling(const MapperContext ctx,
                                   const LegionTask& task,
                                   const TaskProfilingInfo& input)
 {
-  // Shouldn't get any profiling feedback currently
-  LEGATE_ABORT;
+  // We only request profiling feedback to autotune variants and to time stealable tasks
+  if (variant_tuner == nullptr && steal_timings == nullptr) LEGATE_ABORT;
+
+  auto timeline =
+    input.profiling_responses.get_measurement<Realm::ProfilingMeasurements::OperationTimeline>();
+  if (timeline == nullptr) return;
+
+  auto target = to_task_target(task.target_proc.kind());
+  // GPU tasks return as soon as their kernels are enqueued, so their time ends when the work
+  // they launched completes
+  auto end_time     = target == TaskTarget::GPU ? timeline->complete_time : timeline->end_time;
+  double elapsed_ns = static_cast<double>(end_time - timeline->start_time);
+  delete timeline;
+
+  auto bytes = get_point_bytes(ctx, task);
+  if (variant_tuner != nullptr) variant_tuner->record(task.task_id, bytes, target, elapsed_ns);
+  if (steal_timings != nullptr && is_stealable(task))
+    steal_timings->record(task.task_id, bytes, target, elapsed_ns);
 }
 
 ShardingID BaseMapper::find_sharding_functor_by_key_store_projection(
@@ -983,18 +1624,24 @@ void BaseMapper::map_inline(const MapperContext ctx,
                             const MapInlineInput& input,
                             MapInlineOutput& output)
 {
-  Processor target_proc{Processor::NO_PROC};
-  if (!local_omps.empty())
-    target_proc = local_omps.front();
-  else
-    target_proc = local_cpus.front();
-
-  auto store_target = default_store_targets(target_proc.kind()).front();
-
 #ifdef DEBUG_LEGATE
   assert(inline_op.requirement.instance_fields.size() == 1);
 #endif
 
+  Processor target_proc{Processor::NO_PROC};
+  StoreTarget store_target;
+  if (inline_op.tag == LEGATE_CORE_DEVICE_INLINE_MAP_TAG && !local_gpus.empty()) {
+    // The consumer wants a device pointer, so the store goes to the framebuffer
+    target_proc  = local_gpus.front();
+    store_target = StoreTarget::FBMEM;
+  } else {
+    if (!local_omps.empty())
+      target_proc = local_omps.front();
+    else
+      target_proc = local_cpus.front();
+    store_target = find_inline_target(ctx, inline_op.requirement, target_proc);
+  }
+
   Store store(legion_runtime->get_mapper_runtime(), ctx, &inline_op.requirement);
   std::vector<StoreMapping> mappings;
   mappings.push_back(StoreMapping::default_mapping(store, store_target, false));
@@ -1005,12 +1652,35 @@ void BaseMapper::map_inline(const MapperContext ctx,
   map_legate_stores(ctx, inline_op, mappings, target_proc, output_map);
 }
 
+StoreTarget BaseMapper::find_inline_target(const MapperContext ctx,
+                                           const RegionRequirement& req,
+                                           Processor target_proc)
+{
+  std::vector<StoreTarget> candidates{default_store_targets(target_proc.kind()).front()};
+  if (candidates.front() != StoreTarget::SYSMEM) candidates.push_back(StoreTarget::SYSMEM);
+  // Zero-copy instances are addressable from the host, and GPU tasks often leave valid data
+  // there when their stores didn't fit in the framebuffer
+  if (local_zerocopy_memory.exists()) candidates.push_back(StoreTarget::ZCMEM);
+
+  auto field_id = req.instance_fields.front();
+  for (auto target : candidates) {
+    auto memory = get_target_memory(target_proc, target);
+    auto policy = InstanceMappingPolicy::default_policy(target);
+    PhysicalInstance instance;
+    AutoLock lock(ctx, local_instances->manager_lock(memory));
+    if (local_instances->find_instance(req.region, field_id, memory, instance, policy))
+      return target;
+  }
+  return candidates.front();
+}
+
 void BaseMapper::select_inline_sources(const MapperContext ctx,
                                        const InlineMapping& inline_op,
                                        const SelectInlineSrcInput& input,
                                        SelectInlineSrcOutput& output)
 {
-  legate_select_sources(ctx, input.target, input.source_instances, output.chosen_ranking);
+  legate_select_sources(
+    ctx, inline_op, input.target, input.source_instances, output.chosen_ranking);
 }
 
 void BaseMapper::report_profiling(const MapperContext ctx,
@@ -1072,10 +1742,8 @@ void BaseMapper::map_copy(const MapperContext ctx,
   add_to_output_map(copy.src_requirements, output.src_instances);
   add_to_output_map(copy.dst_requirements, output.dst_instances);
 
-#ifdef DEBUG_LEGATE
-  assert(copy.src_indirect_requirements.size() <= 1);
-  assert(copy.dst_indirect_requirements.size() <= 1);
-#endif
+  // A batched copy repeats its only indirection for every source-target pair. We map the first
+  // requirement and hand its instance to the rest once the mapping is done.
   if (!copy.src_indirect_requirements.empty()) {
     // This is to make the push_back call later add the isntance to the right place
     output.src_indirect_instances.clear();
@@ -1099,6 +1767,17 @@ void BaseMapper::map_copy(const MapperContext ctx,
     mappings.push_back(StoreMapping::default_mapping(store, store_target, false));
 
   map_legate_stores(ctx, copy, mappings, target_proc, output_map);
+
+  auto replicate_indirection = [](auto& reqs, auto& instances) {
+    if (reqs.size() <= 1) return;
+#ifdef DEBUG_LEGATE
+    assert(instances.size() == 1);
+    for (auto& req : reqs) assert(req.region == reqs.front().region);
+#endif
+    instances.resize(reqs.size(), instances.front());
+  };
+  replicate_indirection(copy.src_indirect_requirements, output.src_indirect_instances);
+  replicate_indirection(copy.dst_indirect_requirements, output.dst_indirect_instances);
 }
 
 void BaseMapper::select_copy_sources(const MapperContext ctx,
@@ -1106,7 +1785,7 @@ void BaseMapper::select_copy_sources(const MapperContext ctx,
                                      const SelectCopySrcInput& input,
                                      SelectCopySrcOutput& output)
 {
-  legate_select_sources(ctx, input.target, input.source_instances, output.chosen_ranking);
+  legate_select_sources(ctx, copy, input.target, input.source_instances, output.chosen_ranking);
 }
 
 void BaseMapper::speculate(const MapperContext ctx,
@@ -1138,7 +1817,7 @@ void BaseMapper::select_close_sources(const MapperContext ctx,
                                       const SelectCloseSrcInput& input,
                                       SelectCloseSrcOutput& output)
 {
-  legate_select_sources(ctx, input.target, input.source_instances, output.chosen_ranking);
+  legate_select_sources(ctx, close, input.target, input.source_instances, output.chosen_ranking);
 }
 
 void BaseMapper::report_profiling(const MapperContext ctx,
@@ -1201,7 +1880,7 @@ void BaseMapper::select_release_sources(const MapperContext ctx,
                                         const SelectReleaseSrcInput& input,
                                         SelectReleaseSrcOutput& output)
 {
-  legate_select_sources(ctx, input.target, input.source_instances, output.chosen_ranking);
+  legate_select_sources(ctx, release, input.target, input.source_instances, output.chosen_ranking);
 }
 
 void BaseMapper::speculate(const MapperContext ctx,
@@ -1271,7 +1950,8 @@ void BaseMapper::select_partition_sources(const MapperContext ctx,
                                           const SelectPartitionSrcInput& input,
                                           SelectPartitionSrcOutput& output)
 {
-  legate_select_sources(ctx, input.target, input.source_instances, output.chosen_ranking);
+  legate_select_sources(
+    ctx, partition, input.target, input.source_instances, output.chosen_ranking);
 }
 
 void BaseMapper::report_profiling(const MapperContext ctx,
@@ -1332,7 +2012,11 @@ void BaseMapper::memoize_operation(const MapperContext ctx,
                                    const MemoizeInput& input,
                                    MemoizeOutput& output)
 {
-  LEGATE_ABORT;
+  // Legion asks only about operations in traces. Replaying their mappings is safe only when the
+  // decisions depend on nothing but the signatures of the operations and the instances cached in
+  // the instance manager, which Legion validates before replaying a trace. That is what the
+  // libraries promise by enabling the mapping cache.
+  output.memoize = memoize_mappings;
 }
 
 void BaseMapper::map_must_epoch(const MapperContext ctx,
@@ -1359,19 +2043,73 @@ void BaseMapper::select_tasks_to_map(const MapperContext ctx,
   for (auto task : input.ready_tasks) output.map_tasks.insert(task);
 }
 
+bool BaseMapper::is_stealable(const LegionTask& task) const
+{
+  if (!enable_stealing) return false;
+  // Points of concurrent launches communicate with each other through communicators created for
+  // the processors they were sliced to, so they must stay where they are
+  return !task.concurrent_task;
+}
+
 void BaseMapper::select_steal_targets(const MapperContext ctx,
                                       const SelectStealingInput& input,
                                       SelectStealingOutput& output)
 {
-  // Nothing to do, no stealing in the leagte mapper currently
+  if (!enable_stealing) return;
+  // Any local processor can be a victim, as permit_steal_request only gives away tasks that
+  // target processors of the thief's kind
+  auto add_targets = [&](auto& procs) {
+    for (auto& proc : procs)
+      if (input.blacklist.find(proc) == input.blacklist.end()) output.targets.insert(proc);
+  };
+  add_targets(local_cpus);
+  add_targets(local_omps);
+  add_targets(local_gpus);
 }
 
 void BaseMapper::permit_steal_request(const MapperContext ctx,
                                       const StealRequestInput& input,
                                       StealRequestOutput& output)
 {
-  // Nothing to do, no stealing in the legate mapper currently
-  LEGATE_ABORT;
+  if (!enable_stealing) return;
+
+  auto thief = input.thief_proc;
+  std::vector<const LegionTask*> candidates;
+  for (auto task : input.stealable_tasks)
+    if (task->target_proc.kind() == thief.kind()) candidates.push_back(task);
+  if (candidates.empty()) return;
+
+  // Give away the half of the queued tasks that would start the last, but at least one
+  auto num_stolen = std::max<size_t>(candidates.size() / 2, 1);
+  auto first      = candidates.size() - num_stolen;
+
+  // A thief that shares the victim's memory finds the inputs where they already are
+  auto target     = default_store_targets(thief.kind()).front();
+  auto victim_mem = get_target_memory(candidates.front()->target_proc, target);
+  auto thief_mem  = get_target_memory(thief, target);
+  if (victim_mem == thief_mem) {
+    for (size_t idx = first; idx < candidates.size(); ++idx)
+      output.stolen_tasks.insert(candidates[idx]);
+    return;
+  }
+
+  // Otherwise, the stolen tasks need to copy their inputs first. That pays off only for tasks
+  // that would wait in the victim's queue, behind the tasks it keeps, longer than the copy takes.
+  if (candidates.size() < min_steal_backlog) return;
+  auto copy_cost = get_copy_cost(victim_mem, thief_mem);
+  if (copy_cost == UNREACHABLE_COST) return;
+  auto task_target = to_task_target(thief.kind());
+  for (size_t idx = first; idx < candidates.size(); ++idx) {
+    auto task     = candidates[idx];
+    auto bytes    = get_point_bytes(ctx, *task);
+    auto duration = steal_timings->average_time(task->task_id, bytes, task_target);
+    // Tasks that haven't been timed yet stay where their data is
+    if (!duration.has_value()) continue;
+    // get_copy_cost estimates the time to copy a nominal megabyte
+    double copy_time = static_cast<double>(bytes) / (1 << 20) * copy_cost;
+    double wait_time = *duration * first;
+    if (copy_time < wait_time) output.stolen_tasks.insert(task);
+  }
 }
 
 void BaseMapper::handle_message(const MapperContext ctx, const MapperMessage& message)
@@ -31,6 +31,7 @@ namespace legate {
 namespace mapping {
 
 class InstanceManager;
+class VariantTuner;
 
 enum class Strictness : bool {
   strict = true,
@@ -49,6 +50,7 @@ class BaseMapper : public Legion::Mapping::Mapper, public LegateMapper {
  protected:
   // Start-up methods
   static Legion::AddressSpaceID get_local_node(void);
+  // Kept for derived mappers; the node count now comes from the shared LocalMachine
   static size_t get_total_nodes(Legion::Machine m);
   std::string create_name(Legion::AddressSpace node) const;
   std::string create_logger_name() const;
@@ -266,6 +268,16 @@ class BaseMapper : public Legion::Mapping::Mapper, public LegateMapper {
                          OutputMap& output_map);
   void tighten_write_policies(const Legion::Mappable& mappable,
                               std::vector<StoreMapping>& mappings);
+  // Returns the number of instances evicted
+  size_t evict_cached_instances(const Legion::Mapping::MapperContext ctx,
+                                Legion::Memory memory,
+                                size_t target_bytes,
+                                const std::set<Legion::Mapping::PhysicalInstance>& pinned = {});
+  // Returns an estimate of the size of the instance the mapping needs
+  size_t get_instance_bytes(const Legion::Mapping::MapperContext ctx, const StoreMapping& mapping);
+  // Drops the cached instances in the memory that Legion has collected, so that the memory usage
+  // doesn't account them any longer. The caller must hold the lock for the memory.
+  void prune_collected_instances(const Legion::Mapping::MapperContext ctx, Legion::Memory memory);
   bool map_legate_store(const Legion::Mapping::MapperContext ctx,
                         const Legion::Mappable& mappable,
                         const StoreMapping& mapping,
@@ -278,9 +290,14 @@ class BaseMapper : public Legion::Mapping::Mapper, public LegateMapper {
                              Legion::Memory target_memory,
                              Legion::ReductionOpID redop);
   void legate_select_sources(const Legion::Mapping::MapperContext ctx,
+                             const Legion::Mappable& mappable,
                              const Legion::Mapping::PhysicalInstance& target,
                              const std::vector<Legion::Mapping::PhysicalInstance>& sources,
                              std::deque<Legion::Mapping::PhysicalInstance>& ranking);
+  // Estimated cost of copying a nominal amount of data between two memories, which accounts for
+  // the bandwidth and latency of each hop on the cheapest path of at most two hops
+  uint64_t get_copy_cost(Legion::Memory source, Legion::Memory target);
+  uint64_t get_direct_copy_cost(Legion::Memory source, Legion::Memory target);
 
  protected:
   bool has_variant(const Legion::Mapping::MapperContext ctx,
@@ -290,11 +307,6 @@ class BaseMapper : public Legion::Mapping::Mapper, public LegateMapper {
                                                 const Legion::Task& task,
                                                 Legion::Processor::Kind kind);
 
- private:
-  void generate_prime_factors();
-  void generate_prime_factor(const std::vector<Legion::Processor>& processors,
-                             Legion::Processor::Kind kind);
-
  protected:
   template <typename Functor>
   decltype(auto) dispatch(TaskTarget target, Functor functor)
@@ -321,7 +333,9 @@ class BaseMapper : public Legion::Mapping::Mapper, public LegateMapper {
   }
 
  protected:
-  const std::vector<int32_t> get_processor_grid(Legion::Processor::Kind kind, int32_t ndim);
+  // Returns the number of processors along each dimension of the grid for a launch domain
+  const std::vector<int32_t>& get_processor_grid(Legion::Processor::Kind kind,
+                                                 const Legion::Domain& domain);
   void slice_auto_task(const Legion::Mapping::MapperContext ctx,
                        const Legion::Task& task,
                        const SliceTaskInput& input,
@@ -335,15 +349,6 @@ class BaseMapper : public Legion::Mapping::Mapper, public LegateMapper {
   Legion::ShardingID find_sharding_functor_by_key_store_projection(
     const std::vector<Legion::RegionRequirement>& requirements);
 
- protected:
-  static inline bool physical_sort_func(
-    const std::pair<Legion::Mapping::PhysicalInstance, unsigned>& left,
-    const std::pair<Legion::Mapping::PhysicalInstance, unsigned>& right)
-  {
-    return (left.second < right.second);
-  }
-  // NumPyOpCode decode_task_id(Legion::TaskID tid);
-
  public:
   Legion::Runtime* const legion_runtime;
   const Legion::Machine machine;
@@ -361,6 +366,7 @@ class BaseMapper : public Legion::Mapping::Mapper, public LegateMapper {
   Legion::Memory local_system_memory, local_zerocopy_memory;
   std::map<Legion::Processor, Legion::Memory> local_frame_buffers;
   std::map<Legion::Processor, Legion::Memory> local_numa_domains;
+  std::map<Legion::Memory, std::vector<Legion::Processor>> numa_domain_processors;
 
  protected:
   using VariantCacheKey = std::pair<Legion::TaskID, Legion::Processor::Kind>;
@@ -371,13 +377,107 @@ class BaseMapper : public Legion::Mapping::Mapper, public LegateMapper {
 
  protected:
   // Used for n-D cyclic distribution
-  std::map<Legion::Processor::Kind, std::vector<int32_t>> all_factors;
-  std::map<std::pair<Legion::Processor::Kind, int32_t>, std::vector<int32_t>> proc_grids;
+  static constexpr size_t MAX_PROC_GRIDS = 1024;
+  std::map<std::pair<Legion::Processor::Kind, std::vector<int64_t>>, std::vector<int32_t>>
+    proc_grids;
 
  protected:
   // These are used for computing sharding functions
   std::map<Legion::IndexPartition, unsigned> partition_color_space_dims;
   std::map<Legion::IndexSpace, unsigned> index_color_dims;
+
+ protected:
+  // These are used for ranking source instances
+  using MemoryPair = std::pair<Legion::Memory, Legion::Memory>;
+  std::map<MemoryPair, uint64_t> copy_costs;
+  // Number of times each pair of memories was picked as the preferred route recently
+  std::map<MemoryPair, uint32_t> link_loads;
+  uint32_t num_source_selections{0};
+
+ protected:
+  // With LEGATE_MAPPING_CACHE=1, store mappings of a task are memoized by the task's signature,
+  // which consists of the task id, variant, target processor, tag, point, scalar arguments, and
+  // the kinds, region fields and domains of its stores. The memoization is only for libraries
+  // whose mapping decisions depend on nothing else, which also lets Legion traces replay them.
+  struct CachedStoreMapping {
+    // Each store is identified by its future index or by its region field
+    std::vector<std::pair<bool /*is_future*/, RegionField::Id>> stores;
+    InstanceMappingPolicy policy;
+  };
+  struct CachedTaskMapping {
+    std::vector<CachedStoreMapping> for_futures, for_unbound_stores, for_stores;
+  };
+  using TaskSignature = std::vector<int64_t>;
+  void generate_store_mappings(const Task& legate_task,
+                               Legion::Processor::Kind kind,
+                               std::vector<StoreMapping>& for_futures,
+                               std::vector<StoreMapping>& for_unbound_stores,
+                               std::vector<StoreMapping>& for_stores);
+  TaskSignature make_task_signature(const Legion::Task& task,
+                                    const Task& legate_task,
+                                    Legion::VariantID variant) const;
+  const bool memoize_mappings;
+  std::map<TaskSignature, CachedTaskMapping> mapping_cache;
+
+ private:
+  // Points of auto-parallelized launches can be stolen by idle local processors of the same kind
+  // when work stealing is enabled
+  bool is_stealable(const Legion::Task& task) const;
+  const bool enable_stealing;
+  // Minimum number of stealable tasks a processor must have queued before it gives some to a
+  // processor that needs to copy their data to a different memory
+  const uint32_t min_steal_backlog;
+  // Execution times of the stealable tasks, from which we estimate how long a task would wait in
+  // its victim's queue. Only created when work stealing is enabled.
+  std::unique_ptr<VariantTuner> steal_timings;
+
+  Legion::Processor find_numa_affine_processor(const Legion::Mapping::MapperContext ctx,
+                                               const Legion::RegionRequirement& key_req,
+                                               const Legion::DomainPoint& color,
+                                               uint64_t idx,
+                                               Legion::Processor fallback);
+  // Only enabled when the OpenMP processors span more than one NUMA domain
+  bool numa_aware_slicing;
+
+  Legion::Processor find_tree_reduce_processor(const Legion::Mapping::MapperContext ctx,
+                                               const Legion::Task& task,
+                                               const Legion::DomainPoint& point,
+                                               const std::vector<Legion::Processor>& procs,
+                                               Legion::Processor fallback);
+  // The processors that the points of tree reduction levels were sliced to, keyed by the tree id
+  // of the level's output region and the color of the point. The next level looks up and removes
+  // the entries for its inputs.
+  std::map<std::pair<Legion::RegionTreeID, Legion::coord_t>, Legion::Processor> tree_reduce_procs;
+
+  // Picks the host memory for an inline mapping, preferring one that already holds a cached
+  // instance of the store so the mapping doesn't copy the data into a fresh instance
+  StoreTarget find_inline_target(const Legion::Mapping::MapperContext ctx,
+                                 const Legion::RegionRequirement& req,
+                                 Legion::Processor target_proc);
+
+  // Records the dimension orderings that consumers requested for each store, and picks the one
+  // most of them asked for for the mappings that accept any ordering
+  void resolve_dimension_orderings(std::vector<StoreMapping>& mappings);
+  static constexpr size_t MAX_ORDERING_VOTES = 4096;
+  using FieldKey = std::pair<Legion::RegionTreeID, Legion::FieldID>;
+  std::map<FieldKey, std::map<std::vector<int32_t>, uint64_t>> ordering_votes;
+
+  // Finds the memory tier to which stores that don't fit in the target memory are spilled.
+  // Framebuffer stores are spilled to zero-copy memory and NUMA-local stores to system memory.
+  bool find_spill_target(StoreTarget target, StoreTarget& spill_target) const;
+  // When enabled, stores that don't fit in their target memories even after the cached
+  // instances are evicted are mapped to slower memories instead of failing the mapping
+  const bool enable_spilling;
+
+  // Returns the number of bytes in the regions accessed by each point of the task
+  size_t get_point_bytes(const Legion::Mapping::MapperContext ctx, const Legion::Task& task);
+  // Chooses the target of the task from the runtimes observed for its past launches
+  TaskTarget tune_task_target(const Legion::Mapping::MapperContext ctx,
+                              const Legion::Task& task,
+                              const std::vector<TaskTarget>& options,
+                              TaskTarget fallback);
+  // Only created when variants are autotuned
+  std::unique_ptr<VariantTuner> variant_tuner;
 };
 
 }  // namespace mapping
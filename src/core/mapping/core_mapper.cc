@@ -24,6 +24,7 @@
 #endif
 #include "core/task/task.h"
 #include "core/utilities/linearize.h"
+#include "core/utilities/machine.h"
 
 namespace legate {
 
@@ -54,7 +55,6 @@ class CoreMapper : public Legion::Mapping::NullMapper {
  public:
   // Start-up methods
   static AddressSpaceID get_local_node(void);
-  static size_t get_total_nodes(Machine m);
   static const char* create_name(AddressSpace node);
 
  public:
@@ -94,6 +94,10 @@ class CoreMapper : public Legion::Mapping::NullMapper {
                                     const Task& task,
                                     const SelectTunableInput& input,
                                     SelectTunableOutput& output);
+  virtual void memoize_operation(const MapperContext ctx,
+                                 const Mappable& mappable,
+                                 const MemoizeInput& input,
+                                 MemoizeOutput& output);
 
  protected:
   template <typename Functor>
@@ -108,6 +112,8 @@ class CoreMapper : public Legion::Mapping::NullMapper {
     assert(false);
     return functor(local_cpus);
   }
+  // Returns a processor that runs pieces of parallel launches and the memory holding its data
+  std::pair<Processor, Memory> find_piece_target() const;
 
  public:
   const AddressSpace local_node;
@@ -122,9 +128,11 @@ class CoreMapper : public Legion::Mapping::NullMapper {
   const uint32_t window_size;
   const uint32_t max_pending_exceptions;
   const bool precise_exception_trace;
+  const bool future_reductions_on_fb;
   const uint32_t field_reuse_frac;
   const uint32_t field_reuse_freq;
   const uint32_t max_lru_length;
+  const bool memoize_mappings;
   bool has_socket_mem;
 
  protected:
@@ -141,7 +149,7 @@ class CoreMapper : public Legion::Mapping::NullMapper {
 CoreMapper::CoreMapper(MapperRuntime* rt, Machine m, const LibraryContext& c)
   : NullMapper(rt, m),
     local_node(get_local_node()),
-    total_nodes(get_total_nodes(m)),
+    total_nodes(LocalMachine::get_local_machine().total_nodes),
     mapper_name(create_name(local_node)),
     context(c),
     min_gpu_chunk(extract_env("LEGATE_MIN_GPU_CHUNK", 1 << 20, 2)),
@@ -158,64 +166,29 @@ CoreMapper::CoreMapper(MapperRuntime* rt, Machine m, const LibraryContext& c)
 #endif
                   1)),
     precise_exception_trace(static_cast<bool>(extract_env("LEGATE_PRECISE_EXCEPTION_TRACE", 0, 0))),
+    future_reductions_on_fb(static_cast<bool>(extract_env("LEGATE_FUTURE_REDUCTIONS_ON_FB",
+#ifdef LEGATE_MAP_FUTURE_MAP_REDUCTIONS_TO_GPU
+                                                          1,
+#else
+                                                          0,
+#endif
+                                                          0))),
     field_reuse_frac(extract_env("LEGATE_FIELD_REUSE_FRAC", 256, 256)),
     field_reuse_freq(extract_env("LEGATE_FIELD_REUSE_FREQ", 32, 32)),
     max_lru_length(extract_env("LEGATE_MAX_LRU_LENGTH", 5, 1)),
+    memoize_mappings(static_cast<bool>(extract_env("LEGATE_MAPPING_CACHE", 0, 0))),
     has_socket_mem(false)
 {
-  // Query to find all our local processors
-  Machine::ProcessorQuery local_procs(machine);
-  local_procs.local_address_space();
-  for (Machine::ProcessorQuery::iterator it = local_procs.begin(); it != local_procs.end(); it++) {
-    switch (it->kind()) {
-      case Processor::LOC_PROC: {
-        local_cpus.push_back(*it);
-        break;
-      }
-      case Processor::OMP_PROC: {
-        local_omps.push_back(*it);
-        break;
-      }
-      case Processor::TOC_PROC: {
-        local_gpus.push_back(*it);
-        break;
-      }
-      default: break;
-    }
-  }
-  // Now do queries to find all our local memories
-  Machine::MemoryQuery local_sysmem(machine);
-  local_sysmem.local_address_space();
-  local_sysmem.only_kind(Memory::SYSTEM_MEM);
-  assert(local_sysmem.count() > 0);
-  local_system_memory = local_sysmem.first();
-  if (!local_gpus.empty()) {
-    Machine::MemoryQuery local_zcmem(machine);
-    local_zcmem.local_address_space();
-    local_zcmem.only_kind(Memory::Z_COPY_MEM);
-    assert(local_zcmem.count() > 0);
-    local_zerocopy_memory = local_zcmem.first();
-  }
-  for (auto local_gpu : local_gpus) {
-    Machine::MemoryQuery local_framebuffer(machine);
-    local_framebuffer.local_address_space();
-    local_framebuffer.only_kind(Memory::GPU_FB_MEM);
-    local_framebuffer.best_affinity_to(local_gpu);
-    assert(local_framebuffer.count() > 0);
-    local_frame_buffers[local_gpu] = local_framebuffer.first();
-  }
-  for (auto local_omp : local_omps) {
-    Machine::MemoryQuery local_numa(machine);
-    local_numa.local_address_space();
-    local_numa.only_kind(Memory::SOCKET_MEM);
-    local_numa.best_affinity_to(local_omp);
-    if (local_numa.count() > 0)  // if we have NUMA memories then use them
-    {
-      has_socket_mem                = true;
-      local_numa_domains[local_omp] = local_numa.first();
-    } else  // Otherwise we just use the local system memory
-      local_numa_domains[local_omp] = local_system_memory;
-  }
+  // The processors and memories come from the machine model shared by all mappers
+  auto& local_machine   = LocalMachine::get_local_machine();
+  local_cpus            = local_machine.cpus;
+  local_omps            = local_machine.omps;
+  local_gpus            = local_machine.gpus;
+  local_system_memory   = local_machine.system_memory;
+  local_zerocopy_memory = local_machine.zerocopy_memory;
+  local_frame_buffers   = local_machine.frame_buffers;
+  local_numa_domains    = local_machine.numa_domains;
+  has_socket_mem        = local_machine.has_socket_mem;
 }
 
 CoreMapper::~CoreMapper(void) { free(const_cast<char*>(mapper_name)); }
@@ -226,16 +199,6 @@ CoreMapper::~CoreMapper(void) { free(const_cast<char*>(mapper_name)); }
   return p.address_space();
 }
 
-/*static*/ size_t CoreMapper::get_total_nodes(Machine m)
-{
-  Machine::ProcessorQuery query(m);
-  query.only_kind(Processor::LOC_PROC);
-  std::set<AddressSpace> spaces;
-  for (Machine::ProcessorQuery::iterator it = query.begin(); it != query.end(); it++)
-    spaces.insert(it->address_space());
-  return spaces.size();
-}
-
 /*static*/ const char* CoreMapper::create_name(AddressSpace node)
 {
   char buffer[128];
@@ -328,6 +291,16 @@ void CoreMapper::select_tasks_to_map(const MapperContext ctx,
   output.map_tasks.insert(input.ready_tasks.begin(), input.ready_tasks.end());
 }
 
+void CoreMapper::memoize_operation(const MapperContext ctx,
+                                   const Mappable& mappable,
+                                   const MemoizeInput& input,
+                                   MemoizeOutput& output)
+{
+  // The core mapper's decisions depend only on the operations and the machine, so it memoizes
+  // them whenever the library mappers do, which is what turns traces into physical ones
+  output.memoize = memoize_mappings;
+}
+
 void CoreMapper::configure_context(const MapperContext ctx,
                                    const Task& task,
                                    ContextConfigOutput& output)
@@ -350,21 +323,39 @@ void CoreMapper::map_future_map_reduction(const MapperContext ctx,
 {
   output.serdez_upper_bound = LEGATE_MAX_SIZE_SCALAR_RETURN;
 
-#ifdef LEGATE_MAP_FUTURE_MAP_REDUCTIONS_TO_GPU
-  // TODO: It's been reported that blindly mapping target instances of future map reductions
-  // to framebuffers hurts performance. Until we find a better mapping policy, we guard
-  // the current policy with a macro.
-
   // If this was joining exceptions, we don't want to put instances anywhere
   // other than the system memory because they need serdez
   if (input.tag == LEGATE_CORE_JOIN_EXCEPTION_TAG) return;
-  if (!local_gpus.empty())
-    for (auto& pair : local_frame_buffers) output.destination_memories.push_back(pair.second);
+  if (!local_gpus.empty()) {
+    // Futures produced by GPU tasks are reduced in memory the GPUs can access, so that the
+    // reduction never stages them through the system memory. It's been reported that
+    // blindly mapping the targets to framebuffers hurts performance when the result is
+    // consumed on the host, so the zero-copy memory is the default and framebuffers are
+    // opt-in until we find a better mapping policy.
+    if (future_reductions_on_fb)
+      for (auto& pair : local_frame_buffers) output.destination_memories.push_back(pair.second);
+    else if (local_zerocopy_memory.exists())
+      output.destination_memories.push_back(local_zerocopy_memory);
+  }
+#ifdef LEGATE_MAP_FUTURE_MAP_REDUCTIONS_TO_GPU
   else if (has_socket_mem)
     for (auto& pair : local_numa_domains) output.destination_memories.push_back(pair.second);
 #endif
 }
 
+std::pair<Processor, Memory> CoreMapper::find_piece_target() const
+{
+  // We assume that all processors of the same kind are symmetric
+  if (!local_gpus.empty()) {
+    auto proc = local_gpus.front();
+    return std::make_pair(proc, local_frame_buffers.at(proc));
+  } else if (!local_omps.empty()) {
+    auto proc = local_omps.front();
+    return std::make_pair(proc, local_numa_domains.at(proc));
+  } else
+    return std::make_pair(local_cpus.front(), local_system_memory);
+}
+
 void CoreMapper::select_tunable_value(const MapperContext ctx,
                                       const Task& task,
                                       const SelectTunableInput& input,
@@ -452,6 +443,37 @@ void CoreMapper::select_tunable_value(const MapperContext ctx,
       pack_tunable<uint32_t>(max_lru_length, output);
       return;
     }
+    case LEGATE_CORE_TUNABLE_PIECE_MEMORY_SIZE: {
+      auto target   = find_piece_target();
+      auto mem_size = target.second.capacity();
+      // CPUs share the system memory
+      if (local_gpus.empty() && local_omps.empty()) mem_size /= local_cpus.size();
+      pack_tunable<uint64_t>(mem_size, output);
+      return;
+    }
+    case LEGATE_CORE_TUNABLE_LOCAL_BANDWIDTH: {
+      // Bandwidths are reported in MB/s and are zero when Realm doesn't know them
+      auto target = find_piece_target();
+      std::vector<Machine::ProcessorMemoryAffinity> affinities;
+      machine.get_proc_mem_affinity(affinities, target.first, target.second);
+      uint32_t bandwidth = affinities.empty() ? 0 : affinities.front().bandwidth;
+      pack_tunable<uint32_t>(bandwidth, output);
+      return;
+    }
+    case LEGATE_CORE_TUNABLE_REMOTE_BANDWIDTH: {
+      // The slowest path from the piece memory to any other memory bounds the cost of moving
+      // data between pieces
+      auto target = find_piece_target();
+      std::vector<Machine::MemoryMemoryAffinity> affinities;
+      machine.get_mem_mem_affinity(
+        affinities, target.second, Memory::NO_MEMORY, false /*local_only*/);
+      uint32_t bandwidth = 0;
+      for (auto& affinity : affinities)
+        if (affinity.bandwidth > 0 && (0 == bandwidth || affinity.bandwidth < bandwidth))
+          bandwidth = affinity.bandwidth;
+      pack_tunable<uint32_t>(bandwidth, output);
+      return;
+    }
     case LEGATE_CORE_TUNABLE_NCCL_NEEDS_BARRIER: {
 #ifdef LEGATE_USE_CUDA
       pack_tunable<bool>(local_gpus.empty() ? false : comm::nccl::needs_barrier(), output);
@@ -14,8 +14,12 @@
  *
  */
 
+#include <algorithm>
+
 #include "core/mapping/instance_manager.h"
+#include "core/runtime/runtime.h"
 #include "core/utilities/dispatch.h"
+#include "core/utilities/memory_usage.h"
 
 namespace legate {
 namespace mapping {
@@ -85,9 +89,7 @@ bool InstanceSet::find_instance(Region region,
   assert(ifinder != instances_.end());
 
   auto& spec = ifinder->second;
-  // TODO: policies don't need to be exactly the same but the policy of the existing instance
-  // only needs to subsume the requested policy
-  if (spec.policy == policy) {
+  if (spec.policy.subsumes(policy, region.get_dim())) {
     result = spec.instance;
     return true;
   } else
@@ -107,7 +109,8 @@ struct construct_overlapping_region_group_fn {
   template <int32_t DIM>
   RegionGroupP operator()(const InstanceSet::Region& region,
                           const InstanceSet::Domain& domain,
-                          const std::map<RegionGroup*, InstanceSet::InstanceSpec>& instances)
+                          const std::multimap<coord_t, RegionGroup*>& group_index,
+                          coord_t max_group_extent)
   {
     auto bound       = domain.bounds<DIM, coord_t>();
     size_t bound_vol = bound.volume();
@@ -117,46 +120,60 @@ struct construct_overlapping_region_group_fn {
     log_instmgr.debug() << "construct_overlapping_region_group( " << region << "," << domain << ")";
 #endif
 
-    for (const auto& pair : instances) {
-      auto& group = pair.first;
-
-      Rect<DIM> group_bbox = group->bounding_box.bounds<DIM, coord_t>();
+    // Each group is checked at most once. Whenever the bound gets bloated, we query the index
+    // again, as the bloated bound can intersect groups that the original one didn't.
+    std::set<RegionGroup*> visited;
+    bool bloated = true;
+    while (bloated) {
+      bloated = false;
+      // Only the groups whose lower bounds in the first dimension fall in this range can
+      // intersect with the bound
+      auto begin = group_index.lower_bound(bound.lo[0] - max_group_extent);
+      auto end   = group_index.upper_bound(bound.hi[0]);
+      for (auto it = begin; it != end; ++it) {
+        auto group = it->second;
+        if (!visited.insert(group).second) continue;
+
+        Rect<DIM> group_bbox = group->bounding_box.bounds<DIM, coord_t>();
 #ifdef DEBUG_LEGATE
-      log_instmgr.debug() << "  check intersection with " << group_bbox;
+        log_instmgr.debug() << "  check intersection with " << group_bbox;
 #endif
-      auto intersect = bound.intersection(group_bbox);
-      if (intersect.empty()) {
+        auto intersect = bound.intersection(group_bbox);
+        if (intersect.empty()) {
 #ifdef DEBUG_LEGATE
-        log_instmgr.debug() << "    no intersection";
+          log_instmgr.debug() << "    no intersection";
 #endif
-        continue;
-      }
-
-      // Only allow merging if the bloating isn't "too big"
-      auto union_bbox      = bound.union_bbox(group_bbox);
-      size_t union_vol     = union_bbox.volume();
-      size_t group_vol     = group_bbox.volume();
-      size_t intersect_vol = intersect.volume();
-      if (too_big(union_vol, bound_vol, group_vol, intersect_vol)) {
+          continue;
+        }
+
+        // Only allow merging if the bloating isn't "too big"
+        auto union_bbox      = bound.union_bbox(group_bbox);
+        size_t union_vol     = union_bbox.volume();
+        size_t group_vol     = group_bbox.volume();
+        size_t intersect_vol = intersect.volume();
+        if (too_big(union_vol, bound_vol, group_vol, intersect_vol)) {
 #ifdef DEBUG_LEGATE
-        log_instmgr.debug() << "    too big to merge (union:" << union_bbox
-                            << ",bound:" << bound_vol << ",group:" << group_vol
-                            << ",intersect:" << intersect_vol << ")";
+          log_instmgr.debug() << "    too big to merge (union:" << union_bbox
+                              << ",bound:" << bound_vol << ",group:" << group_vol
+                              << ",intersect:" << intersect_vol << ")";
 #endif
-        continue;
-      }
-
-      // NOTE: It is critical that we maintain the invariant that if at least one region is mapped
-      // to a group in the instances_ table, that group is still present on the groups_ table, and
-      // thus there's at least one shared_ptr remaining that points to it. Otherwise we run the risk
-      // that a group pointer stored on the instances_ table points to a group that's been collected
-      regions.insert(group->regions.begin(), group->regions.end());
+          continue;
+        }
+
+        // NOTE: It is critical that we maintain the invariant that if at least one region is
+        // mapped to a group in the instances_ table, that group is still present on the groups_
+        // table, and thus there's at least one shared_ptr remaining that points to it. Otherwise
+        // we run the risk that a group pointer stored on the instances_ table points to a group
+        // that's been collected
+        regions.insert(group->regions.begin(), group->regions.end());
 #ifdef DEBUG_LEGATE
-      log_instmgr.debug() << "    bounds updated: " << bound << " ~> " << union_bbox;
+        log_instmgr.debug() << "    bounds updated: " << bound << " ~> " << union_bbox;
 #endif
 
-      bound     = union_bbox;
-      bound_vol = union_vol;
+        bloated   = bloated || union_bbox != bound;
+        bound     = union_bbox;
+        bound_vol = union_vol;
+      }
     }
 
     return std::make_shared<RegionGroup>(std::move(regions), InstanceSet::Domain(bound));
@@ -169,8 +186,12 @@ RegionGroupP InstanceSet::construct_overlapping_region_group(const Region& regio
 {
   auto finder = groups_.find(region);
   if (finder == groups_.end())
-    return dim_dispatch(
-      domain.get_dim(), construct_overlapping_region_group_fn{}, region, domain, instances_);
+    return dim_dispatch(domain.get_dim(),
+                        construct_overlapping_region_group_fn{},
+                        region,
+                        domain,
+                        group_index_,
+                        max_group_extent_);
   else {
     if (!exact || finder->second->regions.size() == 1) return finder->second;
     return std::make_shared<RegionGroup>(std::set<Region>{region}, domain);
@@ -196,8 +217,10 @@ std::set<InstanceSet::Instance> InstanceSet::record_instance(RegionGroupP group,
   if (finder != instances_.end()) {
     replaced.insert(finder->second.instance);
     finder->second = InstanceSpec(instance, policy);
-  } else
+  } else {
     instances_[group.get()] = InstanceSpec(instance, policy);
+    add_to_index(group.get());
+  }
 
   for (auto& region : group->regions) {
     auto finder = groups_.find(region);
@@ -226,6 +249,7 @@ std::set<InstanceSet::Instance> InstanceSet::record_instance(RegionGroupP group,
       auto finder = instances_.find(removed_group.get());
       replaced.insert(finder->second.instance);
       instances_.erase(finder);
+      remove_from_index(removed_group.get());
     }
   }
 
@@ -255,6 +279,7 @@ bool InstanceSet::erase(PhysicalInstance inst)
     if (it->second.instance == inst) {
       auto to_erase = it++;
       filtered_groups.insert(to_erase->first);
+      remove_from_index(to_erase->first);
       instances_.erase(to_erase);
     } else
       it++;
@@ -279,6 +304,27 @@ bool InstanceSet::erase(PhysicalInstance inst)
   return instances_.empty();
 }
 
+void InstanceSet::add_to_index(RegionGroup* group)
+{
+  auto lo = group->bounding_box.lo()[0];
+  auto hi = group->bounding_box.hi()[0];
+  group_index_.insert(std::make_pair(lo, group));
+  max_group_extent_ = std::max(max_group_extent_, hi - lo);
+}
+
+void InstanceSet::remove_from_index(RegionGroup* group)
+{
+  auto range = group_index_.equal_range(group->bounding_box.lo()[0]);
+  for (auto it = range.first; it != range.second; ++it)
+    if (it->second == group) {
+      group_index_.erase(it);
+      return;
+    }
+#ifdef DEBUG_LEGATE
+  assert(false);
+#endif
+}
+
 size_t InstanceSet::get_instance_size() const
 {
   size_t sum = 0;
@@ -286,6 +332,11 @@ size_t InstanceSet::get_instance_size() const
   return sum;
 }
 
+void InstanceSet::collect_instances(std::set<Instance>& instances) const
+{
+  for (auto& pair : instances_) instances.insert(pair.second.instance);
+}
+
 void InstanceSet::dump_and_sanity_check() const
 {
 #ifdef DEBUG_INSTANCE_MANAGER
@@ -300,6 +351,23 @@ void InstanceSet::dump_and_sanity_check() const
     assert(entry.second->regions.count(entry.first) > 0);
   }
   for (auto& entry : instances_) assert(found_groups.count(entry.first) > 0);
+  assert(group_index_.size() == instances_.size());
+}
+
+InstanceManager::InstanceManager()
+  : budget_percentage_(std::min<uint32_t>(extract_env("LEGATE_INSTANCE_BUDGET", 0, 0), 100))
+{
+}
+
+InstanceManager::Shard& InstanceManager::get_shard(Memory memory)
+{
+  std::lock_guard<std::mutex> guard(shards_lock_);
+  auto& shard = shards_[memory];
+  if (nullptr == shard) {
+    shard = std::make_unique<Shard>();
+    if (budget_percentage_ > 0) shard->budget = memory.capacity() / 100 * budget_percentage_;
+  }
+  return *shard;
 }
 
 bool InstanceManager::find_instance(Region region,
@@ -308,8 +376,20 @@ bool InstanceManager::find_instance(Region region,
                                     Instance& result,
                                     const InstanceMappingPolicy& policy)
 {
-  auto finder = instance_sets_.find(FieldMemInfo(region.get_tree_id(), field_id, memory));
-  return policy.allocation != AllocPolicy::MUST_ALLOC && finder != instance_sets_.end() &&
+  bool found = peek_instance(region, field_id, memory, result, policy);
+  if (found) get_shard(memory).touch(result);
+  return found;
+}
+
+bool InstanceManager::peek_instance(Region region,
+                                    FieldID field_id,
+                                    Memory memory,
+                                    Instance& result,
+                                    const InstanceMappingPolicy& policy)
+{
+  auto& shard = get_shard(memory);
+  auto finder = shard.instance_sets.find(FieldMemInfo(region.get_tree_id(), field_id, memory));
+  return policy.allocation != AllocPolicy::MUST_ALLOC && finder != shard.instance_sets.end() &&
          finder->second.find_instance(region, result, policy);
 }
 
@@ -323,8 +403,9 @@ RegionGroupP InstanceManager::find_region_group(const Region& region,
 
   RegionGroupP result{nullptr};
 
-  auto finder = instance_sets_.find(key);
-  if (finder == instance_sets_.end() || exact)
+  auto& shard = get_shard(memory);
+  auto finder = shard.instance_sets.find(key);
+  if (finder == shard.instance_sets.end() || exact)
     result = std::make_shared<RegionGroup>(std::set<Region>{region}, domain);
   else
     result = finder->second.construct_overlapping_region_group(region, domain, exact);
@@ -338,40 +419,173 @@ RegionGroupP InstanceManager::find_region_group(const Region& region,
 }
 
 std::set<InstanceManager::Instance> InstanceManager::record_instance(
-  RegionGroupP group, FieldID fid, Instance instance, const InstanceMappingPolicy& policy)
+  RegionGroupP group,
+  FieldID fid,
+  Instance instance,
+  const std::string& library,
+  const InstanceMappingPolicy& policy)
 {
   const auto mem = instance.get_location();
   const auto tid = instance.get_tree_id();
 
   FieldMemInfo key(tid, fid, mem);
-  return instance_sets_[key].record_instance(group, instance, policy);
+  auto& shard   = get_shard(mem);
+  auto replaced = shard.instance_sets[key].record_instance(group, instance, policy);
+  for (auto& inst : replaced) {
+    shard.last_use.erase(inst);
+    shard.untrack(inst);
+  }
+  shard.touch(instance);
+  shard.track(instance, library, fid);
+  return std::move(replaced);
+}
+
+bool InstanceManager::find_reduction_instance(
+  Region region, FieldID field_id, Legion::ReductionOpID redop, Memory memory, Instance& result)
+{
+  auto& shard = get_shard(memory);
+  auto finder = shard.reduction_instances.find(ReductionInstanceInfo(region, field_id, redop));
+  if (finder == shard.reduction_instances.end()) return false;
+  result = finder->second;
+  shard.touch(result);
+  return true;
+}
+
+void InstanceManager::record_reduction_instance(Region region,
+                                                FieldID field_id,
+                                                Legion::ReductionOpID redop,
+                                                Instance instance,
+                                                const std::string& library)
+{
+  auto& shard = get_shard(instance.get_location());
+  auto& entry = shard.reduction_instances[ReductionInstanceInfo(region, field_id, redop)];
+  if (entry.exists() && entry != instance) {
+    shard.last_use.erase(entry);
+    shard.untrack(entry);
+  }
+  entry = instance;
+  shard.touch(instance);
+  shard.track(instance, library, field_id);
+}
+
+void InstanceManager::erase(PhysicalInstance inst) { get_shard(inst.get_location()).erase(inst); }
+
+std::vector<InstanceManager::Instance> InstanceManager::tracked_instances(Memory memory)
+{
+  std::vector<Instance> instances;
+  for (auto& pair : get_shard(memory).tracked) instances.push_back(pair.first);
+  return instances;
+}
+
+void InstanceManager::Shard::track(Instance instance,
+                                   const std::string& library,
+                                   FieldID field_id)
+{
+  if (!MemoryUsage::enabled() || tracked.find(instance) != tracked.end()) return;
+  auto bytes = instance.get_instance_size();
+  tracked[instance] = TrackedInstance{library, field_id, bytes};
+  MemoryUsage::add_instance(
+    instance.get_location(), library, instance.get_tree_id(), field_id, bytes);
+}
+
+void InstanceManager::Shard::untrack(Instance instance)
+{
+  auto finder = tracked.find(instance);
+  if (finder == tracked.end()) return;
+  auto& info = finder->second;
+  MemoryUsage::remove_instance(
+    instance.get_location(), info.library, instance.get_tree_id(), info.field_id, info.bytes);
+  tracked.erase(finder);
 }
 
-void InstanceManager::erase(PhysicalInstance inst)
+void InstanceManager::Shard::erase(Instance inst)
 {
-  const auto mem = inst.get_location();
   const auto tid = inst.get_tree_id();
 
-  for (auto fit = instance_sets_.begin(); fit != instance_sets_.end(); /*nothing*/) {
-    if ((fit->first.memory != mem) || (fit->first.tid != tid)) {
+  for (auto fit = instance_sets.begin(); fit != instance_sets.end(); /*nothing*/) {
+    if (fit->first.tid != tid) {
       fit++;
       continue;
     }
     if (fit->second.erase(inst)) {
       auto to_erase = fit++;
-      instance_sets_.erase(to_erase);
+      instance_sets.erase(to_erase);
     } else
       fit++;
   }
+  for (auto it = reduction_instances.begin(); it != reduction_instances.end(); /*nothing*/) {
+    if (it->second == inst)
+      it = reduction_instances.erase(it);
+    else
+      ++it;
+  }
+  last_use.erase(inst);
+  untrack(inst);
+}
+
+void InstanceManager::Shard::collect_instances(std::set<Instance>& instances) const
+{
+  for (auto& pair : instance_sets) pair.second.collect_instances(instances);
+  for (auto& pair : reduction_instances) instances.insert(pair.second);
+}
+
+size_t InstanceManager::Shard::get_memory_usage() const
+{
+  std::set<Instance> instances;
+  collect_instances(instances);
+  size_t usage = 0;
+  for (auto& instance : instances) usage += instance.get_instance_size();
+  return usage;
+}
+
+size_t InstanceManager::get_budget(Memory memory) { return get_shard(memory).budget; }
+
+size_t InstanceManager::get_memory_usage(Memory memory)
+{
+  return get_shard(memory).get_memory_usage();
+}
+
+std::vector<InstanceManager::Instance> InstanceManager::evict_instances(
+  Memory memory, size_t target_bytes, const std::set<Instance>& pinned)
+{
+  auto& shard = get_shard(memory);
+
+  std::set<Instance> instances;
+  shard.collect_instances(instances);
+
+  size_t usage = 0;
+  // Candidates sorted from the least recently used ones
+  std::vector<std::pair<uint64_t, Instance>> candidates;
+  for (auto& instance : instances) {
+    usage += instance.get_instance_size();
+    if (pinned.find(instance) != pinned.end()) continue;
+    auto finder = shard.last_use.find(instance);
+    candidates.push_back(
+      std::make_pair(finder != shard.last_use.end() ? finder->second : 0, instance));
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  std::vector<Instance> evicted;
+  for (auto& candidate : candidates) {
+    if (usage <= target_bytes) break;
+    auto& instance = candidate.second;
+    usage -= instance.get_instance_size();
+    shard.erase(instance);
+    evicted.push_back(instance);
+  }
+  return std::move(evicted);
 }
 
 std::map<Legion::Memory, size_t> InstanceManager::aggregate_instance_sizes() const
 {
   std::map<Legion::Memory, size_t> result;
-  for (auto& pair : instance_sets_) {
-    auto& memory = pair.first.memory;
-    if (result.find(memory) == result.end()) result[memory] = 0;
-    result[memory] += pair.second.get_instance_size();
+  std::lock_guard<std::mutex> guard(shards_lock_);
+  for (auto& shard : shards_) {
+    size_t size = 0;
+    for (auto& pair : shard.second->instance_sets) size += pair.second.get_instance_size();
+    for (auto& pair : shard.second->reduction_instances)
+      size += pair.second.get_instance_size();
+    if (size > 0) result[shard.first] = size;
   }
   return result;
 }
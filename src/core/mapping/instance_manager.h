@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <mutex>
+#include <tuple>
 
 #include "legion.h"
 
@@ -86,6 +87,11 @@ struct InstanceSet {
 
  public:
   size_t get_instance_size() const;
+  void collect_instances(std::set<Instance>& instances) const;
+
+ private:
+  void add_to_index(RegionGroup* group);
+  void remove_from_index(RegionGroup* group);
 
  private:
   void dump_and_sanity_check() const;
@@ -93,6 +99,12 @@ struct InstanceSet {
  private:
   std::map<RegionGroup*, InstanceSpec> instances_;
   std::map<Legion::LogicalRegion, RegionGroupP> groups_;
+  // An index over the bounding boxes of the groups in instances_, keyed by their lower bounds
+  // in the first dimension. Any group that can intersect with a bound [lo, hi] has its lower
+  // bound in [lo - max_group_extent_, hi], where max_group_extent_ is the largest extent of
+  // the indexed groups in the first dimension.
+  std::multimap<Legion::coord_t, RegionGroup*> group_index_;
+  Legion::coord_t max_group_extent_{0};
 };
 
 class InstanceManager {
@@ -132,27 +144,86 @@ class InstanceManager {
     Memory memory;
   };
 
+  struct ReductionInstanceInfo {
+   public:
+    ReductionInstanceInfo(Region r, FieldID f, Legion::ReductionOpID op)
+      : region(r), fid(f), redop(op)
+    {
+    }
+    inline bool operator<(const ReductionInstanceInfo& rhs) const
+    {
+      return std::tie(region, fid, redop) < std::tie(rhs.region, rhs.fid, rhs.redop);
+    }
+
+   public:
+    Region region;
+    FieldID fid;
+    Legion::ReductionOpID redop;
+  };
+
  public:
   bool find_instance(Region region,
                      FieldID field_id,
                      Memory memory,
                      Instance& result,
                      const InstanceMappingPolicy& policy = {});
+  // Same as find_instance, but doesn't count as a use of the instance for eviction
+  bool peek_instance(Region region,
+                     FieldID field_id,
+                     Memory memory,
+                     Instance& result,
+                     const InstanceMappingPolicy& policy = {});
   RegionGroupP find_region_group(const Region& region,
                                  const Domain& domain,
                                  FieldID field_id,
                                  Memory memory,
                                  bool exact = false);
+  // The library whose mapper created the instance is only used for memory usage accounting
   std::set<Instance> record_instance(RegionGroupP group,
                                      FieldID field_id,
                                      Instance instance,
+                                     const std::string& library,
                                      const InstanceMappingPolicy& policy = {});
 
+ public:
+  // Reduction instances are never shared between regions, so they are cached separately by
+  // region, field, and reduction operator. Legion reinitializes a reused reduction instance
+  // with the identity, so iterative reductions into the same region can skip the allocation.
+  bool find_reduction_instance(Region region,
+                               FieldID field_id,
+                               Legion::ReductionOpID redop,
+                               Memory memory,
+                               Instance& result);
+  void record_reduction_instance(Region region,
+                                 FieldID field_id,
+                                 Legion::ReductionOpID redop,
+                                 Instance instance,
+                                 const std::string& library);
+
  public:
   void erase(Instance inst);
+  // Returns the cached instances in the memory that are reported to MemoryUsage
+  std::vector<Instance> tracked_instances(Memory memory);
+
+ public:
+  // Returns the memory budget for cached instances, or 0 if the budget is unlimited.
+  // The budget is a percentage (LEGATE_INSTANCE_BUDGET) of the memory's capacity.
+  size_t get_budget(Memory memory);
+  size_t get_memory_usage(Memory memory);
+  // Removes the least recently used instances in the memory from the cache until the total size
+  // of cached instances is no greater than 'target_bytes'. Pinned instances are never evicted.
+  // Returns the evicted instances, which the caller should make collectable.
+  std::vector<Instance> evict_instances(Memory memory,
+                                        size_t target_bytes,
+                                        const std::set<Instance>& pinned = {});
+
+ public:
+  // Instances are managed separately for each memory, so mapper calls targeting different
+  // memories can proceed in parallel. Callers must hold the lock for the memory.
+  Legion::Mapping::LocalLock& manager_lock(Memory memory) { return get_shard(memory).lock; }
 
  public:
-  Legion::Mapping::LocalLock& manager_lock() { return manager_lock_; }
+  InstanceManager();
 
  public:
   static InstanceManager* get_instance_manager();
@@ -161,8 +232,40 @@ class InstanceManager {
   std::map<Legion::Memory, size_t> aggregate_instance_sizes() const;
 
  private:
-  std::map<FieldMemInfo, InstanceSet> instance_sets_{};
-  Legion::Mapping::LocalLock manager_lock_{};
+  struct Shard {
+   public:
+    void touch(Instance instance) { last_use[instance] = ++clock; }
+    void track(Instance instance, const std::string& library, FieldID field_id);
+    void untrack(Instance instance);
+    void erase(Instance inst);
+    void collect_instances(std::set<Instance>& instances) const;
+    size_t get_memory_usage() const;
+
+   public:
+    std::map<FieldMemInfo, InstanceSet> instance_sets{};
+    std::map<ReductionInstanceInfo, Instance> reduction_instances{};
+    Legion::Mapping::LocalLock lock{};
+    // Logical timestamps of the last uses of cached instances
+    uint64_t clock{0};
+    std::map<Instance, uint64_t> last_use{};
+    // Cached instances reported to MemoryUsage, with the information needed to retract them
+    struct TrackedInstance {
+      std::string library;
+      FieldID field_id;
+      size_t bytes;
+    };
+    std::map<Instance, TrackedInstance> tracked{};
+    size_t budget{0};
+  };
+
+ private:
+  Shard& get_shard(Memory memory);
+
+ private:
+  // Shards are created lazily and never removed. The lock only protects the shard table.
+  std::map<Memory, std::unique_ptr<Shard>> shards_{};
+  mutable std::mutex shards_lock_{};
+  uint32_t budget_percentage_{0};
 };
 
 }  // namespace mapping
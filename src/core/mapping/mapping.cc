@@ -48,40 +48,85 @@ void DimOrdering::populate_dimension_ordering(const Store& store,
 {
   // TODO: We need to implement the relative dimension ordering
   assert(!relative);
+  for (auto idx : dimensions(store.region_field().dim()))
+    ordering.push_back(static_cast<DimensionKind>(DIM_X + idx));
+}
+
+std::vector<int32_t> DimOrdering::dimensions(int32_t dim) const
+{
+  std::vector<int32_t> result;
   switch (kind) {
+    case Kind::ANY: {
+      if (!dims.empty()) return dims;
+      // Falls back to the C order
+      [[fallthrough]];
+    }
     case Kind::C: {
-      auto dim = store.region_field().dim();
-      for (int32_t idx = dim - 1; idx >= 0; --idx)
-        ordering.push_back(static_cast<DimensionKind>(DIM_X + idx));
+      for (int32_t idx = dim - 1; idx >= 0; --idx) result.push_back(idx);
       break;
     }
     case Kind::FORTRAN: {
-      auto dim = store.region_field().dim();
-      for (int32_t idx = 0; idx < dim; ++idx)
-        ordering.push_back(static_cast<DimensionKind>(DIM_X + idx));
+      for (int32_t idx = 0; idx < dim; ++idx) result.push_back(idx);
       break;
     }
     case Kind::CUSTOM: {
-      for (auto idx : dims) ordering.push_back(static_cast<DimensionKind>(DIM_X + idx));
+      result = dims;
       break;
     }
   }
+  return std::move(result);
 }
 
-void DimOrdering::c_order() { kind = Kind::C; }
+void DimOrdering::c_order()
+{
+  kind      = Kind::C;
+  requested = true;
+}
 
-void DimOrdering::fortran_order() { kind = Kind::FORTRAN; }
+void DimOrdering::fortran_order()
+{
+  kind      = Kind::FORTRAN;
+  requested = true;
+}
 
 void DimOrdering::custom_order(std::vector<int32_t>&& dims)
 {
-  kind = Kind::CUSTOM;
-  dims = std::forward<std::vector<int32_t>&&>(dims);
+  kind       = Kind::CUSTOM;
+  this->dims = std::move(dims);
+  requested  = true;
+}
+
+void DimOrdering::any_order()
+{
+  kind = Kind::ANY;
+  dims.clear();
+}
+
+bool InstTiling::operator==(const InstTiling& other) const { return extents == other.extents; }
+
+void InstTiling::populate_tiling_constraints(const Store& store,
+                                             LayoutConstraintSet& layout_constraints) const
+{
+  if (!tiled()) return;
+#ifdef DEBUG_LEGATE
+  assert(static_cast<int32_t>(extents.size()) == store.region_field().dim());
+#endif
+  for (uint32_t idx = 0; idx < extents.size(); ++idx) {
+    if (extents[idx] <= 0) continue;
+    layout_constraints.add_constraint(TilingConstraint(
+      static_cast<DimensionKind>(DIM_X + idx), extents[idx], false /*value is the tile extent*/));
+  }
+}
+
+void InstTiling::tile(std::vector<int64_t>&& tile_extents)
+{
+  extents = std::forward<std::vector<int64_t>&&>(tile_extents);
 }
 
 bool InstanceMappingPolicy::operator==(const InstanceMappingPolicy& other) const
 {
   return target == other.target && allocation == other.allocation && layout == other.layout &&
-         exact == other.exact && ordering == other.ordering;
+         exact == other.exact && ordering == other.ordering && tiling == other.tiling;
 }
 
 bool InstanceMappingPolicy::operator!=(const InstanceMappingPolicy& other) const
@@ -89,6 +134,14 @@ bool InstanceMappingPolicy::operator!=(const InstanceMappingPolicy& other) const
   return !operator==(other);
 }
 
+bool InstanceMappingPolicy::subsumes(const InstanceMappingPolicy& other, int32_t dim) const
+{
+  return target == other.target && layout == other.layout && (exact || !other.exact) &&
+         (dim <= 1 || other.ordering.kind == DimOrdering::Kind::ANY ||
+          ordering.dimensions(dim) == other.ordering.dimensions(dim)) &&
+         tiling == other.tiling;
+}
+
 void InstanceMappingPolicy::populate_layout_constraints(
   const Store& store, Legion::LayoutConstraintSet& layout_constraints) const
 {
@@ -99,6 +152,7 @@ void InstanceMappingPolicy::populate_layout_constraints(
   if (layout == InstLayout::SOA) dimension_ordering.push_back(DIM_F);
 
   layout_constraints.add_constraint(OrderingConstraint(dimension_ordering, false /*contiguous*/));
+  tiling.populate_tiling_constraints(store, layout_constraints);
 
   layout_constraints.add_constraint(MemoryConstraint(get_memory_kind(target)));
 }
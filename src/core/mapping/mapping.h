@@ -50,6 +50,9 @@ struct DimOrdering {
     C       = 1,
     FORTRAN = 2,
     CUSTOM  = 3,
+    // Any ordering works for the consumer. Cached instances of any ordering are reused, and new
+    // instances take the ordering the other consumers of the store asked for most often.
+    ANY = 4,
   };
 
  public:
@@ -69,11 +72,14 @@ struct DimOrdering {
  public:
   void populate_dimension_ordering(const Store& store,
                                    std::vector<Legion::DimensionKind>& ordering) const;
+  // Returns the dimensions of a 'dim'-D store from the fastest-varying to the slowest-varying
+  std::vector<int32_t> dimensions(int32_t dim) const;
 
  public:
   void c_order();
   void fortran_order();
   void custom_order(std::vector<int32_t>&& dims);
+  void any_order();
 
  public:
   Kind kind{Kind::C};
@@ -81,8 +87,42 @@ struct DimOrdering {
   // for the store's local coordinate space, which will be mapped
   // back to the root store's original coordinate space.
   bool relative{false};
-  // Used only when the kind is CUSTOM
+  // Used only when the kind is CUSTOM, or ANY, in which case the mapper fills it in with the
+  // ordering that new instances should take. An empty list stands for the C order.
   std::vector<int32_t> dims{};
+  // Set when the ordering was picked explicitly rather than left as the default. Only explicit
+  // orderings count as votes for the stores that accept any ordering.
+  bool requested{false};
+};
+
+// Blocks an instance into tiles of fixed extents, each of which is laid out contiguously with
+// the dimension ordering of the policy. Tasks must access tiled stores with the tiled accessors.
+struct InstTiling {
+ public:
+  InstTiling() {}
+
+ public:
+  InstTiling(const InstTiling&)            = default;
+  InstTiling& operator=(const InstTiling&) = default;
+
+ public:
+  InstTiling(InstTiling&&)            = default;
+  InstTiling& operator=(InstTiling&&) = default;
+
+ public:
+  bool operator==(const InstTiling&) const;
+
+ public:
+  bool tiled() const { return !extents.empty(); }
+  void populate_tiling_constraints(const Store& store,
+                                   Legion::LayoutConstraintSet& layout_constraints) const;
+
+ public:
+  void tile(std::vector<int64_t>&& tile_extents);
+
+ public:
+  // Tile extent of each dimension of the store. A zero extent leaves the dimension unsplit.
+  std::vector<int64_t> extents{};
 };
 
 struct InstanceMappingPolicy {
@@ -91,6 +131,7 @@ struct InstanceMappingPolicy {
   AllocPolicy allocation{AllocPolicy::MAY_ALLOC};
   InstLayout layout{InstLayout::SOA};
   DimOrdering ordering{};
+  InstTiling tiling{};
   bool exact{false};
 
  public:
@@ -108,6 +149,13 @@ struct InstanceMappingPolicy {
   bool operator==(const InstanceMappingPolicy&) const;
   bool operator!=(const InstanceMappingPolicy&) const;
 
+ public:
+  // Returns true if an instance created with this policy can be used for the other policy.
+  // The allocation policy is irrelevant to reuse and an exact instance satisfies both exact and
+  // non-exact requests. Dimension orderings are ignored for 1D stores and for requests that
+  // accept any ordering.
+  bool subsumes(const InstanceMappingPolicy& other, int32_t dim) const;
+
  public:
   void populate_layout_constraints(const Store& store,
                                    Legion::LayoutConstraintSet& layout_constraints) const;
@@ -0,0 +1,138 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "legion.h"
+
+#include "core/mapping/mapping_trace.h"
+#include "core/runtime/runtime.h"
+
+namespace legate {
+namespace mapping_trace {
+
+std::atomic<bool> enabled{false};
+
+// Number of events each thread buffers before writing them out
+static constexpr size_t BUFFER_CAPACITY = 4096;
+
+static constexpr char MAGIC[8]    = {'L', 'G', 'M', 'A', 'P', 'T', 'R', 'C'};
+static constexpr uint32_t VERSION = 1;
+
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t event_size;
+  uint64_t node;
+};
+
+static std::mutex file_lock;
+static FILE* file = nullptr;
+static std::vector<std::unique_ptr<std::vector<Event>>> buffers;
+
+static void flush(std::vector<Event>& buffer)
+{
+  if (buffer.empty()) return;
+  if (file != nullptr) fwrite(buffer.data(), sizeof(Event), buffer.size(), file);
+  buffer.clear();
+}
+
+static std::vector<Event>& get_local_buffer()
+{
+  thread_local std::vector<Event>* buffer = nullptr;
+  if (nullptr == buffer) {
+    std::lock_guard<std::mutex> guard(file_lock);
+    buffers.push_back(std::make_unique<std::vector<Event>>());
+    buffer = buffers.back().get();
+    buffer->reserve(BUFFER_CAPACITY);
+  }
+  return *buffer;
+}
+
+static void finalize()
+{
+  if (!enabled) return;
+  enabled = false;
+
+  std::lock_guard<std::mutex> guard(file_lock);
+  for (auto& buffer : buffers) flush(*buffer);
+  fclose(file);
+  file = nullptr;
+}
+
+void initialize()
+{
+  if (extract_env("LEGATE_MAPPING_TRACE", 0, 0) == 0) return;
+
+  const auto node = Legion::Processor::get_executing_processor().address_space();
+
+  // Every node writes its own file, even when they share the file system
+  std::string filename;
+  const char* env = getenv("LEGATE_MAPPING_TRACE_FILE");
+  if (env != nullptr)
+    filename = std::string(env) + "." + std::to_string(node);
+  else
+    filename = "legate_mapping." + std::to_string(getpid()) + ".bin";
+
+  file = fopen(filename.c_str(), "wb");
+  if (nullptr == file) {
+    log_legate.error("Failed to open %s to write the mapping trace", filename.c_str());
+    return;
+  }
+
+  Header header;
+  std::copy(std::begin(MAGIC), std::end(MAGIC), header.magic);
+  header.version    = VERSION;
+  header.event_size = sizeof(Event);
+  header.node       = node;
+  fwrite(&header, sizeof(Header), 1, file);
+  enabled = true;
+
+  // Core::shutdown runs while the mappers may still be mapping the last operations, so the
+  // trace is flushed only once the process exits
+  std::atexit(finalize);
+}
+
+void record(EventKind kind,
+            uint64_t operation,
+            uint64_t resource,
+            uint64_t instance,
+            uint64_t value,
+            uint32_t extra)
+{
+  auto& buffer = get_local_buffer();
+  buffer.push_back(Event{Realm::Clock::current_time_in_nanoseconds(),
+                         operation,
+                         resource,
+                         instance,
+                         value,
+                         kind,
+                         extra});
+  if (buffer.size() < BUFFER_CAPACITY) return;
+  std::lock_guard<std::mutex> guard(file_lock);
+  flush(buffer);
+}
+
+}  // namespace mapping_trace
+}  // namespace legate
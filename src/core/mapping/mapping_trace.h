@@ -0,0 +1,75 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace legate {
+namespace mapping_trace {
+
+// Setting LEGATE_MAPPING_TRACE to a positive value makes the mappers record their decisions as
+// fixed-size binary events, which are written to LEGATE_MAPPING_TRACE_FILE.<node>
+// (legate_mapping.<pid>.bin by default). Each thread buffers its events, so recording an event
+// takes no lock until the buffer is full. The buffers are flushed when the process exits, after
+// the Legion runtime has shut down and the mappers have stopped recording events.
+// legate/util/mapping_trace.py reads the files.
+void initialize();
+
+extern std::atomic<bool> enabled;
+
+// Must match the event kinds in legate/util/mapping_trace.py
+enum class EventKind : uint32_t {
+  INSTANCE_CREATED = 0,
+  INSTANCE_REUSED  = 1,
+  INSTANCE_FAILED  = 2,
+  INSTANCE_EVICTED = 3,
+  SOURCE_SELECTED  = 4,
+  TASK_SLICED      = 5,
+  VARIANT_SELECTED = 6,
+};
+
+// The meaning of the fields depends on the kind:
+//
+//   kind              resource            instance         value            extra
+//   INSTANCE_CREATED  memory              instance         size in bytes    requirement index
+//   INSTANCE_REUSED   memory              instance         size in bytes    requirement index
+//   INSTANCE_FAILED   memory              -                -                requirement index
+//   INSTANCE_EVICTED  memory              instance         size in bytes    -
+//   SOURCE_SELECTED   target memory       source instance  source memory    number of sources
+//   TASK_SLICED       processor           -                point index      task id
+//   VARIANT_SELECTED  processor           -                task id          variant id
+struct Event {
+  uint64_t time;
+  uint64_t operation;
+  uint64_t resource;
+  uint64_t instance;
+  uint64_t value;
+  EventKind kind;
+  uint32_t extra;
+};
+static_assert(sizeof(Event) == 48, "Event must have no padding");
+
+void record(EventKind kind,
+            uint64_t operation,
+            uint64_t resource,
+            uint64_t instance,
+            uint64_t value,
+            uint32_t extra);
+
+}  // namespace mapping_trace
+}  // namespace legate
@@ -0,0 +1,101 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <limits>
+
+#include "core/mapping/variant_tuner.h"
+
+namespace legate {
+namespace mapping {
+
+// Samples older than this many launches fade out of the averages, so that the tuner can follow
+// changes in the machine load
+static constexpr uint64_t MAX_AVERAGE_WINDOW = 16;
+
+VariantTuner::VariantTuner(uint32_t warmup) : warmup_(warmup) {}
+
+/*static*/ uint32_t VariantTuner::size_bucket(size_t bytes)
+{
+  uint32_t bucket = 0;
+  while (bytes > 1) {
+    bytes >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+TaskTarget VariantTuner::select_target(Legion::TaskID task_id,
+                                       size_t bytes,
+                                       const std::vector<TaskTarget>& options,
+                                       const std::vector<double>& penalties,
+                                       TaskTarget fallback)
+{
+#ifdef DEBUG_LEGATE
+  assert(options.size() == penalties.size());
+#endif
+  auto bucket = size_bucket(bytes);
+
+  auto get_stats = [&](TaskTarget target) {
+    auto finder = stats_.find(Key(task_id, bucket, target));
+    return finder != stats_.end() ? finder->second : Stats{};
+  };
+
+  // During the warm-up, we try the target with the fewest samples, starting from the fallback
+  TaskTarget result  = fallback;
+  uint64_t min_count = get_stats(fallback).count;
+  for (auto& option : options) {
+    auto count = get_stats(option).count;
+    if (count < min_count) {
+      result    = option;
+      min_count = count;
+    }
+  }
+  if (min_count < warmup_) return result;
+
+  double min_cost = std::numeric_limits<double>::max();
+  for (uint32_t idx = 0; idx < options.size(); ++idx) {
+    double cost = get_stats(options[idx]).average_ns + penalties[idx];
+    if (cost < min_cost) {
+      result   = options[idx];
+      min_cost = cost;
+    }
+  }
+  return result;
+}
+
+void VariantTuner::record(Legion::TaskID task_id,
+                          size_t bytes,
+                          TaskTarget target,
+                          double elapsed_ns)
+{
+  auto& stats = stats_[Key(task_id, size_bucket(bytes), target)];
+  stats.count++;
+  auto weight = static_cast<double>(std::min(stats.count, MAX_AVERAGE_WINDOW));
+  stats.average_ns += (elapsed_ns - stats.average_ns) / weight;
+}
+
+std::optional<double> VariantTuner::average_time(Legion::TaskID task_id,
+                                                 size_t bytes,
+                                                 TaskTarget target) const
+{
+  auto finder = stats_.find(Key(task_id, size_bucket(bytes), target));
+  if (finder == stats_.end()) return std::nullopt;
+  return finder->second.average_ns;
+}
+
+}  // namespace mapping
+}  // namespace legate
@@ -0,0 +1,68 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <map>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#include "legion.h"
+
+#include "core/mapping/mapping.h"
+
+namespace legate {
+namespace mapping {
+
+// Records the execution times of tasks for each processor kind and size of the data they
+// access, and picks the kind that ran the fastest once every kind has been tried a few times
+class VariantTuner {
+ public:
+  VariantTuner(uint32_t warmup);
+
+ public:
+  // Returns the target to use for a task whose points access the given number of bytes, or
+  // `fallback` if the tuner hasn't seen enough launches to decide. `penalties` are the
+  // estimated times in nanoseconds to move the data to where each of the `options` needs it.
+  TaskTarget select_target(Legion::TaskID task_id,
+                           size_t bytes,
+                           const std::vector<TaskTarget>& options,
+                           const std::vector<double>& penalties,
+                           TaskTarget fallback);
+  void record(Legion::TaskID task_id, size_t bytes, TaskTarget target, double elapsed_ns);
+  // Returns the average time in nanoseconds the task took on the target for data of this size,
+  // if it ran there before
+  std::optional<double> average_time(Legion::TaskID task_id,
+                                     size_t bytes,
+                                     TaskTarget target) const;
+
+ private:
+  // Sizes are bucketed by their powers of two
+  static uint32_t size_bucket(size_t bytes);
+
+ private:
+  struct Stats {
+    uint64_t count{0};
+    double average_ns{0.0};
+  };
+  using Key = std::tuple<Legion::TaskID, uint32_t, TaskTarget>;
+  const uint32_t warmup_;
+  std::map<Key, Stats> stats_;
+};
+
+}  // namespace mapping
+}  // namespace legate
@@ -23,6 +23,8 @@
 #include "core/runtime/context.h"
 #include "core/runtime/runtime.h"
 #include "core/utilities/deserializer.h"
+#include "core/utilities/machine.h"
+#include "core/utilities/trace.h"
 
 #ifdef LEGATE_USE_CUDA
 #include "core/cuda/cuda_help.h"
@@ -163,6 +165,7 @@ TaskContext::TaskContext(const Legion::Task* task,
                          Legion::Runtime* runtime)
   : task_(task), regions_(regions), context_(context), runtime_(runtime)
 {
+  trace::Range auto_range("legate::deserialize");
   TaskDeserializer dez(task, regions);
   inputs_     = dez.unpack<std::vector<Store>>();
   outputs_    = dez.unpack<std::vector<Store>>();
@@ -170,6 +173,7 @@ TaskContext::TaskContext(const Legion::Task* task,
   scalars_    = dez.unpack<std::vector<Scalar>>();
 
   can_raise_exception_ = dez.unpack<bool>();
+  reports_time_        = dez.unpack<bool>();
 
   bool insert_barrier = false;
   Legion::PhaseBarrier arrival, wait;
@@ -212,6 +216,24 @@ TaskContext::TaskContext(const Legion::Task* task,
 #endif
 }
 
+TaskContext::TaskContext(const TaskContext& parent,
+                         std::vector<Store>&& inputs,
+                         std::vector<Store>&& outputs,
+                         std::vector<Store>&& reductions,
+                         std::vector<Scalar>&& scalars)
+  : task_(parent.task_),
+    regions_(parent.regions_),
+    context_(parent.context_),
+    runtime_(parent.runtime_),
+    inputs_(std::move(inputs)),
+    outputs_(std::move(outputs)),
+    reductions_(std::move(reductions)),
+    scalars_(std::move(scalars)),
+    can_raise_exception_(false),
+    reports_time_(false)
+{
+}
+
 bool TaskContext::is_single_task() const { return !task_->is_index_space; }
 
 Legion::DomainPoint TaskContext::get_task_index() const { return task_->index_point; }
@@ -231,6 +253,7 @@ ReturnValues TaskContext::pack_return_values() const
     ReturnedException exn{};
     return_values.push_back(exn.pack());
   }
+  if (reports_time_) return_values.push_back(pack_elapsed_time());
   return ReturnValues(std::move(return_values));
 }
 
@@ -242,9 +265,21 @@ ReturnValues TaskContext::pack_return_values_with_exception(int32_t index,
     ReturnedException exn(index, error_message);
     return_values.push_back(exn.pack());
   }
+  if (reports_time_) return_values.push_back(pack_elapsed_time());
   return ReturnValues(std::move(return_values));
 }
 
+ReturnValue TaskContext::pack_elapsed_time() const
+{
+  auto mem_kind = find_memory_kind_for_executing_processor();
+  auto buffer   = Legion::UntypedDeferredValue(sizeof(uint64_t), mem_kind);
+
+  AccessorWO<uint64_t, 1> acc(buffer, sizeof(uint64_t), false);
+  acc[0] = elapsed_ns_;
+
+  return ReturnValue(buffer, sizeof(uint64_t));
+}
+
 std::vector<ReturnValue> TaskContext::get_return_values() const
 {
   size_t num_unbound_outputs = 0;
@@ -122,6 +122,13 @@ class TaskContext {
               const std::vector<Legion::PhysicalRegion>& regions,
               Legion::Context context,
               Legion::Runtime* runtime);
+  // Creates a context for a sub-task of the fused task whose context is `parent`. The sub-task
+  // takes the stores and scalars given to it, which the fused task moves in and out.
+  TaskContext(const TaskContext& parent,
+              std::vector<Store>&& inputs,
+              std::vector<Store>&& outputs,
+              std::vector<Store>&& reductions,
+              std::vector<Scalar>&& scalars);
 
  public:
   std::vector<Store>& inputs() { return inputs_; }
@@ -133,17 +140,22 @@ class TaskContext {
  public:
   bool is_single_task() const;
   bool can_raise_exception() const { return can_raise_exception_; }
+  bool reports_time() const { return reports_time_; }
   Legion::DomainPoint get_task_index() const;
   Legion::Domain get_launch_domain() const;
 
  public:
   void make_all_unbound_stores_empty();
+  // Records the time the task body took, which is returned with the other values when the task
+  // reports its time
+  void record_elapsed_time(uint64_t elapsed_ns) { elapsed_ns_ = elapsed_ns; }
   ReturnValues pack_return_values() const;
   ReturnValues pack_return_values_with_exception(int32_t index,
                                                  const std::string& error_message) const;
 
  private:
   std::vector<ReturnValue> get_return_values() const;
+  ReturnValue pack_elapsed_time() const;
 
  private:
   const Legion::Task* task_;
@@ -156,6 +168,8 @@ class TaskContext {
   std::vector<Scalar> scalars_;
   std::vector<comm::Communicator> comms_;
   bool can_raise_exception_;
+  bool reports_time_;
+  uint64_t elapsed_ns_{0};
 };
 
 }  // namespace legate
@@ -0,0 +1,331 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+
+#include "core/runtime/launcher.h"
+#include "core/runtime/context.h"
+#include "core/utilities/buffer_builder.h"
+#include "core/utilities/dispatch.h"
+#include "legate_defines.h"
+
+namespace legate {
+
+struct type_size_fn {
+  template <LegateTypeCode CODE>
+  int32_t operator()()
+  {
+    return static_cast<int32_t>(sizeof(legate_type_of<CODE>));
+  }
+};
+
+// Privileges of a field are derived from the root region, as the Python launcher does
+static Legion::LogicalRegion find_root(Legion::Runtime* runtime, Legion::LogicalRegion region)
+{
+  while (runtime->has_parent_logical_partition(region))
+    region = runtime->get_parent_logical_region(runtime->get_parent_logical_partition(region));
+  return region;
+}
+
+TaskLauncher::TaskLauncher(const LibraryContext& library,
+                           int64_t task_id,
+                           int64_t mapper_id,
+                           Legion::MappingTagID tag)
+  : TaskLauncher(library.get_task_id(task_id), library.get_mapper_id(mapper_id), tag)
+{
+}
+
+TaskLauncher::TaskLauncher(Legion::TaskID legion_task_id,
+                           Legion::MapperID legion_mapper_id,
+                           Legion::MappingTagID tag)
+  : task_id_(legion_task_id), mapper_id_(legion_mapper_id), tag_(tag)
+{
+}
+
+void TaskLauncher::add_input(const RegionStore& store)
+{
+  add_store(inputs_, store, LEGION_READ_ONLY, -1);
+}
+
+void TaskLauncher::add_output(const RegionStore& store)
+{
+  add_store(outputs_, store, LEGION_WRITE_DISCARD, -1);
+}
+
+void TaskLauncher::add_reduction(const RegionStore& store,
+                                 Legion::ReductionOpID redop,
+                                 bool read_write /*= false*/)
+{
+  add_store(reductions_, store, read_write ? LEGION_READ_WRITE : LEGION_REDUCE, redop);
+}
+
+void TaskLauncher::add_input(const FutureStore& store)
+{
+  add_store(inputs_, store, true /*read_only*/, -1);
+}
+
+void TaskLauncher::add_output(const FutureStore& store)
+{
+  add_store(outputs_, store, false /*read_only*/, -1);
+}
+
+void TaskLauncher::add_reduction(const FutureStore& store, Legion::ReductionOpID redop)
+{
+  add_store(reductions_, store, false /*read_only*/, redop);
+}
+
+void TaskLauncher::add_scalar(const Scalar& scalar) { scalars_.push_back(scalar); }
+
+void TaskLauncher::set_can_raise_exception(bool can_raise_exception)
+{
+  can_raise_exception_ = can_raise_exception;
+}
+
+void TaskLauncher::set_reports_time(bool reports_time) { reports_time_ = reports_time; }
+
+void TaskLauncher::set_side_effect(bool has_side_effect) { has_side_effect_ = has_side_effect; }
+
+void TaskLauncher::set_provenance(const std::string& provenance) { provenance_ = provenance; }
+
+void TaskLauncher::add_store(std::vector<StoreArg>& args,
+                             const RegionStore& store,
+                             Legion::PrivilegeMode privilege,
+                             int32_t redop)
+{
+  StoreArg arg;
+  arg.is_future  = false;
+  arg.dim        = store.region.get_dim();
+  arg.code       = store.code;
+  arg.redop      = redop;
+  arg.region     = store.region;
+  arg.field_id   = store.field_id;
+  arg.projection = Projection{store.partition, store.proj, store.tag, store.flags};
+  arg.privilege  = privilege;
+  arg.read_only  = privilege == LEGION_READ_ONLY;
+  args.push_back(std::move(arg));
+}
+
+void TaskLauncher::add_store(std::vector<StoreArg>& args,
+                             const FutureStore& store,
+                             bool read_only,
+                             int32_t redop)
+{
+  StoreArg arg;
+  arg.is_future = true;
+  arg.dim       = static_cast<int32_t>(store.extents.size());
+  arg.code      = store.code;
+  arg.redop     = redop;
+  arg.future    = store.future;
+  arg.read_only = read_only;
+  arg.extents   = store.extents;
+  args.push_back(std::move(arg));
+}
+
+void TaskLauncher::analyze_requirements()
+{
+  requirements_.clear();
+  requirement_indices_.clear();
+
+  // Gather the accesses to each field, keeping the fields in the order they first appear
+  using FieldKey = std::pair<Legion::LogicalRegion, Legion::FieldID>;
+  std::vector<FieldKey> fields;
+  std::map<FieldKey, std::vector<const StoreArg*>> accesses;
+  for (auto* args : {&inputs_, &outputs_, &reductions_})
+    for (auto& arg : *args) {
+      if (arg.is_future) continue;
+      FieldKey key{arg.region, arg.field_id};
+      auto& field_accesses = accesses[key];
+      if (field_accesses.empty()) fields.push_back(key);
+      field_accesses.push_back(&arg);
+    }
+
+  std::map<std::tuple<Legion::LogicalRegion, Projection, Legion::PrivilegeMode, int32_t>, uint32_t>
+    requirement_map;
+  auto add_field = [&](const StoreArg& arg, Legion::PrivilegeMode privilege, int32_t redop) {
+    auto key    = std::make_tuple(arg.region, arg.projection, privilege, redop);
+    auto finder = requirement_map.find(key);
+    uint32_t req_idx;
+    if (finder == requirement_map.end()) {
+      req_idx = static_cast<uint32_t>(requirements_.size());
+      requirements_.push_back(Requirement{arg.region, arg.projection, privilege, redop, {}});
+      requirement_map[key] = req_idx;
+    } else
+      req_idx = finder->second;
+    auto& fields = requirements_[req_idx].fields;
+    if (std::find(fields.begin(), fields.end(), arg.field_id) == fields.end())
+      fields.push_back(arg.field_id);
+    requirement_indices_[std::make_tuple(arg.region, arg.field_id, arg.projection)] = req_idx;
+  };
+
+  for (auto& key : fields) {
+    auto& field_accesses = accesses[key];
+    auto& first          = *field_accesses.front();
+
+    bool same_projection = true;
+    bool same_privilege  = true;
+    for (auto* arg : field_accesses) {
+      same_projection = same_projection && arg->projection == first.projection;
+      same_privilege  = same_privilege && arg->privilege == first.privilege &&
+                       arg->redop == first.redop;
+    }
+
+    if (same_privilege && (same_projection || first.privilege == LEGION_READ_ONLY)) {
+      // Reads can go through different projections, as they never interfere
+      for (auto* arg : field_accesses) add_field(*arg, arg->privilege, arg->redop);
+    } else if (same_projection) {
+      // Conflicting privileges on the same field are promoted to read-write
+      for (auto* arg : field_accesses) add_field(*arg, LEGION_READ_WRITE, -1);
+    } else {
+      log_legate.error("Interfering requirements found on field %u of a region",
+                       static_cast<uint32_t>(key.second));
+      LEGATE_ABORT;
+    }
+  }
+}
+
+uint32_t TaskLauncher::find_requirement_index(const StoreArg& arg) const
+{
+  auto finder =
+    requirement_indices_.find(std::make_tuple(arg.region, arg.field_id, arg.projection));
+#ifdef DEBUG_LEGATE
+  assert(finder != requirement_indices_.end());
+#endif
+  return finder->second;
+}
+
+void TaskLauncher::pack_args(BufferBuilder& buffer, const std::vector<StoreArg>& args) const
+{
+  buffer.pack<uint32_t>(static_cast<uint32_t>(args.size()));
+  for (auto& arg : args) {
+    buffer.pack<bool>(arg.is_future);
+    buffer.pack<bool>(false /*is_output_region*/);
+    buffer.pack<int32_t>(arg.dim);
+    buffer.pack(arg.code);
+    // Stores are always passed without transformations
+    buffer.pack<int32_t>(-1);
+    buffer.pack<int32_t>(arg.redop);
+    if (arg.is_future) {
+      buffer.pack<bool>(arg.read_only);
+      buffer.pack<bool>(arg.future.exists());
+      buffer.pack<int32_t>(type_dispatch(arg.code, type_size_fn{}));
+      buffer.pack(arg.extents);
+    } else {
+      buffer.pack<int32_t>(arg.dim);
+      buffer.pack<uint32_t>(find_requirement_index(arg));
+      buffer.pack<uint32_t>(arg.field_id);
+    }
+  }
+}
+
+void TaskLauncher::pack_common_args(BufferBuilder& buffer) const
+{
+  pack_args(buffer, inputs_);
+  pack_args(buffer, outputs_);
+  pack_args(buffer, reductions_);
+  buffer.pack(scalars_);
+  buffer.pack<bool>(can_raise_exception_);
+  buffer.pack<bool>(reports_time_);
+}
+
+std::vector<Legion::RegionRequirement> TaskLauncher::create_requirements(Legion::Runtime* runtime,
+                                                                         bool index_launch) const
+{
+  std::vector<Legion::RegionRequirement> result;
+  for (auto& req : requirements_) {
+    auto parent         = find_root(runtime, req.region);
+    auto& proj          = req.projection;
+    bool use_projection = index_launch && proj.partition != Legion::LogicalPartition::NO_PART;
+    if (req.privilege == LEGION_REDUCE) {
+      if (use_projection)
+        result.emplace_back(
+          proj.partition, proj.proj, req.redop, LEGION_EXCLUSIVE, parent, proj.tag);
+      else if (index_launch)
+        result.emplace_back(req.region, 0, req.redop, LEGION_EXCLUSIVE, parent, proj.tag);
+      else
+        result.emplace_back(req.region, req.redop, LEGION_EXCLUSIVE, parent, proj.tag);
+    } else {
+      if (use_projection)
+        result.emplace_back(
+          proj.partition, proj.proj, req.privilege, LEGION_EXCLUSIVE, parent, proj.tag);
+      else if (index_launch)
+        result.emplace_back(req.region, 0, req.privilege, LEGION_EXCLUSIVE, parent, proj.tag);
+      else
+        result.emplace_back(req.region, req.privilege, LEGION_EXCLUSIVE, parent, proj.tag);
+    }
+    auto& requirement = result.back();
+    requirement.add_fields(req.fields);
+    if (proj.flags != LEGION_NO_FLAG) requirement.add_flags(proj.flags);
+  }
+  return result;
+}
+
+std::vector<Legion::Future> TaskLauncher::collect_futures() const
+{
+  // Futures are consumed in the order the task unpacks the stores
+  std::vector<Legion::Future> futures;
+  for (auto* args : {&inputs_, &outputs_, &reductions_})
+    for (auto& arg : *args)
+      if (arg.is_future && arg.future.exists()) futures.push_back(arg.future);
+  return futures;
+}
+
+Legion::Future TaskLauncher::execute_single(Legion::Runtime* runtime, Legion::Context ctx)
+{
+  analyze_requirements();
+
+  BufferBuilder buffer;
+  pack_common_args(buffer);
+
+  Legion::TaskLauncher launcher(
+    task_id_, buffer.to_legion_buffer(), Legion::Predicate::TRUE_PRED, mapper_id_, tag_);
+  for (auto& req : create_requirements(runtime, false /*index_launch*/))
+    launcher.add_region_requirement(req);
+  for (auto& future : collect_futures()) launcher.add_future(future);
+  launcher.local_function_task = !has_side_effect_ && requirements_.empty();
+  launcher.provenance          = provenance_;
+
+  return runtime->execute_task(ctx, launcher);
+}
+
+Legion::FutureMap TaskLauncher::execute(Legion::Runtime* runtime,
+                                        Legion::Context ctx,
+                                        const Legion::Domain& launch_domain)
+{
+  analyze_requirements();
+
+  BufferBuilder buffer;
+  pack_common_args(buffer);
+  // Native launches never insert barriers or use communicators
+  buffer.pack<bool>(false /*insert_barrier*/);
+  buffer.pack<uint32_t>(0 /*num_communicators*/);
+
+  Legion::IndexTaskLauncher launcher(task_id_,
+                                     launch_domain,
+                                     buffer.to_legion_buffer(),
+                                     Legion::ArgumentMap(),
+                                     Legion::Predicate::TRUE_PRED,
+                                     false /*must*/,
+                                     mapper_id_,
+                                     tag_);
+  for (auto& req : create_requirements(runtime, true /*index_launch*/))
+    launcher.add_region_requirement(req);
+  for (auto& future : collect_futures()) launcher.add_future(future);
+  launcher.provenance = provenance_;
+
+  return runtime->execute_index_space(ctx, launcher);
+}
+
+}  // namespace legate
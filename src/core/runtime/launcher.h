@@ -0,0 +1,160 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "legion.h"
+
+#include "core/data/scalar.h"
+#include "core/utilities/typedefs.h"
+
+namespace legate {
+
+class BufferBuilder;
+class LibraryContext;
+
+// Launches Legate tasks from native code. The launcher serializes the task arguments in the
+// format TaskDeserializer expects, so tasks can't tell it apart from the Python launcher.
+// Stores are passed to tasks without transformations.
+class TaskLauncher {
+ public:
+  // A store backed by a field of a region. Index launches pass each point the subregion that
+  // the projection functor `proj` picks from `partition`, or the whole region when there is
+  // no partition.
+  struct RegionStore {
+    Legion::LogicalRegion region;
+    Legion::FieldID field_id;
+    LegateTypeCode code;
+    Legion::LogicalPartition partition{Legion::LogicalPartition::NO_PART};
+    Legion::ProjectionID proj{0};
+    Legion::MappingTagID tag{0};
+    Legion::RegionFlags flags{LEGION_NO_FLAG};
+  };
+  // A store backed by a future. The future can be empty if the task only writes to the store.
+  struct FutureStore {
+    Legion::Future future;
+    LegateTypeCode code;
+    std::vector<int64_t> extents;
+  };
+
+ public:
+  TaskLauncher(const LibraryContext& library,
+               int64_t task_id,
+               int64_t mapper_id       = 0,
+               Legion::MappingTagID tag = 0);
+  TaskLauncher(Legion::TaskID legion_task_id,
+               Legion::MapperID legion_mapper_id,
+               Legion::MappingTagID tag = 0);
+
+ public:
+  void add_input(const RegionStore& store);
+  void add_output(const RegionStore& store);
+  void add_reduction(const RegionStore& store,
+                     Legion::ReductionOpID redop,
+                     bool read_write = false);
+  void add_input(const FutureStore& store);
+  void add_output(const FutureStore& store);
+  void add_reduction(const FutureStore& store, Legion::ReductionOpID redop);
+  void add_scalar(const Scalar& scalar);
+
+ public:
+  void set_can_raise_exception(bool can_raise_exception);
+  void set_reports_time(bool reports_time);
+  void set_side_effect(bool has_side_effect);
+  void set_provenance(const std::string& provenance);
+
+ public:
+  Legion::Future execute_single(Legion::Runtime* runtime, Legion::Context ctx);
+  Legion::FutureMap execute(Legion::Runtime* runtime,
+                            Legion::Context ctx,
+                            const Legion::Domain& launch_domain);
+
+ private:
+  struct Projection {
+    Legion::LogicalPartition partition;
+    Legion::ProjectionID proj;
+    Legion::MappingTagID tag;
+    Legion::RegionFlags flags;
+
+    auto key() const { return std::make_tuple(partition, proj, tag, flags); }
+    bool operator<(const Projection& other) const { return key() < other.key(); }
+    bool operator==(const Projection& other) const { return key() == other.key(); }
+  };
+  struct StoreArg {
+    bool is_future;
+    int32_t dim;
+    LegateTypeCode code;
+    int32_t redop;
+    // Only for stores backed by region fields
+    Legion::LogicalRegion region;
+    Legion::FieldID field_id;
+    Projection projection;
+    Legion::PrivilegeMode privilege;
+    // Only for stores backed by futures
+    Legion::Future future;
+    bool read_only;
+    std::vector<int64_t> extents;
+  };
+  struct Requirement {
+    Legion::LogicalRegion region;
+    Projection projection;
+    Legion::PrivilegeMode privilege;
+    int32_t redop;
+    std::vector<Legion::FieldID> fields;
+  };
+
+ private:
+  void add_store(std::vector<StoreArg>& args,
+                 const RegionStore& store,
+                 Legion::PrivilegeMode privilege,
+                 int32_t redop);
+  void add_store(std::vector<StoreArg>& args,
+                 const FutureStore& store,
+                 bool read_only,
+                 int32_t redop);
+  void analyze_requirements();
+  uint32_t find_requirement_index(const StoreArg& arg) const;
+  void pack_args(BufferBuilder& buffer, const std::vector<StoreArg>& args) const;
+  void pack_common_args(BufferBuilder& buffer) const;
+  std::vector<Legion::RegionRequirement> create_requirements(Legion::Runtime* runtime,
+                                                             bool index_launch) const;
+  std::vector<Legion::Future> collect_futures() const;
+
+ private:
+  Legion::TaskID task_id_;
+  Legion::MapperID mapper_id_;
+  Legion::MappingTagID tag_;
+  std::vector<StoreArg> inputs_;
+  std::vector<StoreArg> outputs_;
+  std::vector<StoreArg> reductions_;
+  std::vector<Scalar> scalars_;
+  bool can_raise_exception_{false};
+  bool reports_time_{false};
+  bool has_side_effect_{false};
+  std::string provenance_;
+
+ private:
+  std::vector<Requirement> requirements_;
+  std::map<std::tuple<Legion::LogicalRegion, Legion::FieldID, Projection>, uint32_t>
+    requirement_indices_;
+};
+
+}  // namespace legate
@@ -14,6 +14,7 @@
  *
  */
 
+#include <map>
 #include <mutex>
 #include <numeric>
 #include <sstream>
@@ -40,32 +41,56 @@ class DelinearizationFunctor : public ProjectionFunctor {
   virtual bool is_functional(void) const { return true; }
   virtual bool is_exclusive(void) const { return true; }
   virtual unsigned get_depth(void) const { return 0; }
+
+ private:
+  struct Strides {
+    int32_t dim;
+    int64_t values[LEGION_MAX_DIM];
+  };
+  const Strides& find_or_create_strides(Legion::IndexPartition partition);
+
+ private:
+  // Color spaces of partitions never change, so their strides can be cached for good. The
+  // functor is exclusive, so Legion never calls it concurrently and the cache needs no lock.
+  std::map<Legion::IndexPartition, Strides> strides_cache_;
 };
 
 DelinearizationFunctor::DelinearizationFunctor(Runtime* runtime) : ProjectionFunctor(runtime) {}
 
-LogicalRegion DelinearizationFunctor::project(LogicalPartition upper_bound,
-                                              const DomainPoint& point,
-                                              const Domain& launch_domain)
+const DelinearizationFunctor::Strides& DelinearizationFunctor::find_or_create_strides(
+  IndexPartition partition)
 {
-  const auto color_space =
-    runtime->get_index_partition_color_space(upper_bound.get_index_partition());
+  auto finder = strides_cache_.find(partition);
+  if (finder != strides_cache_.end()) return finder->second;
 
+  const auto color_space = runtime->get_index_partition_color_space(partition);
   assert(color_space.dense());
-  assert(point.dim == 1);
 
-  std::vector<int64_t> strides(color_space.dim, 1);
+  Strides strides;
+  strides.dim                         = color_space.dim;
+  strides.values[color_space.dim - 1] = 1;
   for (int32_t dim = color_space.dim - 1; dim > 0; --dim) {
     auto extent = color_space.rect_data[dim + color_space.dim] - color_space.rect_data[dim] + 1;
-    strides[dim - 1] = strides[dim] * extent;
+    strides.values[dim - 1] = strides.values[dim] * extent;
   }
+  // std::map never moves its elements, so the reference stays valid as the cache grows
+  return strides_cache_.emplace(partition, strides).first->second;
+}
+
+LogicalRegion DelinearizationFunctor::project(LogicalPartition upper_bound,
+                                              const DomainPoint& point,
+                                              const Domain& launch_domain)
+{
+  assert(point.dim == 1);
+
+  const auto& strides = find_or_create_strides(upper_bound.get_index_partition());
 
   DomainPoint delinearized;
-  delinearized.dim = color_space.dim;
+  delinearized.dim = strides.dim;
   int64_t value    = point[0];
-  for (int32_t dim = 0; dim < color_space.dim; ++dim) {
-    delinearized[dim] = value / strides[dim];
-    value             = value % strides[dim];
+  for (int32_t dim = 0; dim < strides.dim; ++dim) {
+    delinearized[dim] = value / strides.values[dim];
+    value             = value % strides.values[dim];
   }
 
   if (runtime->has_logical_subregion_by_color(upper_bound, delinearized))
@@ -87,6 +112,53 @@ LogicalRegion LegateProjectionFunctor::project(LogicalPartition upper_bound,
     return LogicalRegion::NO_REGION;
 }
 
+// Adds a constant offset to every point: the identity projection with an offset
+template <int32_t DIM>
+class ShiftFunctor : public LegateProjectionFunctor {
+ public:
+  ShiftFunctor(Runtime* runtime, int32_t* offsets) : LegateProjectionFunctor(runtime)
+  {
+    for (int32_t dim = 0; dim < DIM; ++dim) offsets_[dim] = offsets[dim];
+  }
+
+ public:
+  DomainPoint project_point(const DomainPoint& point, const Domain& launch_domain) const override
+  {
+    return DomainPoint(Point<DIM>(point) + offsets_);
+  }
+
+ private:
+  Point<DIM> offsets_;
+};
+
+// Each target coordinate is a source coordinate plus an offset, or a constant when the
+// target dimension is broadcast. This covers permutations and dimension drops.
+template <int32_t SRC_DIM, int32_t TGT_DIM>
+class SelectionFunctor : public LegateProjectionFunctor {
+ public:
+  SelectionFunctor(Runtime* runtime, int32_t* dims, int32_t* offsets)
+    : LegateProjectionFunctor(runtime)
+  {
+    for (int32_t dim = 0; dim < TGT_DIM; ++dim) {
+      dims_[dim]    = dims[dim];
+      offsets_[dim] = offsets[dim];
+    }
+  }
+
+ public:
+  DomainPoint project_point(const DomainPoint& point, const Domain& launch_domain) const override
+  {
+    Point<TGT_DIM> result = offsets_;
+    for (int32_t dim = 0; dim < TGT_DIM; ++dim)
+      if (dims_[dim] != -1) result[dim] += point[dims_[dim]];
+    return DomainPoint(result);
+  }
+
+ private:
+  int32_t dims_[TGT_DIM];
+  Point<TGT_DIM> offsets_;
+};
+
 template <int32_t SRC_DIM, int32_t TGT_DIM>
 class AffineFunctor : public LegateProjectionFunctor {
  public:
@@ -111,7 +183,8 @@ AffineFunctor<SRC_DIM, TGT_DIM>::AffineFunctor(Runtime* runtime,
                                                int32_t* dims,
                                                int32_t* weights,
                                                int32_t* offsets)
-  : LegateProjectionFunctor(runtime), transform_(create_transform(dims, weights))
+  : LegateProjectionFunctor(runtime),
+    transform_(create_transform(dims, weights))
 {
   for (int32_t dim = 0; dim < TGT_DIM; ++dim) offsets_[dim] = offsets[dim];
 }
@@ -146,11 +219,47 @@ static std::unordered_map<ProjectionID, LegateProjectionFunctor*> functor_table{
 static std::mutex functor_table_lock{};
 
 struct create_affine_functor_fn {
+  template <int32_t SRC_DIM, int32_t TGT_DIM>
+  static bool is_shift(const int32_t* dims, const int32_t* weights)
+  {
+    if (SRC_DIM != TGT_DIM) return false;
+    for (int32_t dim = 0; dim < TGT_DIM; ++dim)
+      if (dims[dim] != dim || weights[dim] != 1) return false;
+    return true;
+  }
+
+  template <int32_t SRC_DIM, int32_t TGT_DIM>
+  static bool is_selection(const int32_t* dims, const int32_t* weights)
+  {
+    for (int32_t dim = 0; dim < TGT_DIM; ++dim)
+      if (dims[dim] != -1 && weights[dim] != 1) return false;
+    return true;
+  }
+
+  template <int32_t SRC_DIM, int32_t TGT_DIM, std::enable_if_t<SRC_DIM == TGT_DIM>* = nullptr>
+  static LegateProjectionFunctor* create_shift_functor(Runtime* runtime, int32_t* offsets)
+  {
+    return new ShiftFunctor<TGT_DIM>(runtime, offsets);
+  }
+
+  template <int32_t SRC_DIM, int32_t TGT_DIM, std::enable_if_t<SRC_DIM != TGT_DIM>* = nullptr>
+  static LegateProjectionFunctor* create_shift_functor(Runtime* runtime, int32_t* offsets)
+  {
+    assert(false);
+    return nullptr;
+  }
+
   template <int32_t SRC_DIM, int32_t TGT_DIM>
   void operator()(
     Runtime* runtime, int32_t* dims, int32_t* weights, int32_t* offsets, ProjectionID proj_id)
   {
-    auto functor = new AffineFunctor<SRC_DIM, TGT_DIM>(runtime, dims, weights, offsets);
+    LegateProjectionFunctor* functor = nullptr;
+    if (is_shift<SRC_DIM, TGT_DIM>(dims, weights))
+      functor = create_shift_functor<SRC_DIM, TGT_DIM>(runtime, offsets);
+    else if (is_selection<SRC_DIM, TGT_DIM>(dims, weights))
+      functor = new SelectionFunctor<SRC_DIM, TGT_DIM>(runtime, dims, offsets);
+    else
+      functor = new AffineFunctor<SRC_DIM, TGT_DIM>(runtime, dims, weights, offsets);
     runtime->register_projection_functor(proj_id, functor, true /*silence warnings*/);
 
     const std::lock_guard<std::mutex> lock(functor_table_lock);
@@ -16,13 +16,16 @@
 
 #include "core/comm/comm.h"
 #include "core/mapping/core_mapper.h"
+#include "core/mapping/mapping_trace.h"
 #include "core/runtime/context.h"
 #include "core/runtime/projection.h"
 #include "core/runtime/shard.h"
 #include "core/task/exception.h"
 #include "core/task/task.h"
+#include "core/task/task_stats.h"
 #include "core/utilities/deserializer.h"
 #include "core/utilities/machine.h"
+#include "core/utilities/trace.h"
 #include "legate.h"
 
 namespace legate {
@@ -41,8 +44,18 @@ static const char* const core_library_name = "legate.core";
 
 /*static*/ bool Core::synchronize_stream_view = false;
 
+/*static*/ bool Core::async_stream_view = false;
+
 /*static*/ bool Core::log_mapping_decisions = false;
 
+/*static*/ bool Core::tiled_sharding = false;
+
+/*static*/ bool Core::morton_sharding = false;
+
+/*static*/ bool Core::task_stats = false;
+
+/*static*/ bool Core::skip_absent_variants = false;
+
 /*static*/ bool Core::has_socket_mem = false;
 
 /*static*/ void Core::parse_config(void)
@@ -82,7 +95,14 @@ static const char* const core_library_name = "legate.core";
   parse_variable("LEGATE_SHOW_PROGRESS", show_progress_requested);
   parse_variable("LEGATE_EMPTY_TASK", use_empty_task);
   parse_variable("LEGATE_SYNC_STREAM_VIEW", synchronize_stream_view);
+  parse_variable("LEGATE_ASYNC_STREAM_VIEW", async_stream_view);
   parse_variable("LEGATE_LOG_MAPPING", log_mapping_decisions);
+  parse_variable("LEGATE_TILED_SHARDING", tiled_sharding);
+  parse_variable("LEGATE_MORTON_SHARDING", morton_sharding);
+  parse_variable("LEGATE_TASK_STATS", task_stats);
+  parse_variable("LEGATE_SKIP_ABSENT_VARIANTS", skip_absent_variants);
+  trace::initialize();
+  mapping_trace::initialize();
 }
 
 static void extract_scalar_task(
@@ -107,7 +127,8 @@ static void extract_scalar_task(
 
 /*static*/ void Core::shutdown(void)
 {
-  // Nothing to do here yet...
+  trace::finalize();
+  if (task_stats) log_legate.print() << "Task statistics:\n" << TaskStats::summary();
 }
 
 /*static*/ void Core::show_progress(const Legion::Task* task,
@@ -194,10 +215,14 @@ extern void register_exception_reduction_op(Runtime* runtime, const LibraryConte
 
   register_legate_core_tasks(machine, runtime, context);
 
+  fusion::register_tasks(runtime, context);
+
   register_legate_core_mapper(machine, runtime, context);
 
   register_exception_reduction_op(runtime, context);
 
+  register_builtin_reduction_ops(context);
+
   register_legate_core_projection_functors(runtime, context);
 
   register_legate_core_sharding_functors(runtime, context);
@@ -42,7 +42,12 @@ class Core {
   static bool show_progress_requested;
   static bool use_empty_task;
   static bool synchronize_stream_view;
+  static bool async_stream_view;
   static bool log_mapping_decisions;
+  static bool tiled_sharding;
+  static bool morton_sharding;
+  static bool task_stats;
+  static bool skip_absent_variants;
   static bool has_socket_mem;
 };
 
@@ -14,8 +14,14 @@
  *
  */
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <list>
+#include <map>
+#include <memory>
 #include <mutex>
-#include <unordered_map>
 
 #include "legate.h"
 
@@ -27,8 +33,89 @@ using namespace Legion;
 
 namespace legate {
 
-static std::unordered_map<ProjectionID, ShardID> functor_id_table;
-static std::mutex functor_table_lock;
+// Maps projection functors to the sharding functors that go with them. Mappers look up this
+// table on every sharding decision, so lookups never take a lock. Registrations are rare and
+// serialized; they update entries in place with atomic stores, and when the table gets half
+// full they build a bigger copy and publish it with an atomic pointer swap. Retired tables
+// are kept alive, as readers may still be probing them.
+class FunctorIdTable {
+ private:
+  static constexpr uint64_t EMPTY          = std::numeric_limits<uint64_t>::max();
+  static constexpr size_t INITIAL_CAPACITY = 1024;
+
+  struct Table {
+    Table(size_t cap) : capacity(cap), slots(new std::atomic<uint64_t>[cap])
+    {
+      for (size_t idx = 0; idx < capacity; ++idx) slots[idx].store(EMPTY);
+    }
+    size_t capacity;
+    std::unique_ptr<std::atomic<uint64_t>[]> slots;
+  };
+
+ public:
+  FunctorIdTable()
+  {
+    tables_.push_back(std::make_unique<Table>(INITIAL_CAPACITY));
+    table_.store(tables_.back().get());
+  }
+
+ public:
+  ShardingID find(ProjectionID proj_id) const
+  {
+    auto table = table_.load(std::memory_order_acquire);
+    for (auto idx = hash(proj_id, table->capacity);; idx = (idx + 1) & (table->capacity - 1)) {
+      auto slot = table->slots[idx].load(std::memory_order_acquire);
+      if (slot == EMPTY) break;
+      if (key(slot) == proj_id) return value(slot);
+    }
+    log_legate.error("No sharding functor is registered for projection functor %u", proj_id);
+    LEGATE_ABORT;
+    return 0;
+  }
+
+  void insert(ProjectionID proj_id, ShardingID shard_id)
+  {
+    const std::lock_guard<std::mutex> lock(lock_);
+    auto table = table_.load(std::memory_order_relaxed);
+    if (!insert(table, proj_id, shard_id)) return;
+    if (2 * ++size_ <= table->capacity) return;
+
+    auto new_table = std::make_unique<Table>(2 * table->capacity);
+    for (size_t idx = 0; idx < table->capacity; ++idx) {
+      auto slot = table->slots[idx].load(std::memory_order_relaxed);
+      if (slot != EMPTY) insert(new_table.get(), key(slot), value(slot));
+    }
+    table_.store(new_table.get(), std::memory_order_release);
+    tables_.push_back(std::move(new_table));
+  }
+
+ private:
+  // Returns true if the projection functor didn't have an entry before
+  static bool insert(Table* table, ProjectionID proj_id, ShardingID shard_id)
+  {
+    auto entry = (static_cast<uint64_t>(proj_id) << 32) | shard_id;
+    for (auto idx = hash(proj_id, table->capacity);; idx = (idx + 1) & (table->capacity - 1)) {
+      auto slot = table->slots[idx].load(std::memory_order_relaxed);
+      if (slot != EMPTY && key(slot) != proj_id) continue;
+      table->slots[idx].store(entry, std::memory_order_release);
+      return slot == EMPTY;
+    }
+  }
+  static size_t hash(ProjectionID proj_id, size_t capacity)
+  {
+    return (static_cast<size_t>(proj_id) * 0x9E3779B97F4A7C15ULL >> 32) & (capacity - 1);
+  }
+  static ProjectionID key(uint64_t slot) { return static_cast<ProjectionID>(slot >> 32); }
+  static ShardingID value(uint64_t slot) { return static_cast<ShardingID>(slot & 0xFFFFFFFF); }
+
+ private:
+  std::atomic<Table*> table_;
+  std::vector<std::unique_ptr<Table>> tables_;
+  size_t size_{0};
+  std::mutex lock_;
+};
+
+static FunctorIdTable functor_id_table;
 
 class ToplevelTaskShardingFunctor : public ShardingFunctor {
  public:
@@ -80,6 +167,177 @@ class LinearizingShardingFunctor : public ShardingFunctor {
   }
 };
 
+// Blocks the launch domain into one N-D tile per shard. The shard count is factored into
+// primes, and each factor goes to the dimension whose tiles are currently the longest, which
+// keeps the tiles close to cubes and the surface between shards small.
+class TiledShardingFunctor : public ShardingFunctor {
+ public:
+  // When 'morton' is true, the tiles are numbered along a Morton curve instead of in
+  // row-major order, so shards with nearby IDs also own nearby tiles
+  TiledShardingFunctor(bool morton) : morton_(morton) {}
+
+ public:
+  virtual ShardID shard(const DomainPoint& p, const Domain& launch_space, const size_t total_shards)
+  {
+    auto layout = find_or_create_layout(launch_space, total_shards);
+    auto& grid  = layout->grid;
+    auto lo     = launch_space.lo();
+    auto hi     = launch_space.hi();
+    size_t idx  = 0;
+    for (int32_t dim = 0; dim < launch_space.dim; ++dim) {
+      int64_t extent = hi[dim] - lo[dim] + 1;
+      int64_t coord  = (p[dim] - lo[dim]) * grid[dim] / extent;
+      idx            = idx * grid[dim] + coord;
+    }
+    if (!morton_) return idx;
+    return layout->tile_to_shard[idx];
+  }
+
+  virtual bool is_invertible(void) const { return true; }
+
+  virtual void invert(ShardID shard,
+                      const Domain& shard_domain,
+                      const Domain& full_domain,
+                      const size_t total_shards,
+                      std::vector<DomainPoint>& points)
+  {
+    // Tiles are always computed on the full domain, and then clipped to the requested part
+    auto layout = find_or_create_layout(full_domain, total_shards);
+    auto& grid  = layout->grid;
+    auto lo     = full_domain.lo();
+    auto hi     = full_domain.hi();
+    auto sub_lo = shard_domain.lo();
+    auto sub_hi = shard_domain.hi();
+
+    size_t idx = morton_ ? layout->shard_to_tile[shard] : shard;
+
+    DomainPoint tile_lo = lo;
+    DomainPoint tile_hi = hi;
+    for (int32_t dim = full_domain.dim - 1; dim >= 0; --dim) {
+      int64_t coord  = idx % grid[dim];
+      int64_t extent = hi[dim] - lo[dim] + 1;
+      idx /= grid[dim];
+      // the tile owns the points whose tile coordinate computed in shard() is 'coord'
+      tile_lo[dim] = lo[dim] + (coord * extent + grid[dim] - 1) / grid[dim];
+      tile_hi[dim] = lo[dim] + ((coord + 1) * extent + grid[dim] - 1) / grid[dim] - 1;
+      tile_lo[dim] = std::max<coord_t>(tile_lo[dim], sub_lo[dim]);
+      tile_hi[dim] = std::min<coord_t>(tile_hi[dim], sub_hi[dim]);
+      if (tile_lo[dim] > tile_hi[dim]) return;
+    }
+    const bool filter = !shard_domain.dense();
+    for (Domain::DomainPointIterator it(Domain(tile_lo, tile_hi)); it; it++)
+      if (!filter || shard_domain.contains(it.p)) points.push_back(it.p);
+  }
+
+ private:
+  // The tile grid of a launch domain, and for Morton order, the maps from row-major tile
+  // indices to shards and back
+  struct Layout {
+    std::vector<int64_t> grid;
+    std::vector<ShardID> tile_to_shard;
+    std::vector<size_t> shard_to_tile;
+  };
+
+  // The layout depends only on the shard count and the extents of the launch domain
+  using LayoutKey = std::array<int64_t, LEGION_MAX_DIM + 1>;
+
+  // Launch domains rarely vary much, so the cache is simply dropped once it gets this big
+  static constexpr size_t MAX_CACHED_LAYOUTS = 1024;
+
+  std::shared_ptr<const Layout> find_or_create_layout(const Domain& launch_space,
+                                                      size_t total_shards)
+  {
+    LayoutKey key{};
+    key[0]  = static_cast<int64_t>(total_shards);
+    auto lo = launch_space.lo();
+    auto hi = launch_space.hi();
+    for (int32_t dim = 0; dim < launch_space.dim; ++dim) key[dim + 1] = hi[dim] - lo[dim] + 1;
+
+    const std::lock_guard<std::mutex> lock(layout_lock_);
+    auto finder = layouts_.find(key);
+    if (finder != layouts_.end()) return finder->second;
+
+    auto layout  = std::make_shared<Layout>();
+    layout->grid = compute_tile_grid(launch_space, total_shards);
+    if (morton_) compute_morton_order(*layout);
+    if (layouts_.size() >= MAX_CACHED_LAYOUTS) layouts_.clear();
+    layouts_[key] = layout;
+    return layout;
+  }
+
+  static std::vector<int64_t> compute_tile_grid(const Domain& launch_space, size_t total_shards)
+  {
+    std::vector<int64_t> grid(launch_space.dim, 1);
+    auto lo = launch_space.lo();
+    auto hi = launch_space.hi();
+
+    std::vector<size_t> factors;
+    size_t remaining = total_shards;
+    for (size_t factor = 2; factor * factor <= remaining; ++factor)
+      while (remaining % factor == 0) {
+        factors.push_back(factor);
+        remaining /= factor;
+      }
+    if (remaining > 1) factors.push_back(remaining);
+
+    for (auto it = factors.rbegin(); it != factors.rend(); ++it) {
+      int32_t next_dim = 0;
+      double max_tile  = -1.0;
+      for (int32_t dim = 0; dim < launch_space.dim; ++dim) {
+        double tile = static_cast<double>(hi[dim] - lo[dim] + 1) / grid[dim];
+        if (tile > max_tile) {
+          max_tile = tile;
+          next_dim = dim;
+        }
+      }
+      grid[next_dim] *= *it;
+    }
+    return grid;
+  }
+
+  static void compute_morton_order(Layout& layout)
+  {
+    auto& grid   = layout.grid;
+    int32_t ndim = static_cast<int32_t>(grid.size());
+    std::vector<int32_t> bits(ndim, 0);
+    for (int32_t dim = 0; dim < ndim; ++dim)
+      while ((int64_t{1} << bits[dim]) < grid[dim]) ++bits[dim];
+    int32_t max_bits = *std::max_element(bits.begin(), bits.end());
+
+    size_t num_tiles = 1;
+    for (auto extent : grid) num_tiles *= extent;
+
+    std::vector<std::pair<uint64_t, size_t>> codes(num_tiles);
+    std::vector<int64_t> coords(ndim, 0);
+    for (size_t idx = 0; idx < num_tiles; ++idx) {
+      size_t rem = idx;
+      for (int32_t dim = ndim - 1; dim >= 0; --dim) {
+        coords[dim] = rem % grid[dim];
+        rem /= grid[dim];
+      }
+      // Interleave the coordinate bits, skipping dimensions that have run out of them
+      uint64_t code = 0;
+      for (int32_t bit = max_bits - 1; bit >= 0; --bit)
+        for (int32_t dim = 0; dim < ndim; ++dim)
+          if (bit < bits[dim]) code = (code << 1) | ((coords[dim] >> bit) & 1);
+      codes[idx] = std::make_pair(code, idx);
+    }
+    std::sort(codes.begin(), codes.end());
+
+    layout.tile_to_shard.resize(num_tiles);
+    layout.shard_to_tile.resize(num_tiles);
+    for (size_t rank = 0; rank < num_tiles; ++rank) {
+      layout.tile_to_shard[codes[rank].second] = rank;
+      layout.shard_to_tile[rank]               = codes[rank].second;
+    }
+  }
+
+ private:
+  bool morton_;
+  std::mutex layout_lock_;
+  std::map<LayoutKey, std::shared_ptr<const Layout>> layouts_;
+};
+
 void register_legate_core_sharding_functors(Legion::Runtime* runtime, const LibraryContext& context)
 {
   runtime->register_sharding_functor(context.get_sharding_id(LEGATE_CORE_TOPLEVEL_TASK_SHARD_ID),
@@ -89,10 +347,22 @@ void register_legate_core_sharding_functors(Legion::Runtime* runtime, const Libr
   auto sharding_id = context.get_sharding_id(LEGATE_CORE_LINEARIZE_SHARD_ID);
   runtime->register_sharding_functor(
     sharding_id, new LinearizingShardingFunctor(), true /*silence warnings*/);
-  // Use linearizing functor for identity projections
-  functor_id_table[0] = sharding_id;
-  // and for the delinearizing projection
-  functor_id_table[context.get_projection_id(LEGATE_CORE_DELINEARIZE_PROJ_ID)] = sharding_id;
+  auto tiled_sharding_id = context.get_sharding_id(LEGATE_CORE_TILED_SHARD_ID);
+  runtime->register_sharding_functor(
+    tiled_sharding_id, new TiledShardingFunctor(false), true /*silence warnings*/);
+  auto morton_sharding_id = context.get_sharding_id(LEGATE_CORE_MORTON_SHARD_ID);
+  runtime->register_sharding_functor(
+    morton_sharding_id, new TiledShardingFunctor(true), true /*silence warnings*/);
+
+  // Use linearizing functor for identity projections, unless tiles are requested
+  if (Core::morton_sharding)
+    functor_id_table.insert(0, morton_sharding_id);
+  else if (Core::tiled_sharding)
+    functor_id_table.insert(0, tiled_sharding_id);
+  else
+    functor_id_table.insert(0, sharding_id);
+  // The delinearizing projection always comes from a 1D launch, so linear chunks are fine
+  functor_id_table.insert(context.get_projection_id(LEGATE_CORE_DELINEARIZE_PROJ_ID), sharding_id);
 }
 
 class LegateShardingFunctor : public ShardingFunctor {
@@ -104,24 +374,116 @@ class LegateShardingFunctor : public ShardingFunctor {
                         const Domain& launch_space,
                         const size_t total_shards) override
   {
-    auto lo    = proj_functor_->project_point(launch_space.lo(), launch_space);
-    auto hi    = proj_functor_->project_point(launch_space.hi(), launch_space);
+    return compute_shard(*find_or_create_assignment(launch_space, total_shards), p, launch_space);
+  }
+
+  virtual bool is_invertible(void) const override { return true; }
+
+  virtual void invert(ShardID shard,
+                      const Domain& shard_domain,
+                      const Domain& full_domain,
+                      const size_t total_shards,
+                      std::vector<DomainPoint>& points) override
+  {
+    // Points are handed out in chunks of the linearized projected domain, which generally
+    // don't map back to rectangles of the launch domain, so we test the points one by one
+    auto assignment = find_or_create_assignment(full_domain, total_shards);
+    for (Domain::DomainPointIterator it(shard_domain); it; it++)
+      if (compute_shard(*assignment, it.p, full_domain) == shard) points.push_back(it.p);
+  }
+
+ private:
+  // The bounds of the projected launch domain and the number of its points each shard gets,
+  // from which the shard of any point takes one projection to find
+  struct Assignment {
+    DomainPoint lo;
+    DomainPoint hi;
+    size_t chunk;
+  };
+
+  ShardID compute_shard(const Assignment& assignment,
+                        const DomainPoint& p,
+                        const Domain& launch_space) const
+  {
     auto point = proj_functor_->project_point(p, launch_space);
+    return linearize(assignment.lo, assignment.hi, point) / assignment.chunk;
+  }
 
-    const size_t size  = Domain(lo, hi).get_volume();
-    const size_t chunk = (size + total_shards - 1) / total_shards;
-    return linearize(lo, hi, point) / chunk;
+  // The shard count, the dimension, and the bounds of the launch domain
+  using AssignmentKey = std::array<int64_t, 2 * LEGION_MAX_DIM + 2>;
+
+  // The most recent assignment each thread looked up. Mappers ask for the shards of the same
+  // launch many times in a row, and these hits don't have to take the lock.
+  struct LastHit {
+    const LegateShardingFunctor* owner{nullptr};
+    AssignmentKey key{};
+    std::shared_ptr<const Assignment> assignment{};
+  };
+
+  std::shared_ptr<const Assignment> find_or_create_assignment(const Domain& launch_space,
+                                                              const size_t total_shards)
+  {
+    AssignmentKey key{};
+    key[0]  = static_cast<int64_t>(total_shards);
+    key[1]  = launch_space.dim;
+    auto lo = launch_space.lo();
+    auto hi = launch_space.hi();
+    for (int32_t dim = 0; dim < launch_space.dim; ++dim) {
+      key[2 + 2 * dim]     = lo[dim];
+      key[2 + 2 * dim + 1] = hi[dim];
+    }
+
+    static thread_local LastHit last_hit;
+    if (last_hit.owner == this && last_hit.key == key) return last_hit.assignment;
+
+    {
+      const std::lock_guard<std::mutex> lock(assignment_lock_);
+      auto finder = assignments_.find(key);
+      if (finder != assignments_.end()) {
+        lru_.splice(lru_.begin(), lru_, finder->second.second);
+        last_hit = LastHit{this, key, finder->second.first};
+        return last_hit.assignment;
+      }
+    }
+
+    // If two threads race to create the assignment, one of the results is dropped
+    auto assignment   = std::make_shared<Assignment>();
+    assignment->lo    = proj_functor_->project_point(lo, launch_space);
+    assignment->hi    = proj_functor_->project_point(hi, launch_space);
+    const size_t size = Domain(assignment->lo, assignment->hi).get_volume();
+    assignment->chunk = (size + total_shards - 1) / total_shards;
+
+    const std::lock_guard<std::mutex> lock(assignment_lock_);
+    auto finder = assignments_.find(key);
+    if (finder == assignments_.end()) {
+      // Evict the least recently used assignment. Threads that still hold it keep it alive.
+      if (assignments_.size() >= MAX_CACHED_ASSIGNMENTS) {
+        assignments_.erase(lru_.back());
+        lru_.pop_back();
+      }
+      lru_.push_front(key);
+      finder = assignments_.emplace(key, std::make_pair(std::move(assignment), lru_.begin())).first;
+    }
+    last_hit = LastHit{this, key, finder->second.first};
+    return last_hit.assignment;
   }
 
+ private:
+  static constexpr size_t MAX_CACHED_ASSIGNMENTS = 64;
+
  private:
   LegateProjectionFunctor* proj_functor_;
+  std::mutex assignment_lock_;
+  // Keys ordered from the most to the least recently used
+  std::list<AssignmentKey> lru_;
+  std::map<AssignmentKey,
+           std::pair<std::shared_ptr<const Assignment>, std::list<AssignmentKey>::iterator>>
+    assignments_;
 };
 
 ShardingID find_sharding_functor_by_projection_functor(Legion::ProjectionID proj_id)
 {
-  const std::lock_guard<std::mutex> lock(legate::functor_table_lock);
-  assert(functor_id_table.find(proj_id) != functor_id_table.end());
-  return functor_id_table[proj_id];
+  return functor_id_table.find(proj_id);
 }
 
 struct callback_args_t {
@@ -150,10 +512,7 @@ void legate_create_sharding_functor_using_projection(Legion::ShardID shard_id,
 {
   auto runtime = Runtime::get_runtime();
   legate::callback_args_t args{shard_id, proj_id};
-  {
-    const std::lock_guard<std::mutex> lock(legate::functor_table_lock);
-    legate::functor_id_table[proj_id] = shard_id;
-  }
+  legate::functor_id_table.insert(proj_id, shard_id);
   UntypedBuffer buffer(&args, sizeof(args));
   Legion::Runtime::perform_registration_callback(
     legate::sharding_functor_registration_callback, buffer, false /*global*/, false /*dedup*/);
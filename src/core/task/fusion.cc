@@ -0,0 +1,183 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "core/data/scalar.h"
+#include "core/data/store.h"
+#include "core/runtime/context.h"
+#include "core/task/fusion.h"
+#include "core/task/task.h"
+
+namespace legate {
+namespace fusion {
+
+using namespace Legion;
+
+// Fusable variants are recorded while libraries register their tasks and looked up by fused
+// tasks, which can run concurrently with the registration of a library loaded later
+static std::mutex fusable_variants_lock;
+static std::map<std::string, std::map<LegateVariantCode, LegateVariantImpl>> pending_variants;
+static std::map<std::pair<TaskID, LegateVariantCode>, LegateVariantImpl> fusable_variants;
+
+void record_fusable_variant(const char* task_name, LegateVariantCode var, LegateVariantImpl body)
+{
+  std::lock_guard<std::mutex> guard(fusable_variants_lock);
+  pending_variants[task_name][var] = body;
+}
+
+void register_fusable_variants(const char* task_name, TaskID task_id)
+{
+  std::lock_guard<std::mutex> guard(fusable_variants_lock);
+  auto finder = pending_variants.find(task_name);
+  if (pending_variants.end() == finder) return;
+  for (auto& pair : finder->second)
+    fusable_variants[std::make_pair(task_id, pair.first)] = pair.second;
+  pending_variants.erase(finder);
+}
+
+LegateVariantImpl find_fusable_variant(TaskID task_id, LegateVariantCode var)
+{
+  std::lock_guard<std::mutex> guard(fusable_variants_lock);
+  auto finder = fusable_variants.find(std::make_pair(task_id, var));
+  return fusable_variants.end() == finder ? nullptr : finder->second;
+}
+
+bool has_fusable_variants(TaskID task_id)
+{
+  const std::pair<Processor::Kind, LegateVariantCode> kinds[] = {
+    {Processor::LOC_PROC, LEGATE_CPU_VARIANT},
+    {Processor::OMP_PROC, LEGATE_OMP_VARIANT},
+    {Processor::TOC_PROC, LEGATE_GPU_VARIANT},
+  };
+  for (auto& [kind, var] : kinds) {
+    Machine::ProcessorQuery procs(Machine::get_machine());
+    procs.local_address_space().only_kind(kind);
+    if (procs.count() > 0 && nullptr == find_fusable_variant(task_id, var)) return false;
+  }
+  return true;
+}
+
+template <typename T>
+static std::vector<T> take_range(std::vector<T>& from, size_t offset, size_t count)
+{
+  std::vector<T> result;
+  result.reserve(count);
+  for (size_t idx = 0; idx < count; ++idx) result.push_back(std::move(from[offset + idx]));
+  return result;
+}
+
+template <typename T>
+static void return_range(std::vector<T>& to, size_t offset, std::vector<T>& from)
+{
+  for (size_t idx = 0; idx < from.size(); ++idx) to[offset + idx] = std::move(from[idx]);
+}
+
+static void run_fused_tasks(TaskContext& context, LegateVariantCode var)
+{
+  auto& inputs     = context.inputs();
+  auto& outputs    = context.outputs();
+  auto& reductions = context.reductions();
+  auto& scalars    = context.scalars();
+
+  // The first scalar describes the fused tasks: their number, followed by the global task id
+  // and the numbers of inputs, outputs, reductions and scalars of each task. The stores and
+  // scalars of the fused tasks are laid out back to back in the same order.
+  auto desc      = scalars[0].values<int64_t>();
+  auto num_tasks = static_cast<size_t>(desc[0]);
+#ifdef DEBUG_LEGATE
+  assert(desc.size() == 1 + 5 * num_tasks);
+#endif
+
+  size_t input_offset     = 0;
+  size_t output_offset    = 0;
+  size_t reduction_offset = 0;
+  size_t scalar_offset    = 1;
+  for (size_t task_idx = 0; task_idx < num_tasks; ++task_idx) {
+    const int64_t* task_desc = &desc[1 + 5 * task_idx];
+    auto task_id             = static_cast<TaskID>(task_desc[0]);
+    auto num_inputs          = static_cast<size_t>(task_desc[1]);
+    auto num_outputs         = static_cast<size_t>(task_desc[2]);
+    auto num_reductions      = static_cast<size_t>(task_desc[3]);
+    auto num_scalars         = static_cast<size_t>(task_desc[4]);
+
+    // Tasks are fused only when they have fusable variants for every processor kind on the node
+    // (see has_fusable_variants), so this can only fail when that promise is broken
+    auto body = find_fusable_variant(task_id, var);
+    if (nullptr == body) {
+      log_legate.error("Task %u was fused, but it has no fusable variant for this processor kind",
+                       task_id);
+      LEGATE_ABORT;
+    }
+
+    TaskContext sub_context(context,
+                            take_range(inputs, input_offset, num_inputs),
+                            take_range(outputs, output_offset, num_outputs),
+                            take_range(reductions, reduction_offset, num_reductions),
+                            take_range(scalars, scalar_offset, num_scalars));
+    (*body)(sub_context);
+    return_range(inputs, input_offset, sub_context.inputs());
+    return_range(outputs, output_offset, sub_context.outputs());
+    return_range(reductions, reduction_offset, sub_context.reductions());
+    return_range(scalars, scalar_offset, sub_context.scalars());
+
+    input_offset += num_inputs;
+    output_offset += num_outputs;
+    reduction_offset += num_reductions;
+    scalar_offset += num_scalars;
+  }
+}
+
+class FusedTaskRegistrar {
+ public:
+  static LegateTaskRegistrar& get_registrar()
+  {
+    static LegateTaskRegistrar registrar;
+    return registrar;
+  }
+
+  template <typename... Args>
+  static void record_variant(Args&&... args)
+  {
+    get_registrar().record_variant(std::forward<Args>(args)...);
+  }
+};
+
+class FusedTask : public LegateTask<FusedTask> {
+ public:
+  static const int32_t TASK_ID = LEGATE_CORE_FUSED_TASK_ID;
+  using Registrar              = FusedTaskRegistrar;
+
+ public:
+  static void cpu_variant(TaskContext& context) { run_fused_tasks(context, LEGATE_CPU_VARIANT); }
+#ifdef LEGATE_USE_OPENMP
+  static void omp_variant(TaskContext& context) { run_fused_tasks(context, LEGATE_OMP_VARIANT); }
+#endif
+#ifdef LEGATE_USE_CUDA
+  static void gpu_variant(TaskContext& context) { run_fused_tasks(context, LEGATE_GPU_VARIANT); }
+#endif
+};
+
+void register_tasks(Runtime* runtime, LibraryContext& context)
+{
+  FusedTask::register_variants();
+  FusedTaskRegistrar::get_registrar().register_all_tasks(runtime, context);
+}
+
+}  // namespace fusion
+}  // namespace legate
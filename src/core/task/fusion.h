@@ -0,0 +1,51 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "legion.h"
+
+#include "core/utilities/typedefs.h"
+
+namespace legate {
+
+class LibraryContext;
+class TaskContext;
+
+using LegateVariantImpl = void (*)(TaskContext&);
+
+namespace fusion {
+
+// Records the body of a fusable variant of a task. The body is keyed by the task name until
+// the task's library registers it and gives it a global id.
+void record_fusable_variant(const char* task_name, LegateVariantCode var, LegateVariantImpl body);
+
+// Makes the fusable variants recorded for a task findable by its global id
+void register_fusable_variants(const char* task_name, Legion::TaskID task_id);
+
+LegateVariantImpl find_fusable_variant(Legion::TaskID task_id, LegateVariantCode var);
+
+// Returns true if the task has a fusable variant for every kind of processor on this node, so
+// that a fused task can run it wherever the task is mapped
+bool has_fusable_variants(Legion::TaskID task_id);
+
+// Registers the fused task, which runs a sequence of fusable tasks back to back on the stores
+// passed to it
+void register_tasks(Legion::Runtime* runtime, LibraryContext& context);
+
+}  // namespace fusion
+
+}  // namespace legate
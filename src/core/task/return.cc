@@ -15,6 +15,7 @@
  */
 
 #include <assert.h>
+#include <algorithm>
 #include <stdint.h>
 #include <string.h>
 
@@ -41,6 +42,14 @@ ReturnValue::ReturnValue(Legion::UntypedDeferredValue value, size_t size)
   is_device_value_ = value.get_instance().get_location().kind() == Memory::Kind::GPU_FB_MEM;
 }
 
+ReturnValue::ReturnValue(const void* ptr, size_t size) : size_(size), is_inline_(true)
+{
+#ifdef DEBUG_LEGATE
+  assert(size <= MAX_INLINE_SIZE);
+#endif
+  memcpy(inline_value_.data(), ptr, size);
+}
+
 /*static*/ ReturnValue ReturnValue::unpack(const void* ptr, size_t size, Memory::Kind memory_kind)
 {
   ReturnValue result(UntypedDeferredValue(size, memory_kind), size);
@@ -54,17 +63,22 @@ ReturnValue::ReturnValue(Legion::UntypedDeferredValue value, size_t size)
 
 void ReturnValue::finalize(Legion::Context legion_context) const
 {
-  value_.finalize(legion_context);
+  if (is_inline_)
+    Runtime::legion_task_postamble(legion_context, inline_value_.data(), size_);
+  else
+    value_.finalize(legion_context);
 }
 
 void* ReturnValue::ptr()
 {
+  if (is_inline_) return inline_value_.data();
   AccessorRW<int8_t, 1> acc(value_, size_, false);
   return acc.ptr(0);
 }
 
 const void* ReturnValue::ptr() const
 {
+  if (is_inline_) return inline_value_.data();
   AccessorRO<int8_t, 1> acc(value_, size_, false);
   return acc.ptr(0);
 }
@@ -169,6 +183,10 @@ void ReturnedException::legion_deserialize(const void* buffer)
 
 ReturnValue ReturnedException::pack() const
 {
+  // Nearly all tasks finish without raising, so the flag alone goes back inline without the cost
+  // of creating a deferred value
+  if (!raised_) return ReturnValue(&raised_, sizeof(bool));
+
   auto buffer_size = legion_buffer_size();
   auto mem_kind    = find_memory_kind_for_executing_processor();
   auto buffer      = UntypedDeferredValue(buffer_size, mem_kind);
@@ -220,44 +238,77 @@ void ReturnValues::legion_serialize(void* buffer) const
                                  ret.ptr(),
                                  ret.size(),
                                  cudaMemcpyDeviceToHost,
-                                 cuda::StreamPool::get_stream_pool().get_stream()));
+                                 cuda::StreamPool::get_stream_pool().lease_stream()));
     } else
 #endif
       memcpy(buffer, ret.ptr(), ret.size());
     return;
   }
 
+  auto ptr = static_cast<int8_t*>(buffer) + pack_header(buffer);
+
+#ifdef LEGATE_USE_CUDA
+  if (Processor::get_executing_processor().kind() == Processor::Kind::TOC_PROC) {
+    pack_values_on_device(ptr, false /*target_on_device*/);
+    return;
+  }
+#endif
+  for (auto& ret : return_values_) {
+    uint32_t size = ret.size();
+    memcpy(ptr, ret.ptr(), size);
+    ptr += size;
+  }
+}
+
+size_t ReturnValues::pack_header(void* buffer) const
+{
   *static_cast<uint32_t*>(buffer) = return_values_.size();
   auto ptr                        = static_cast<int8_t*>(buffer) + sizeof(uint32_t);
 
   uint32_t offset = 0;
-  for (auto ret : return_values_) {
+  for (auto& ret : return_values_) {
     offset += ret.size();
     *reinterpret_cast<uint32_t*>(ptr) = offset;
     ptr                               = ptr + sizeof(uint32_t);
   }
+  return sizeof(uint32_t) * (return_values_.size() + 1);
+}
 
 #ifdef LEGATE_USE_CUDA
-  if (Processor::get_executing_processor().kind() == Processor::Kind::TOC_PROC) {
-    auto stream = cuda::StreamPool::get_stream_pool().get_stream();
-    for (auto ret : return_values_) {
-      uint32_t size = ret.size();
-      if (ret.is_device_value())
-        CHECK_CUDA(cudaMemcpyAsync(ptr, ret.ptr(), size, cudaMemcpyDeviceToHost, stream));
-      else
-        memcpy(ptr, ret.ptr(), size);
-      ptr += size;
-    }
-  } else
-#endif
-  {
-    for (auto ret : return_values_) {
-      uint32_t size = ret.size();
-      memcpy(ptr, ret.ptr(), size);
-      ptr += size;
+void ReturnValues::pack_values_on_device(int8_t* target, bool target_on_device) const
+{
+  bool has_device_values = std::any_of(return_values_.begin(),
+                                       return_values_.end(),
+                                       [](const auto& ret) { return ret.is_device_value(); });
+  if (!has_device_values && !target_on_device) {
+    for (auto& ret : return_values_) {
+      memcpy(target, ret.ptr(), ret.size());
+      target += ret.size();
     }
+    return;
+  }
+
+  // Issuing one device-to-host copy per value would pay the transfer latency N times, so
+  // we instead gather the values in a framebuffer scratch buffer that is laid out exactly
+  // like the target and move them all in one copy. When the target itself is in the
+  // framebuffer, the values are gathered directly into it. The copies must see the values
+  // the task body produced, so they go on the primary stream after the body's kernels.
+  auto stream        = cuda::StreamPool::get_stream_pool().get_stream();
+  size_t values_size = buffer_size_ - sizeof(uint32_t) * (return_values_.size() + 1);
+  int8_t* staging    = target;
+  if (!target_on_device)
+    staging = create_buffer<int8_t>(values_size, Memory::Kind::GPU_FB_MEM).ptr(0);
+
+  size_t offset = 0;
+  for (auto& ret : return_values_) {
+    CHECK_CUDA(
+      cudaMemcpyAsync(staging + offset, ret.ptr(), ret.size(), cudaMemcpyDefault, stream));
+    offset += ret.size();
   }
+  if (!target_on_device)
+    CHECK_CUDA(cudaMemcpyAsync(target, staging, values_size, cudaMemcpyDeviceToHost, stream));
 }
+#endif
 
 void ReturnValues::legion_deserialize(const void* buffer)
 {
@@ -316,6 +367,31 @@ void ReturnValues::finalize(Context legion_context) const
 #endif
 
   size_t return_size = legion_buffer_size();
+
+#ifdef LEGATE_USE_CUDA
+  // When every value lives in the framebuffer, we pack them in the framebuffer as well so
+  // that consumers on the same GPU never see the data bounce through host memory
+  if (kind == Processor::TOC_PROC &&
+      std::all_of(return_values_.begin(), return_values_.end(), [](const auto& ret) {
+        return ret.is_device_value();
+      })) {
+    auto return_buffer = UntypedDeferredValue(
+      return_size, find_memory_kind_for_executing_processor(false /*host_accessible*/));
+    AccessorWO<int8_t, 1> acc(return_buffer, return_size, false);
+
+    // The header is staged in zero-copy memory, as a copy from pageable memory would not
+    // return until the transfer is done
+    size_t header_size = sizeof(uint32_t) * (return_values_.size() + 1);
+    auto header        = create_buffer<int8_t>(header_size, Memory::Kind::Z_COPY_MEM).ptr(0);
+    pack_header(header);
+    auto stream = cuda::StreamPool::get_stream_pool().get_stream();
+    CHECK_CUDA(cudaMemcpyAsync(acc.ptr(0), header, header_size, cudaMemcpyHostToDevice, stream));
+    pack_values_on_device(acc.ptr(0) + header_size, true /*target_on_device*/);
+    return_buffer.finalize(legion_context);
+    return;
+  }
+#endif
+
   auto return_buffer =
     UntypedDeferredValue(return_size, find_memory_kind_for_executing_processor());
   AccessorWO<int8_t, 1> acc(return_buffer, return_size, false);
@@ -16,13 +16,20 @@
 
 #pragma once
 
+#include <array>
 #include <vector>
 
 namespace legate {
 
 struct ReturnValue {
+ public:
+  // Values up to this size can be kept inline, without creating a deferred value
+  static constexpr size_t MAX_INLINE_SIZE = 16;
+
  public:
   ReturnValue(Legion::UntypedDeferredValue value, size_t size);
+  // Makes an inline copy of a small value in host memory
+  ReturnValue(const void* ptr, size_t size);
 
  public:
   ReturnValue(const ReturnValue&)            = default;
@@ -45,6 +52,8 @@ struct ReturnValue {
   Legion::UntypedDeferredValue value_{};
   size_t size_{0};
   bool is_device_value_{false};
+  bool is_inline_{false};
+  std::array<int8_t, MAX_INLINE_SIZE> inline_value_{};
 };
 
 struct ReturnedException {
@@ -97,6 +106,13 @@ struct ReturnValues {
   // Calls the Legion postamble with an instance that packs all return values
   void finalize(Legion::Context legion_context) const;
 
+ private:
+  // Writes the number of values and their offsets, and returns the number of bytes written
+  size_t pack_header(void* buffer) const;
+#ifdef LEGATE_USE_CUDA
+  void pack_values_on_device(int8_t* target, bool target_on_device) const;
+#endif
+
  private:
   size_t buffer_size_{0};
   std::vector<ReturnValue> return_values_{};
@@ -14,12 +14,25 @@
  *
  */
 
+#include <map>
+#include <mutex>
+#include <set>
+#include <vector>
+
 #include "core/task/task.h"
+#include "core/utilities/machine.h"
 
 namespace legate {
 
 using namespace Legion;
 
+namespace {
+
+std::mutex registered_variants_lock;
+std::set<std::pair<TaskID, Processor::Kind>> registered_variants;
+
+}  // namespace
+
 void LegateTaskRegistrar::record_variant(TaskID tid,
                                          const char* task_name,
                                          const CodeDescriptor& descriptor,
@@ -41,6 +54,7 @@ void LegateTaskRegistrar::record_variant(TaskID tid,
                                                       task_name,
                                                       descriptor,
                                                       var,
+                                                      kind,
                                                       options.return_size));
 
   auto& registrar = pending_task_variants_.back();
@@ -55,15 +69,38 @@ void LegateTaskRegistrar::record_variant(TaskID tid,
 
 void LegateTaskRegistrar::register_all_tasks(Runtime* runtime, LibraryContext& context)
 {
-  // Do all our registrations
+  auto& local_machine = LocalMachine::get_local_machine();
+
+  // Group the variants by task so the per-task registrations happen only once
+  std::map<TaskID, std::vector<PendingTaskVariant*>> variants_by_task;
   for (auto& task : pending_task_variants_) {
+    // Variants for processor kinds this node doesn't have would never run here
+    if (Core::skip_absent_variants && !local_machine.has_processors(task.kind)) continue;
     task.task_id =
       context.get_task_id(task.task_id);  // Convert a task local task id to a global id
+    variants_by_task[task.task_id].push_back(&task);
+  }
+
+  // Do all our registrations
+  for (auto& [task_id, variants] : variants_by_task) {
+    auto task_name = variants.front()->task_name;
     // Attach the task name too for debugging
-    runtime->attach_name(task.task_id, task.task_name, false /*mutable*/, true /*local only*/);
-    runtime->register_task_variant(task, task.descriptor, nullptr, 0, task.ret_size, task.var);
+    runtime->attach_name(task_id, task_name, false /*mutable*/, true /*local only*/);
+    fusion::register_fusable_variants(task_name, task_id);
+    for (auto* task : variants) {
+      runtime->register_task_variant(
+        *task, task->descriptor, nullptr, 0, task->ret_size, task->var);
+      std::lock_guard<std::mutex> lock(registered_variants_lock);
+      registered_variants.emplace(task_id, task->kind);
+    }
   }
   pending_task_variants_.clear();
 }
 
+/*static*/ bool LegateTaskRegistrar::has_registered_variant(TaskID task_id, Processor::Kind kind)
+{
+  std::lock_guard<std::mutex> lock(registered_variants_lock);
+  return registered_variants.find(std::make_pair(task_id, kind)) != registered_variants.end();
+}
+
 }  // namespace legate
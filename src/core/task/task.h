@@ -17,17 +17,25 @@
 #pragma once
 
 #include <cxxabi.h>
+#include <optional>
 #include <sstream>
 
 #include "legion.h"
 #include "realm/faults.h"
 
+#ifdef LEGATE_USE_CUDA
+#include "core/cuda/graph_cache.h"
+#include "core/cuda/stream_pool.h"
+#endif
 #include "core/runtime/context.h"
 #include "core/runtime/runtime.h"
 #include "core/task/exception.h"
+#include "core/task/fusion.h"
 #include "core/task/return.h"
+#include "core/task/task_stats.h"
 #include "core/utilities/deserializer.h"
-#include "core/utilities/nvtx_help.h"
+#include "core/utilities/memory_usage.h"
+#include "core/utilities/trace.h"
 #include "core/utilities/typedefs.h"
 
 namespace legate {
@@ -40,6 +48,15 @@ struct VariantOptions {
   bool inner{false};
   bool idempotent{false};
   bool concurrent{false};
+  // Fusable variants can also run as part of a fused task, which Python fuses from element-wise
+  // operations on aligned stores
+  bool fusable{false};
+  // The stream work of a GPU variant can be captured into a CUDA graph and replayed, which the
+  // body must be written for (see core/cuda/graph_cache.h)
+  bool cuda_graph{false};
+  // A GPU variant that enqueues all of its work through the stream pool can complete without
+  // a context synchronization when LEGATE_ASYNC_STREAM_VIEW is set
+  bool async_completion{false};
   size_t return_size{LEGATE_MAX_SIZE_SCALAR_RETURN};
 
   VariantOptions& with_leaf(bool _leaf)
@@ -62,6 +79,21 @@ struct VariantOptions {
     concurrent = _concurrent;
     return *this;
   }
+  VariantOptions& with_fusable(bool _fusable)
+  {
+    fusable = _fusable;
+    return *this;
+  }
+  VariantOptions& with_cuda_graph(bool _cuda_graph)
+  {
+    cuda_graph = _cuda_graph;
+    return *this;
+  }
+  VariantOptions& with_async_completion(bool _async_completion)
+  {
+    async_completion = _async_completion;
+    return *this;
+  }
   VariantOptions& with_return_size(size_t _return_size)
   {
     return_size = _return_size;
@@ -69,8 +101,6 @@ struct VariantOptions {
   }
 };
 
-using LegateVariantImpl = void (*)(TaskContext&);
-
 template <typename T>
 class LegateTask {
  protected:
@@ -113,11 +143,15 @@ class LegateTask {
     return result.c_str();
   }
 
-  // Task wrappers so we can instrument all Legate tasks if we want
-  template <LegateVariantImpl TASK_PTR>
+  // Task wrappers so we can instrument all Legate tasks if we want. CUDA_GRAPH and
+  // ASYNC_COMPLETION are set for GPU variants registered with VariantOptions::cuda_graph and
+  // VariantOptions::async_completion, respectively.
+  template <LegateVariantImpl TASK_PTR, bool CUDA_GRAPH = false, bool ASYNC_COMPLETION = false>
   static void legate_task_wrapper(
     const void* args, size_t arglen, const void* userdata, size_t userlen, Legion::Processor p)
   {
+    uint64_t start = Core::task_stats ? TaskStats::now() : 0;
+
     // Legion preamble
     const Legion::Task* task;
     const std::vector<Legion::PhysicalRegion>* regions;
@@ -125,17 +159,48 @@ class LegateTask {
     Legion::Runtime* runtime;
     Legion::Runtime::legion_task_preamble(args, arglen, p, task, regions, legion_context, runtime);
 
-#ifdef LEGATE_USE_CUDA
-    nvtx::Range auto_range(task_name());
-#endif
+    trace::Range auto_range(task_name());
 
     Core::show_progress(task, legion_context, runtime, task_name());
 
     TaskContext context(task, *regions, legion_context, runtime);
 
+    TaskStats::Sample sample;
+    uint64_t body_start = 0;
+    bool timed          = Core::task_stats || context.reports_time();
+    if (timed) {
+      body_start = TaskStats::now();
+      if (Core::task_stats) sample.preamble_ns = body_start - start;
+    }
+
+#ifdef LEGATE_USE_CUDA
+    // GPU variants enqueue their kernels asynchronously, so the time the body takes on the host
+    // says little about the time the task takes. We report the time the work on the task's
+    // stream takes on the device instead, which suspends the task until the work is done.
+    std::optional<cuda::StreamTimer> device_timer;
+    if (context.reports_time() && p.kind() == Legion::Processor::TOC_PROC)
+      device_timer.emplace(cuda::StreamPool::get_stream_pool().get_stream());
+#endif
+
     ReturnValues return_values{};
     try {
-      if (!Core::use_empty_task) (*TASK_PTR)(context);
+      if (!Core::use_empty_task) {
+#ifdef LEGATE_USE_CUDA
+        if (CUDA_GRAPH)
+          cuda::run_graph_variant(context, TASK_PTR);
+        else
+#endif
+          (*TASK_PTR)(context);
+      }
+      if (timed) {
+        sample.body_ns = TaskStats::now() - body_start;
+#ifdef LEGATE_USE_CUDA
+        if (device_timer.has_value())
+          context.record_elapsed_time(device_timer->elapsed_ns());
+        else
+#endif
+          context.record_elapsed_time(sample.body_ns);
+      }
       return_values = context.pack_return_values();
     } catch (legate::TaskException& e) {
       if (context.can_raise_exception()) {
@@ -147,8 +212,26 @@ class LegateTask {
         Core::report_unexpected_exception(task_name(), e);
     }
 
-    // Legion postamble
-    return_values.finalize(legion_context);
+#ifdef LEGATE_USE_CUDA
+    // The context synchronization is skipped only for the variants that promised their stream
+    // views cover all their work; other tasks keep it even with LEGATE_ASYNC_STREAM_VIEW
+    if (ASYNC_COMPLETION) cuda::skip_context_synchronization();
+#endif
+
+    // Buffers the task didn't destroy are reclaimed once it finishes
+    MemoryUsage::release_task_temporaries();
+
+    if (Core::task_stats) {
+      auto postamble_start = TaskStats::now();
+      // The time spent in the task when it threw is attributed to the body
+      if (0 == sample.body_ns) sample.body_ns = postamble_start - body_start;
+      // Legion postamble
+      return_values.finalize(legion_context);
+      sample.postamble_ns = TaskStats::now() - postamble_start;
+      TaskStats::record(task_name(), p.kind(), sample);
+    } else
+      // Legion postamble
+      return_values.finalize(legion_context);
   }
 
  public:
@@ -162,14 +245,33 @@ class LegateTask {
   {
     // Construct the code descriptor for this task so that the library
     // can register it later when it is ready
-    Legion::CodeDescriptor desc(legate_task_wrapper<TASK_PTR>);
+#ifdef LEGATE_USE_CUDA
+    const bool on_gpu = kind == Legion::Processor::TOC_PROC;
+#else
+    const bool on_gpu = false;
+#endif
+    const bool cuda_graph       = on_gpu && options.cuda_graph;
+    const bool async_completion = on_gpu && options.async_completion;
+    Legion::CodeDescriptor desc(select_task_wrapper<TASK_PTR>(cuda_graph, async_completion));
     auto task_id = T::TASK_ID;
 
     T::Registrar::record_variant(
       task_id, T::task_name(), desc, execution_constraints, layout_constraints, var, kind, options);
+    if (options.fusable) fusion::record_fusable_variant(T::task_name(), var, TASK_PTR);
   }
   static void register_variants(
     const std::map<LegateVariantCode, VariantOptions>& all_options = {});
+
+ private:
+  template <LegateVariantImpl TASK_PTR>
+  static Realm::Processor::TaskFuncPtr select_task_wrapper(bool cuda_graph, bool async_completion)
+  {
+    if (cuda_graph)
+      return async_completion ? legate_task_wrapper<TASK_PTR, true, true>
+                              : legate_task_wrapper<TASK_PTR, true, false>;
+    return async_completion ? legate_task_wrapper<TASK_PTR, false, true>
+                            : legate_task_wrapper<TASK_PTR, false, false>;
+  }
 };
 
 template <typename T, typename BASE, bool HAS_CPU>
@@ -272,11 +374,19 @@ class LegateTaskRegistrar {
  public:
   void register_all_tasks(Legion::Runtime* runtime, LibraryContext& context);
 
+ public:
+  // Returns true if a variant for the processor kind has been registered on this node for the
+  // task. The task id is a global id.
+  static bool has_registered_variant(Legion::TaskID task_id, Legion::Processor::Kind kind);
+
  private:
   struct PendingTaskVariant : public Legion::TaskVariantRegistrar {
    public:
     PendingTaskVariant(void)
-      : Legion::TaskVariantRegistrar(), task_name(nullptr), var(LEGATE_NO_VARIANT)
+      : Legion::TaskVariantRegistrar(),
+        task_name(nullptr),
+        var(LEGATE_NO_VARIANT),
+        kind(Legion::Processor::NO_KIND)
     {
     }
     PendingTaskVariant(Legion::TaskID tid,
@@ -285,11 +395,13 @@ class LegateTaskRegistrar {
                        const char* t_name,
                        const Legion::CodeDescriptor& desc,
                        LegateVariantCode v,
+                       Legion::Processor::Kind k,
                        size_t ret)
       : Legion::TaskVariantRegistrar(tid, global, var_name),
         task_name(t_name),
         descriptor(desc),
         var(v),
+        kind(k),
         ret_size(ret)
     {
     }
@@ -298,6 +410,7 @@ class LegateTaskRegistrar {
     const char* task_name;
     Legion::CodeDescriptor descriptor;
     LegateVariantCode var;
+    Legion::Processor::Kind kind;
     size_t ret_size;
   };
 
@@ -0,0 +1,167 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#include "core/task/task_stats.h"
+
+namespace legate {
+
+using namespace Legion;
+
+// The number of distinct (task, variant) pairs a single thread can track. Samples of any
+// task beyond this are dropped and counted in the table's overflow counter.
+static constexpr size_t TABLE_CAPACITY = 1024;
+
+struct StatsTable {
+  TaskStats::Entry entries[TABLE_CAPACITY];
+  std::atomic<uint64_t> overflow{0};
+};
+
+static std::mutex tables_lock;
+static std::vector<std::unique_ptr<StatsTable>> tables;
+
+// Tables are never freed, so that they can be read after their threads are gone
+static StatsTable& get_local_table()
+{
+  thread_local StatsTable* table = nullptr;
+  if (nullptr == table) {
+    std::lock_guard<std::mutex> guard(tables_lock);
+    tables.push_back(std::make_unique<StatsTable>());
+    table = tables.back().get();
+  }
+  return *table;
+}
+
+static uint32_t to_bucket(uint64_t ns)
+{
+  uint32_t bucket = 0;
+  while (ns > 1 && bucket < TaskStats::NUM_BUCKETS - 1) {
+    ns >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+// Only the owning thread writes to a table, so plain load-then-store updates suffice
+static void add(std::atomic<uint64_t>& counter, uint64_t value)
+{
+  counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+/*static*/ uint64_t TaskStats::now() { return Realm::Clock::current_time_in_nanoseconds(); }
+
+/*static*/ void TaskStats::record(const char* task_name,
+                                  Processor::Kind kind,
+                                  const Sample& sample)
+{
+  auto& table = get_local_table();
+
+  // Task names are static strings, so their addresses identify the tasks
+  auto hash  = (reinterpret_cast<uintptr_t>(task_name) >> 3) ^ static_cast<uintptr_t>(kind);
+  Entry* hit = nullptr;
+  for (size_t probe = 0; probe < TABLE_CAPACITY; ++probe) {
+    auto& entry = table.entries[(hash + probe) % TABLE_CAPACITY];
+    auto name   = entry.task_name.load(std::memory_order_relaxed);
+    if (name == task_name && entry.kind == kind) {
+      hit = &entry;
+      break;
+    } else if (nullptr == name) {
+      entry.kind = kind;
+      for (auto& bucket : entry.histogram) bucket.store(0, std::memory_order_relaxed);
+      // Publishing the name makes the entry visible to readers
+      entry.task_name.store(task_name, std::memory_order_release);
+      hit = &entry;
+      break;
+    }
+  }
+  if (nullptr == hit) {
+    add(table.overflow, 1);
+    return;
+  }
+
+  auto total = sample.preamble_ns + sample.body_ns + sample.postamble_ns;
+  add(hit->count, 1);
+  add(hit->total_ns, total);
+  add(hit->preamble_ns, sample.preamble_ns);
+  add(hit->postamble_ns, sample.postamble_ns);
+  add(hit->histogram[to_bucket(total)], 1);
+}
+
+/*static*/ std::string TaskStats::summary()
+{
+  struct Merged {
+    uint64_t count{0};
+    uint64_t total_ns{0};
+    uint64_t preamble_ns{0};
+    uint64_t postamble_ns{0};
+    uint64_t histogram[NUM_BUCKETS] = {0};
+  };
+
+  auto kind_name = [](Processor::Kind kind) {
+    return (kind == Processor::LOC_PROC) ? "CPU" : (kind == Processor::TOC_PROC) ? "GPU" : "OpenMP";
+  };
+
+  std::map<std::pair<std::string, Processor::Kind>, Merged> merged;
+  uint64_t overflow = 0;
+  {
+    std::lock_guard<std::mutex> guard(tables_lock);
+    for (auto& table : tables) {
+      overflow += table->overflow.load(std::memory_order_relaxed);
+      for (auto& entry : table->entries) {
+        auto name = entry.task_name.load(std::memory_order_acquire);
+        if (nullptr == name) continue;
+        auto& target = merged[std::make_pair(std::string(name), entry.kind)];
+        target.count += entry.count.load(std::memory_order_relaxed);
+        target.total_ns += entry.total_ns.load(std::memory_order_relaxed);
+        target.preamble_ns += entry.preamble_ns.load(std::memory_order_relaxed);
+        target.postamble_ns += entry.postamble_ns.load(std::memory_order_relaxed);
+        for (uint32_t idx = 0; idx < NUM_BUCKETS; ++idx)
+          target.histogram[idx] += entry.histogram[idx].load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // The median is reported as the upper bound of the bucket that contains it
+  auto median = [](const Merged& m) {
+    uint64_t seen = 0;
+    for (uint32_t idx = 0; idx < NUM_BUCKETS; ++idx) {
+      seen += m.histogram[idx];
+      if (2 * seen >= m.count) return uint64_t(1) << (idx + 1);
+    }
+    return uint64_t(1) << NUM_BUCKETS;
+  };
+
+  std::stringstream ss;
+  ss << "task,kind,count,total_us,mean_us,median_us(<=),preamble_pct,postamble_pct\n";
+  for (auto& pair : merged) {
+    auto& m = pair.second;
+    if (0 == m.count) continue;
+    ss << pair.first.first << "," << kind_name(pair.first.second) << "," << m.count << ","
+       << m.total_ns / 1000 << "," << m.total_ns / m.count / 1000.0 << ","
+       << median(m) / 1000.0 << "," << 100.0 * m.preamble_ns / std::max<uint64_t>(m.total_ns, 1)
+       << "," << 100.0 * m.postamble_ns / std::max<uint64_t>(m.total_ns, 1) << "\n";
+  }
+  if (overflow > 0) ss << "# " << overflow << " samples were dropped as the tables were full\n";
+  return ss.str();
+}
+
+}  // namespace legate
@@ -0,0 +1,59 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#include "legion.h"
+
+namespace legate {
+
+// Per-task execution statistics, collected when LEGATE_TASK_STATS is set. Each processor
+// thread records into its own table, so recording takes no locks and readers only ever see
+// entries that have been fully published.
+class TaskStats {
+ public:
+  // Durations are bucketed by powers of two nanoseconds
+  static constexpr uint32_t NUM_BUCKETS = 40;
+
+  struct Sample {
+    uint64_t preamble_ns{0};
+    uint64_t body_ns{0};
+    uint64_t postamble_ns{0};
+  };
+
+  struct Entry {
+    std::atomic<const char*> task_name{nullptr};
+    Legion::Processor::Kind kind{Legion::Processor::NO_KIND};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> total_ns{0};
+    std::atomic<uint64_t> preamble_ns{0};
+    std::atomic<uint64_t> postamble_ns{0};
+    std::atomic<uint64_t> histogram[NUM_BUCKETS];
+  };
+
+ public:
+  static uint64_t now();
+  static void record(const char* task_name, Legion::Processor::Kind kind, const Sample& sample);
+
+ public:
+  // Returns a table with one row per task name and processor kind, merged over all threads
+  static std::string summary();
+};
+
+}  // namespace legate
@@ -0,0 +1,50 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cstring>
+
+#include "core/utilities/buffer_builder.h"
+
+namespace legate {
+
+BufferBuilder::BufferBuilder()
+{
+  // Most task arguments fit in this, so the buffer rarely needs to grow
+  buffer_.reserve(256);
+}
+
+void BufferBuilder::pack(LegateTypeCode code) { pack<int32_t>(static_cast<int32_t>(code)); }
+
+void BufferBuilder::pack(const Scalar& scalar)
+{
+  pack<bool>(scalar.is_tuple());
+  pack(scalar.code());
+  pack_buffer(scalar.ptr(), scalar.size());
+}
+
+void BufferBuilder::pack_buffer(const void* src, size_t size)
+{
+  auto offset = buffer_.size();
+  buffer_.resize(offset + size);
+  memcpy(buffer_.data() + offset, src, size);
+}
+
+Legion::UntypedBuffer BufferBuilder::to_legion_buffer() const
+{
+  return Legion::UntypedBuffer(buffer_.data(), buffer_.size());
+}
+
+}  // namespace legate
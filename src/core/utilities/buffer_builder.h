@@ -0,0 +1,55 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <type_traits>
+#include <vector>
+
+#include "legion.h"
+
+#include "core/data/scalar.h"
+#include "core/utilities/type_traits.h"
+
+namespace legate {
+
+// The serializing counterpart of BaseDeserializer. Values are packed back to back without
+// padding in the layout the deserializers expect, which is also the layout the Python
+// BufferBuilder produces.
+class BufferBuilder {
+ public:
+  BufferBuilder();
+
+ public:
+  template <typename T, std::enable_if_t<legate_type_code_of<T> != MAX_TYPE_NUMBER>* = nullptr>
+  void pack(const T& value);
+  template <typename T>
+  void pack(const std::vector<T>& values);
+  void pack(LegateTypeCode code);
+  void pack(const Scalar& scalar);
+  void pack_buffer(const void* buffer, size_t size);
+
+ public:
+  size_t size() const { return buffer_.size(); }
+  Legion::UntypedBuffer to_legion_buffer() const;
+
+ private:
+  std::vector<int8_t> buffer_;
+};
+
+}  // namespace legate
+
+#include "core/utilities/buffer_builder.inl"
@@ -0,0 +1,37 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+namespace legate {
+
+template <typename T, std::enable_if_t<legate_type_code_of<T> != MAX_TYPE_NUMBER>*>
+void BufferBuilder::pack(const T& value)
+{
+  pack_buffer(&value, sizeof(T));
+}
+
+template <typename T>
+void BufferBuilder::pack(const std::vector<T>& values)
+{
+  pack<uint32_t>(static_cast<uint32_t>(values.size()));
+  // std::vector<bool> packs its bits, so it has no contiguous storage to copy from
+  if constexpr (legate_type_code_of<T> != MAX_TYPE_NUMBER && std::is_trivially_copyable_v<T> &&
+                !std::is_same_v<T, bool>)
+    pack_buffer(values.data(), values.size() * sizeof(T));
+  else
+    for (auto& value : values) pack(value);
+}
+
+}  // namespace legate
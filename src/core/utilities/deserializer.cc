@@ -34,12 +34,9 @@ TaskDeserializer::TaskDeserializer(const LegionTask* task,
   : BaseDeserializer(static_cast<const int8_t*>(task->args), task->arglen),
     futures_{task->futures.data(), task->futures.size()},
     regions_{regions.data(), regions.size()},
+    outputs_fetched_(false),
     outputs_()
 {
-  auto runtime = Runtime::get_runtime();
-  auto ctx     = Runtime::get_context();
-  runtime->get_output_regions(ctx, outputs_);
-
   first_task_ = !task->is_index_space || (task->index_point == task->index_domain.lo());
 }
 
@@ -75,13 +72,7 @@ void TaskDeserializer::_unpack(FutureWrapper& value)
   auto has_storage = unpack<bool>();
   auto field_size  = unpack<int32_t>();
 
-  auto point = unpack<std::vector<int64_t>>();
-  Legion::Domain domain;
-  domain.dim = static_cast<int32_t>(point.size());
-  for (int32_t idx = 0; idx < domain.dim; ++idx) {
-    domain.rect_data[idx]              = 0;
-    domain.rect_data[idx + domain.dim] = point[idx] - 1;
-  }
+  auto domain = unpack_domain_extents();
 
   Legion::Future future;
   if (has_storage) {
@@ -107,6 +98,13 @@ void TaskDeserializer::_unpack(OutputRegionField& value)
   auto idx = unpack<uint32_t>();
   auto fid = unpack<int32_t>();
 
+  if (!outputs_fetched_) {
+    auto runtime = Runtime::get_runtime();
+    auto ctx     = Runtime::get_context();
+    runtime->get_output_regions(ctx, outputs_);
+    outputs_fetched_ = true;
+  }
+
   value = OutputRegionField(outputs_[idx], fid);
 }
 
@@ -169,13 +167,7 @@ void TaskDeserializer::_unpack(FutureWrapper& value)
   unpack<bool>();
   unpack<int32_t>();
 
-  auto point = unpack<std::vector<int64_t>>();
-  Legion::Domain domain;
-  domain.dim = static_cast<int32_t>(point.size());
-  for (int32_t idx = 0; idx < domain.dim; ++idx) {
-    domain.rect_data[idx]              = 0;
-    domain.rect_data[idx + domain.dim] = point[idx] - 1;
-  }
+  auto domain = unpack_domain_extents();
 
   value = FutureWrapper(future_index_++, domain);
 }
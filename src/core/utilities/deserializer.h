@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <cstring>
 #include <memory>
+#include <type_traits>
 
 #include "legion.h"
 
@@ -58,7 +60,17 @@ class BaseDeserializer {
   void _unpack(std::vector<T>& values)
   {
     auto size = unpack<uint32_t>();
-    for (uint32_t idx = 0; idx < size; ++idx) values.push_back(unpack<T>());
+    // std::vector<bool> packs its bits, so it has no contiguous storage to copy into
+    if constexpr (legate_type_code_of<T> != MAX_TYPE_NUMBER && std::is_trivially_copyable_v<T> &&
+                  !std::is_same_v<T, bool>) {
+      // Primitive values are laid out back to back, so they can be copied in one go
+      values.resize(size);
+      memcpy(values.data(), args_.ptr(), size * sizeof(T));
+      args_ = args_.subspan(size * sizeof(T));
+    } else {
+      values.reserve(values.size() + size);
+      for (uint32_t idx = 0; idx < size; ++idx) values.push_back(unpack<T>());
+    }
   }
 
  public:
@@ -67,6 +79,8 @@ class BaseDeserializer {
 
  protected:
   std::shared_ptr<TransformStack> unpack_transform();
+  // Unpacks a serialized vector of extents as a domain starting from the origin
+  Legion::Domain unpack_domain_extents();
 
  protected:
   bool first_task_;
@@ -93,6 +107,8 @@ class TaskDeserializer : public BaseDeserializer<TaskDeserializer> {
  private:
   Span<const Legion::Future> futures_;
   Span<const Legion::PhysicalRegion> regions_;
+  // Output regions are only fetched once the task unpacks an unbound store
+  bool outputs_fetched_;
   std::vector<Legion::OutputRegion> outputs_;
 };
 
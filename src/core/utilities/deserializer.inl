@@ -37,13 +37,25 @@ void BaseDeserializer<Deserializer>::_unpack(Scalar& value)
   args_      = args_.subspan(value.size());
 }
 
+template <typename Deserializer>
+Legion::Domain BaseDeserializer<Deserializer>::unpack_domain_extents()
+{
+  Legion::Domain domain;
+  domain.dim = static_cast<int32_t>(unpack<uint32_t>());
+  for (int32_t idx = 0; idx < domain.dim; ++idx) {
+    domain.rect_data[idx]              = 0;
+    domain.rect_data[idx + domain.dim] = unpack<int64_t>() - 1;
+  }
+  return domain;
+}
+
 template <typename Deserializer>
 std::shared_ptr<TransformStack> BaseDeserializer<Deserializer>::unpack_transform()
 {
   auto code = unpack<int32_t>();
   switch (code) {
     case -1: {
-      return std::make_shared<TransformStack>();
+      return TransformStack::identity_stack();
     }
     case LEGATE_CORE_TRANSFORM_SHIFT: {
       auto dim    = unpack<int32_t>();
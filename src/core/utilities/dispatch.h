@@ -16,10 +16,86 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include "core/utilities/typedefs.h"
+#include "legate_defines.h"
 
 namespace legate {
 
+namespace detail {
+
+// A functor can limit the combinations of type codes and dimensions that dispatch instantiates
+// it for by declaring 'static constexpr bool supports_type(LegateTypeCode)', 'static constexpr
+// bool supports_dim(int)', or both. Combinations it rejects are never instantiated and are
+// instead sent to the functor's non-template 'fallback' member, which takes the same arguments
+// as the other instantiations and must return the same type. Without a fallback, a rejected
+// combination is an error, which is allowed only for functors that return nothing.
+
+template <typename Functor, typename = void>
+struct has_supports_type : std::false_type {};
+template <typename Functor>
+struct has_supports_type<Functor, std::void_t<decltype(Functor::supports_type(LegateTypeCode{}))>>
+  : std::true_type {};
+
+template <typename Functor, typename = void>
+struct has_supports_dim : std::false_type {};
+template <typename Functor>
+struct has_supports_dim<Functor, std::void_t<decltype(Functor::supports_dim(1))>>
+  : std::true_type {};
+
+template <typename Functor>
+constexpr bool restricts_dispatch =
+  has_supports_type<Functor>::value || has_supports_dim<Functor>::value;
+
+template <typename Functor>
+constexpr bool supports_type(LegateTypeCode code)
+{
+  if constexpr (has_supports_type<Functor>::value)
+    return Functor::supports_type(code);
+  else
+    return true;
+}
+
+template <typename Functor>
+constexpr bool supports_dim(int dim)
+{
+  if constexpr (has_supports_dim<Functor>::value)
+    return Functor::supports_dim(dim);
+  else
+    return true;
+}
+
+template <typename Functor, typename = void, typename... Fnargs>
+struct has_fallback : std::false_type {};
+template <typename Functor, typename... Fnargs>
+struct has_fallback<
+  Functor,
+  std::void_t<decltype(std::declval<Functor&>().fallback(std::declval<Fnargs>()...))>,
+  Fnargs...> : std::true_type {};
+
+// Kept out of line so the rarely taken path doesn't bloat the dispatch
+template <typename Functor, typename... Fnargs>
+__attribute__((noinline, cold)) decltype(auto) unsupported_dispatch(Functor& f, Fnargs&&... args)
+{
+  if constexpr (has_fallback<Functor, void, Fnargs...>::value)
+    return f.fallback(std::forward<Fnargs>(args)...);
+  else {
+    log_legate.error("Dispatched a functor on a type code or dimension that it doesn't support");
+    LEGATE_ABORT;
+  }
+}
+
+}  // namespace detail
+
+// Returns true if dispatching the functor on the type code and dimension instantiates it, as
+// opposed to going to its fallback
+template <typename Functor>
+constexpr bool is_dispatchable(LegateTypeCode code, int dim)
+{
+  return detail::supports_type<Functor>(code) && detail::supports_dim<Functor>(dim);
+}
+
 template <int DIM>
 struct inner_type_dispatch_fn {
   template <typename Functor, typename... Fnargs>
@@ -27,53 +103,94 @@ struct inner_type_dispatch_fn {
   {
     switch (code) {
       case LegateTypeCode::BOOL_LT: {
-        return f.template operator()<LegateTypeCode::BOOL_LT, DIM>(std::forward<Fnargs>(args)...);
+        if constexpr (detail::supports_type<Functor>(LegateTypeCode::BOOL_LT))
+          return f.template operator()<LegateTypeCode::BOOL_LT, DIM>(std::forward<Fnargs>(args)...);
+        break;
       }
       case LegateTypeCode::INT8_LT: {
-        return f.template operator()<LegateTypeCode::INT8_LT, DIM>(std::forward<Fnargs>(args)...);
+        if constexpr (detail::supports_type<Functor>(LegateTypeCode::INT8_LT))
+          return f.template operator()<LegateTypeCode::INT8_LT, DIM>(std::forward<Fnargs>(args)...);
+        break;
       }
       case LegateTypeCode::INT16_LT: {
-        return f.template operator()<LegateTypeCode::INT16_LT, DIM>(std::forward<Fnargs>(args)...);
+        if constexpr (detail::supports_type<Functor>(LegateTypeCode::INT16_LT))
+          return f.template operator()<LegateTypeCode::INT16_LT, DIM>(
+            std::forward<Fnargs>(args)...);
+        break;
       }
       case LegateTypeCode::INT32_LT: {
-        return f.template operator()<LegateTypeCode::INT32_LT, DIM>(std::forward<Fnargs>(args)...);
+        if constexpr (detail::supports_type<Functor>(LegateTypeCode::INT32_LT))
+          return f.template operator()<LegateTypeCode::INT32_LT, DIM>(
+            std::forward<Fnargs>(args)...);
+        break;
       }
       case LegateTypeCode::INT64_LT: {
-        return f.template operator()<LegateTypeCode::INT64_LT, DIM>(std::forward<Fnargs>(args)...);
+        if constexpr (detail::supports_type<Functor>(LegateTypeCode::INT64_LT))
+          return f.template operator()<LegateTypeCode::INT64_LT, DIM>(
+            std::forward<Fnargs>(args)...);
+        break;
       }
       case LegateTypeCode::UINT8_LT: {
-        return f.template operator()<LegateTypeCode::UINT8_LT, DIM>(std::forward<Fnargs>(args)...);
+        if constexpr (detail::supports_type<Functor>(LegateTypeCode::UINT8_LT))
+          return f.template operator()<LegateTypeCode::UINT8_LT, DIM>(
+            std::forward<Fnargs>(args)...);
+        break;
       }
       case LegateTypeCode::UINT16_LT: {
-        return f.template operator()<LegateTypeCode::UINT16_LT, DIM>(std::forward<Fnargs>(args)...);
+        if constexpr (detail::supports_type<Functor>(LegateTypeCode::UINT16_LT))
+          return f.template operator()<LegateTypeCode::UINT16_LT, DIM>(
+            std::forward<Fnargs>(args)...);
+        break;
       }
       case LegateTypeCode::UINT32_LT: {
-        return f.template operator()<LegateTypeCode::UINT32_LT, DIM>(std::forward<Fnargs>(args)...);
+        if constexpr (detail::supports_type<Functor>(LegateTypeCode::UINT32_LT))
+          return f.template operator()<LegateTypeCode::UINT32_LT, DIM>(
+            std::forward<Fnargs>(args)...);
+        break;
       }
       case LegateTypeCode::UINT64_LT: {
-        return f.template operator()<LegateTypeCode::UINT64_LT, DIM>(std::forward<Fnargs>(args)...);
+        if constexpr (detail::supports_type<Functor>(LegateTypeCode::UINT64_LT))
+          return f.template operator()<LegateTypeCode::UINT64_LT, DIM>(
+            std::forward<Fnargs>(args)...);
+        break;
       }
       case LegateTypeCode::HALF_LT: {
-        return f.template operator()<LegateTypeCode::HALF_LT, DIM>(std::forward<Fnargs>(args)...);
+        if constexpr (detail::supports_type<Functor>(LegateTypeCode::HALF_LT))
+          return f.template operator()<LegateTypeCode::HALF_LT, DIM>(std::forward<Fnargs>(args)...);
+        break;
       }
       case LegateTypeCode::FLOAT_LT: {
-        return f.template operator()<LegateTypeCode::FLOAT_LT, DIM>(std::forward<Fnargs>(args)...);
+        if constexpr (detail::supports_type<Functor>(LegateTypeCode::FLOAT_LT))
+          return f.template operator()<LegateTypeCode::FLOAT_LT, DIM>(
+            std::forward<Fnargs>(args)...);
+        break;
       }
       case LegateTypeCode::DOUBLE_LT: {
-        return f.template operator()<LegateTypeCode::DOUBLE_LT, DIM>(std::forward<Fnargs>(args)...);
+        if constexpr (detail::supports_type<Functor>(LegateTypeCode::DOUBLE_LT))
+          return f.template operator()<LegateTypeCode::DOUBLE_LT, DIM>(
+            std::forward<Fnargs>(args)...);
+        break;
       }
       case LegateTypeCode::COMPLEX64_LT: {
-        return f.template operator()<LegateTypeCode::COMPLEX64_LT, DIM>(
-          std::forward<Fnargs>(args)...);
+        if constexpr (detail::supports_type<Functor>(LegateTypeCode::COMPLEX64_LT))
+          return f.template operator()<LegateTypeCode::COMPLEX64_LT, DIM>(
+            std::forward<Fnargs>(args)...);
+        break;
       }
       case LegateTypeCode::COMPLEX128_LT: {
-        return f.template operator()<LegateTypeCode::COMPLEX128_LT, DIM>(
-          std::forward<Fnargs>(args)...);
+        if constexpr (detail::supports_type<Functor>(LegateTypeCode::COMPLEX128_LT))
+          return f.template operator()<LegateTypeCode::COMPLEX128_LT, DIM>(
+            std::forward<Fnargs>(args)...);
+        break;
       }
       default: break;
     }
-    assert(false);
-    return f.template operator()<LegateTypeCode::BOOL_LT, DIM>(std::forward<Fnargs>(args)...);
+    if constexpr (detail::restricts_dispatch<Functor>)
+      return detail::unsupported_dispatch(f, std::forward<Fnargs>(args)...);
+    else {
+      assert(false);
+      return f.template operator()<LegateTypeCode::BOOL_LT, DIM>(std::forward<Fnargs>(args)...);
+    }
   }
 };
 
@@ -84,51 +201,73 @@ struct inner_dim_dispatch_fn {
   {
     switch (dim) {
       case 1: {
-        return f.template operator()<DIM, 1>(std::forward<Fnargs>(args)...);
+        if constexpr (detail::supports_dim<Functor>(1))
+          return f.template operator()<DIM, 1>(std::forward<Fnargs>(args)...);
+        break;
       }
 #if LEGION_MAX_DIM >= 2
       case 2: {
-        return f.template operator()<DIM, 2>(std::forward<Fnargs>(args)...);
+        if constexpr (detail::supports_dim<Functor>(2))
+          return f.template operator()<DIM, 2>(std::forward<Fnargs>(args)...);
+        break;
       }
 #endif
 #if LEGION_MAX_DIM >= 3
       case 3: {
-        return f.template operator()<DIM, 3>(std::forward<Fnargs>(args)...);
+        if constexpr (detail::supports_dim<Functor>(3))
+          return f.template operator()<DIM, 3>(std::forward<Fnargs>(args)...);
+        break;
       }
 #endif
 #if LEGION_MAX_DIM >= 4
       case 4: {
-        return f.template operator()<DIM, 4>(std::forward<Fnargs>(args)...);
+        if constexpr (detail::supports_dim<Functor>(4))
+          return f.template operator()<DIM, 4>(std::forward<Fnargs>(args)...);
+        break;
       }
 #endif
 #if LEGION_MAX_DIM >= 5
       case 5: {
-        return f.template operator()<DIM, 5>(std::forward<Fnargs>(args)...);
+        if constexpr (detail::supports_dim<Functor>(5))
+          return f.template operator()<DIM, 5>(std::forward<Fnargs>(args)...);
+        break;
       }
 #endif
 #if LEGION_MAX_DIM >= 6
       case 6: {
-        return f.template operator()<DIM, 6>(std::forward<Fnargs>(args)...);
+        if constexpr (detail::supports_dim<Functor>(6))
+          return f.template operator()<DIM, 6>(std::forward<Fnargs>(args)...);
+        break;
       }
 #endif
 #if LEGION_MAX_DIM >= 7
       case 7: {
-        return f.template operator()<DIM, 7>(std::forward<Fnargs>(args)...);
+        if constexpr (detail::supports_dim<Functor>(7))
+          return f.template operator()<DIM, 7>(std::forward<Fnargs>(args)...);
+        break;
       }
 #endif
 #if LEGION_MAX_DIM >= 8
       case 8: {
-        return f.template operator()<DIM, 8>(std::forward<Fnargs>(args)...);
+        if constexpr (detail::supports_dim<Functor>(8))
+          return f.template operator()<DIM, 8>(std::forward<Fnargs>(args)...);
+        break;
       }
 #endif
 #if LEGION_MAX_DIM >= 9
       case 9: {
-        return f.template operator()<DIM, 9>(std::forward<Fnargs>(args)...);
+        if constexpr (detail::supports_dim<Functor>(9))
+          return f.template operator()<DIM, 9>(std::forward<Fnargs>(args)...);
+        break;
       }
 #endif
     }
-    assert(false);
-    return f.template operator()<DIM, 1>(std::forward<Fnargs>(args)...);
+    if constexpr (detail::restricts_dispatch<Functor>)
+      return detail::unsupported_dispatch(f, std::forward<Fnargs>(args)...);
+    else {
+      assert(false);
+      return f.template operator()<DIM, 1>(std::forward<Fnargs>(args)...);
+    }
   }
 };
 
@@ -138,52 +277,74 @@ constexpr decltype(auto) double_dispatch(int dim, LegateTypeCode code, Functor f
   switch (dim) {
 #if LEGION_MAX_DIM >= 1
     case 1: {
-      return inner_type_dispatch_fn<1>{}(code, f, std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(1))
+        return inner_type_dispatch_fn<1>{}(code, f, std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
 #if LEGION_MAX_DIM >= 2
     case 2: {
-      return inner_type_dispatch_fn<2>{}(code, f, std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(2))
+        return inner_type_dispatch_fn<2>{}(code, f, std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
 #if LEGION_MAX_DIM >= 3
     case 3: {
-      return inner_type_dispatch_fn<3>{}(code, f, std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(3))
+        return inner_type_dispatch_fn<3>{}(code, f, std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
 #if LEGION_MAX_DIM >= 4
     case 4: {
-      return inner_type_dispatch_fn<4>{}(code, f, std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(4))
+        return inner_type_dispatch_fn<4>{}(code, f, std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
 #if LEGION_MAX_DIM >= 5
     case 5: {
-      return inner_type_dispatch_fn<5>{}(code, f, std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(5))
+        return inner_type_dispatch_fn<5>{}(code, f, std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
 #if LEGION_MAX_DIM >= 6
     case 6: {
-      return inner_type_dispatch_fn<6>{}(code, f, std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(6))
+        return inner_type_dispatch_fn<6>{}(code, f, std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
 #if LEGION_MAX_DIM >= 7
     case 7: {
-      return inner_type_dispatch_fn<7>{}(code, f, std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(7))
+        return inner_type_dispatch_fn<7>{}(code, f, std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
 #if LEGION_MAX_DIM >= 8
     case 8: {
-      return inner_type_dispatch_fn<8>{}(code, f, std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(8))
+        return inner_type_dispatch_fn<8>{}(code, f, std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
 #if LEGION_MAX_DIM >= 9
     case 9: {
-      return inner_type_dispatch_fn<9>{}(code, f, std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(9))
+        return inner_type_dispatch_fn<9>{}(code, f, std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
   }
-  assert(false);
-  return inner_type_dispatch_fn<1>{}(code, f, std::forward<Fnargs>(args)...);
+  if constexpr (detail::restricts_dispatch<Functor>)
+    return detail::unsupported_dispatch(f, std::forward<Fnargs>(args)...);
+  else {
+    assert(false);
+    return inner_type_dispatch_fn<1>{}(code, f, std::forward<Fnargs>(args)...);
+  }
 }
 
 template <typename Functor, typename... Fnargs>
@@ -192,52 +353,74 @@ constexpr decltype(auto) double_dispatch(int dim1, int dim2, Functor f, Fnargs&&
   switch (dim1) {
 #if LEGION_MAX_DIM >= 1
     case 1: {
-      return inner_dim_dispatch_fn<1>{}(dim2, f, std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(1))
+        return inner_dim_dispatch_fn<1>{}(dim2, f, std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
 #if LEGION_MAX_DIM >= 2
     case 2: {
-      return inner_dim_dispatch_fn<2>{}(dim2, f, std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(2))
+        return inner_dim_dispatch_fn<2>{}(dim2, f, std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
 #if LEGION_MAX_DIM >= 3
     case 3: {
-      return inner_dim_dispatch_fn<3>{}(dim2, f, std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(3))
+        return inner_dim_dispatch_fn<3>{}(dim2, f, std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
 #if LEGION_MAX_DIM >= 4
     case 4: {
-      return inner_dim_dispatch_fn<4>{}(dim2, f, std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(4))
+        return inner_dim_dispatch_fn<4>{}(dim2, f, std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
 #if LEGION_MAX_DIM >= 5
     case 5: {
-      return inner_dim_dispatch_fn<5>{}(dim2, f, std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(5))
+        return inner_dim_dispatch_fn<5>{}(dim2, f, std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
 #if LEGION_MAX_DIM >= 6
     case 6: {
-      return inner_dim_dispatch_fn<6>{}(dim2, f, std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(6))
+        return inner_dim_dispatch_fn<6>{}(dim2, f, std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
 #if LEGION_MAX_DIM >= 7
     case 7: {
-      return inner_dim_dispatch_fn<7>{}(dim2, f, std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(7))
+        return inner_dim_dispatch_fn<7>{}(dim2, f, std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
 #if LEGION_MAX_DIM >= 8
     case 8: {
-      return inner_dim_dispatch_fn<8>{}(dim2, f, std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(8))
+        return inner_dim_dispatch_fn<8>{}(dim2, f, std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
 #if LEGION_MAX_DIM >= 9
     case 9: {
-      return inner_dim_dispatch_fn<9>{}(dim2, f, std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(9))
+        return inner_dim_dispatch_fn<9>{}(dim2, f, std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
   }
-  assert(false);
-  return inner_dim_dispatch_fn<1>{}(dim2, f, std::forward<Fnargs>(args)...);
+  if constexpr (detail::restricts_dispatch<Functor>)
+    return detail::unsupported_dispatch(f, std::forward<Fnargs>(args)...);
+  else {
+    assert(false);
+    return inner_dim_dispatch_fn<1>{}(dim2, f, std::forward<Fnargs>(args)...);
+  }
 }
 
 template <typename Functor, typename... Fnargs>
@@ -246,52 +429,74 @@ constexpr decltype(auto) dim_dispatch(int dim, Functor f, Fnargs&&... args)
   switch (dim) {
 #if LEGION_MAX_DIM >= 1
     case 1: {
-      return f.template operator()<1>(std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(1))
+        return f.template operator()<1>(std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
 #if LEGION_MAX_DIM >= 2
     case 2: {
-      return f.template operator()<2>(std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(2))
+        return f.template operator()<2>(std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
 #if LEGION_MAX_DIM >= 3
     case 3: {
-      return f.template operator()<3>(std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(3))
+        return f.template operator()<3>(std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
 #if LEGION_MAX_DIM >= 4
     case 4: {
-      return f.template operator()<4>(std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(4))
+        return f.template operator()<4>(std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
 #if LEGION_MAX_DIM >= 5
     case 5: {
-      return f.template operator()<5>(std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(5))
+        return f.template operator()<5>(std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
 #if LEGION_MAX_DIM >= 6
     case 6: {
-      return f.template operator()<6>(std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(6))
+        return f.template operator()<6>(std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
 #if LEGION_MAX_DIM >= 7
     case 7: {
-      return f.template operator()<7>(std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(7))
+        return f.template operator()<7>(std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
 #if LEGION_MAX_DIM >= 8
     case 8: {
-      return f.template operator()<8>(std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(8))
+        return f.template operator()<8>(std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
 #if LEGION_MAX_DIM >= 9
     case 9: {
-      return f.template operator()<9>(std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_dim<Functor>(9))
+        return f.template operator()<9>(std::forward<Fnargs>(args)...);
+      break;
     }
 #endif
   }
-  assert(false);
-  return f.template operator()<1>(std::forward<Fnargs>(args)...);
+  if constexpr (detail::restricts_dispatch<Functor>)
+    return detail::unsupported_dispatch(f, std::forward<Fnargs>(args)...);
+  else {
+    assert(false);
+    return f.template operator()<1>(std::forward<Fnargs>(args)...);
+  }
 }
 
 template <typename Functor, typename... Fnargs>
@@ -299,51 +504,83 @@ constexpr decltype(auto) type_dispatch(LegateTypeCode code, Functor f, Fnargs&&.
 {
   switch (code) {
     case LegateTypeCode::BOOL_LT: {
-      return f.template operator()<LegateTypeCode::BOOL_LT>(std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_type<Functor>(LegateTypeCode::BOOL_LT))
+        return f.template operator()<LegateTypeCode::BOOL_LT>(std::forward<Fnargs>(args)...);
+      break;
     }
     case LegateTypeCode::INT8_LT: {
-      return f.template operator()<LegateTypeCode::INT8_LT>(std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_type<Functor>(LegateTypeCode::INT8_LT))
+        return f.template operator()<LegateTypeCode::INT8_LT>(std::forward<Fnargs>(args)...);
+      break;
     }
     case LegateTypeCode::INT16_LT: {
-      return f.template operator()<LegateTypeCode::INT16_LT>(std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_type<Functor>(LegateTypeCode::INT16_LT))
+        return f.template operator()<LegateTypeCode::INT16_LT>(std::forward<Fnargs>(args)...);
+      break;
     }
     case LegateTypeCode::INT32_LT: {
-      return f.template operator()<LegateTypeCode::INT32_LT>(std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_type<Functor>(LegateTypeCode::INT32_LT))
+        return f.template operator()<LegateTypeCode::INT32_LT>(std::forward<Fnargs>(args)...);
+      break;
     }
     case LegateTypeCode::INT64_LT: {
-      return f.template operator()<LegateTypeCode::INT64_LT>(std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_type<Functor>(LegateTypeCode::INT64_LT))
+        return f.template operator()<LegateTypeCode::INT64_LT>(std::forward<Fnargs>(args)...);
+      break;
     }
     case LegateTypeCode::UINT8_LT: {
-      return f.template operator()<LegateTypeCode::UINT8_LT>(std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_type<Functor>(LegateTypeCode::UINT8_LT))
+        return f.template operator()<LegateTypeCode::UINT8_LT>(std::forward<Fnargs>(args)...);
+      break;
     }
     case LegateTypeCode::UINT16_LT: {
-      return f.template operator()<LegateTypeCode::UINT16_LT>(std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_type<Functor>(LegateTypeCode::UINT16_LT))
+        return f.template operator()<LegateTypeCode::UINT16_LT>(std::forward<Fnargs>(args)...);
+      break;
     }
     case LegateTypeCode::UINT32_LT: {
-      return f.template operator()<LegateTypeCode::UINT32_LT>(std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_type<Functor>(LegateTypeCode::UINT32_LT))
+        return f.template operator()<LegateTypeCode::UINT32_LT>(std::forward<Fnargs>(args)...);
+      break;
     }
     case LegateTypeCode::UINT64_LT: {
-      return f.template operator()<LegateTypeCode::UINT64_LT>(std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_type<Functor>(LegateTypeCode::UINT64_LT))
+        return f.template operator()<LegateTypeCode::UINT64_LT>(std::forward<Fnargs>(args)...);
+      break;
     }
     case LegateTypeCode::HALF_LT: {
-      return f.template operator()<LegateTypeCode::HALF_LT>(std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_type<Functor>(LegateTypeCode::HALF_LT))
+        return f.template operator()<LegateTypeCode::HALF_LT>(std::forward<Fnargs>(args)...);
+      break;
     }
     case LegateTypeCode::FLOAT_LT: {
-      return f.template operator()<LegateTypeCode::FLOAT_LT>(std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_type<Functor>(LegateTypeCode::FLOAT_LT))
+        return f.template operator()<LegateTypeCode::FLOAT_LT>(std::forward<Fnargs>(args)...);
+      break;
     }
     case LegateTypeCode::DOUBLE_LT: {
-      return f.template operator()<LegateTypeCode::DOUBLE_LT>(std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_type<Functor>(LegateTypeCode::DOUBLE_LT))
+        return f.template operator()<LegateTypeCode::DOUBLE_LT>(std::forward<Fnargs>(args)...);
+      break;
     }
     case LegateTypeCode::COMPLEX64_LT: {
-      return f.template operator()<LegateTypeCode::COMPLEX64_LT>(std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_type<Functor>(LegateTypeCode::COMPLEX64_LT))
+        return f.template operator()<LegateTypeCode::COMPLEX64_LT>(std::forward<Fnargs>(args)...);
+      break;
     }
     case LegateTypeCode::COMPLEX128_LT: {
-      return f.template operator()<LegateTypeCode::COMPLEX128_LT>(std::forward<Fnargs>(args)...);
+      if constexpr (detail::supports_type<Functor>(LegateTypeCode::COMPLEX128_LT))
+        return f.template operator()<LegateTypeCode::COMPLEX128_LT>(std::forward<Fnargs>(args)...);
+      break;
     }
     default: break;
   }
-  assert(false);
-  return f.template operator()<LegateTypeCode::BOOL_LT>(std::forward<Fnargs>(args)...);
+  if constexpr (detail::restricts_dispatch<Functor>)
+    return detail::unsupported_dispatch(f, std::forward<Fnargs>(args)...);
+  else {
+    assert(false);
+    return f.template operator()<LegateTypeCode::BOOL_LT>(std::forward<Fnargs>(args)...);
+  }
 }
 
 }  // namespace legate
@@ -14,6 +14,8 @@
  *
  */
 
+#include <set>
+
 #include "core/utilities/machine.h"
 
 #include "core/runtime/runtime.h"
@@ -41,4 +43,84 @@ Memory::Kind find_memory_kind_for_executing_processor(bool host_accessible)
   return Memory::Kind::SYSTEM_MEM;
 }
 
+LocalMachine::LocalMachine()
+{
+  auto machine = Machine::get_machine();
+
+  Machine::ProcessorQuery local_procs(machine);
+  local_procs.local_address_space();
+  for (auto local_proc : local_procs) {
+    switch (local_proc.kind()) {
+      case Processor::LOC_PROC: {
+        cpus.push_back(local_proc);
+        break;
+      }
+      case Processor::TOC_PROC: {
+        gpus.push_back(local_proc);
+        break;
+      }
+      case Processor::OMP_PROC: {
+        omps.push_back(local_proc);
+        break;
+      }
+      default: break;
+    }
+  }
+
+  Machine::MemoryQuery local_sysmem(machine);
+  local_sysmem.local_address_space();
+  local_sysmem.only_kind(Memory::SYSTEM_MEM);
+  assert(local_sysmem.count() > 0);
+  system_memory = local_sysmem.first();
+  if (!gpus.empty()) {
+    Machine::MemoryQuery local_zcmem(machine);
+    local_zcmem.local_address_space();
+    local_zcmem.only_kind(Memory::Z_COPY_MEM);
+    assert(local_zcmem.count() > 0);
+    zerocopy_memory = local_zcmem.first();
+  }
+  for (auto& gpu : gpus) {
+    Machine::MemoryQuery local_framebuffer(machine);
+    local_framebuffer.local_address_space();
+    local_framebuffer.only_kind(Memory::GPU_FB_MEM);
+    local_framebuffer.best_affinity_to(gpu);
+    assert(local_framebuffer.count() > 0);
+    frame_buffers[gpu] = local_framebuffer.first();
+  }
+  for (auto& omp : omps) {
+    Machine::MemoryQuery local_numa(machine);
+    local_numa.local_address_space();
+    local_numa.only_kind(Memory::SOCKET_MEM);
+    local_numa.best_affinity_to(omp);
+    if (local_numa.count() > 0) {
+      has_socket_mem    = true;
+      numa_domains[omp] = local_numa.first();
+    } else
+      numa_domains[omp] = system_memory;
+  }
+
+  Machine::ProcessorQuery all_cpus(machine);
+  all_cpus.only_kind(Processor::LOC_PROC);
+  std::set<AddressSpace> spaces;
+  for (auto proc : all_cpus) spaces.insert(proc.address_space());
+  total_nodes = spaces.size();
+}
+
+bool LocalMachine::has_processors(Processor::Kind kind) const
+{
+  switch (kind) {
+    case Processor::LOC_PROC: return !cpus.empty();
+    case Processor::TOC_PROC: return !gpus.empty();
+    case Processor::OMP_PROC: return !omps.empty();
+    default: break;
+  }
+  return false;
+}
+
+/*static*/ const LocalMachine& LocalMachine::get_local_machine()
+{
+  static LocalMachine local_machine;
+  return local_machine;
+}
+
 }  // namespace legate
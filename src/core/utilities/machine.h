@@ -16,10 +16,42 @@
 
 #pragma once
 
+#include <map>
+#include <vector>
+
 #include "legion.h"
 
 namespace legate {
 
 Legion::Memory::Kind find_memory_kind_for_executing_processor(bool host_accessible = true);
 
+// Processors and memories of the local node. Querying the machine is expensive on large
+// machines, so the model is built once per process and shared by all mappers.
+struct LocalMachine {
+ public:
+  std::vector<Legion::Processor> cpus{};
+  std::vector<Legion::Processor> gpus{};
+  std::vector<Legion::Processor> omps{};
+
+ public:
+  Legion::Memory system_memory{Legion::Memory::NO_MEMORY};
+  Legion::Memory zerocopy_memory{Legion::Memory::NO_MEMORY};
+  std::map<Legion::Processor, Legion::Memory> frame_buffers{};
+  // NUMA domain of each OpenMP processor, which is the system memory when there's no NUMA memory
+  std::map<Legion::Processor, Legion::Memory> numa_domains{};
+  bool has_socket_mem{false};
+
+ public:
+  size_t total_nodes{0};
+
+ public:
+  bool has_processors(Legion::Processor::Kind kind) const;
+
+ public:
+  static const LocalMachine& get_local_machine();
+
+ private:
+  LocalMachine();
+};
+
 }  // namespace legate
@@ -0,0 +1,208 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+#include "core/runtime/runtime.h"
+#include "core/utilities/memory_usage.h"
+
+namespace legate {
+
+using namespace Legion;
+
+struct Counter {
+  size_t current{0};
+  size_t peak{0};
+
+  void add(size_t bytes)
+  {
+    current += bytes;
+    peak = std::max(peak, current);
+  }
+  void remove(size_t bytes) { current -= std::min(current, bytes); }
+};
+
+struct MemoryCounters {
+  Counter total{};
+  Counter instances{};
+  Counter temporaries{};
+  std::map<std::string, Counter> libraries{};
+  std::map<std::pair<RegionTreeID, FieldID>, Counter> fields{};
+};
+
+struct Temporary {
+  Memory memory;
+  size_t bytes;
+};
+
+static std::mutex usage_lock;
+static std::map<Memory, MemoryCounters> usages;
+
+// Buffers created by the task running on this thread that haven't been destroyed yet
+static std::unordered_map<const void*, Temporary>& get_local_temporaries()
+{
+  thread_local std::unordered_map<const void*, Temporary> temporaries;
+  return temporaries;
+}
+
+// Finds the memory that create_buffer allocates from for the kind, which is the one with the
+// best affinity to the executing processor
+static Memory find_local_memory(Memory::Kind kind)
+{
+  thread_local Processor cached_proc = Processor::NO_PROC;
+  thread_local std::map<Memory::Kind, Memory> cached_memories;
+
+  auto proc = Processor::get_executing_processor();
+  if (proc != cached_proc) {
+    cached_memories.clear();
+    cached_proc = proc;
+  }
+  auto finder = cached_memories.find(kind);
+  if (finder != cached_memories.end()) return finder->second;
+
+  Machine::MemoryQuery query(Machine::get_machine());
+  query.only_kind(kind).local_address_space().best_affinity_to(proc);
+  auto memory = query.count() > 0 ? query.first() : Memory::NO_MEMORY;
+  cached_memories[kind] = memory;
+  return memory;
+}
+
+/*static*/ bool MemoryUsage::enabled()
+{
+  static const bool result = extract_env("LEGATE_MEMORY_USAGE", 0, 0) > 0;
+  return result;
+}
+
+/*static*/ void MemoryUsage::add_instance(Memory memory,
+                                          const std::string& library,
+                                          RegionTreeID tree_id,
+                                          FieldID field_id,
+                                          size_t bytes)
+{
+  if (!enabled()) return;
+  std::lock_guard<std::mutex> guard(usage_lock);
+  auto& usage = usages[memory];
+  usage.total.add(bytes);
+  usage.instances.add(bytes);
+  usage.libraries[library].add(bytes);
+  usage.fields[std::make_pair(tree_id, field_id)].add(bytes);
+}
+
+/*static*/ void MemoryUsage::remove_instance(Memory memory,
+                                             const std::string& library,
+                                             RegionTreeID tree_id,
+                                             FieldID field_id,
+                                             size_t bytes)
+{
+  if (!enabled()) return;
+  std::lock_guard<std::mutex> guard(usage_lock);
+  auto& usage = usages[memory];
+  usage.total.remove(bytes);
+  usage.instances.remove(bytes);
+  usage.libraries[library].remove(bytes);
+  auto finder = usage.fields.find(std::make_pair(tree_id, field_id));
+  if (finder == usage.fields.end()) return;
+  finder->second.remove(bytes);
+  if (0 == finder->second.current) usage.fields.erase(finder);
+}
+
+/*static*/ void MemoryUsage::add_temporary(const void* ptr, Memory::Kind kind, size_t bytes)
+{
+  if (!enabled()) return;
+  auto memory = find_local_memory(kind);
+  get_local_temporaries()[ptr] = Temporary{memory, bytes};
+
+  std::lock_guard<std::mutex> guard(usage_lock);
+  auto& usage = usages[memory];
+  usage.total.add(bytes);
+  usage.temporaries.add(bytes);
+}
+
+/*static*/ void MemoryUsage::remove_temporary(const void* ptr)
+{
+  if (!enabled()) return;
+  auto& temporaries = get_local_temporaries();
+  auto finder       = temporaries.find(ptr);
+  if (finder == temporaries.end()) return;
+  auto temporary = finder->second;
+  temporaries.erase(finder);
+
+  std::lock_guard<std::mutex> guard(usage_lock);
+  auto& usage = usages[temporary.memory];
+  usage.total.remove(temporary.bytes);
+  usage.temporaries.remove(temporary.bytes);
+}
+
+/*static*/ void MemoryUsage::release_task_temporaries()
+{
+  if (!enabled()) return;
+  auto& temporaries = get_local_temporaries();
+  if (temporaries.empty()) return;
+
+  std::lock_guard<std::mutex> guard(usage_lock);
+  for (auto& pair : temporaries) {
+    auto& usage = usages[pair.second.memory];
+    usage.total.remove(pair.second.bytes);
+    usage.temporaries.remove(pair.second.bytes);
+  }
+  temporaries.clear();
+}
+
+/*static*/ std::vector<MemoryUsage::Entry> MemoryUsage::snapshot()
+{
+  std::vector<Entry> entries;
+  std::lock_guard<std::mutex> guard(usage_lock);
+  for (auto& [memory, usage] : usages) {
+    auto add_entry = [&](Category category, std::string name, const Counter& counter) {
+      entries.push_back(Entry{memory, category, std::move(name), counter.current, counter.peak});
+    };
+    add_entry(Category::TOTAL, "", usage.total);
+    add_entry(Category::INSTANCES, "", usage.instances);
+    add_entry(Category::TEMPORARIES, "", usage.temporaries);
+    for (auto& [library, counter] : usage.libraries) add_entry(Category::LIBRARY, library, counter);
+    for (auto& [field, counter] : usage.fields)
+      add_entry(Category::FIELD,
+                std::to_string(field.first) + ":" + std::to_string(field.second),
+                counter);
+  }
+  return entries;
+}
+
+/*static*/ std::string MemoryUsage::summary()
+{
+  static const char* memory_kinds[] = {
+#define MEM_NAMES(name, desc) desc,
+    REALM_MEMORY_KINDS(MEM_NAMES)
+#undef MEM_NAMES
+  };
+  static const char* categories[] = {"total", "instances", "temporaries", "library", "field"};
+
+  std::stringstream ss;
+  ss << "memory,kind,capacity,category,name,current_bytes,peak_bytes\n";
+  for (auto& entry : snapshot()) {
+    ss << std::hex << "0x" << entry.memory.id << std::dec << ","
+       << memory_kinds[entry.memory.kind()] << "," << entry.memory.capacity() << ","
+       << categories[static_cast<int32_t>(entry.category)] << "," << entry.name << ","
+       << entry.current_bytes << "," << entry.peak_bytes << "\n";
+  }
+  return ss.str();
+}
+
+}  // namespace legate
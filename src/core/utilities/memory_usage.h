@@ -0,0 +1,82 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "legion.h"
+
+namespace legate {
+
+// Current and peak bytes in use in each local memory, which is cheap enough to sample
+// periodically. The usage consists of the instances the mappers cached for stores, broken down
+// by the library whose mapper created them and by the field of the store, and of the temporary
+// buffers tasks created with create_buffer. Temporary buffers that aren't destroyed explicitly
+// are accounted until the task that created them finishes. Instances Legion collects are
+// retracted when the mapper next creates an instance in the same memory, which is when Legion
+// collects instances to make room. The accounting is off unless LEGATE_MEMORY_USAGE is set to
+// a positive value; until then, none of the calls below do anything.
+class MemoryUsage {
+ public:
+  enum class Category : int32_t {
+    TOTAL       = 0,
+    INSTANCES   = 1,
+    TEMPORARIES = 2,
+    LIBRARY     = 3,
+    FIELD       = 4,
+  };
+
+  struct Entry {
+    Legion::Memory memory;
+    Category category;
+    // The library name for LIBRARY entries, "<tree id>:<field id>" for FIELD entries, and
+    // empty otherwise. FIELD entries are kept only while the field has instances.
+    std::string name;
+    size_t current_bytes;
+    size_t peak_bytes;
+  };
+
+ public:
+  static bool enabled();
+
+ public:
+  static void add_instance(Legion::Memory memory,
+                           const std::string& library,
+                           Legion::RegionTreeID tree_id,
+                           Legion::FieldID field_id,
+                           size_t bytes);
+  static void remove_instance(Legion::Memory memory,
+                              const std::string& library,
+                              Legion::RegionTreeID tree_id,
+                              Legion::FieldID field_id,
+                              size_t bytes);
+
+ public:
+  // Temporary buffers are identified by their base pointers
+  static void add_temporary(const void* ptr, Legion::Memory::Kind kind, size_t bytes);
+  static void remove_temporary(const void* ptr);
+  // Releases the temporary buffers the executing task didn't destroy
+  static void release_task_temporaries();
+
+ public:
+  static std::vector<Entry> snapshot();
+  // Returns the snapshot as CSV text with one row per entry
+  static std::string summary();
+};
+
+}  // namespace legate
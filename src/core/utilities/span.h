@@ -41,6 +41,8 @@ struct Span {
   }
   const T* begin() const { return &data_[0]; }
   const T* end() const { return &data_[size_]; }
+  T* begin() { return &data_[0]; }
+  T* end() { return &data_[size_]; }
 
  public:
   decltype(auto) subspan(size_t off)
@@ -0,0 +1,148 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <unistd.h>
+
+#include "legion.h"
+
+#include "core/runtime/runtime.h"
+#include "core/utilities/trace.h"
+
+namespace legate {
+namespace trace {
+
+bool record_events = false;
+
+static uint32_t ring_capacity = 0;
+
+struct Event {
+  const char* name;
+  uint64_t start;
+  uint64_t end;
+};
+
+// Each thread owns its ring, so recording never takes a lock
+struct Ring {
+  std::vector<Event> events;
+  uint64_t num_recorded{0};
+};
+
+static std::mutex rings_lock;
+static std::vector<std::unique_ptr<Ring>> rings;
+
+static Ring& get_local_ring()
+{
+  thread_local Ring* ring = nullptr;
+  if (nullptr == ring) {
+    std::lock_guard<std::mutex> guard(rings_lock);
+    rings.push_back(std::make_unique<Ring>());
+    ring = rings.back().get();
+    ring->events.resize(ring_capacity);
+  }
+  return *ring;
+}
+
+void initialize()
+{
+  ring_capacity = extract_env("LEGATE_TRACE_EVENTS", 0, 0);
+  record_events = ring_capacity > 0;
+}
+
+uint64_t now() { return Realm::Clock::current_time_in_nanoseconds(); }
+
+void record_event(const char* name, uint64_t start, uint64_t end)
+{
+  auto& ring = get_local_ring();
+  auto& slot = ring.events[ring.num_recorded++ % ring.events.size()];
+  slot       = Event{name, start, end};
+}
+
+#ifdef LEGATE_USE_ITT
+__itt_domain* get_itt_domain()
+{
+  static __itt_domain* domain = __itt_domain_create("legate");
+  return domain;
+}
+
+__itt_string_handle* get_itt_string_handle(const char* name)
+{
+  // Range names are string literals, so each thread caches the handles by their addresses
+  // instead of going through the lock and the name lookup in __itt_string_handle_create
+  thread_local std::unordered_map<const char*, __itt_string_handle*> handles;
+  auto finder = handles.find(name);
+  if (finder != handles.end()) return finder->second;
+  auto handle   = __itt_string_handle_create(name);
+  handles[name] = handle;
+  return handle;
+}
+#endif
+
+static void write_escaped(std::ostream& out, const char* str)
+{
+  for (; *str != '\0'; ++str) {
+    if (*str == '"' || *str == '\\') out << '\\';
+    out << *str;
+  }
+}
+
+void finalize()
+{
+  if (!record_events) return;
+  record_events = false;
+
+  std::string filename;
+  const char* env = getenv("LEGATE_TRACE_FILE");
+  if (env != nullptr)
+    filename = env;
+  else
+    filename = "legate_trace." + std::to_string(getpid()) + ".json";
+
+  std::ofstream out(filename);
+  if (!out) {
+    log_legate.error("Failed to open %s to write the trace", filename.c_str());
+    return;
+  }
+
+  // Timestamps in the Chrome trace format are in microseconds
+  out << "{\"traceEvents\":[";
+  bool first = true;
+  std::lock_guard<std::mutex> guard(rings_lock);
+  for (uint32_t tid = 0; tid < rings.size(); ++tid) {
+    auto& ring         = *rings[tid];
+    uint64_t num_valid = std::min<uint64_t>(ring.num_recorded, ring.events.size());
+    for (uint64_t idx = ring.num_recorded - num_valid; idx < ring.num_recorded; ++idx) {
+      auto& event = ring.events[idx % ring.events.size()];
+      out << (first ? "\n" : ",\n") << "{\"name\":\"";
+      write_escaped(out, event.name);
+      out << "\",\"ph\":\"X\",\"pid\":" << getpid() << ",\"tid\":" << tid
+          << ",\"ts\":" << event.start / 1e3 << ",\"dur\":" << (event.end - event.start) / 1e3
+          << "}";
+      first = false;
+    }
+  }
+  out << "\n]}\n";
+}
+
+}  // namespace trace
+}  // namespace legate
@@ -0,0 +1,86 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#ifdef LEGATE_USE_CUDA
+#include <nvtx3/nvToolsExt.h>
+#endif
+#ifdef LEGATE_USE_ITT
+#include <ittnotify.h>
+#endif
+
+namespace legate {
+namespace trace {
+
+// Ranges are emitted to NVTX in CUDA builds and to ITT when built with LEGATE_USE_ITT, so
+// they show up in Nsight Systems and VTune respectively. Independently of the build, setting
+// LEGATE_TRACE_EVENTS to N makes each thread keep its last N ranges in a ring buffer, which
+// is written at shutdown to LEGATE_TRACE_FILE (legate_trace.<pid>.json by default) in the
+// Chrome trace format that Perfetto loads.
+void initialize();
+void finalize();
+
+extern bool record_events;
+
+uint64_t now();
+void record_event(const char* name, uint64_t start, uint64_t end);
+
+#ifdef LEGATE_USE_ITT
+__itt_domain* get_itt_domain();
+__itt_string_handle* get_itt_string_handle(const char* name);
+#endif
+
+class Range {
+ public:
+  // The name must outlive the program, as the ring buffers keep the pointer
+  Range(const char* name) : name_(name)
+  {
+#ifdef LEGATE_USE_CUDA
+    nvtx_range_ = nvtxRangeStartA(name);
+#endif
+#ifdef LEGATE_USE_ITT
+    __itt_task_begin(get_itt_domain(), __itt_null, __itt_null, get_itt_string_handle(name));
+#endif
+    if (record_events) start_ = now();
+  }
+  ~Range()
+  {
+    if (record_events) record_event(name_, start_, now());
+#ifdef LEGATE_USE_ITT
+    __itt_task_end(get_itt_domain());
+#endif
+#ifdef LEGATE_USE_CUDA
+    nvtxRangeEnd(nvtx_range_);
+#endif
+  }
+
+ public:
+  Range(const Range&)            = delete;
+  Range& operator=(const Range&) = delete;
+
+ private:
+  const char* name_;
+  uint64_t start_{0};
+#ifdef LEGATE_USE_CUDA
+  nvtxRangeId_t nvtx_range_;
+#endif
+};
+
+}  // namespace trace
+}  // namespace legate
@@ -53,6 +53,8 @@ template <>
 static constexpr LegateTypeCode legate_type_code_of<complex<float>> = COMPLEX64_LT;
 template <>
 static constexpr LegateTypeCode legate_type_code_of<complex<double>> = COMPLEX128_LT;
+template <>
+static constexpr LegateTypeCode legate_type_code_of<Legion::Rect<1>> = RECT1_LT;
 #else  // not clang
 template <class>
 constexpr LegateTypeCode legate_type_code_of = MAX_TYPE_NUMBER;
@@ -85,6 +87,8 @@ template <>
 constexpr LegateTypeCode legate_type_code_of<complex<float>> = COMPLEX64_LT;
 template <>
 constexpr LegateTypeCode legate_type_code_of<complex<double>> = COMPLEX128_LT;
+template <>
+constexpr LegateTypeCode legate_type_code_of<Legion::Rect<1>> = RECT1_LT;
 #endif
 
 template <LegateTypeCode CODE>
@@ -147,6 +151,10 @@ template <>
 struct LegateTypeOf<LegateTypeCode::COMPLEX128_LT> {
   using type = complex<double>;
 };
+template <>
+struct LegateTypeOf<LegateTypeCode::RECT1_LT> {
+  using type = Legion::Rect<1>;
+};
 
 template <LegateTypeCode CODE>
 using legate_type_of = typename LegateTypeOf<CODE>::type;
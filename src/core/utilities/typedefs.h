@@ -33,6 +33,16 @@ using AccessorRW = Legion::FieldAccessor<READ_WRITE, FT, N, T, Realm::AffineAcce
 template <typename REDOP, bool EXCLUSIVE, int N, typename T = Legion::coord_t>
 using AccessorRD = Legion::
   ReductionAccessor<REDOP, EXCLUSIVE, N, T, Realm::AffineAccessor<typename REDOP::RHS, N, T>>;
+// Accessors for instances made of multiple affine pieces, such as the tiled instances
+template <typename FT, int N, typename T = Legion::coord_t>
+using TiledAccessorRO =
+  Legion::FieldAccessor<READ_ONLY, FT, N, T, Realm::MultiAffineAccessor<FT, N, T>>;
+template <typename FT, int N, typename T = Legion::coord_t>
+using TiledAccessorWO =
+  Legion::FieldAccessor<WRITE_DISCARD, FT, N, T, Realm::MultiAffineAccessor<FT, N, T>>;
+template <typename FT, int N, typename T = Legion::coord_t>
+using TiledAccessorRW =
+  Legion::FieldAccessor<READ_WRITE, FT, N, T, Realm::MultiAffineAccessor<FT, N, T>>;
 template <typename FT, int N, typename T = Legion::coord_t>
 using GenericAccessorRO = Legion::FieldAccessor<READ_ONLY, FT, N, T>;
 template <typename FT, int N, typename T = Legion::coord_t>
@@ -18,10 +18,15 @@
 
 #include "legion.h"
 // legion.h has to go before these
+#include "core/comm/collectives.h"
 #include "core/data/allocator.h"
+#include "core/data/buffer_pool.h"
+#include "core/data/reduction.h"
 #include "core/data/scalar.h"
 #include "core/data/store.h"
+#include "core/data/string_store.h"
 #include "core/legate_c.h"
+#include "core/runtime/launcher.h"
 #include "core/runtime/runtime.h"
 #include "core/task/task.h"
 #include "core/utilities/deserializer.h"
@@ -0,0 +1,46 @@
+/* Copyright 2022 NVIDIA Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "legate.h"
+
+#include "core/mapping/mapping.h"
+
+namespace legate {
+namespace mapping {
+
+TEST(DimOrdering, CustomOrder)
+{
+  DimOrdering ordering;
+  ordering.custom_order({2, 0, 1});
+  EXPECT_EQ(ordering.kind, DimOrdering::Kind::CUSTOM);
+  EXPECT_EQ(ordering.dims, (std::vector<int32_t>{2, 0, 1}));
+  EXPECT_TRUE(ordering.requested);
+  EXPECT_EQ(ordering.dimensions(3), (std::vector<int32_t>{2, 0, 1}));
+}
+
+TEST(DimOrdering, CustomOrderAfterAnyOrder)
+{
+  DimOrdering ordering;
+  ordering.any_order();
+  ordering.custom_order({1, 0});
+  EXPECT_EQ(ordering.kind, DimOrdering::Kind::CUSTOM);
+  EXPECT_EQ(ordering.dims, (std::vector<int32_t>{1, 0}));
+}
+
+}  // namespace mapping
+}  // namespace legate
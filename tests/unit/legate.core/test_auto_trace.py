@@ -0,0 +1,121 @@
+# Copyright 2022 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import ctypes
+import struct
+
+import numpy as np
+import pytest
+
+from legate.core import get_legate_runtime, types as ty
+from legate.core.runtime import AutoTracer
+from legate.core.solver import Partitioner
+
+
+class Test_AutoTracer:
+    def test_replay(self) -> None:
+        runtime = get_legate_runtime()
+        context = runtime.core_context
+        tracer = AutoTracer(runtime, 4)
+        src = context.create_store(ty.int64, shape=(4,))
+        dst = context.create_store(ty.int64, shape=(4,))
+        # Allocates the fields, so the stores are named by them in the
+        # signatures from the start
+        assert src.storage is not None
+        assert dst.storage is not None
+
+        # The loop body repeats from the second iteration, and the ones
+        # after that are replayed in traces
+        for i in range(4):
+            future = runtime.create_future(struct.pack("q", i), 8)
+            value = context.create_store(
+                ty.int64, shape=(1,), storage=future, optimize_scalar=True
+            )
+            fill = context.create_fill(src, value)
+            copy = context.create_copy()
+            copy.add_input(src)
+            copy.add_output(dst)
+            for op in (fill, copy):
+                tracer.launch(op, Partitioner([op]).partition_stores())
+        assert tracer.num_traces == 2
+
+        alloc = dst.get_inline_allocation()
+        values = alloc.consume(
+            lambda shape, ptr, strides: np.ndarray(
+                shape,
+                dtype=np.int64,
+                buffer=(ctypes.c_int64 * 4).from_address(ptr),
+                strides=strides,
+            )
+        )
+        assert (values == 3).all()
+
+    def test_different_stores(self) -> None:
+        runtime = get_legate_runtime()
+        context = runtime.core_context
+        tracer = AutoTracer(runtime, 4)
+        future = runtime.create_future(struct.pack("q", 1), 8)
+        value = context.create_store(
+            ty.int64, shape=(1,), storage=future, optimize_scalar=True
+        )
+        # Each fill writes a store the others don't, so nothing repeats. The
+        # stores are kept alive so that their fields aren't recycled.
+        stores = [context.create_store(ty.int64, shape=(4,)) for _ in range(4)]
+        for store in stores:
+            assert store.storage is not None
+            fill = context.create_fill(store, value)
+            tracer.launch(fill, Partitioner([fill]).partition_stores())
+        assert tracer.num_traces == 0
+
+    def test_flush(self) -> None:
+        runtime = get_legate_runtime()
+        context = runtime.core_context
+        tracer = AutoTracer(runtime, 4)
+        store = context.create_store(ty.int64, shape=(4,))
+        assert store.storage is not None
+
+        for i in range(3):
+            future = runtime.create_future(struct.pack("q", i), 8)
+            value = context.create_store(
+                ty.int64, shape=(1,), storage=future, optimize_scalar=True
+            )
+            fill = context.create_fill(store, value)
+            copy = context.create_copy()
+            copy.add_input(store)
+            copy.add_output(context.create_store(ty.int64, shape=(4,)))
+            ops = (fill, copy) if i < 2 else (fill,)
+            for op in ops:
+                tracer.launch(op, Partitioner([op]).partition_stores())
+        # The last fill matches the start of the repeated sequence, so it
+        # is held back until the flush
+        tracer.flush()
+        assert tracer.num_traces == 0
+
+        alloc = store.get_inline_allocation()
+        values = alloc.consume(
+            lambda shape, ptr, strides: np.ndarray(
+                shape,
+                dtype=np.int64,
+                buffer=(ctypes.c_int64 * 4).from_address(ptr),
+                strides=strides,
+            )
+        )
+        assert (values == 2).all()
+
+
+if __name__ == "__main__":
+    import sys
+
+    sys.exit(pytest.main(sys.argv))
@@ -0,0 +1,101 @@
+# Copyright 2022 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+from typing import Any
+
+import pytest
+
+from legate.core import get_legate_runtime, types as ty
+from legate.core.partition import Tiling
+from legate.core.shape import Shape
+from legate.core.store import Store
+
+OLD = Tiling(Shape((5,)), Shape((2,)))
+NEW = Tiling(Shape((6,)), Shape((2,)))
+
+
+def create_store(dtype: Any = ty.int64, compress: bool = True) -> Store:
+    context = get_legate_runtime().core_context
+    store = context.create_store(dtype, shape=(10,))
+    # Allocates the field, as the shuffle only moves data that exists
+    assert store.storage is not None
+    store.set_key_partition(OLD)
+    store.set_compress_transfers(compress)
+    return store
+
+
+class Test_can_compress_transfer:
+    def test_retiling(self) -> None:
+        store = create_store()
+        assert store.compress_transfers
+        assert store.can_compress_transfer(NEW)
+
+    def test_not_opted_in(self) -> None:
+        store = create_store(compress=False)
+        assert not store.can_compress_transfer(NEW)
+
+    def test_same_partition(self) -> None:
+        store = create_store()
+        assert not store.can_compress_transfer(OLD)
+
+    def test_different_color_shape(self) -> None:
+        store = create_store()
+        assert not store.can_compress_transfer(
+            Tiling(Shape((4,)), Shape((3,)))
+        )
+
+    def test_incomplete(self) -> None:
+        store = create_store()
+        assert not store.can_compress_transfer(
+            Tiling(Shape((4,)), Shape((2,)))
+        )
+
+    def test_element_sizes(self) -> None:
+        store = create_store(dtype=ty.complex128)
+        assert store.can_compress_transfer(NEW)
+        store = create_store(dtype=ty.bool_)
+        assert store.can_compress_transfer(NEW)
+
+    def test_transformed(self) -> None:
+        store = create_store()
+        promoted = store.promote(0, 1)
+        assert not promoted.can_compress_transfer(
+            Tiling(Shape((1, 6)), Shape((1, 2)))
+        )
+
+    def test_too_large(self) -> None:
+        # Each task of the shuffle would receive 2GB
+        extent = 2**28 + 2
+        context = get_legate_runtime().core_context
+        store = context.create_store(ty.int64, shape=(extent,))
+        assert store.storage is not None
+        store.set_key_partition(Tiling(Shape((extent // 2,)), Shape((2,))))
+        store.set_compress_transfers()
+        assert not store.can_compress_transfer(
+            Tiling(Shape((2**28,)), Shape((2,)))
+        )
+
+    def test_no_data(self) -> None:
+        context = get_legate_runtime().core_context
+        store = context.create_store(ty.int64, shape=(10,))
+        store.set_key_partition(OLD)
+        store.set_compress_transfers()
+        assert not store.can_compress_transfer(NEW)
+
+
+if __name__ == "__main__":
+    import sys
+
+    sys.exit(pytest.main(sys.argv))
@@ -0,0 +1,78 @@
+# Copyright 2022 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import math
+
+import pytest
+
+from legate.core import get_legate_runtime
+from legate.core.cost_model import DefaultCostModel, enumerate_launch_shapes
+
+
+class Test_enumerate_launch_shapes:
+    def test_all_grids(self) -> None:
+        shapes = set(enumerate_launch_shapes((4, 4), 4))
+        assert shapes == {(1, 4), (2, 2), (4, 1)}
+
+    def test_small_extents(self) -> None:
+        shapes = set(enumerate_launch_shapes((2, 8), 4))
+        assert shapes == {(1, 4), (2, 2)}
+
+    def test_no_grid(self) -> None:
+        assert list(enumerate_launch_shapes((1, 1), 4)) == []
+
+
+class Test_DefaultCostModel:
+    def test_square_tiles(self) -> None:
+        model = DefaultCostModel(0, 100, 10)
+        square = model.estimate((100, 100), (4, 4), 8, None)
+        skinny = model.estimate((100, 100), (16, 1), 8, None)
+        assert square < skinny
+
+    def test_piece_memory(self) -> None:
+        model = DefaultCostModel(1000, 100, 10)
+        assert math.isinf(model.estimate((100, 100), (2, 2), 8, None))
+        assert not math.isinf(model.estimate((100, 100), (10, 10), 8, None))
+
+    def test_repartition(self) -> None:
+        model = DefaultCostModel(0, 100, 10)
+        kept = model.estimate((100, 100), (2, 2), 8, (2, 2))
+        moved = model.estimate((100, 100), (2, 2), 8, (4, 1))
+        assert kept < moved
+
+    def test_unknown_bandwidths(self) -> None:
+        model = DefaultCostModel(0, 0, 0)
+        assert math.isfinite(model.estimate((100, 100), (2, 2), 8, None))
+
+
+class Test_set_cost_model:
+    def test_clears_solutions(self) -> None:
+        partition_manager = get_legate_runtime().partition_manager
+        partition_manager.record_solution("test_clears_solutions", 1)
+        try:
+            partition_manager.set_cost_model(DefaultCostModel(0, 100, 10))
+            assert (
+                partition_manager.find_solution("test_clears_solutions")
+                is None
+            )
+        finally:
+            # The cost model is off unless -legate:cost-model is passed
+            partition_manager.set_cost_model(None)
+
+
+if __name__ == "__main__":
+    import sys
+
+    sys.exit(pytest.main(sys.argv))
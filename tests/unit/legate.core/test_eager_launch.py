@@ -0,0 +1,78 @@
+# Copyright 2022 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import pytest
+
+from legate.core import get_legate_runtime, types as ty
+from legate.core.partition import Replicate
+from legate.core.solver import Strategy
+
+
+class Test_can_launch_eagerly:
+    def test_disabled(self, monkeypatch: pytest.MonkeyPatch) -> None:
+        runtime = get_legate_runtime()
+        monkeypatch.setattr(runtime, "eager_threshold", 0)
+        context = runtime.core_context
+        task = context.create_auto_task(0)
+        task.add_input(context.create_store(ty.int64, shape=(1,)))
+        assert not runtime.can_launch_eagerly(task)
+
+    def test_large_store(self, monkeypatch: pytest.MonkeyPatch) -> None:
+        runtime = get_legate_runtime()
+        monkeypatch.setattr(runtime, "eager_threshold", 16)
+        context = runtime.core_context
+        task = context.create_auto_task(0)
+        task.add_input(context.create_store(ty.int64, shape=(16,)))
+        task.add_input(context.create_store(ty.int64, shape=(17,)))
+        assert not runtime.can_launch_eagerly(task)
+
+    def test_unbound_output(self, monkeypatch: pytest.MonkeyPatch) -> None:
+        runtime = get_legate_runtime()
+        monkeypatch.setattr(runtime, "eager_threshold", 16)
+        context = runtime.core_context
+        task = context.create_auto_task(0)
+        task.add_output(context.create_store(ty.int64))
+        assert not runtime.can_launch_eagerly(task)
+
+    def test_no_cpu_variant(self, monkeypatch: pytest.MonkeyPatch) -> None:
+        runtime = get_legate_runtime()
+        monkeypatch.setattr(runtime, "eager_threshold", 16)
+        context = runtime.core_context
+        # The core task that extracts scalars is registered directly with
+        # Legion, not as a Legate task with a CPU variant
+        task = context.create_auto_task(
+            runtime.core_library.LEGATE_CORE_EXTRACT_SCALAR_TASK_ID
+        )
+        task.add_input(context.create_store(ty.int64, shape=(1,)))
+        assert not runtime.can_launch_eagerly(task)
+
+
+class Test_replicated_strategy:
+    def test_replicates_all_stores(self) -> None:
+        context = get_legate_runtime().core_context
+        task = context.create_auto_task(0)
+        task.add_input(context.create_store(ty.int64, shape=(16,)))
+        task.add_output(context.create_store(ty.int64, shape=(16,)))
+        strategy = Strategy.replicated(task.all_unknowns)
+        assert not strategy.parallel
+        assert strategy.launch_domain is None
+        for part in task.all_unknowns:
+            assert isinstance(strategy.get_partition(part), Replicate)
+
+
+if __name__ == "__main__":
+    import sys
+
+    sys.exit(pytest.main(sys.argv))
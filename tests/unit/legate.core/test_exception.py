@@ -0,0 +1,65 @@
+# Copyright 2022 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import struct
+
+import pytest
+
+from legate.core import get_legate_runtime
+
+
+class Test_poll_exceptions:
+    def test_raises(self) -> None:
+        runtime = get_legate_runtime()
+        # The payload of a task that raised the first of its exception types
+        message = b"foo"
+        buf = struct.pack("?", True) + struct.pack("iI", 0, len(message))
+        buf += message
+        future = runtime.create_future(buf, len(buf))
+        runtime.record_pending_exception([ValueError], future)
+        with pytest.raises(ValueError, match="foo"):
+            runtime.poll_exceptions()
+        # The exception is raised only once
+        runtime.raise_exceptions()
+
+    def test_not_raised(self) -> None:
+        runtime = get_legate_runtime()
+        buf = struct.pack("?", False)
+        future = runtime.create_future(buf, len(buf))
+        runtime.record_pending_exception([ValueError], future)
+        runtime.poll_exceptions()
+        runtime.raise_exceptions()
+
+    def test_in_program_order(self) -> None:
+        runtime = get_legate_runtime()
+        buf = struct.pack("?", False)
+        runtime.record_pending_exception(
+            [ValueError], runtime.create_future(buf, len(buf))
+        )
+        message = b"foo"
+        buf = struct.pack("?", True) + struct.pack("iI", 1, len(message))
+        buf += message
+        runtime.record_pending_exception(
+            [ValueError, TypeError], runtime.create_future(buf, len(buf))
+        )
+        # The operation that didn't raise is skipped over
+        with pytest.raises(TypeError, match="foo"):
+            runtime.poll_exceptions()
+
+
+if __name__ == "__main__":
+    import sys
+
+    sys.exit(pytest.main(sys.argv))
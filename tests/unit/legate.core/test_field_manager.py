@@ -0,0 +1,81 @@
+# Copyright 2022 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import pytest
+
+from legate.core import get_legate_runtime
+from legate.core.runtime import FieldManager
+from legate.core.shape import Shape
+
+
+class Test_adaptive_field_reuse:
+    def test_keeps_recently_allocated(
+        self, monkeypatch: pytest.MonkeyPatch
+    ) -> None:
+        runtime = get_legate_runtime()
+        monkeypatch.setattr(runtime, "adaptive_field_reuse", True)
+        manager = FieldManager(runtime, Shape((10,)), 8)
+
+        fields = [manager.allocate_field() for _ in range(10)]
+        for region, field_id in fields:
+            manager.free_field(region, field_id, ordered=True)
+        # All ten fields were allocated recently, so all of them are kept
+        assert len(manager.free_fields) == 10
+
+    def test_trims_unused(self, monkeypatch: pytest.MonkeyPatch) -> None:
+        runtime = get_legate_runtime()
+        monkeypatch.setattr(runtime, "adaptive_field_reuse", True)
+        manager = FieldManager(runtime, Shape((10,)), 8)
+
+        fields = [manager.allocate_field() for _ in range(10)]
+        for region, field_id in fields:
+            manager.free_field(region, field_id, ordered=True)
+
+        # The shape sees a single allocation at a time from here on. Once
+        # enough allocations of other shapes have passed, the free fields
+        # kept for the earlier burst are destroyed.
+        num_allocations = runtime.num_field_allocations
+        for _ in range(2):
+            num_allocations += 1 << 20
+            monkeypatch.setattr(
+                runtime, "num_field_allocations", num_allocations
+            )
+            region, field_id = manager.allocate_field()
+            manager.free_field(region, field_id, ordered=True)
+        assert 0 < len(manager.free_fields) < 10
+
+    def test_disabled(self, monkeypatch: pytest.MonkeyPatch) -> None:
+        runtime = get_legate_runtime()
+        monkeypatch.setattr(runtime, "adaptive_field_reuse", False)
+        manager = FieldManager(runtime, Shape((10,)), 8)
+
+        fields = [manager.allocate_field() for _ in range(10)]
+        for region, field_id in fields:
+            manager.free_field(region, field_id, ordered=True)
+        monkeypatch.setattr(
+            runtime,
+            "num_field_allocations",
+            runtime.num_field_allocations + (1 << 20),
+        )
+        region, field_id = manager.allocate_field()
+        manager.free_field(region, field_id, ordered=True)
+        # Without adaptive reuse, every freed field is kept
+        assert len(manager.free_fields) == 10
+
+
+if __name__ == "__main__":
+    import sys
+
+    sys.exit(pytest.main(sys.argv))
@@ -0,0 +1,145 @@
+# Copyright 2022 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+from __future__ import annotations
+
+import ctypes
+from pathlib import Path
+
+import numpy as np
+import pytest
+
+from legate.core import Point, Rect, export, ingest, types as ty
+from legate.core.io import BinaryFileReader, BinaryFileWriter, TiledSplit
+from legate.core.shape import Shape
+
+ARRAY = np.arange(24, dtype=np.int64).reshape(4, 6)
+
+
+class Test_TiledSplit:
+    def test_get_subdomain(self) -> None:
+        split = TiledSplit((2, 4))
+        rect = split.get_subdomain(Shape((4, 6)), Point([1, 1]))
+        assert rect == Rect([3, 5], [2, 4], exclusive=False)
+
+
+class Test_ingest_BinaryFileReader:
+    # Blocks of whole rows are attached in place, whereas blocks of columns
+    # are gathered into new buffers
+    @pytest.mark.parametrize(
+        "colors,tile_shape", [((2, 1), (2, 6)), ((1, 2), (4, 3))]
+    )
+    def test_tiles(
+        self,
+        tmp_path: Path,
+        colors: tuple[int, int],
+        tile_shape: tuple[int, int],
+    ) -> None:
+        path = tmp_path / "array.bin"
+        ARRAY.tofile(path)
+        reader = BinaryFileReader(path, np.int64, (4, 6), num_threads=2)
+        table = ingest(
+            ty.int64, (4, 6), colors, TiledSplit(tile_shape), reader
+        )
+
+        store = table.column(0).stores()[1]
+        assert store is not None
+        alloc = store.get_inline_allocation()
+        values = alloc.consume(
+            lambda shape, ptr, strides: np.ndarray(
+                shape,
+                dtype=np.int64,
+                buffer=(ctypes.c_int64 * 24).from_address(ptr),
+                strides=strides,
+            )
+        )
+        assert np.array_equal(values, ARRAY)
+
+    def test_offset(self, tmp_path: Path) -> None:
+        path = tmp_path / "array.bin"
+        with open(path, "wb") as f:
+            f.write(b"\0" * 16)
+            f.write(ARRAY.tobytes())
+        reader = BinaryFileReader(path, np.int64, (4, 6), offset=16)
+        table = ingest(ty.int64, (4, 6), (2, 1), TiledSplit((2, 6)), reader)
+
+        store = table.column(0).stores()[1]
+        assert store is not None
+        alloc = store.get_inline_allocation()
+        values = alloc.consume(
+            lambda shape, ptr, strides: np.ndarray(
+                shape,
+                dtype=np.int64,
+                buffer=(ctypes.c_int64 * 24).from_address(ptr),
+                strides=strides,
+            )
+        )
+        assert np.array_equal(values, ARRAY)
+
+
+class Test_export_BinaryFileWriter:
+    # Blocks of whole rows are written in place, whereas blocks of columns
+    # are staged in separate buffers
+    @pytest.mark.parametrize(
+        "colors,tile_shape", [((2, 1), (2, 6)), ((1, 2), (4, 3))]
+    )
+    def test_tiles(
+        self,
+        tmp_path: Path,
+        colors: tuple[int, int],
+        tile_shape: tuple[int, int],
+    ) -> None:
+        split = TiledSplit(tile_shape)
+
+        def get_buffer(color: Point) -> memoryview:
+            rect = split.get_subdomain(Shape((4, 6)), color)
+            lo, hi = rect.lo, rect.hi
+            tile = ARRAY[lo[0] : hi[0] + 1, lo[1] : hi[1] + 1]
+            return memoryview(np.ascontiguousarray(tile))
+
+        table = ingest(ty.int64, (4, 6), colors, split, get_buffer)
+        store = table.column(0).stores()[1]
+        assert store is not None
+
+        path = tmp_path / "array.bin"
+        export(store, BinaryFileWriter(path, num_threads=2))
+        written = np.fromfile(path, dtype=np.int64).reshape(ARRAY.shape)
+        assert np.array_equal(written, ARRAY)
+
+    def test_offset(self, tmp_path: Path) -> None:
+        table = ingest(
+            ty.int64,
+            (4, 6),
+            (1, 1),
+            TiledSplit((4, 6)),
+            lambda color: memoryview(ARRAY.copy()),
+        )
+        store = table.column(0).stores()[1]
+        assert store is not None
+
+        # The bytes before the offset are left alone
+        path = tmp_path / "array.bin"
+        with open(path, "wb") as f:
+            f.write(b"header")
+        export(store, BinaryFileWriter(path, offset=6))
+        with open(path, "rb") as f:
+            assert f.read(6) == b"header"
+            written = np.frombuffer(f.read(), dtype=np.int64)
+        assert np.array_equal(written, ARRAY.ravel())
+
+
+if __name__ == "__main__":
+    import sys
+
+    sys.exit(pytest.main(sys.argv))
@@ -0,0 +1,110 @@
+# Copyright 2022 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import ctypes
+import struct
+
+import numpy as np
+import pytest
+
+from legate.core import get_legate_runtime, types as ty
+
+
+class Test_lazy_fill:
+    def test_deferred(self, monkeypatch: pytest.MonkeyPatch) -> None:
+        runtime = get_legate_runtime()
+        monkeypatch.setattr(runtime, "lazy_fill", True)
+        context = runtime.core_context
+        store = context.create_store(ty.int64, shape=(4,))
+        future = runtime.create_future(struct.pack("q", 1), 8)
+        value = context.create_store(
+            ty.int64, shape=(1,), storage=future, optimize_scalar=True
+        )
+        context.create_fill(store, value).execute()
+        runtime.flush_scheduling_window()
+        assert store.fill_value is value
+
+    def test_overwritten(self, monkeypatch: pytest.MonkeyPatch) -> None:
+        runtime = get_legate_runtime()
+        monkeypatch.setattr(runtime, "lazy_fill", True)
+        context = runtime.core_context
+        store = context.create_store(ty.int64, shape=(4,))
+        # Only the last of the fills is kept
+        for i in range(2):
+            future = runtime.create_future(struct.pack("q", i), 8)
+            value = context.create_store(
+                ty.int64, shape=(1,), storage=future, optimize_scalar=True
+            )
+            context.create_fill(store, value).execute()
+        runtime.flush_scheduling_window()
+        assert store.fill_value is value
+
+    def test_materialized(self, monkeypatch: pytest.MonkeyPatch) -> None:
+        runtime = get_legate_runtime()
+        monkeypatch.setattr(runtime, "lazy_fill", True)
+        context = runtime.core_context
+        store = context.create_store(ty.int64, shape=(4,))
+        future = runtime.create_future(struct.pack("q", 1), 8)
+        value = context.create_store(
+            ty.int64, shape=(1,), storage=future, optimize_scalar=True
+        )
+        context.create_fill(store, value).execute()
+        runtime.flush_scheduling_window()
+
+        # Mapping the store issues the fill
+        alloc = store.get_inline_allocation()
+        assert store.fill_value is None
+        values = alloc.consume(
+            lambda shape, ptr, strides: np.ndarray(
+                shape,
+                dtype=np.int64,
+                buffer=(ctypes.c_int64 * 4).from_address(ptr),
+                strides=strides,
+            )
+        )
+        assert (values == 1).all()
+
+    def test_disabled(self, monkeypatch: pytest.MonkeyPatch) -> None:
+        runtime = get_legate_runtime()
+        monkeypatch.setattr(runtime, "lazy_fill", False)
+        context = runtime.core_context
+        store = context.create_store(ty.int64, shape=(4,))
+        future = runtime.create_future(struct.pack("q", 1), 8)
+        value = context.create_store(
+            ty.int64, shape=(1,), storage=future, optimize_scalar=True
+        )
+        context.create_fill(store, value).execute()
+        runtime.flush_scheduling_window()
+        assert store.fill_value is None
+
+    def test_transformed(self, monkeypatch: pytest.MonkeyPatch) -> None:
+        runtime = get_legate_runtime()
+        monkeypatch.setattr(runtime, "lazy_fill", True)
+        context = runtime.core_context
+        store = context.create_store(ty.int64, shape=(4,))
+        future = runtime.create_future(struct.pack("q", 1), 8)
+        value = context.create_store(
+            ty.int64, shape=(1,), storage=future, optimize_scalar=True
+        )
+        # Fills of views of a store are issued right away
+        context.create_fill(store.promote(0, 2), value).execute()
+        runtime.flush_scheduling_window()
+        assert store.fill_value is None
+
+
+if __name__ == "__main__":
+    import sys
+
+    sys.exit(pytest.main(sys.argv))
@@ -0,0 +1,92 @@
+# Copyright 2022 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+from __future__ import annotations
+
+import struct
+
+import pytest
+
+from legate.core import FutureMap, Point, Rect, get_legate_runtime, types as ty
+from legate.core.load_balancer import LoadBalancer
+from legate.core.partition import Weighted
+
+
+class Test_LoadBalancer:
+    # The points of the last launch each got 10 elements. Only when one of
+    # them took clearly longer than the average are the stores rebalanced.
+    @pytest.mark.parametrize(
+        "times,rebalanced",
+        [((100, 400), True), ((100, 105), False), ((100, 0), False)],
+    )
+    def test_rebalance(
+        self, times: tuple[int, int], rebalanced: bool
+    ) -> None:
+        runtime = get_legate_runtime()
+        context = runtime.core_context
+        store = context.create_store(ty.int64, shape=(20,))
+        future = runtime.create_future(struct.pack("q", 0), 8)
+        value = context.create_store(
+            ty.int64, shape=(1,), storage=future, optimize_scalar=True
+        )
+        balancer = LoadBalancer(runtime, 0.1)
+
+        futures = {
+            Point([color]): runtime.create_future(struct.pack("Q", time), 8)
+            for color, time in enumerate(times)
+        }
+        timings = FutureMap.from_dict(
+            runtime.legion_context, runtime.legion_runtime, Rect([2]), futures
+        )
+        timings.wait()
+        balancer.record_timings((store, (10, 10)), timings)
+
+        balancer.rebalance([context.create_fill(store, value)])
+        partition = store.get_key_partition()
+        if rebalanced:
+            assert isinstance(partition, Weighted)
+            assert partition.color_shape == (2,)
+        else:
+            assert not isinstance(partition, Weighted)
+
+    def test_other_store(self) -> None:
+        runtime = get_legate_runtime()
+        context = runtime.core_context
+        store = context.create_store(ty.int64, shape=(20,))
+        other = context.create_store(ty.int64, shape=(20,))
+        future = runtime.create_future(struct.pack("q", 0), 8)
+        value = context.create_store(
+            ty.int64, shape=(1,), storage=future, optimize_scalar=True
+        )
+        balancer = LoadBalancer(runtime, 0.1)
+
+        futures = {
+            Point([color]): runtime.create_future(struct.pack("Q", time), 8)
+            for color, time in enumerate((100, 400))
+        }
+        timings = FutureMap.from_dict(
+            runtime.legion_context, runtime.legion_runtime, Rect([2]), futures
+        )
+        timings.wait()
+        balancer.record_timings((store, (10, 10)), timings)
+
+        # Feedback only applies to the stores of the operations passed in
+        balancer.rebalance([context.create_fill(other, value)])
+        assert not isinstance(store.get_key_partition(), Weighted)
+
+
+if __name__ == "__main__":
+    import sys
+
+    sys.exit(pytest.main(sys.argv))
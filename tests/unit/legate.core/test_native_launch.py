@@ -0,0 +1,67 @@
+# Copyright 2022 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import struct
+
+import pytest
+
+from legate.core import get_legate_runtime, types as ty
+from legate.core.launcher import TaskLauncher
+
+
+class Test_native_launch:
+    # Untyped scalars of primitive types are packed by the core library,
+    # whereas typed scalars make the launcher pack the arguments in Python
+    @pytest.mark.parametrize("native_launch", [True, False])
+    @pytest.mark.parametrize("untyped", [True, False])
+    def test_scalars(
+        self,
+        monkeypatch: pytest.MonkeyPatch,
+        native_launch: bool,
+        untyped: bool,
+    ) -> None:
+        runtime = get_legate_runtime()
+        monkeypatch.setattr(runtime, "native_launch", native_launch)
+        library = runtime.core_library
+        # The task ignores its arguments and returns the rank of the process
+        launcher = TaskLauncher(
+            runtime.core_context,
+            library.LEGATE_CORE_INIT_CPUCOLL_MAPPING_TASK_ID,
+            tag=library.LEGATE_CPU_VARIANT,
+        )
+        launcher.add_scalar_arg(3, ty.int32, untyped=untyped)
+        launcher.add_scalar_arg(1.5, ty.float64, untyped=untyped)
+        launcher.add_scalar_arg(True, bool, untyped=untyped)
+        future = launcher.execute_single()
+        assert struct.unpack("i", future.get_buffer(4))[0] == 0
+
+    @pytest.mark.parametrize("native_launch", [True, False])
+    def test_future(
+        self, monkeypatch: pytest.MonkeyPatch, native_launch: bool
+    ) -> None:
+        runtime = get_legate_runtime()
+        monkeypatch.setattr(runtime, "native_launch", native_launch)
+        # Launches with futures always pack the arguments in Python. The
+        # future holds two packed return values of 8 bytes each.
+        buf = struct.pack("III", 2, 8, 16) + struct.pack("qq", 42, 7)
+        future = runtime.create_future(buf, len(buf))
+        result = runtime.extract_scalar(future, 1)
+        assert struct.unpack("q", result.get_buffer(8))[0] == 7
+
+
+if __name__ == "__main__":
+    import sys
+
+    sys.exit(pytest.main(sys.argv))
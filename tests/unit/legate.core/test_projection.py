@@ -0,0 +1,58 @@
+# Copyright 2022 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import pytest
+
+from legate.core import get_legate_runtime, types as ty
+from legate.core.projection import ProjExpr, execute_functor_symbolically
+
+
+class Test_canonicalize:
+    def test_coordinate(self) -> None:
+        expr = ProjExpr(dim=1, weight=2, offset=3)
+        assert expr.canonicalize() == expr
+
+    def test_zero_weight(self) -> None:
+        expr = ProjExpr(dim=1, weight=0, offset=3)
+        assert expr.canonicalize() == ProjExpr(dim=-1, weight=0, offset=3)
+
+    def test_no_dimension(self) -> None:
+        expr = ProjExpr(dim=-1, weight=1, offset=3)
+        assert expr.canonicalize() == ProjExpr(dim=-1, weight=0, offset=3)
+
+
+class Test_get_projection:
+    def test_shared_between_transform_stacks(self) -> None:
+        runtime = get_legate_runtime()
+        store = runtime.core_context.create_store(ty.int64, shape=(4, 4))
+        point = execute_functor_symbolically(1)
+
+        # Projecting out a dimension makes a coordinate without an input
+        # dimension, whereas a functor multiplying a coordinate by zero
+        # makes one with a zero weight. Both are the constant 0.
+        projected = store.project(0, 0)
+        dims1 = projected._transform.invert_symbolic_point(point)
+        dims2 = execute_functor_symbolically(1, lambda p: (p[0] * 0, p[0]))
+        assert dims1 != dims2
+
+        proj_id = runtime.get_projection(1, dims1)
+        assert proj_id != 0
+        assert runtime.get_projection(1, dims2) == proj_id
+
+
+if __name__ == "__main__":
+    import sys
+
+    sys.exit(pytest.main(sys.argv))
@@ -0,0 +1,88 @@
+# Copyright 2022 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+import struct
+
+import pytest
+
+from legate.core import FutureMap, Point, Rect, get_legate_runtime
+from legate.timing import TaskTimes, Timer, time
+
+
+class Test_Timer:
+    def test_empty_region(self) -> None:
+        with Timer("ns") as timer:
+            pass
+        assert timer.tasks == []
+        assert isinstance(timer.elapsed, int)
+
+    def test_not_entered(self) -> None:
+        timer = Timer()
+        with pytest.raises(RuntimeError):
+            timer.start
+        with pytest.raises(RuntimeError):
+            timer.stop
+
+    def test_invalid_units(self) -> None:
+        with pytest.raises(ValueError):
+            Timer("ms")
+
+    def test_nested(self) -> None:
+        runtime = get_legate_runtime()
+        assert runtime.task_timer is None
+        with Timer() as outer:
+            assert runtime.task_timer is outer
+            with Timer() as inner:
+                assert runtime.task_timer is inner
+            assert runtime.task_timer is outer
+        assert runtime.task_timer is None
+
+
+class Test_TaskTimes:
+    def test_single_task(self) -> None:
+        runtime = get_legate_runtime()
+        future = runtime.create_future(struct.pack("Q", 42), 8)
+        times = TaskTimes("task", future, None)
+        assert len(times) == 1
+        assert times.values() == [42]
+        assert int(times.max()) == 42
+
+    def test_index_launch(self) -> None:
+        runtime = get_legate_runtime()
+        futures = {
+            Point([point]): runtime.create_future(struct.pack("Q", time), 8)
+            for point, time in enumerate((30, 50, 40))
+        }
+        timings = FutureMap.from_dict(
+            runtime.legion_context, runtime.legion_runtime, Rect([3]), futures
+        )
+        times = TaskTimes("task", timings, Rect([3]))
+        assert len(times) == 3
+        assert times.values() == [30, 50, 40]
+        assert int(times[1]) == 50
+        # The launch took as long as its slowest point
+        assert int(times.max()) == 50
+
+
+class Test_time:
+    def test_no_fence(self) -> None:
+        start = time("us", fence=False)
+        assert int(start) >= 0
+
+
+if __name__ == "__main__":
+    import sys
+
+    sys.exit(pytest.main(sys.argv))
@@ -56,6 +56,9 @@ class TestParserDefaults:
     def test_nic_bind(self) -> None:
         assert m.parser.get_default("nic_bind") is None
 
+    def test_auto_bind(self) -> None:
+        assert m.parser.get_default("auto_bind") is False
+
     # core
 
     def test_cpus(self) -> None:
@@ -0,0 +1,104 @@
+# Copyright 2022 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+from __future__ import annotations
+
+from pathlib import Path
+
+import pytest
+
+import legate.driver.auto_bind as m
+
+# Two sockets with four cores each, two GPUs and one NIC per socket
+TOPOLOGY = m.Topology(
+    {0: (0, 1, 2, 3), 1: (4, 5, 6, 7)},
+    (0, 1, 0, 1),
+    {"mlx5_0": 0, "mlx5_1": 1},
+)
+
+
+def test___all__() -> None:
+    assert m.__all__ == ("Topology", "compute_bindings", "read_topology")
+
+
+class Test_compute_bindings:
+    def test_cpu_ranks(self) -> None:
+        result = m.compute_bindings(TOPOLOGY, 4, 0)
+
+        assert result == {
+            "cpu": "0,1/2,3/4,5/6,7",
+            "mem": "0/0/1/1",
+            "nic": "mlx5_0/mlx5_0/mlx5_1/mlx5_1",
+        }
+
+    def test_gpu_ranks(self) -> None:
+        result = m.compute_bindings(TOPOLOGY, 2, 2)
+
+        assert result == {
+            "cpu": "0,1,2,3/4,5,6,7",
+            "mem": "0/1",
+            "gpu": "0,2/1,3",
+            "nic": "mlx5_0/mlx5_1",
+        }
+
+    def test_one_gpu_per_rank(self) -> None:
+        result = m.compute_bindings(TOPOLOGY, 4, 1)
+
+        assert result["gpu"] == "0/2/1/3"
+        assert result["mem"] == "0/0/1/1"
+        assert result["cpu"] == "0,1/2,3/4,5/6,7"
+
+    def test_no_local_nic(self) -> None:
+        topology = m.Topology(TOPOLOGY.numa_cpus, (), {"eth0": 0})
+
+        result = m.compute_bindings(topology, 2, 0)
+
+        assert result["nic"] == "eth0/eth0"
+
+    def test_too_many_gpus(self) -> None:
+        msg = "Cannot bind 3 ranks with 2 GPUs"
+        with pytest.raises(RuntimeError, match=msg):
+            m.compute_bindings(TOPOLOGY, 3, 2)
+
+    def test_too_many_ranks(self) -> None:
+        msg = "Cannot bind 5 ranks to the 4 cores"
+        with pytest.raises(RuntimeError, match=msg):
+            m.compute_bindings(TOPOLOGY, 10, 0)
+
+
+class Test_read_topology:
+    def test_sysfs(self, tmp_path: Path) -> None:
+        for node, cpus in ((0, "0-1,4"), (1, "2-3,5")):
+            path = tmp_path / "devices" / "system" / "node" / f"node{node}"
+            path.mkdir(parents=True)
+            (path / "cpulist").write_text(f"{cpus}\n")
+        for nic, node in (("mlx5_0", "1"), ("mlx5_1", "-1")):
+            path = tmp_path / "class" / "infiniband" / nic / "device"
+            path.mkdir(parents=True)
+            (path / "numa_node").write_text(f"{node}\n")
+
+        result = m.read_topology(tmp_path)
+
+        assert result.numa_cpus == {0: (0, 1, 4), 1: (2, 3, 5)}
+        assert result.nic_numa == {"mlx5_0": 1, "mlx5_1": 0}
+
+    def test_no_numa(self, tmp_path: Path) -> None:
+        path = tmp_path / "devices" / "system" / "cpu"
+        path.mkdir(parents=True)
+        (path / "online").write_text("0-3\n")
+
+        result = m.read_topology(tmp_path)
+
+        assert result.numa_cpus == {0: (0, 1, 2, 3)}
+        assert result.nic_numa == {}
@@ -18,8 +18,10 @@ import sys
 from pathlib import Path
 
 import pytest
+from pytest_mock import MockerFixture
 
 import legate.driver.command as m
+from legate.driver.auto_bind import Topology
 from legate.driver.launcher import RANK_ENV_VARS
 from legate.util.colors import scrub
 from legate.util.types import LauncherType
@@ -185,6 +187,34 @@ class Test_cmd_bind:
         with pytest.raises(RuntimeError, match=msg):
             m.cmd_bind(config, system, launcher)
 
+    def test_auto_bind(self, genobjs: GenObjs, mocker: MockerFixture) -> None:
+        topology = Topology({0: (0, 1), 1: (2, 3)}, (1, 0), {"mlx5_0": 1})
+        mocker.patch.object(m, "read_topology", return_value=topology)
+
+        config, system, launcher = genobjs(
+            ["--auto-bind", "--cpu-bind", "5/6", "--gpus", "1"],
+            multi_rank=(2, 2),
+            rank_env={"OMPI_COMM_WORLD_RANK": "1"},
+        )
+
+        result = m.cmd_bind(config, system, launcher)
+
+        bind_sh = str(system.legate_paths.bind_sh_path)
+        assert result == (
+            bind_sh,
+            "--launcher",
+            "auto",
+            "--cpus",
+            "5/6",
+            "--gpus",
+            "1/0",
+            "--mems",
+            "0/1",
+            "--nics",
+            "mlx5_0/mlx5_0",
+            "--",
+        )
+
 
 class Test_cmd_gdb:
 
@@ -113,6 +113,7 @@ class TestBinding:
             "mem_bind",
             "gpu_bind",
             "nic_bind",
+            "auto_bind",
         }
 
     def test_mixin(self) -> None:
@@ -293,6 +294,7 @@ class TestConfig:
             mem_bind=None,
             gpu_bind=None,
             nic_bind=None,
+            auto_bind=False,
         )
         assert c.core == m.Core(
             cpus=4,
@@ -80,6 +80,7 @@ class TestConfig:
             mem_bind=None,
             gpu_bind=None,
             nic_bind=None,
+            auto_bind=False,
         )
 
         c.profiling == m.Profiling(
@@ -0,0 +1,89 @@
+# Copyright 2022 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+"""Consolidate test configuration from command-line and environment.
+
+"""
+from __future__ import annotations
+
+import pytest
+
+from legate.tester.config import Config
+from legate.tester.stages._linux import perf as m
+from legate.tester.stages.util import UNPIN_ENV
+
+from .. import FakeSystem
+
+
+def test_default() -> None:
+    c = Config([])
+    s = FakeSystem(cpus=12)
+    stage = m.Perf(c, s)
+    assert stage.kind == "perf"
+    assert stage.args == []
+    assert stage.env(c, s) == UNPIN_ENV
+    assert stage.spec.workers == 1
+
+
+def test_cpu_pin_strict() -> None:
+    c = Config(["test.py", "--cpu-pin", "strict"])
+    s = FakeSystem(cpus=12)
+    stage = m.Perf(c, s)
+    assert stage.env(c, s) == {}
+    assert stage.spec.shards == [(0, 1, 2, 3, 4, 5)]
+
+
+@pytest.mark.parametrize("shard,expected", [[(2,), "2"], [(1, 2, 3), "1,2,3"]])
+def test_shard_args(shard: tuple[int, ...], expected: str) -> None:
+    c = Config([])
+    s = FakeSystem()
+    stage = m.Perf(c, s)
+    result = stage.shard_args(shard, c)
+    assert result == ["--cpus", f"{c.cpus}", "--cpu-bind", expected]
+
+
+def test_shard_args_cpu_pin_none() -> None:
+    c = Config(["test.py", "--cpu-pin", "none"])
+    s = FakeSystem()
+    stage = m.Perf(c, s)
+    assert stage.shard_args((1, 2), c) == ["--cpus", f"{c.cpus}"]
+
+
+def test_gbench_launcher() -> None:
+    c = Config([])
+    s = FakeSystem()
+    stage = m.Perf(c, s)
+    assert stage.gbench_launcher((1, 2), c) == ["taskset", "-c", "1,2"]
+
+
+def test_gbench_launcher_cpu_pin_none() -> None:
+    c = Config(["test.py", "--cpu-pin", "none"])
+    s = FakeSystem()
+    stage = m.Perf(c, s)
+    assert stage.gbench_launcher((1, 2), c) == []
+
+
+def test_spec_ignores_requested_workers() -> None:
+    c = Config(["test.py", "-j", "4"])
+    s = FakeSystem(cpus=12)
+    stage = m.Perf(c, s)
+    assert stage.spec.workers == 1
+    assert stage.spec.shards == [(0, 1, 2, 3, 4)]
+
+
+def test_spec_too_few_cpus() -> None:
+    c = Config(["test.py", "--cpus", "8"])
+    s = FakeSystem(cpus=4)
+    with pytest.raises(RuntimeError):
+        m.Perf(c, s)
@@ -0,0 +1,86 @@
+# Copyright 2022 NVIDIA Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+from __future__ import annotations
+
+import json
+from pathlib import Path
+
+import pytest
+
+from legate.tester.config import Config
+from legate.tester.stages import perf as m
+
+
+class Test_compare:
+    def test_within_tolerance(self) -> None:
+        lines, regressed = m.compare({"a": 1.05}, {"a": 1.0}, 0.1)
+        assert not regressed
+        assert lines == ["a: 1.05s (1.05x of baseline 1s)"]
+
+    def test_regressed(self) -> None:
+        lines, regressed = m.compare({"a": 1.2, "b": 0.5}, {"a": 1.0}, 0.1)
+        assert regressed
+        assert lines == [
+            "a: 1.2s (1.20x of baseline 1s) REGRESSED",
+            "b: 0.5s (no baseline)",
+        ]
+
+    def test_faster(self) -> None:
+        _, regressed = m.compare({"a": 0.5}, {"a": 1.0}, 0.0)
+        assert not regressed
+
+
+OSU_OUTPUT = """\
+# allreduce on 2 ranks (cpu)
+# Size          Latency (us)    Bandwidth (MB/s)
+1                       2.50                0.40
+2                       3.00                0.67
+
+# alltoallv on 2 ranks (cpu)
+# Size          Latency (us)    Bandwidth (MB/s)
+1                      10.00                0.10
+"""
+
+
+class Test_parse_osu_output:
+    def test_latencies(self) -> None:
+        assert m.parse_osu_output("bench", OSU_OUTPUT) == pytest.approx(
+            {
+                "bench/allreduce/2/1": 2.5e-6,
+                "bench/allreduce/2/2": 3.0e-6,
+                "bench/alltoallv/2/1": 1.0e-5,
+            }
+        )
+
+    def test_ignores_other_output(self) -> None:
+        assert m.parse_osu_output("bench", "1 2 3\nwarning\n") == {}
+
+
+class Test_results:
+    def test_no_baseline(self) -> None:
+        c = Config([])
+        assert m.load_baseline(c) == {}
+
+    def test_round_trip(self, tmp_path: Path) -> None:
+        path = tmp_path / "perf.json"
+        c = Config(["test.py", "--perf-results", str(path)])
+        m.save_results(c, {"a": 1.0})
+
+        data = json.loads(path.read_text())
+        assert data["config"] == m.perf_config(c)
+        assert data["measurements"] == {"a": 1.0}
+
+        c = Config(["test.py", "--perf-baseline", str(path)])
+        assert m.load_baseline(c) == {"a": 1.0}
@@ -24,9 +24,13 @@ from legate.tester import (
     DEFAULT_GPUS_PER_NODE,
     DEFAULT_OMPS_PER_NODE,
     DEFAULT_OMPTHREADS,
+    DEFAULT_PERF_REPEAT,
+    DEFAULT_PERF_TOLERANCE,
     DEFAULT_PROCESS_ENV,
     FEATURES,
     PER_FILE_ARGS,
+    PERF_BENCHMARKS,
+    PerfBenchmark,
     SKIPPED_EXAMPLES,
 )
 
@@ -50,13 +54,19 @@ class TestConsts:
     def test_DEFAULT_OMPTHREADS(self) -> None:
         assert DEFAULT_OMPTHREADS == 4
 
+    def test_DEFAULT_PERF_TOLERANCE(self) -> None:
+        assert DEFAULT_PERF_TOLERANCE == 0.1
+
+    def test_DEFAULT_PERF_REPEAT(self) -> None:
+        assert DEFAULT_PERF_REPEAT == 3
+
     def test_DEFAULT_PROCESS_ENV(self) -> None:
         assert DEFAULT_PROCESS_ENV == {
             "LEGATE_TEST": "1",
         }
 
     def test_FEATURES(self) -> None:
-        assert FEATURES == ("cpus", "cuda", "eager", "openmp")
+        assert FEATURES == ("cpus", "cuda", "eager", "openmp", "perf")
 
     def test_SKIPPED_EXAMPLES(self) -> None:
         assert isinstance(SKIPPED_EXAMPLES, set)
@@ -67,3 +77,9 @@ class TestConsts:
         assert isinstance(PER_FILE_ARGS, dict)
         assert all(isinstance(x, str) for x in PER_FILE_ARGS.keys())
         assert all(isinstance(x, list) for x in PER_FILE_ARGS.values())
+
+    def test_PERF_BENCHMARKS(self) -> None:
+        assert isinstance(PERF_BENCHMARKS, list)
+        assert all(isinstance(x, PerfBenchmark) for x in PERF_BENCHMARKS)
+        names = [x.name for x in PERF_BENCHMARKS]
+        assert len(set(names)) == len(names)
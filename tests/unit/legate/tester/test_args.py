@@ -24,6 +24,8 @@ from legate.tester import (
     DEFAULT_GPUS_PER_NODE,
     DEFAULT_OMPS_PER_NODE,
     DEFAULT_OMPTHREADS,
+    DEFAULT_PERF_REPEAT,
+    DEFAULT_PERF_TOLERANCE,
     args as m,
 )
 
@@ -59,6 +61,18 @@ class TestParserDefaults:
     def test_ompthreads(self) -> None:
         assert m.parser.get_default("ompthreads") == DEFAULT_OMPTHREADS
 
+    def test_perf_baseline(self) -> None:
+        assert m.parser.get_default("perf_baseline") is None
+
+    def test_perf_results(self) -> None:
+        assert m.parser.get_default("perf_results") == "legate_perf.json"
+
+    def test_perf_tolerance(self) -> None:
+        assert m.parser.get_default("perf_tolerance") == DEFAULT_PERF_TOLERANCE
+
+    def test_perf_repeat(self) -> None:
+        assert m.parser.get_default("perf_repeat") == DEFAULT_PERF_REPEAT
+
     def test_legate_dir(self) -> None:
         assert m.parser.get_default("legate_dir") is None
 